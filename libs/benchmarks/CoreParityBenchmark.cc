@@ -0,0 +1,326 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "config/Config.hh"
+#include "config/SettingCache.hh"
+#include "core/IApp.hh"
+#include "core/IBreak.hh"
+#include "core/ICore.hh"
+#include "utils/TimeSource.hh"
+
+#include "Core.hh"
+#include "ICoreTestHooks.hh"
+#include "Timer.hh"
+
+#include "ActivityMonitorStub.hh"
+#include "testsupport/AllocationCounter.hh"
+#include "SimulatedTime.hh"
+
+using namespace workrave;
+using namespace workrave::config;
+using namespace workrave::utils;
+
+// Runs the same scripted workloads against libs/core or, if PARITY_CORE_NEXT
+// is defined, against libs/corenext, and reports the cost of a heartbeat as JSON.
+
+namespace
+{
+#if defined(PARITY_CORE_NEXT)
+  constexpr const char *CORE_NAME = "corenext";
+  using CorePtr = ICore::Ptr;
+#else
+  constexpr const char *CORE_NAME = "core";
+  using CorePtr = ICore *;
+#endif
+
+  struct Workload
+  {
+    std::string name;
+
+    //! Whether the user is active, per simulated second.
+    std::vector<bool> activity;
+  };
+
+  struct Result
+  {
+    std::string name;
+    std::vector<int64_t> latencies;
+    int64_t allocations{0};
+    int64_t allocated_bytes{0};
+    int64_t signals{0};
+    int64_t app_calls{0};
+  };
+
+  //! Application stub that only counts what the core asks of it.
+  class App : public IApp
+  {
+  public:
+    void create_prelude_window(BreakId) override
+    {
+      calls++;
+    }
+
+    void create_break_window(BreakId, workrave::utils::Flags<BreakHint>) override
+    {
+      calls++;
+    }
+
+    void hide_break_window() override
+    {
+      calls++;
+    }
+
+    void show_break_window() override
+    {
+      calls++;
+    }
+
+    void refresh_break_window() override
+    {
+      calls++;
+    }
+
+    void set_break_progress(int, int) override
+    {
+      calls++;
+    }
+
+    void set_prelude_stage(PreludeStage) override
+    {
+      calls++;
+    }
+
+    void set_prelude_progress_text(PreludeProgressText) override
+    {
+      calls++;
+    }
+
+    int64_t calls{0};
+  };
+
+  //! The configuration used by the integration tests.
+  IConfigurator::Ptr create_configurator()
+  {
+    IConfigurator::Ptr config = ConfiguratorFactory::create(ConfigFileFormat::Ini);
+
+    config->set_value("timers/micro_pause/limit", 300);
+    config->set_value("timers/micro_pause/auto_reset", 20);
+    config->set_value("timers/micro_pause/reset_pred", "");
+    config->set_value("timers/micro_pause/snooze", 150);
+
+    config->set_value("timers/rest_break/limit", 1500);
+    config->set_value("timers/rest_break/auto_reset", 300);
+    config->set_value("timers/rest_break/reset_pred", "");
+    config->set_value("timers/rest_break/snooze", 180);
+
+    config->set_value("timers/daily_limit/limit", 14400);
+    config->set_value("timers/daily_limit/auto_reset", 0);
+    config->set_value("timers/daily_limit/reset_pred", "day/4:00");
+    config->set_value("timers/daily_limit/snooze", 1200);
+
+    config->set_value("breaks/micro_pause/max_preludes", 3);
+    config->set_value("breaks/micro_pause/enabled", true);
+    config->set_value("breaks/rest_break/max_preludes", 6);
+    config->set_value("breaks/rest_break/enabled", true);
+    config->set_value("breaks/daily_limit/max_preludes", 3);
+    config->set_value("breaks/daily_limit/enabled", true);
+
+    config->set_value("timers/daily_limit/use_microbreak_activity", false);
+    config->set_value("general/usage-mode", 0);
+    config->set_value("general/operation-mode", 0);
+
+    return config;
+  }
+
+  std::vector<Workload> create_workloads(int seconds)
+  {
+    std::vector<Workload> workloads;
+
+    workloads.push_back({"idle", std::vector<bool>(seconds, false)});
+    workloads.push_back({"active", std::vector<bool>(seconds, true)});
+
+    // Bursts of typing separated by short pauses, the same for both cores.
+    Workload typing{"typing", {}};
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> burst(5, 300);
+    std::uniform_int_distribution<int> pause(1, 120);
+    while (static_cast<int>(typing.activity.size()) < seconds)
+      {
+        typing.activity.insert(typing.activity.end(), burst(random), true);
+        typing.activity.insert(typing.activity.end(), pause(random), false);
+      }
+    typing.activity.resize(seconds);
+    workloads.push_back(typing);
+
+    return workloads;
+  }
+
+  Result run(const Workload &workload)
+  {
+    Result result;
+    result.name = workload.name;
+    result.latencies.reserve(workload.activity.size());
+
+    SimulatedTime::Ptr sim = SimulatedTime::create();
+    sim->reset();
+    TimeSource::sync();
+
+    App app;
+    ActivityMonitorStub::Ptr monitor;
+
+    SettingCache::reset();
+#if defined(PARITY_CORE_NEXT)
+    CorePtr core = CoreFactory::create();
+#else
+    CorePtr core = Core::get_instance();
+#endif
+
+    ICoreTestHooks::Ptr hooks = std::dynamic_pointer_cast<ICoreTestHooks>(core->get_hooks());
+    hooks->hook_create_configurator() = create_configurator;
+    hooks->hook_create_monitor() = [&monitor]() {
+      monitor = std::make_shared<ActivityMonitorStub>();
+      return monitor;
+    };
+    hooks->hook_load_timer_state() = [](auto) { return true; };
+
+#if defined(PARITY_CORE_NEXT)
+    core->init(&app, "");
+#else
+    core->init(0, nullptr, &app, "");
+#endif
+
+    for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+      {
+        core->get_break(BreakId(i))->signal_break_event().connect([&result](BreakEvent) { result.signals++; });
+      }
+    core->signal_operation_mode_changed().connect([&result](OperationMode) { result.signals++; });
+    core->signal_usage_mode_changed().connect([&result](UsageMode) { result.signals++; });
+
+    core->set_operation_mode(OperationMode::Normal);
+    core->set_usage_mode(UsageMode::Normal);
+    result.signals = 0;
+    app.calls = 0;
+
+    for (bool active: workload.activity)
+      {
+        monitor->set_active(active);
+        TimeSource::sync();
+
+        int64_t allocations = AllocationCounter::get_count();
+        int64_t bytes = AllocationCounter::get_bytes();
+        auto start = std::chrono::steady_clock::now();
+
+#if !defined(PARITY_CORE_NEXT)
+        monitor->heartbeat();
+#endif
+        core->heartbeat();
+
+        auto end = std::chrono::steady_clock::now();
+        result.allocations += AllocationCounter::get_count() - allocations;
+        result.allocated_bytes += AllocationCounter::get_bytes() - bytes;
+        result.latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+
+        sim->current_time += 1000000;
+      }
+
+    result.app_calls = app.calls;
+
+#if !defined(PARITY_CORE_NEXT)
+    Core::reset_instance();
+#endif
+    return result;
+  }
+
+  int64_t percentile(const std::vector<int64_t> &sorted, double p)
+  {
+    if (sorted.empty())
+      {
+        return 0;
+      }
+    auto index = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[index];
+  }
+
+  std::string to_json(const std::vector<Result> &results)
+  {
+    std::ostringstream out;
+    out << "{\n  \"core\": \"" << CORE_NAME << "\",\n  \"workloads\": [";
+
+    for (std::size_t i = 0; i < results.size(); i++)
+      {
+        const Result &result = results[i];
+        std::vector<int64_t> sorted = result.latencies;
+        std::sort(sorted.begin(), sorted.end());
+
+        double heartbeats = static_cast<double>(std::max<std::size_t>(sorted.size(), 1));
+
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    {\n";
+        out << "      \"name\": \"" << result.name << "\",\n";
+        out << "      \"heartbeats\": " << sorted.size() << ",\n";
+        out << "      \"latency_ns\": {\"p50\": " << percentile(sorted, 0.50) << ", \"p90\": " << percentile(sorted, 0.90)
+            << ", \"p99\": " << percentile(sorted, 0.99) << ", \"max\": " << (sorted.empty() ? 0 : sorted.back()) << "},\n";
+        out << "      \"allocations_per_heartbeat\": " << static_cast<double>(result.allocations) / heartbeats << ",\n";
+        out << "      \"allocated_bytes_per_heartbeat\": " << static_cast<double>(result.allocated_bytes) / heartbeats << ",\n";
+        out << "      \"signals\": " << result.signals << ",\n";
+        out << "      \"app_calls\": " << result.app_calls << "\n";
+        out << "    }";
+      }
+
+    out << "\n  ]\n}\n";
+    return out.str();
+  }
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+  int hours = argc > 1 ? std::atoi(argv[1]) : 8;
+  std::string output = argc > 2 ? argv[2] : "";
+
+  std::vector<Result> results;
+  for (const Workload &workload: create_workloads(hours * 60 * 60))
+    {
+      results.push_back(run(workload));
+    }
+
+  std::string json = to_json(results);
+  if (output.empty())
+    {
+      std::cout << json;
+    }
+  else
+    {
+      std::ofstream file(output);
+      file << json;
+    }
+  return 0;
+}
@@ -18,7 +18,6 @@
 #ifndef WORKRAVE_CONFIG_SETTING_HH
 #define WORKRAVE_CONFIG_SETTING_HH
 
-#include <boost/signals2.hpp>
 #include <boost/noncopyable.hpp>
 #include <utility>
 
@@ -42,7 +41,7 @@ namespace workrave
       , boost::noncopyable
     {
     private:
-      using NotifyType = boost::signals2::signal<void()>;
+      using NotifyType = workrave::utils::Signal<void()>;
 
     public:
       explicit SettingGroup(workrave::config::IConfigurator::Ptr config, std::string setting)
@@ -99,7 +98,7 @@ namespace workrave
       , boost::noncopyable
     {
     private:
-      using NotifyType = boost::signals2::signal<void(const R &)>;
+      using NotifyType = workrave::utils::Signal<void(const R &)>;
 
     public:
       explicit Setting(workrave::config::IConfigurator::Ptr config, std::string setting)
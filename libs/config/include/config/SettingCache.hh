@@ -21,6 +21,7 @@
 #include <map>
 #include <utility>
 #include <memory>
+#include <mutex>
 #include <boost/noncopyable.hpp>
 
 #include "config/IConfigurator.hh"
@@ -36,6 +37,7 @@ namespace workrave
       template<typename T, typename S = T>
       static workrave::config::Setting<T, S> &get(IConfigurator::Ptr config, const std::string &key, const S &def = S())
       {
+        std::lock_guard<std::mutex> lock(mutex);
         if (cache.find(key) == cache.end())
           {
             cache[key] = std::make_shared<workrave::config::Setting<T, S>>(config, key, def);
@@ -48,6 +50,7 @@ namespace workrave
 
       static workrave::config::SettingGroup &group(IConfigurator::Ptr config, const std::string &key)
       {
+        std::lock_guard<std::mutex> lock(mutex);
         if (cache.find(key) == cache.end())
           {
             cache[key] = std::make_shared<workrave::config::SettingGroup>(config, key);
@@ -60,11 +63,15 @@ namespace workrave
 
       static void reset()
       {
+        std::lock_guard<std::mutex> lock(mutex);
         cache.clear();
       }
 
     private:
       static std::map<std::string, std::shared_ptr<SettingBase>> cache;
+
+      //! Settings are looked up from the session threads of the session server.
+      static std::mutex mutex;
     };
   } // namespace config
 } // namespace workrave
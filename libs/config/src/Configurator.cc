@@ -47,6 +47,7 @@ Configurator::Configurator(IConfigBackend *backend)
     {
       dynamic_cast<IConfigBackendMonitoring *>(backend)->set_listener(this);
     }
+  batching = dynamic_cast<IConfigBackendBatching *>(backend);
 }
 
 // Destructs the configurator.
@@ -121,6 +122,11 @@ Configurator::heartbeat()
       save();
       auto_save_time = 0;
     }
+
+  if (batching != nullptr)
+    {
+      batching->flush();
+    }
 }
 
 void
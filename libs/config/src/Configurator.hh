@@ -119,6 +119,9 @@ private:
   //! The backend in use.
   IConfigBackend *backend{nullptr};
 
+  //! The backend, if it collects writes until flushed.
+  IConfigBackendBatching *batching{nullptr};
+
   //! Next auto save time.
   int64_t auto_save_time{0};
 };
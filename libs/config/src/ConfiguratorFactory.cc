@@ -26,6 +26,7 @@
 #include "Configurator.hh"
 
 #include "IniConfigurator.hh"
+#include "JournaledConfigurator.hh"
 #include "XmlConfigurator.hh"
 #ifdef HAVE_GSETTINGS
 #  include "GSettingsConfigurator.hh"
@@ -64,12 +65,12 @@ ConfiguratorFactory::create(ConfigFileFormat fmt)
 
   if (fmt == ConfigFileFormat::Xml)
     {
-      b = new XmlConfigurator();
+      b = new JournaledConfigurator(new XmlConfigurator());
     }
 
   if (fmt == ConfigFileFormat::Ini)
     {
-      b = new IniConfigurator();
+      b = new JournaledConfigurator(new IniConfigurator());
     }
 
   if (b != nullptr)
@@ -20,7 +20,6 @@
 #endif
 
 #include "debug.hh"
-#include <cstring>
 #include <boost/algorithm/string/replace.hpp>
 
 #include "GSettingsConfigurator.hh"
@@ -45,6 +44,8 @@ GSettingsConfigurator::GSettingsConfigurator()
 
 GSettingsConfigurator::~GSettingsConfigurator()
 {
+  flush();
+
   for (const auto &[key, setting]: settings)
     {
       g_object_unref(setting);
@@ -68,25 +69,34 @@ GSettingsConfigurator::save(string filename)
 bool
 GSettingsConfigurator::save()
 {
+  flush();
   return true;
 }
 
 bool
 GSettingsConfigurator::remove_key(const std::string &full_path)
 {
-  bool ret = true;
-  std::string key;
-  GSettings *child = get_settings(full_path, key);
-  g_settings_reset(child, key.c_str());
-  return ret;
+  const KeyEntry *entry = find_key(full_path);
+  if (entry == nullptr)
+    {
+      return false;
+    }
+
+  g_settings_reset(entry->settings, g_quark_to_string(entry->key));
+  unapplied.insert(entry->settings);
+  return true;
 }
 
 bool
 GSettingsConfigurator::has_user_value(const std::string &full_path)
 {
-  std::string key;
-  GSettings *child = get_settings(full_path, key);
-  GVariant *value = g_settings_get_user_value(child, key.c_str());
+  const KeyEntry *entry = find_key(full_path);
+  if (entry == nullptr)
+    {
+      return false;
+    }
+
+  GVariant *value = g_settings_get_user_value(entry->settings, g_quark_to_string(entry->key));
   if (value != nullptr)
     {
       g_variant_unref(value);
@@ -100,11 +110,12 @@ GSettingsConfigurator::get_value(const std::string &full_path, VariantType type,
 {
   bool ret = false;
 
-  string key;
-  GSettings *child = get_settings(full_path, key);
-  if (child != nullptr)
+  const KeyEntry *entry = find_key(full_path);
+  if (entry != nullptr)
     {
-      GVariant *value = g_settings_get_value(child, key.c_str());
+      GSettings *child = entry->settings;
+      const gchar *key = g_quark_to_string(entry->key);
+      GVariant *value = g_settings_get_value(child, key);
       if (value != nullptr)
         {
           if (type == VARIANT_TYPE_NONE)
@@ -134,26 +145,26 @@ GSettingsConfigurator::get_value(const std::string &full_path, VariantType type,
 
           if (type == VARIANT_TYPE_INT && g_variant_type_equal(G_VARIANT_TYPE_INT32, value_type))
             {
-              out.int_value = g_settings_get_int(child, key.c_str());
+              out.int_value = g_variant_get_int32(value);
               ret = true;
             }
           else if (type == VARIANT_TYPE_BOOL && g_variant_type_equal(G_VARIANT_TYPE_BOOLEAN, value_type))
             {
-              out.bool_value = g_settings_get_boolean(child, key.c_str());
+              out.bool_value = g_variant_get_boolean(value);
               ret = true;
             }
           else if (type == VARIANT_TYPE_DOUBLE && g_variant_type_equal(G_VARIANT_TYPE_DOUBLE, value_type))
             {
-              out.double_value = g_settings_get_double(child, key.c_str());
+              out.double_value = g_variant_get_double(value);
               ret = true;
             }
           else if (type == VARIANT_TYPE_STRING && g_variant_type_equal(G_VARIANT_TYPE_STRING, value_type))
             {
-              out.string_value = g_settings_get_string(child, key.c_str());
+              out.string_value = g_variant_get_string(value, nullptr);
               ret = true;
             }
 
-          // g_variant_unref(value);
+          g_variant_unref(value);
         }
 
       if (ret)
@@ -168,13 +179,14 @@ GSettingsConfigurator::get_value(const std::string &full_path, VariantType type,
 bool
 GSettingsConfigurator::set_value(const std::string &full_path, Variant &value)
 {
-  bool ret = true;
-
-  string key;
-  GSettings *child = get_settings(full_path, key);
+  bool ret = false;
 
-  if (child != nullptr)
+  const KeyEntry *entry = find_key(full_path);
+  if (entry != nullptr)
     {
+      GSettings *child = entry->settings;
+      const gchar *key = g_quark_to_string(entry->key);
+
       switch (value.type)
         {
         case VARIANT_TYPE_NONE:
@@ -182,24 +194,29 @@ GSettingsConfigurator::set_value(const std::string &full_path, Variant &value)
           break;
 
         case VARIANT_TYPE_INT:
-          ret = g_settings_set_int(child, key.c_str(), value.int_value);
+          ret = g_settings_set_int(child, key, value.int_value);
           break;
 
         case VARIANT_TYPE_BOOL:
-          ret = g_settings_set_boolean(child, key.c_str(), value.bool_value);
+          ret = g_settings_set_boolean(child, key, value.bool_value);
           break;
 
         case VARIANT_TYPE_DOUBLE:
-          ret = g_settings_set_double(child, key.c_str(), value.double_value);
+          ret = g_settings_set_double(child, key, value.double_value);
           break;
 
         case VARIANT_TYPE_STRING:
-          ret = g_settings_set_string(child, key.c_str(), value.string_value.c_str());
+          ret = g_settings_set_string(child, key, value.string_value.c_str());
           break;
 
         default:
           ret = false;
         }
+
+      if (ret)
+        {
+          unapplied.insert(child);
+        }
     }
   return ret;
 }
@@ -224,14 +241,31 @@ GSettingsConfigurator::remove_listener(const string &remove_key)
   return true;
 }
 
+void
+GSettingsConfigurator::flush()
+{
+  for (GSettings *gsettings: unapplied)
+    {
+      g_settings_apply(gsettings);
+    }
+  unapplied.clear();
+}
+
+bool
+GSettingsConfigurator::has_unapplied() const
+{
+  return !unapplied.empty();
+}
+
 void
 GSettingsConfigurator::add_children()
 {
   TRACE_ENTER("GSettingsConfigurator::add_children");
   int len = schema_base.length();
 
+  GSettingsSchemaSource *source = g_settings_schema_source_get_default();
   gchar **schemas = nullptr;
-  g_settings_schema_source_list_schemas(g_settings_schema_source_get_default(), TRUE, &schemas, nullptr);
+  g_settings_schema_source_list_schemas(source, TRUE, &schemas, nullptr);
 
   for (int i = 0; schemas[i] != nullptr; i++)
     {
@@ -239,18 +273,85 @@ GSettingsConfigurator::add_children()
         {
           GSettings *gsettings = g_settings_new(schemas[i]);
 
+          // Collect writes until the next flush.
+          g_settings_delay(gsettings);
+
           settings[schemas[i]] = gsettings;
           g_signal_connect(gsettings, "changed", G_CALLBACK(on_settings_changed), this);
+
+          GSettingsSchema *schema = g_settings_schema_source_lookup(source, schemas[i], TRUE);
+          if (schema != nullptr)
+            {
+              add_keys(gsettings, schema);
+              g_settings_schema_unref(schema);
+            }
         }
     }
 
+  g_strfreev(schemas);
   TRACE_EXIT();
 }
 
+//! Adds all keys of a schema to the key table.
+/*!
+ *  Workrave uses underscores where GSettings uses dashes, except for a few
+ *  keys. Both spellings are added, so that a lookup needs no string
+ *  conversion.
+ */
+void
+GSettingsConfigurator::add_keys(GSettings *gsettings, GSettingsSchema *schema)
+{
+  gchar *path = nullptr;
+  g_object_get(gsettings, "path", &path, NULL);
+
+  string relative_path = path != nullptr ? path : "";
+  if (relative_path.compare(0, path_base.length(), path_base) == 0)
+    {
+      relative_path = relative_path.substr(path_base.length());
+    }
+  g_free(path);
+
+  gchar **schema_keys = g_settings_schema_list_keys(schema);
+  for (int i = 0; schema_keys[i] != nullptr; i++)
+    {
+      KeyEntry entry{gsettings, g_quark_from_string(schema_keys[i])};
+
+      string dashed = relative_path + schema_keys[i];
+      string name = boost::algorithm::replace_all_copy(dashed, "-", "_");
+
+      keys[dashed] = entry;
+      keys[name] = entry;
+
+      for (auto &underscore_exception: underscore_exceptions)
+        {
+          if (underscore_exception == dashed)
+            {
+              name = dashed;
+              break;
+            }
+        }
+      key_names[std::make_pair(gsettings, entry.key)] = name;
+    }
+  g_strfreev(schema_keys);
+}
+
 void
 GSettingsConfigurator::on_settings_changed(GSettings *gsettings, const gchar *key, void *user_data)
 {
   TRACE_ENTER_MSG("GSettingsConfigurator::on_settings_changed", key);
+  auto *self = (GSettingsConfigurator *)user_data;
+
+  auto it = self->key_names.find(std::make_pair(gsettings, g_quark_from_string(key)));
+  if (it != self->key_names.end())
+    {
+      if (self->listener != nullptr)
+        {
+          self->listener->config_changed_notify(it->second);
+        }
+      TRACE_EXIT();
+      return;
+    }
+
   gchar *path;
   g_object_get(gsettings, "path", &path, NULL);
 
@@ -269,7 +370,6 @@ GSettingsConfigurator::on_settings_changed(GSettings *gsettings, const gchar *ke
         }
     }
 
-  auto *self = (GSettingsConfigurator *)user_data;
   if (self->listener != nullptr)
     {
       self->listener->config_changed_notify(changed);
@@ -279,43 +379,15 @@ GSettingsConfigurator::on_settings_changed(GSettings *gsettings, const gchar *ke
   TRACE_EXIT();
 }
 
-void
-GSettingsConfigurator::key_split(const string &key, string &parent, string &child) const
+const GSettingsConfigurator::KeyEntry *
+GSettingsConfigurator::find_key(const std::string &full_path) const
 {
-  const char *s = key.c_str();
-  const char *slash = strrchr(s, '/');
-  if (slash)
-    {
-      parent = key.substr(0, slash - s);
-      child = slash + 1;
-    }
-  else
-    {
-      parent = "";
-      child = "";
-    }
-}
-
-GSettings *
-GSettingsConfigurator::get_settings(const std::string &full_path, string &key) const
-{
-  TRACE_ENTER_MSG("GSettingsConfigurator::get_settings", full_path);
-
-  string path;
-
-  string tmp = boost::algorithm::replace_all_copy(full_path, "_", "-");
-  key_split(tmp, path, key);
-  string schema = boost::algorithm::replace_all_copy(path, "/", ".");
-
-  TRACE_MSG(key << " " << path << " " << schema);
-
-  auto i = settings.find(schema_base + "." + schema);
-  if (i == settings.end())
+  auto i = keys.find(full_path);
+  if (i == keys.end())
     {
+      TRACE_ENTER_MSG("GSettingsConfigurator::find_key", full_path);
       TRACE_RETURN("NULL");
       return nullptr;
     }
-
-  TRACE_EXIT();
-  return i->second;
+  return &i->second;
 }
@@ -20,6 +20,9 @@
 
 #include <string>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 #include <glib.h>
 #include <gio/gio.h>
@@ -29,6 +32,7 @@
 class GSettingsConfigurator
   : public IConfigBackend
   , public IConfigBackendMonitoring
+  , public IConfigBackendBatching
 {
 public:
   GSettingsConfigurator();
@@ -47,7 +51,16 @@ public:
   bool add_listener(const std::string &key_prefix) override;
   bool remove_listener(const std::string &key_prefix) override;
 
+  //! Applies all changes made since the last flush, one write per schema.
+  void flush() override;
+
 private:
+  struct KeyEntry
+  {
+    GSettings *settings;
+    GQuark key;
+  };
+
   //! Send changes to.
   workrave::config::IConfiguratorListener *listener{nullptr};
 
@@ -59,11 +72,27 @@ private:
   //!
   SettingsMap settings;
 
+  //! All keys of all schemas, by Workrave key name.
+  std::unordered_map<std::string, KeyEntry> keys;
+
+  //! Workrave key names by schema and GSettings key.
+  std::map<std::pair<GSettings *, GQuark>, std::string> key_names;
+
+  //! Schemas with changes that have not been applied.
+  std::unordered_set<GSettings *> unapplied;
+
   void add_children();
-  void key_split(const std::string &key, std::string &parent, std::string &child) const;
-  GSettings *get_settings(const std::string &path, std::string &key) const;
+  void add_keys(GSettings *gsettings, GSettingsSchema *schema);
+  const KeyEntry *find_key(const std::string &full_path) const;
+
+  //! Returns whether there are changes that have not been flushed.
+  bool has_unapplied() const;
 
   static void on_settings_changed(GSettings *settings, const gchar *key, void *user_data);
+
+#ifdef HAVE_TESTS
+  friend class Fixture;
+#endif
 };
 
 #endif // GGSETTINGSCONFIGURATOR_HH
@@ -55,4 +55,22 @@ public:
   virtual bool remove_listener(const std::string &key_prefix) = 0;
 };
 
+class IConfigBackendBatching
+{
+public:
+  virtual ~IConfigBackendBatching() = default;
+
+  //! Writes all changes made since the last flush.
+  virtual void flush() = 0;
+};
+
+class IConfigBackendSerializing
+{
+public:
+  virtual ~IConfigBackendSerializing() = default;
+
+  //! Writes the complete configuration in the file format of the backend.
+  virtual bool serialize(std::string &out) const = 0;
+};
+
 #endif // ICONFIGBACKEND_HH
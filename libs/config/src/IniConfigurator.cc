@@ -28,6 +28,7 @@
 #include <boost/algorithm/string.hpp>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 
 #include "debug.hh"
 
@@ -73,6 +74,25 @@ IniConfigurator::save(string filename)
   return ret;
 }
 
+bool
+IniConfigurator::serialize(std::string &out) const
+{
+  bool ret = false;
+
+  try
+    {
+      ostringstream stream;
+      boost::property_tree::ini_parser::write_ini(stream, pt);
+      out = stream.str();
+      ret = true;
+    }
+  catch (boost::property_tree::ini_parser_error &)
+    {
+    }
+
+  return ret;
+}
+
 bool
 IniConfigurator::save()
 {
@@ -110,7 +130,11 @@ IniConfigurator::remove_key(const std::string &key)
       std::string section = key.substr(0, pos);
       boost::replace_all(inikey, "/", ".");
 
-      pt.get_child(section).erase(inikey);
+      auto child = pt.get_child_optional(section);
+      if (child)
+        {
+          child->erase(inikey);
+        }
     }
 
   TRACE_EXIT();
@@ -0,0 +1,827 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "JournaledConfigurator.hh"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <sys/stat.h>
+
+#ifdef PLATFORM_OS_WINDOWS
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
+#include <boost/crc.hpp>
+
+#include "debug.hh"
+#include "utils/StateWriter.hh"
+
+using namespace std;
+using namespace workrave::utils;
+
+namespace
+{
+  //! Journal file header, followed by records.
+  /*!
+   *  header: magic, u32 CRC-32 of the canonical file the journal applies to.
+   *  record: u32 payload size, u32 CRC-32 of the payload, payload.
+   *  payload: u8 op, u16 key size, key, and for OP_SET: u8 type, value.
+   *  value: i32 (int), u8 (bool), 64 bit IEEE 754 (double), u32 size + bytes (string).
+   *  All integers are little endian.
+   */
+  constexpr char MAGIC[] = {'W', 'R', 'J', '2'};
+  constexpr size_t HEADER_SIZE = sizeof(MAGIC) + 4;
+  constexpr size_t RECORD_HEADER_SIZE = 8;
+
+  constexpr uint8_t OP_SET = 1;
+  constexpr uint8_t OP_REMOVE = 2;
+
+  void put_u8(string &out, uint8_t v)
+  {
+    out.push_back(static_cast<char>(v));
+  }
+
+  void put_u16(string &out, uint16_t v)
+  {
+    put_u8(out, v & 0xff);
+    put_u8(out, v >> 8);
+  }
+
+  void put_u32(string &out, uint32_t v)
+  {
+    put_u16(out, v & 0xffff);
+    put_u16(out, v >> 16);
+  }
+
+  void put_u64(string &out, uint64_t v)
+  {
+    put_u32(out, v & 0xffffffff);
+    put_u32(out, v >> 32);
+  }
+
+  uint32_t get_u32(const char *data)
+  {
+    const auto *p = reinterpret_cast<const uint8_t *>(data);
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+  }
+
+  uint32_t crc32(const char *data, size_t size)
+  {
+    boost::crc_32_type crc;
+    crc.process_bytes(data, size);
+    return crc.checksum();
+  }
+
+  //! Reads a record payload, failing on any read beyond its end.
+  class PayloadReader
+  {
+  public:
+    PayloadReader(const char *data, size_t size)
+      : data(reinterpret_cast<const uint8_t *>(data))
+      , size(size)
+    {
+    }
+
+    bool get_u8(uint8_t &v)
+    {
+      if (pos + 1 > size)
+        {
+          return false;
+        }
+      v = data[pos++];
+      return true;
+    }
+
+    bool get_u16(uint16_t &v)
+    {
+      uint8_t lo = 0;
+      uint8_t hi = 0;
+      bool ok = get_u8(lo) && get_u8(hi);
+      v = lo | (hi << 8);
+      return ok;
+    }
+
+    bool get_u32(uint32_t &v)
+    {
+      uint16_t lo = 0;
+      uint16_t hi = 0;
+      bool ok = get_u16(lo) && get_u16(hi);
+      v = lo | (static_cast<uint32_t>(hi) << 16);
+      return ok;
+    }
+
+    bool get_u64(uint64_t &v)
+    {
+      uint32_t lo = 0;
+      uint32_t hi = 0;
+      bool ok = get_u32(lo) && get_u32(hi);
+      v = lo | (static_cast<uint64_t>(hi) << 32);
+      return ok;
+    }
+
+    bool get_string(size_t len, string &v)
+    {
+      if (len > size - pos)
+        {
+          return false;
+        }
+      v.assign(reinterpret_cast<const char *>(data + pos), len);
+      pos += len;
+      return true;
+    }
+
+    bool at_end() const
+    {
+      return pos == size;
+    }
+
+  private:
+    const uint8_t *data;
+    size_t size;
+    size_t pos{0};
+  };
+
+  void encode_record(string &out, const string &key, bool removed, const Variant &value)
+  {
+    string payload;
+    put_u8(payload, removed ? OP_REMOVE : OP_SET);
+    put_u16(payload, static_cast<uint16_t>(key.size()));
+    payload += key;
+
+    if (!removed)
+      {
+        put_u8(payload, static_cast<uint8_t>(value.type));
+        switch (value.type)
+          {
+          case VARIANT_TYPE_INT:
+            put_u32(payload, static_cast<uint32_t>(value.int_value));
+            break;
+
+          case VARIANT_TYPE_BOOL:
+            put_u8(payload, value.bool_value ? 1 : 0);
+            break;
+
+          case VARIANT_TYPE_DOUBLE:
+            {
+              uint64_t bits = 0;
+              memcpy(&bits, &value.double_value, sizeof(bits));
+              put_u64(payload, bits);
+            }
+            break;
+
+          case VARIANT_TYPE_NONE:
+          case VARIANT_TYPE_STRING:
+            put_u32(payload, static_cast<uint32_t>(value.string_value.size()));
+            payload += value.string_value;
+            break;
+          }
+      }
+
+    put_u32(out, static_cast<uint32_t>(payload.size()));
+    put_u32(out, crc32(payload.data(), payload.size()));
+    out += payload;
+  }
+
+  bool decode_record(const char *data, size_t size, string &key, bool &removed, Variant &value)
+  {
+    PayloadReader reader(data, size);
+
+    uint8_t op = 0;
+    uint16_t key_size = 0;
+    if (!reader.get_u8(op) || !reader.get_u16(key_size) || !reader.get_string(key_size, key))
+      {
+        return false;
+      }
+
+    removed = op == OP_REMOVE;
+    if (op == OP_SET)
+      {
+        uint8_t type = 0;
+        if (!reader.get_u8(type))
+          {
+            return false;
+          }
+
+        value.type = static_cast<VariantType>(type);
+        switch (value.type)
+          {
+          case VARIANT_TYPE_INT:
+            {
+              uint32_t v = 0;
+              if (!reader.get_u32(v))
+                {
+                  return false;
+                }
+              value.int_value = static_cast<int32_t>(v);
+            }
+            break;
+
+          case VARIANT_TYPE_BOOL:
+            {
+              uint8_t v = 0;
+              if (!reader.get_u8(v))
+                {
+                  return false;
+                }
+              value.bool_value = v != 0;
+            }
+            break;
+
+          case VARIANT_TYPE_DOUBLE:
+            {
+              uint64_t bits = 0;
+              if (!reader.get_u64(bits))
+                {
+                  return false;
+                }
+              memcpy(&value.double_value, &bits, sizeof(bits));
+            }
+            break;
+
+          case VARIANT_TYPE_NONE:
+          case VARIANT_TYPE_STRING:
+            {
+              uint32_t len = 0;
+              if (!reader.get_u32(len) || !reader.get_string(len, value.string_value))
+                {
+                  return false;
+                }
+            }
+            break;
+
+          default:
+            return false;
+          }
+      }
+    else if (op != OP_REMOVE)
+      {
+        return false;
+      }
+
+    return reader.at_end();
+  }
+
+  int open_append(const filesystem::path &path)
+  {
+#ifdef PLATFORM_OS_WINDOWS
+    return _wopen(path.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    return ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+#endif
+  }
+
+  bool write_all(int fd, const char *data, size_t size)
+  {
+    while (size > 0)
+      {
+#ifdef PLATFORM_OS_WINDOWS
+        int ret = _write(fd, data, static_cast<unsigned int>(size));
+#else
+        ssize_t ret = ::write(fd, data, size);
+#endif
+        if (ret < 0)
+          {
+            if (errno == EINTR)
+              {
+                continue;
+              }
+            return false;
+          }
+        data += ret;
+        size -= ret;
+      }
+    return true;
+  }
+
+  void sync_fd(int fd)
+  {
+#ifdef PLATFORM_OS_WINDOWS
+    _commit(fd);
+#else
+    ::fsync(fd);
+#endif
+  }
+
+  void close_fd(int fd)
+  {
+#ifdef PLATFORM_OS_WINDOWS
+    _close(fd);
+#else
+    ::close(fd);
+#endif
+  }
+
+  string read_file(const filesystem::path &path)
+  {
+    ifstream in(path, ios::binary);
+    return string(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+  }
+
+  //! Returns whether the journal was started on top of the canonical file with the specified checksum.
+  bool is_journal_of(const filesystem::path &path, uint32_t base)
+  {
+    char header[HEADER_SIZE];
+    ifstream in(path, ios::binary);
+    in.read(header, HEADER_SIZE);
+    return in && memcmp(header, MAGIC, sizeof(MAGIC)) == 0 && get_u32(header + sizeof(MAGIC)) == base;
+  }
+} // namespace
+
+JournaledConfigurator::JournaledConfigurator(IConfigBackend *backend)
+  : backend(backend)
+  , serializer(dynamic_cast<IConfigBackendSerializing *>(backend))
+{
+}
+
+JournaledConfigurator::~JournaledConfigurator()
+{
+  flush();
+  sync_journal();
+  wait_for_compaction();
+  close_journal();
+}
+
+bool
+JournaledConfigurator::load(string filename)
+{
+  TRACE_ENTER_MSG("JournaledConfigurator::load", filename);
+
+  wait_for_compaction();
+  close_journal();
+  pending.clear();
+
+  bool ret = backend->load(filename);
+
+  if (serializer == nullptr)
+    {
+      TRACE_RETURN("not journaled");
+      return ret;
+    }
+
+  this->filename = filename;
+
+  // Left behind by a compaction that was interrupted while writing.
+  error_code ec;
+  filesystem::remove(StateWriter::get_temp_path(this->filename), ec);
+
+  // A journal only applies to the file it was started on. If the file was
+  // replaced since, by a compaction or by hand, the journal is stale.
+  string contents = read_file(this->filename);
+  journal_base = crc32(contents.data(), contents.size());
+
+  filesystem::path journal = get_journal_path(this->filename);
+  filesystem::path old_journal = get_old_journal_path(this->filename);
+  bool interrupted = filesystem::exists(old_journal, ec);
+  if (interrupted && !is_journal_of(old_journal, journal_base))
+    {
+      TRACE_MSG("discarding old journal");
+      filesystem::remove(old_journal, ec);
+      interrupted = false;
+    }
+  if (!interrupted && filesystem::exists(journal, ec) && !is_journal_of(journal, journal_base))
+    {
+      TRACE_MSG("discarding journal of modified file");
+      filesystem::remove(journal, ec);
+    }
+
+  if (interrupted)
+    {
+      ret = replay(old_journal) || ret;
+    }
+  ret = replay(journal) || ret;
+
+  open_journal();
+
+  if (interrupted)
+    {
+      compact();
+    }
+
+  TRACE_RETURN(ret);
+  return ret;
+}
+
+bool
+JournaledConfigurator::save(string filename)
+{
+  if (journal_fd >= 0 && filesystem::path(filename) == this->filename)
+    {
+      return compact();
+    }
+  return backend->save(filename);
+}
+
+bool
+JournaledConfigurator::save()
+{
+  if (journal_fd < 0)
+    {
+      return backend->save();
+    }
+
+  flush();
+  sync_journal();
+
+  if ((journal_size >= COMPACTION_SIZE || journal_failed) && !compacting)
+    {
+      wait_for_compaction();
+      start_compaction();
+    }
+  return true;
+}
+
+bool
+JournaledConfigurator::remove_key(const string &key)
+{
+  bool existed = backend->has_user_value(key);
+
+  bool ret = backend->remove_key(key);
+  if (ret && existed && journal_fd >= 0)
+    {
+      Change &change = pending[key];
+      change.removed = true;
+    }
+  return ret;
+}
+
+bool
+JournaledConfigurator::has_user_value(const string &key)
+{
+  return backend->has_user_value(key);
+}
+
+bool
+JournaledConfigurator::get_value(const string &key, VariantType type, Variant &value) const
+{
+  return backend->get_value(key, type, value);
+}
+
+bool
+JournaledConfigurator::set_value(const string &key, Variant &value)
+{
+  Variant old_value;
+  bool changed = !backend->get_value(key, value.type, old_value) || old_value != value;
+
+  bool ret = backend->set_value(key, value);
+  if (ret && changed && journal_fd >= 0)
+    {
+      Change &change = pending[key];
+      change.removed = false;
+      change.value = value;
+    }
+  return ret;
+}
+
+void
+JournaledConfigurator::flush()
+{
+  if (pending.empty())
+    {
+      return;
+    }
+
+  string data;
+  for (const auto &[key, change]: pending)
+    {
+      encode_record(data, key, change.removed, change.value);
+    }
+  pending.clear();
+
+  append(data);
+}
+
+bool
+JournaledConfigurator::compact()
+{
+  if (journal_fd < 0)
+    {
+      return backend->save();
+    }
+
+  flush();
+  wait_for_compaction();
+  start_compaction();
+  wait_for_compaction();
+
+  error_code ec;
+  return !filesystem::exists(get_old_journal_path(filename), ec);
+}
+
+void
+JournaledConfigurator::wait_for_compaction()
+{
+  if (compaction_thread.joinable())
+    {
+      compaction_thread.join();
+    }
+}
+
+int64_t
+JournaledConfigurator::get_journal_size() const
+{
+  return journal_size;
+}
+
+int64_t
+JournaledConfigurator::get_journal_bytes_written() const
+{
+  return journal_bytes_written;
+}
+
+int64_t
+JournaledConfigurator::get_compaction_bytes_written() const
+{
+  return compaction_bytes_written;
+}
+
+int64_t
+JournaledConfigurator::get_compaction_count() const
+{
+  return compaction_count;
+}
+
+filesystem::path
+JournaledConfigurator::get_journal_path(const filesystem::path &path)
+{
+  filesystem::path journal = path;
+  journal += ".journal";
+  return journal;
+}
+
+filesystem::path
+JournaledConfigurator::get_old_journal_path(const filesystem::path &path)
+{
+  filesystem::path journal = path;
+  journal += ".journal.old";
+  return journal;
+}
+
+#ifdef HAVE_TESTS
+void
+JournaledConfigurator::set_compaction_hook(std::function<void(CompactionStep)> hook)
+{
+  compaction_hook = std::move(hook);
+}
+#endif
+
+//! Applies all valid records of a journal to the backend.
+/*!
+ *  The journal is cut off at the first invalid record, so that new
+ *  records are never appended after garbage.
+ */
+bool
+JournaledConfigurator::replay(const filesystem::path &path)
+{
+  TRACE_ENTER_MSG("JournaledConfigurator::replay", path.u8string());
+  string data = read_file(path);
+
+  bool ret = false;
+  size_t valid = 0;
+  if (data.size() >= HEADER_SIZE && memcmp(data.data(), MAGIC, sizeof(MAGIC)) == 0)
+    {
+      valid = HEADER_SIZE;
+      while (data.size() - valid >= RECORD_HEADER_SIZE)
+        {
+          size_t size = get_u32(data.data() + valid);
+          uint32_t crc = get_u32(data.data() + valid + 4);
+          const char *payload = data.data() + valid + RECORD_HEADER_SIZE;
+
+          if (size > data.size() - valid - RECORD_HEADER_SIZE || crc32(payload, size) != crc)
+            {
+              break;
+            }
+
+          string key;
+          bool removed = false;
+          Variant value;
+          if (!decode_record(payload, size, key, removed, value))
+            {
+              break;
+            }
+
+          if (!removed)
+            {
+              backend->set_value(key, value);
+            }
+          else if (backend->has_user_value(key))
+            {
+              backend->remove_key(key);
+            }
+
+          valid += RECORD_HEADER_SIZE + size;
+          ret = true;
+        }
+    }
+
+  if (valid != data.size())
+    {
+      TRACE_MSG("discarding " << data.size() - valid << " bytes");
+      error_code ec;
+      if (valid == 0)
+        {
+          filesystem::remove(path, ec);
+        }
+      else
+        {
+          filesystem::resize_file(path, valid, ec);
+        }
+    }
+
+  TRACE_RETURN(ret);
+  return ret;
+}
+
+void
+JournaledConfigurator::start_compaction()
+{
+  TRACE_ENTER("JournaledConfigurator::start_compaction");
+  string contents;
+  if (!serializer->serialize(contents))
+    {
+      TRACE_RETURN("cannot serialize");
+      return;
+    }
+
+  sync_journal();
+  close_journal();
+
+  filesystem::path journal = get_journal_path(filename);
+  filesystem::path old_journal = get_old_journal_path(filename);
+
+  error_code ec;
+  if (filesystem::exists(old_journal, ec))
+    {
+      // A previous compaction failed. Both journals are needed until the
+      // canonical file is written, so keep them in a single one.
+      string data = read_file(journal);
+      int fd = open_append(old_journal);
+      if (fd < 0)
+        {
+          open_journal();
+          TRACE_RETURN("cannot open old journal");
+          return;
+        }
+
+      bool ok = data.size() <= HEADER_SIZE || write_all(fd, data.data() + HEADER_SIZE, data.size() - HEADER_SIZE);
+      sync_fd(fd);
+      close_fd(fd);
+      if (!ok)
+        {
+          open_journal();
+          TRACE_RETURN("cannot append to old journal");
+          return;
+        }
+      filesystem::remove(journal, ec);
+    }
+  else
+    {
+      filesystem::rename(journal, old_journal, ec);
+      if (ec)
+        {
+          open_journal();
+          TRACE_RETURN("cannot move journal");
+          return;
+        }
+    }
+
+  // The new journal applies to the file that is about to be written.
+  journal_base = crc32(contents.data(), contents.size());
+  open_journal();
+
+  compacting = true;
+  compaction_thread = std::thread([this, contents = std::move(contents)]() mutable { run_compaction(std::move(contents)); });
+  TRACE_EXIT();
+}
+
+void
+JournaledConfigurator::run_compaction(string contents)
+{
+#ifdef HAVE_TESTS
+  if (compaction_hook)
+    {
+      compaction_hook(CompactionStep::Rotated);
+    }
+#endif
+
+  // On failure, the old journal is kept and merged by the next compaction.
+  if (!StateWriter::write_atomic(filename, contents))
+    {
+      compacting = false;
+      return;
+    }
+
+  compaction_bytes_written += static_cast<int64_t>(contents.size());
+  compaction_count++;
+
+#ifdef HAVE_TESTS
+  if (compaction_hook)
+    {
+      compaction_hook(CompactionStep::Replaced);
+    }
+#endif
+
+  error_code ec;
+  filesystem::remove(get_old_journal_path(filename), ec);
+
+#ifdef HAVE_TESTS
+  if (compaction_hook)
+    {
+      compaction_hook(CompactionStep::Done);
+    }
+#endif
+
+  compacting = false;
+}
+
+bool
+JournaledConfigurator::open_journal()
+{
+  filesystem::path journal = get_journal_path(filename);
+
+  journal_failed = false;
+  journal_fd = open_append(journal);
+  if (journal_fd < 0)
+    {
+      return false;
+    }
+
+  error_code ec;
+  journal_size = static_cast<int64_t>(filesystem::file_size(journal, ec));
+  if (ec || journal_size == 0)
+    {
+      journal_size = 0;
+
+      string header(MAGIC, sizeof(MAGIC));
+      put_u32(header, journal_base);
+      return append(header);
+    }
+  return true;
+}
+
+void
+JournaledConfigurator::close_journal()
+{
+  if (journal_fd >= 0)
+    {
+      close_fd(journal_fd);
+      journal_fd = -1;
+    }
+  journal_size = 0;
+  journal_dirty = false;
+}
+
+bool
+JournaledConfigurator::append(const string &data)
+{
+  if (journal_fd < 0 || journal_failed)
+    {
+      return false;
+    }
+
+  if (!write_all(journal_fd, data.data(), data.size()))
+    {
+      // The journal may now end in a partial record. Records appended after it
+      // would be lost, so write the canonical file and start a new journal.
+      journal_failed = true;
+      return false;
+    }
+
+  journal_size += static_cast<int64_t>(data.size());
+  journal_bytes_written += static_cast<int64_t>(data.size());
+  journal_dirty = true;
+  return true;
+}
+
+//! Makes the journal durable. Appends are only synced on save, to limit disk writes.
+void
+JournaledConfigurator::sync_journal()
+{
+  if (journal_fd >= 0 && journal_dirty)
+    {
+      sync_fd(journal_fd);
+      journal_dirty = false;
+    }
+}
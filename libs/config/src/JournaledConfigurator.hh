@@ -0,0 +1,167 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef JOURNALEDCONFIGURATOR_HH
+#define JOURNALEDCONFIGURATOR_HH
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "IConfigBackend.hh"
+
+//! File configuration backend that records changes in an append-only journal.
+/*!
+ *  Writing a full INI or XML file for every small change wastes disk
+ *  writes, especially for keys that change often, such as window
+ *  positions. This backend keeps the configuration in a file backend
+ *  and only appends changed keys to a journal next to the file
+ *  (<file>.journal). Every record carries a checksum. Once the journal
+ *  has grown large enough, it is compacted: the full configuration is
+ *  written to the canonical file on a worker thread.
+ *
+ *  Loading replays the journal on top of the canonical file. A record
+ *  that was torn by a crash, and everything after it, is discarded.
+ *  The journal records a checksum of the canonical file it was started
+ *  on. If the file was edited by hand since, the journal is discarded
+ *  so that the edit is not overwritten.
+ *
+ *  Compaction first moves the journal aside (<file>.journal.old) and
+ *  starts a new one. The worker replaces the canonical file atomically
+ *  and then removes the old journal. A crash at any point leaves a set
+ *  of files from which load() restores every change that was flushed.
+ */
+class JournaledConfigurator
+  : public IConfigBackend
+  , public IConfigBackendBatching
+{
+public:
+  //! Takes ownership of the file backend.
+  explicit JournaledConfigurator(IConfigBackend *backend);
+  ~JournaledConfigurator() override;
+
+  JournaledConfigurator(const JournaledConfigurator &) = delete;
+  JournaledConfigurator &operator=(const JournaledConfigurator &) = delete;
+
+  bool load(std::string filename) override;
+  bool save(std::string filename) override;
+  bool save() override;
+
+  bool remove_key(const std::string &key) override;
+  bool has_user_value(const std::string &key) override;
+  bool get_value(const std::string &key, VariantType type, Variant &value) const override;
+  bool set_value(const std::string &key, Variant &value) override;
+
+  //! Appends all changes since the last flush to the journal.
+  void flush() override;
+
+  //! Writes the canonical file now and waits until it is done.
+  bool compact();
+
+  //! Blocks until a running compaction is done.
+  void wait_for_compaction();
+
+  //! Returns the size of the journal in bytes.
+  int64_t get_journal_size() const;
+
+  //! Returns the number of bytes appended to the journal.
+  int64_t get_journal_bytes_written() const;
+
+  //! Returns the number of bytes written to the canonical file by compaction.
+  int64_t get_compaction_bytes_written() const;
+
+  //! Returns the number of compactions.
+  int64_t get_compaction_count() const;
+
+  //! Returns the name of the journal of the specified file.
+  static std::filesystem::path get_journal_path(const std::filesystem::path &path);
+
+  //! Returns the name of the journal that is being compacted.
+  static std::filesystem::path get_old_journal_path(const std::filesystem::path &path);
+
+#ifdef HAVE_TESTS
+  enum class CompactionStep
+  {
+    //! The journal was moved aside, the canonical file is not written yet.
+    Rotated,
+    //! The canonical file was replaced, the old journal still exists.
+    Replaced,
+    //! The old journal was removed.
+    Done
+  };
+
+  //! Calls the function from the worker thread at each step of a compaction.
+  void set_compaction_hook(std::function<void(CompactionStep)> hook);
+#endif
+
+  //! Journal size from which the journal is compacted on save.
+  static constexpr int64_t COMPACTION_SIZE = 64 * 1024;
+
+private:
+  struct Change
+  {
+    bool removed{false};
+    Variant value;
+  };
+
+  bool replay(const std::filesystem::path &path);
+  void start_compaction();
+  void run_compaction(std::string contents);
+  bool open_journal();
+  void close_journal();
+  bool append(const std::string &data);
+  void sync_journal();
+
+private:
+  std::unique_ptr<IConfigBackend> backend;
+
+  //! The backend as serializer, or nullptr if it cannot be compacted in the background.
+  IConfigBackendSerializing *serializer{nullptr};
+
+  std::filesystem::path filename;
+
+  //! Changes since the last flush, by key.
+  std::map<std::string, Change> pending;
+
+  int journal_fd{-1};
+
+  //! Checksum of the canonical file the current journal applies to.
+  uint32_t journal_base{0};
+  int64_t journal_size{0};
+  bool journal_dirty{false};
+
+  //! An append failed, so the journal must be compacted.
+  bool journal_failed{false};
+
+  int64_t journal_bytes_written{0};
+  std::atomic<int64_t> compaction_bytes_written{0};
+  std::atomic<int64_t> compaction_count{0};
+  std::atomic<bool> compacting{false};
+
+  std::thread compaction_thread;
+
+#ifdef HAVE_TESTS
+  std::function<void(CompactionStep)> compaction_hook;
+#endif
+};
+
+#endif // JOURNALEDCONFIGURATOR_HH
@@ -22,3 +22,4 @@
 #include "config/SettingCache.hh"
 
 std::map<std::string, std::shared_ptr<workrave::config::SettingBase>> workrave::config::SettingCache::cache;
+std::mutex workrave::config::SettingCache::mutex;
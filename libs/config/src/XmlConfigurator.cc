@@ -24,6 +24,7 @@
 #include <cstring>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 
 #include <boost/algorithm/string.hpp>
 
@@ -71,6 +72,25 @@ XmlConfigurator::save(string filename)
   return ret;
 }
 
+bool
+XmlConfigurator::serialize(std::string &out) const
+{
+  bool ret = false;
+
+  try
+    {
+      ostringstream stream;
+      boost::property_tree::xml_parser::write_xml(stream, pt);
+      out = stream.str();
+      ret = true;
+    }
+  catch (boost::property_tree::xml_parser_error &)
+    {
+    }
+
+  return ret;
+}
+
 bool
 XmlConfigurator::save()
 {
@@ -25,7 +25,9 @@
 
 #include "IConfigBackend.hh"
 
-class XmlConfigurator : public virtual IConfigBackend
+class XmlConfigurator
+  : public virtual IConfigBackend
+  , public IConfigBackendSerializing
 {
 public:
   XmlConfigurator() = default;
@@ -40,6 +42,8 @@ public:
   bool get_value(const std::string &key, VariantType type, Variant &value) const override;
   bool set_value(const std::string &key, Variant &value) override;
 
+  bool serialize(std::string &out) const override;
+
 private:
   std::string path(const std::string &key) const;
 
@@ -0,0 +1,208 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "SimulatedTime.hh"
+
+#include "Configurator.hh"
+#include "IniConfigurator.hh"
+#include "JournaledConfigurator.hh"
+
+using namespace std;
+using namespace workrave::config;
+using namespace workrave::utils;
+
+namespace
+{
+  //! Counts the bytes of every full save of a file backend.
+  class CountingConfigurator : public IniConfigurator
+  {
+  public:
+    bool save() override
+    {
+      bool ret = IniConfigurator::save();
+      error_code ec;
+      bytes_written += static_cast<int64_t>(filesystem::file_size(filename, ec));
+      return ret;
+    }
+
+    bool load(string filename) override
+    {
+      this->filename = filename;
+      return IniConfigurator::load(filename);
+    }
+
+    int64_t bytes_written{0};
+
+  private:
+    string filename;
+  };
+
+  //! A typical configuration of about 150 keys.
+  void populate(Configurator &config)
+  {
+    for (const char *timer: {"micro_pause", "rest_break", "daily_limit"})
+      {
+        string t = string("timers/") + timer + "/";
+        config.set_value(t + "limit", 3000);
+        config.set_value(t + "auto_reset", 300);
+        config.set_value(t + "snooze", 150);
+        config.set_value(t + "monitor", string(""));
+        config.set_value(t + "activity_sensitive", true);
+
+        string b = string("gui/breaks/") + timer + "/";
+        config.set_value(b + "max_preludes", 3);
+        config.set_value(b + "enabled", true);
+        config.set_value(b + "exercises", 3);
+        config.set_value(b + "auto_natural", false);
+        config.set_value(b + "ignorable_break", true);
+        config.set_value(b + "skippable_break", true);
+
+        for (int i = 0; i < 10; i++)
+          {
+            config.set_value(string("gui/applet/") + timer + "/slot" + to_string(i), i);
+            config.set_value(string("gui/main_window/") + timer + "/slot" + to_string(i), i);
+          }
+      }
+
+    for (int i = 0; i < 40; i++)
+      {
+        config.set_value("plugins/misc/option" + to_string(i), string("value") + to_string(i));
+      }
+    config.save();
+  }
+
+  //! Plays one simulated day of preference changes.
+  /*!
+   *  The user drags the timer box twice per hour, which changes its
+   *  position about 30 times within a few seconds. The main window is
+   *  moved or resized ten times a day. A few preferences are changed
+   *  over the day.
+   */
+  int play_day(Configurator &config, const SimulatedTime::Ptr &sim)
+  {
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> position(0, 2000);
+
+    int changes = 0;
+    for (int second = 0; second < 24 * 3600; second++)
+      {
+        if (second % 1800 == 0)
+          {
+            for (int i = 0; i < 30; i++)
+              {
+                config.set_value("gui/main_window/x", position(random));
+                config.set_value("gui/main_window/y", position(random));
+                changes += 2;
+              }
+          }
+
+        if (second % 8640 == 100)
+          {
+            config.set_value("gui/main_window/width", 200 + position(random) / 10);
+            config.set_value("gui/main_window/height", 100 + position(random) / 10);
+            changes += 2;
+          }
+
+        if (second % 17280 == 500)
+          {
+            config.set_value("timers/micro_pause/limit", 150 + position(random) / 10);
+            config.set_value("gui/breaks/micro_pause/max_preludes", position(random) % 5);
+            config.set_value("general/usage-mode", position(random) % 2);
+            changes += 3;
+          }
+
+        TimeSource::sync();
+        config.heartbeat();
+        sim->current_time += 1000000;
+      }
+    return changes;
+  }
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+  auto sim = SimulatedTime::create();
+  filesystem::path dir = filesystem::temp_directory_path()
+                         / ("workrave-churn-" + to_string(chrono::steady_clock::now().time_since_epoch().count()));
+  filesystem::create_directories(dir);
+
+  int64_t full_bytes = 0;
+  int changes = 0;
+  {
+    sim->reset();
+    TimeSource::sync();
+    // IniConfigurator only saves to a file it loaded.
+    ofstream((dir / "full.ini").u8string()).close();
+
+    auto *backend = new CountingConfigurator();
+    Configurator config(backend);
+    config.load((dir / "full.ini").u8string());
+    populate(config);
+
+    backend->bytes_written = 0;
+    changes = play_day(config, sim);
+    config.save();
+    full_bytes = backend->bytes_written;
+  }
+
+  int64_t journal_bytes = 0;
+  int64_t compaction_bytes = 0;
+  int64_t compactions = 0;
+  {
+    sim->reset();
+    TimeSource::sync();
+    auto *backend = new JournaledConfigurator(new IniConfigurator());
+    Configurator config(backend);
+    config.load((dir / "journaled.ini").u8string());
+    populate(config);
+    backend->wait_for_compaction();
+
+    int64_t journal_start = backend->get_journal_bytes_written();
+    int64_t compaction_start = backend->get_compaction_bytes_written();
+    int64_t compaction_count_start = backend->get_compaction_count();
+
+    play_day(config, sim);
+    config.save();
+    backend->wait_for_compaction();
+
+    journal_bytes = backend->get_journal_bytes_written() - journal_start;
+    compaction_bytes = backend->get_compaction_bytes_written() - compaction_start;
+    compactions = backend->get_compaction_count() - compaction_count_start;
+  }
+
+  cout << changes << " changes per day" << endl;
+  cout << "full saves: " << full_bytes << " bytes/day" << endl;
+  cout << "journaled:  " << journal_bytes + compaction_bytes << " bytes/day (" << journal_bytes << " journal, " << compaction_bytes
+       << " in " << compactions << " compactions)" << endl;
+
+  error_code ec;
+  filesystem::remove_all(dir, ec);
+  return 0;
+}
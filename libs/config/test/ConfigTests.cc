@@ -189,6 +189,13 @@ public:
     return SettingCache::get<bool>(configurator, "test/settings/default/bool", true);
   }
 
+#ifdef HAVE_GSETTINGS
+  static bool has_unapplied(const GSettingsConfigurator *backend)
+  {
+    return backend->has_unapplied();
+  }
+#endif
+
   SimulatedTime::Ptr sim;
   Configurator::Ptr configurator;
   bool has_defaults{false};
@@ -991,6 +998,27 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_configurator_remove, T, backend_types)
     }
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_configurator_remove_missing, T, backend_types)
+{
+  init<T>();
+
+  bool ok{false};
+
+  ok = configurator->remove_key("/test/missing/int/");
+  BOOST_CHECK_EQUAL(ok, true);
+
+  ok = configurator->set_value("/test/other/int/", 1023);
+  BOOST_CHECK_EQUAL(ok, true);
+
+  ok = configurator->remove_key("/test/other/missing/");
+  BOOST_CHECK_EQUAL(ok, true);
+
+  int value;
+  ok = configurator->get_value("/test/other/int/", value);
+  BOOST_CHECK_EQUAL(ok, true);
+  BOOST_CHECK_EQUAL(value, 1023);
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_configurator_rename_int, T, backend_types)
 {
   init<T>();
@@ -1556,4 +1584,51 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_settings_group_connect_tracked, T, backend_ty
   BOOST_CHECK_EQUAL(fired, 2);
 };
 
+#ifdef HAVE_GSETTINGS
+BOOST_AUTO_TEST_CASE(test_gsettings_batched_writes)
+{
+  sim->reset();
+  TimeSource::sync();
+  helper::init<GSettingsConfigurator>(this);
+
+  auto *backend = new GSettingsConfigurator();
+  configurator = std::make_shared<Configurator>(backend);
+
+  GSettings *other = g_settings_new("org.workrave.test.other");
+  GSettings *settings = g_settings_new("org.workrave.test.settings");
+
+  int base = g_settings_get_int(other, "int") + 1;
+  for (int i = 0; i < 10; i++)
+    {
+      configurator->set_value("test/other/int", base + i);
+      configurator->set_value("test/other/delay-initial", base + i);
+      configurator->set_value("test/settings/int", base + i);
+      configurator->set_value("test/settings/string", std::string{"batched"} + std::to_string(i));
+    }
+  BOOST_CHECK(has_unapplied(backend));
+
+  // Pending changes are visible through the configurator...
+  int value{0};
+  bool ok = configurator->get_value("test/other/int", value);
+  BOOST_CHECK_EQUAL(ok, true);
+  BOOST_CHECK_EQUAL(value, base + 9);
+
+  // ...but are not written until the next heartbeat.
+  BOOST_CHECK_EQUAL(g_settings_get_int(other, "int"), base - 1);
+
+  tick();
+  BOOST_CHECK(!has_unapplied(backend));
+
+  BOOST_CHECK_EQUAL(g_settings_get_int(other, "int"), base + 9);
+  BOOST_CHECK_EQUAL(g_settings_get_int(other, "delay-initial"), base + 9);
+  BOOST_CHECK_EQUAL(g_settings_get_int(settings, "int"), base + 9);
+  gchar *str = g_settings_get_string(settings, "string");
+  BOOST_CHECK_EQUAL(std::string(str), "batched9");
+  g_free(str);
+
+  g_object_unref(other);
+  g_object_unref(settings);
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
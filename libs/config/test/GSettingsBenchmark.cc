@@ -0,0 +1,91 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+#include "Configurator.hh"
+#include "GSettingsConfigurator.hh"
+
+using namespace workrave::config;
+
+namespace
+{
+  const char *const int_keys[] = {"test/other/int",
+                                  "test/other/int2",
+                                  "test/other/initial",
+                                  "test/other/delay-initial",
+                                  "test/settings/int",
+                                  "test/settings/mode",
+                                  "test/code-defaults/int",
+                                  "test/schema-defaults/int"};
+
+  double elapsed_us(std::chrono::steady_clock::time_point start)
+  {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+  }
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+  int iterations = argc > 1 ? std::atoi(argv[1]) : 20000;
+
+  g_setenv("GSETTINGS_SCHEMA_DIR", BUILDDIR, true);
+  g_setenv("GSETTINGS_BACKEND", "memory", 1);
+
+  auto *backend = new GSettingsConfigurator();
+  auto configurator = std::make_shared<Configurator>(backend);
+
+  int64_t sum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++)
+    {
+      for (const char *key: int_keys)
+        {
+          int value = 0;
+          configurator->get_value(key, value);
+          sum += value;
+        }
+    }
+  double us = elapsed_us(start);
+  std::cout << "get_value: " << (iterations * std::size(int_keys)) / us << " M lookups/s" << std::endl;
+
+  // A preferences change: 20 writes spread over a few schemas, then one heartbeat.
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations / 100; i++)
+    {
+      for (int j = 0; j < 20; j++)
+        {
+          configurator->set_value(int_keys[j % std::size(int_keys)], i + j);
+        }
+      configurator->heartbeat();
+    }
+  us = elapsed_us(start);
+  std::cout << "20 x set_value + flush: " << us / (iterations / 100) << " us" << std::endl;
+
+  std::cout << "(" << sum << ")" << std::endl;
+  return 0;
+}
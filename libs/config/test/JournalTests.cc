@@ -0,0 +1,440 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#define BOOST_TEST_MODULE workrave_config_journal
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "IniConfigurator.hh"
+#include "JournaledConfigurator.hh"
+#include "XmlConfigurator.hh"
+
+using namespace std;
+
+class Fixture
+{
+public:
+  Fixture()
+  {
+    dir = filesystem::temp_directory_path() / ("workrave-journal-" + to_string(chrono::steady_clock::now().time_since_epoch().count()));
+    filesystem::create_directories(dir);
+  }
+
+  ~Fixture()
+  {
+    error_code ec;
+    filesystem::remove_all(dir, ec);
+  }
+
+  filesystem::path file(const string &name = "workrave.ini") const
+  {
+    return dir / name;
+  }
+
+  static unique_ptr<JournaledConfigurator> open(const filesystem::path &path)
+  {
+    auto config = make_unique<JournaledConfigurator>(new IniConfigurator());
+    config->load(path.u8string());
+    return config;
+  }
+
+  //! Copies the files of a configuration as they are now, as if the process died at this point.
+  static void crash_copy(const filesystem::path &from, const filesystem::path &to)
+  {
+    for (const auto &[src, dst]: {make_pair(from, to),
+                                  make_pair(JournaledConfigurator::get_journal_path(from), JournaledConfigurator::get_journal_path(to)),
+                                  make_pair(JournaledConfigurator::get_old_journal_path(from), JournaledConfigurator::get_old_journal_path(to))})
+      {
+        error_code ec;
+        filesystem::remove(dst, ec);
+        if (filesystem::exists(src))
+          {
+            filesystem::copy_file(src, dst);
+          }
+      }
+  }
+
+  static int get_int(IConfigBackend &config, const string &key, int def = -1)
+  {
+    Variant value;
+    if (!config.get_value(key, VARIANT_TYPE_INT, value))
+      {
+        return def;
+      }
+    return value.int_value;
+  }
+
+  static void set_int(IConfigBackend &config, const string &key, int v)
+  {
+    Variant value(v);
+    config.set_value(key, value);
+  }
+
+protected:
+  filesystem::path dir;
+};
+
+BOOST_FIXTURE_TEST_SUITE(journal, Fixture)
+
+BOOST_AUTO_TEST_CASE(test_journal_roundtrip)
+{
+  auto config = open(file());
+
+  Variant s(string("hello world"));
+  Variant b(true);
+  Variant d(12.25);
+  config->set_value("gui/main_window/title", s);
+  config->set_value("gui/main_window/visible", b);
+  config->set_value("timers/micro_pause/ratio", d);
+  set_int(*config, "timers/micro_pause/limit", 180);
+  set_int(*config, "timers/rest_break/limit", 2700);
+  config->remove_key("timers/rest_break/limit");
+  config->flush();
+
+  // Nothing was compacted, so the canonical file does not exist yet.
+  BOOST_CHECK(!filesystem::exists(file()));
+  BOOST_CHECK_GT(config->get_journal_size(), 0);
+
+  crash_copy(file(), file("crash.ini"));
+  auto restored = open(file("crash.ini"));
+
+  Variant value;
+  BOOST_CHECK(restored->get_value("gui/main_window/title", VARIANT_TYPE_STRING, value));
+  BOOST_CHECK_EQUAL(value.string_value, "hello world");
+  BOOST_CHECK(restored->get_value("gui/main_window/visible", VARIANT_TYPE_BOOL, value));
+  BOOST_CHECK_EQUAL(value.bool_value, true);
+  BOOST_CHECK(restored->get_value("timers/micro_pause/ratio", VARIANT_TYPE_DOUBLE, value));
+  BOOST_CHECK_EQUAL(value.double_value, 12.25);
+  BOOST_CHECK_EQUAL(get_int(*restored, "timers/micro_pause/limit"), 180);
+  BOOST_CHECK(!restored->has_user_value("timers/rest_break/limit"));
+}
+
+BOOST_AUTO_TEST_CASE(test_journal_unchanged_values)
+{
+  auto config = open(file());
+
+  set_int(*config, "gui/applet/x", 10);
+  config->flush();
+  int64_t size = config->get_journal_size();
+
+  set_int(*config, "gui/applet/x", 10);
+  config->flush();
+  BOOST_CHECK_EQUAL(config->get_journal_size(), size);
+
+  // Only the last of several changes within one flush is written.
+  for (int i = 0; i < 100; i++)
+    {
+      set_int(*config, "gui/applet/x", i);
+    }
+  config->flush();
+  int64_t one_record = config->get_journal_size() - size;
+
+  set_int(*config, "gui/applet/x", 1000);
+  config->flush();
+  BOOST_CHECK_EQUAL(config->get_journal_size() - size, 2 * one_record);
+}
+
+BOOST_AUTO_TEST_CASE(test_journal_torn_tail)
+{
+  const int count = 20;
+  {
+    auto config = open(file());
+    for (int i = 0; i < count; i++)
+      {
+        set_int(*config, "test/key" + to_string(i), i);
+        config->flush();
+      }
+  }
+
+  filesystem::path journal = JournaledConfigurator::get_journal_path(file());
+  auto full_size = static_cast<int64_t>(filesystem::file_size(journal));
+
+  // Cut the journal at every possible offset, as a crash during a write would.
+  int last_restored = count;
+  for (int64_t size = full_size; size >= 0; size--)
+    {
+      crash_copy(file(), file("crash.ini"));
+      filesystem::path crash_journal = JournaledConfigurator::get_journal_path(file("crash.ini"));
+      filesystem::resize_file(crash_journal, size);
+
+      int restored = 0;
+      {
+        auto config = open(file("crash.ini"));
+        while (restored < count && get_int(*config, "test/key" + to_string(restored)) == restored)
+          {
+            restored++;
+          }
+
+        // Exactly a prefix of the changes survives.
+        for (int i = restored; i < count; i++)
+          {
+            BOOST_CHECK(!config->has_user_value("test/key" + to_string(i)));
+          }
+
+        // New changes must not end up behind the torn record.
+        set_int(*config, "test/after", 1);
+      }
+      BOOST_CHECK_LE(restored, last_restored);
+      last_restored = restored;
+
+      auto config = open(file("crash.ini"));
+      BOOST_CHECK_EQUAL(get_int(*config, "test/after"), 1);
+      if (restored > 0)
+        {
+          BOOST_CHECK_EQUAL(get_int(*config, "test/key" + to_string(restored - 1)), restored - 1);
+        }
+    }
+  BOOST_CHECK_EQUAL(last_restored, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_journal_corrupt_record)
+{
+  {
+    auto config = open(file());
+    for (int i = 0; i < 10; i++)
+      {
+        set_int(*config, "test/key" + to_string(i), i);
+        config->flush();
+      }
+  }
+
+  filesystem::path journal = JournaledConfigurator::get_journal_path(file());
+  auto size = filesystem::file_size(journal);
+
+  // Flip a bit in the middle of the journal.
+  {
+    fstream f(journal, ios::in | ios::out | ios::binary);
+    f.seekg(static_cast<streamoff>(size / 2));
+    char c = 0;
+    f.get(c);
+    f.seekp(static_cast<streamoff>(size / 2));
+    f.put(static_cast<char>(c ^ 0x10));
+  }
+
+  auto config = open(file());
+  BOOST_CHECK_EQUAL(get_int(*config, "test/key0"), 0);
+  BOOST_CHECK(!config->has_user_value("test/key9"));
+  BOOST_CHECK_LT(filesystem::file_size(journal), size);
+}
+
+BOOST_AUTO_TEST_CASE(test_journal_compaction_crash)
+{
+  auto config = open(file());
+  for (int i = 0; i < 50; i++)
+    {
+      set_int(*config, "test/key" + to_string(i), i);
+    }
+  config->flush();
+
+  int steps = 0;
+  config->set_compaction_hook([&](JournaledConfigurator::CompactionStep step) {
+    filesystem::path copy = file("crash" + to_string(static_cast<int>(step)) + ".ini");
+    crash_copy(file(), copy);
+
+    if (step == JournaledConfigurator::CompactionStep::Rotated)
+      {
+        // Crash while the canonical file was being written.
+        ofstream tmp(copy.u8string() + ".tmp");
+        tmp << "[test]\nkey0=garbage";
+      }
+    steps++;
+  });
+
+  BOOST_CHECK(config->compact());
+  BOOST_CHECK_EQUAL(steps, 3);
+  BOOST_CHECK_EQUAL(config->get_compaction_count(), 1);
+
+  for (int step = 0; step < 3; step++)
+    {
+      BOOST_TEST_CONTEXT("step " << step)
+      {
+        filesystem::path copy = file("crash" + to_string(step) + ".ini");
+        auto restored = open(copy);
+        for (int i = 0; i < 50; i++)
+          {
+            BOOST_CHECK_EQUAL(get_int(*restored, "test/key" + to_string(i)), i);
+          }
+
+        // An interrupted compaction is completed on load.
+        BOOST_CHECK(!filesystem::exists(JournaledConfigurator::get_old_journal_path(copy)));
+        BOOST_CHECK(!filesystem::exists(copy.u8string() + ".tmp"));
+      }
+    }
+
+  // The canonical file alone holds everything after a compaction.
+  IniConfigurator plain;
+  plain.load(file().u8string());
+  for (int i = 0; i < 50; i++)
+    {
+      BOOST_CHECK_EQUAL(get_int(plain, "test/key" + to_string(i)), i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_journal_changes_during_compaction)
+{
+  auto config = open(file());
+
+  int i = 0;
+  while (config->get_journal_size() < JournaledConfigurator::COMPACTION_SIZE)
+    {
+      set_int(*config, "gui/main_window/x", i++);
+      config->flush();
+    }
+
+  // Hold the compaction before it writes the canonical file.
+  promise<void> rotated;
+  promise<void> resume;
+  config->set_compaction_hook([&](JournaledConfigurator::CompactionStep step) {
+    if (step == JournaledConfigurator::CompactionStep::Rotated)
+      {
+        rotated.set_value();
+        resume.get_future().wait();
+      }
+  });
+
+  BOOST_CHECK(config->save());
+  rotated.get_future().wait();
+
+  // Changes made meanwhile go to the new journal.
+  set_int(*config, "gui/main_window/x", -1);
+  set_int(*config, "gui/main_window/y", 2);
+  config->flush();
+  crash_copy(file(), file("crash.ini"));
+
+  resume.set_value();
+  config->wait_for_compaction();
+
+  auto restored = open(file("crash.ini"));
+  BOOST_CHECK_EQUAL(get_int(*restored, "gui/main_window/x"), -1);
+  BOOST_CHECK_EQUAL(get_int(*restored, "gui/main_window/y"), 2);
+
+  // The live configuration ends up the same.
+  config.reset();
+  restored = open(file());
+  BOOST_CHECK_EQUAL(get_int(*restored, "gui/main_window/x"), -1);
+  BOOST_CHECK_EQUAL(get_int(*restored, "gui/main_window/y"), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_journal_compacts_on_save)
+{
+  auto config = open(file());
+
+  int i = 0;
+  while (config->get_journal_size() < JournaledConfigurator::COMPACTION_SIZE)
+    {
+      set_int(*config, "gui/main_window/x", i++);
+      config->flush();
+    }
+
+  int64_t size = config->get_journal_size();
+  BOOST_CHECK(config->save());
+  config->wait_for_compaction();
+
+  BOOST_CHECK_EQUAL(config->get_compaction_count(), 1);
+  BOOST_CHECK_LT(config->get_journal_size(), size);
+  BOOST_CHECK(!filesystem::exists(JournaledConfigurator::get_old_journal_path(file())));
+
+  IniConfigurator plain;
+  plain.load(file().u8string());
+  BOOST_CHECK_EQUAL(get_int(plain, "gui/main_window/x"), i - 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_journal_hand_edit)
+{
+  {
+    auto config = open(file());
+    set_int(*config, "timers/micro_pause/limit", 180);
+    config->compact();
+    set_int(*config, "timers/micro_pause/limit", 200);
+    set_int(*config, "timers/micro_pause/snooze", 150);
+  }
+
+  // Edited while Workrave was not running. The journal predates the edit.
+  {
+    ofstream out(file());
+    out << "[timers]\nmicro_pause.limit=300\n";
+  }
+
+  {
+    auto config = open(file());
+    BOOST_CHECK_EQUAL(get_int(*config, "timers/micro_pause/limit"), 300);
+    BOOST_CHECK(!config->has_user_value("timers/micro_pause/snooze"));
+
+    // The journal starts over on top of the edited file.
+    set_int(*config, "timers/rest_break/limit", 2700);
+  }
+
+  auto config = open(file());
+  BOOST_CHECK_EQUAL(get_int(*config, "timers/micro_pause/limit"), 300);
+  BOOST_CHECK_EQUAL(get_int(*config, "timers/rest_break/limit"), 2700);
+}
+
+BOOST_AUTO_TEST_CASE(test_journal_hand_edit_during_compaction)
+{
+  auto config = open(file());
+  set_int(*config, "timers/micro_pause/limit", 180);
+  config->flush();
+
+  config->set_compaction_hook([&](JournaledConfigurator::CompactionStep step) {
+    filesystem::path copy = file("crash" + to_string(static_cast<int>(step)) + ".ini");
+    crash_copy(file(), copy);
+
+    ofstream out(copy);
+    out << "[timers]\nmicro_pause.limit=300\n";
+  });
+  BOOST_CHECK(config->compact());
+
+  for (int step = 0; step < 3; step++)
+    {
+      BOOST_TEST_CONTEXT("step " << step)
+      {
+        filesystem::path copy = file("crash" + to_string(step) + ".ini");
+        auto restored = open(copy);
+        BOOST_CHECK_EQUAL(get_int(*restored, "timers/micro_pause/limit"), 300);
+        BOOST_CHECK(!filesystem::exists(JournaledConfigurator::get_old_journal_path(copy)));
+      }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_journal_xml)
+{
+  {
+    auto config = make_unique<JournaledConfigurator>(new XmlConfigurator());
+    config->load(file("config.xml").u8string());
+    set_int(*config, "timers/micro_pause/limit", 180);
+    config->compact();
+    set_int(*config, "timers/micro_pause/snooze", 150);
+  }
+
+  auto config = make_unique<JournaledConfigurator>(new XmlConfigurator());
+  config->load(file("config.xml").u8string());
+  BOOST_CHECK_EQUAL(get_int(*config, "timers/micro_pause/limit"), 180);
+  BOOST_CHECK_EQUAL(get_int(*config, "timers/micro_pause/snooze"), 150);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -15,6 +15,9 @@
 #ifndef DISTRIBUTIONLOGLISTENER_HH
 #define DISTRIBUTIONLOGLISTENER_HH
 
+#include <list>
+#include <string>
+
 namespace workrave
 {
   class DistributionLogListener
@@ -22,8 +25,9 @@ namespace workrave
   public:
     virtual ~DistributionLogListener() = default;
 
-    //! Notification that a new log message has arrived.
-    virtual void distribution_log(std::string msg) = 0;
+    //! Notification that new log messages have arrived.
+    /*! Messages are delivered in batches, oldest first. */
+    virtual void distribution_log(const std::list<std::string> &messages) = 0;
   };
 } // namespace workrave
 
@@ -463,7 +463,7 @@ Break::config_changed_notify(const string &key)
   TRACE_EXIT();
 }
 
-boost::signals2::signal<void(BreakEvent)> &
+workrave::utils::Signal<void(BreakEvent)> &
 Break::signal_break_event()
 {
   return break_control->signal_break_event();
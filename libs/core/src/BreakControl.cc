@@ -841,13 +841,13 @@ BreakControl::send_signal(BreakStage stage)
 #endif
 }
 
-boost::signals2::signal<void(BreakEvent)> &
+workrave::utils::Signal<void(BreakEvent)> &
 BreakControl::signal_break_event()
 {
   return break_event_signal;
 }
 
-boost::signals2::signal<void(BreakStage)> &
+workrave::utils::Signal<void(BreakStage)> &
 BreakControl::signal_break_stage_changed()
 {
   return break_stage_changed_signal;
@@ -123,8 +123,8 @@ public:
 
   std::string get_current_stage();
 
-  boost::signals2::signal<void(workrave::BreakEvent)> &signal_break_event();
-  boost::signals2::signal<void(BreakStage)> &signal_break_stage_changed();
+  workrave::utils::Signal<void(workrave::BreakEvent)> &signal_break_event();
+  workrave::utils::Signal<void(BreakStage)> &signal_break_stage_changed();
 
 private:
   void break_window_start();
@@ -190,8 +190,8 @@ private:
   //! Break hint if break has been started.
   workrave::utils::Flags<BreakHint> break_hint{BreakHint::Normal};
 
-  boost::signals2::signal<void(workrave::BreakEvent)> break_event_signal;
-  boost::signals2::signal<void(BreakStage)> break_stage_changed_signal;
+  workrave::utils::Signal<void(workrave::BreakEvent)> break_event_signal;
+  workrave::utils::Signal<void(BreakStage)> break_stage_changed_signal;
 };
 
 #endif // BREAKCONTROL_HH
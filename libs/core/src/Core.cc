@@ -25,12 +25,15 @@
 
 #include "debug.hh"
 
+#include <array>
 #include <cassert>
+#include <chrono>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <filesystem>
+#include <utility>
 
 #include "Core.hh"
 
@@ -45,12 +48,15 @@
 #include "Statistics.hh"
 #include "BreakControl.hh"
 #include "Timer.hh"
+#include "TimerStateRecord.hh"
 #include "TimePredFactory.hh"
 #include "TimePred.hh"
 #include "utils/TimeSource.hh"
 #include "input-monitor/InputMonitorFactory.hh"
 #include "utils/AssetPath.hh"
+#include "utils/Calendar.hh"
 #include "utils/Paths.hh"
+#include "utils/StateWriter.hh"
 
 #ifdef HAVE_DISTRIBUTION
 #  include "DistributionManager.hh"
@@ -77,6 +83,7 @@
 Core *Core::instance = nullptr;
 
 const char *WORKRAVESTATE = "WorkRaveState";
+const int WORKRAVESTATE_VERSION = 4;
 const int SAVESTATETIME = 60;
 
 #define DBUS_PATH_WORKRAVE "/org/workrave/Workrave/Core"
@@ -132,6 +139,8 @@ Core::~Core()
 #  endif
 #endif
 
+  StateWriter::instance().flush();
+
   TRACE_EXIT();
 }
 
@@ -539,6 +548,55 @@ Core::get_break_stage(BreakId id)
     }
 }
 
+//! Returns all metrics reported through workrave::utils::Metrics.
+std::vector<workrave::utils::MetricSnapshot>
+Core::get_metrics() const
+{
+  return workrave::utils::Metrics::instance().snapshot();
+}
+
+//! Returns the statistics of the days in [from, to], see IStatistics::get_range.
+/*!
+ *  The fields are specified by name, see IStatistics::DailyStatsView::get_field_name.
+ *  Returns false if a field is unknown.
+ */
+bool
+Core::get_statistics_range(int32_t from,
+                           int32_t to,
+                           const std::vector<std::string> &fields,
+                           std::vector<int32_t> &days,
+                           std::vector<int64_t> &values) const
+{
+  int32_t next = 0;
+  return get_statistics_range_chunk(from, to, fields, 0, days, values, next);
+}
+
+//! Returns the statistics of at most max_days days in [from, to], and the day from which to continue.
+bool
+Core::get_statistics_range_chunk(int32_t from,
+                                 int32_t to,
+                                 const std::vector<std::string> &fields,
+                                 int32_t max_days,
+                                 std::vector<int32_t> &days,
+                                 std::vector<int64_t> &values,
+                                 int32_t &next) const
+{
+  std::vector<int> ids;
+  ids.reserve(fields.size());
+  for (const auto &name: fields)
+    {
+      int id = IStatistics::DailyStatsView::find_field(name);
+      if (id < 0)
+        {
+          return false;
+        }
+      ids.push_back(id);
+    }
+
+  next = statistics->get_range(from, to, ids, max_days, days, values);
+  return true;
+}
+
 #ifdef HAVE_DISTRIBUTION
 //! Returns the distribution manager.
 DistributionManager *
@@ -863,7 +921,7 @@ Core::time_changed()
   TRACE_ENTER("Core::time_changed");
 
   // In case out timezone changed..
-  tzset();
+  workrave::utils::Calendar::reset();
 
   // A change of system time idle handled by process_timewarp.
   // This is used to handle a change in timezone on windows.
@@ -1063,6 +1121,8 @@ Core::heartbeat()
   TRACE_ENTER("Core::heartbeat");
   assert(application != nullptr);
 
+  auto start = std::chrono::steady_clock::now();
+
   TimeSource::sync();
 
   // Performs timewarp checking.
@@ -1106,6 +1166,8 @@ Core::heartbeat()
   // Done.
   last_process_time = current_time;
 
+  heartbeat_duration.record(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+
   TRACE_EXIT();
 }
 
@@ -1138,9 +1200,13 @@ Core::process_distribution()
 
   if ((previous_master_mode != master_node) || (master_node && local_state != state))
     {
-      PacketBuffer buffer;
-      buffer.create();
+      PacketBuffer &buffer = dist_buffer;
+      if (buffer.get_buffer() == nullptr)
+        {
+          buffer.create();
+        }
 
+      buffer.clear();
       buffer.pack_ushort(1);
       buffer.pack_ushort(state);
 
@@ -1167,22 +1233,9 @@ Core::process_state()
   // Default
   local_state = monitor->get_current_state();
 
-  map<std::string, int64_t>::iterator i = external_activity.begin();
-  while (i != external_activity.end())
+  if (external_activity.is_active(current_time))
     {
-      map<std::string, int64_t>::iterator next = i;
-      next++;
-
-      if (i->second >= current_time)
-        {
-          local_state = ACTIVITY_ACTIVE;
-        }
-      else
-        {
-          external_activity.erase(i);
-        }
-
-      i = next;
+      local_state = ACTIVITY_ACTIVE;
     }
 
   monitor_state = local_state;
@@ -1215,17 +1268,13 @@ Core::process_state()
 }
 
 void
-Core::report_external_activity(std::string who, bool act)
+Core::report_external_activity(const std::string &who, bool act)
 {
   TRACE_ENTER_MSG("Core::report_external_activity", who << " " << act);
-  if (act)
+  if (!external_activity.report(who, act, TimeSource::get_real_time_sec()))
     {
-      int64_t current_time = TimeSource::get_real_time_sec();
-      external_activity[who] = current_time + 10;
-    }
-  else
-    {
-      external_activity.erase(who);
+      external_activity_dropped.add();
+      TRACE_MSG("rate limited");
     }
   TRACE_EXIT();
 }
@@ -1624,22 +1673,30 @@ Core::daily_reset()
 
 //! Saves the current state.
 void
-Core::save_state() const
+Core::save_state()
 {
-  std::filesystem::path path = Paths::get_state_directory() / "state";
-  ofstream stateFile(path.u8string());
+  if (state_path.empty())
+    {
+      state_path = Paths::get_state_directory() / "state";
+    }
 
-  int64_t current_time = TimeSource::get_real_time_sec();
-  stateFile << "WorkRaveState 3" << endl << current_time << endl;
+  string &state = state_buffer;
+  state.assign(WORKRAVESTATE);
+  state.append(" ");
+  state.append(to_string(WORKRAVESTATE_VERSION));
+  state.append("\n");
 
   for (int i = 0; i < BREAK_ID_SIZEOF; i++)
     {
-      string stateStr = breaks[i].get_timer()->serialize_state();
+      Timer::TimerStateData state_data{};
+      breaks[i].get_timer()->get_state_data(state_data);
 
-      stateFile << stateStr << endl;
+      uint8_t record[TimerStateRecord::SIZE];
+      TimerStateRecord::encode(BreakId(i), state_data, record);
+      state.append(reinterpret_cast<const char *>(record), sizeof(record));
     }
 
-  stateFile.close();
+  StateWriter::instance().write(state_path, state);
 }
 
 //! Loads miscellaneous
@@ -1684,7 +1741,7 @@ Core::load_state()
     }
 #endif
 
-  ifstream stateFile(path.u8string());
+  ifstream stateFile(path.u8string(), ios::binary);
 
   int version = 0;
   bool ok = stateFile.good();
@@ -1701,7 +1758,25 @@ Core::load_state()
     {
       stateFile >> version;
 
-      ok = (version >= 1 && version <= 3);
+      ok = (version >= 1 && version <= WORKRAVESTATE_VERSION);
+    }
+
+  if (ok && version == WORKRAVESTATE_VERSION)
+    {
+      stateFile.get();
+      string records((istreambuf_iterator<char>(stateFile)), istreambuf_iterator<char>());
+
+      for (size_t pos = 0; pos + TimerStateRecord::SIZE <= records.size(); pos += TimerStateRecord::SIZE)
+        {
+          BreakId break_id = BREAK_ID_NONE;
+          Timer::TimerStateData state_data{};
+
+          if (TimerStateRecord::decode(reinterpret_cast<const uint8_t *>(records.data() + pos), TimerStateRecord::SIZE, break_id, state_data))
+            {
+              breaks[break_id].get_timer()->deserialize_state(state_data);
+            }
+        }
+      return;
     }
 
   if (ok)
@@ -1970,6 +2045,9 @@ Core::request_timer_state(PacketBuffer &buffer) const
 {
   TRACE_ENTER("Core::get_timer_state");
 
+  // The message starts with the 32-bit encoding that all peers understand.
+  // Peers ignore data after the timers they know, so newer peers find the
+  // TimerStateRecords of all timers behind it.
   buffer.pack_ushort(BREAK_ID_SIZEOF);
 
   for (int i = 0; i < BREAK_ID_SIZEOF; i++)
@@ -1997,6 +2075,18 @@ Core::request_timer_state(PacketBuffer &buffer) const
       buffer.poke_ushort(pos, buffer.bytes_written() - pos);
     }
 
+  buffer.pack_ushort(BREAK_ID_SIZEOF);
+
+  for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+    {
+      Timer::TimerStateData state_data{};
+      breaks[i].get_timer()->get_state_data(state_data);
+
+      guint8 record[TimerStateRecord::SIZE];
+      TimerStateRecord::encode(BreakId(i), state_data, record);
+      buffer.pack_raw(record, sizeof(record));
+    }
+
   TRACE_EXIT();
   return true;
 }
@@ -2006,6 +2096,9 @@ Core::set_timer_state(PacketBuffer &buffer)
 {
   TRACE_ENTER("Core::set_timer_state");
 
+  std::array<std::pair<Timer *, Timer::TimerStateData>, BREAK_ID_SIZEOF> legacy{};
+  int num_legacy = 0;
+
   int num_breaks = buffer.unpack_ushort();
 
   TRACE_MSG("numtimer = " << num_breaks);
@@ -2020,8 +2113,6 @@ Core::set_timer_state(PacketBuffer &buffer)
           return false;
         }
 
-      Timer *t = (Timer *)get_timer(id);
-
       Timer::TimerStateData state_data{};
 
       buffer.unpack_ushort();
@@ -2036,17 +2127,57 @@ Core::set_timer_state(PacketBuffer &buffer)
       state_data.last_limit_elapsed = buffer.unpack_ulong();
       state_data.snooze_inhibited = buffer.unpack_ushort();
 
-      TRACE_MSG("state = " << state_data.current_time << " " << state_data.elapsed_time << " " << state_data.elapsed_idle_time << " "
-                           << state_data.last_pred_reset_time << " " << state_data.total_overdue_time);
-
-      if (t != nullptr)
+      Timer *t = (Timer *)get_timer(id);
+      if (t != nullptr && num_legacy < BREAK_ID_SIZEOF)
         {
-          t->set_state_data(state_data);
+          legacy[num_legacy++] = std::make_pair(t, state_data);
         }
 
       g_free(id);
     }
 
+  if (buffer.bytes_available() < 2)
+    {
+      // A peer that only sends the 32-bit encoding.
+      for (int i = 0; i < num_legacy; i++)
+        {
+          legacy[i].first->set_state_data(legacy[i].second);
+        }
+
+      TRACE_EXIT();
+      return true;
+    }
+
+  int num_records = buffer.unpack_ushort();
+  if (num_records > BREAK_ID_SIZEOF || buffer.bytes_available() < num_records * static_cast<int>(TimerStateRecord::SIZE))
+    {
+      TRACE_MSG("invalid number of records " << num_records);
+      TRACE_EXIT();
+      return false;
+    }
+
+  for (int i = 0; i < num_records; i++)
+    {
+      BreakId break_id = BREAK_ID_NONE;
+      Timer::TimerStateData state_data{};
+
+      bool ok = TimerStateRecord::decode(reinterpret_cast<const uint8_t *>(buffer.read_ptr), TimerStateRecord::SIZE, break_id, state_data);
+      buffer.skip(TimerStateRecord::SIZE);
+
+      if (!ok || break_id < BREAK_ID_MICRO_BREAK || break_id >= BREAK_ID_SIZEOF)
+        {
+          TRACE_MSG("invalid record " << i);
+          TRACE_EXIT();
+          return false;
+        }
+
+      TRACE_MSG("state = " << break_id << " " << state_data.current_time << " " << state_data.elapsed_time << " "
+                           << state_data.elapsed_idle_time << " " << state_data.last_pred_reset_time << " "
+                           << state_data.total_overdue_time);
+
+      breaks[break_id].get_timer()->set_state_data(state_data);
+    }
+
   TRACE_EXIT();
   return true;
 }
@@ -2236,13 +2367,13 @@ namespace workrave
   }
 } // namespace workrave
 
-boost::signals2::signal<void(OperationMode)> &
+workrave::utils::Signal<void(OperationMode)> &
 Core::signal_operation_mode_changed()
 {
   return operation_mode_changed_signal;
 }
 
-boost::signals2::signal<void(UsageMode)> &
+workrave::utils::Signal<void(UsageMode)> &
 Core::signal_usage_mode_changed()
 {
   return usage_mode_changed_signal;
@@ -30,9 +30,11 @@
 
 #include <iostream>
 #include <string>
+#include <filesystem>
 #include <map>
 
 #include "Break.hh"
+#include "ExternalActivity.hh"
 #include "IActivityMonitor.hh"
 #include "core/ICore.hh"
 #include "core/ICoreEventListener.hh"
@@ -56,6 +58,7 @@ class BreakControl;
 #  include "DistributionManager.hh"
 #  include "IDistributionClientMessage.hh"
 #  include "DistributionListener.hh"
+#  include "PacketBuffer.hh"
 #endif
 
 class Core
@@ -78,8 +81,8 @@ public:
 #endif
 
   // ICore
-  boost::signals2::signal<void(workrave::OperationMode)> &signal_operation_mode_changed() override;
-  boost::signals2::signal<void(workrave::UsageMode)> &signal_usage_mode_changed() override;
+  workrave::utils::Signal<void(workrave::OperationMode)> &signal_operation_mode_changed() override;
+  workrave::utils::Signal<void(workrave::UsageMode)> &signal_usage_mode_changed() override;
 
   Timer *get_timer(std::string name) const;
   Timer *get_timer(BreakId id) const;
@@ -89,6 +92,19 @@ public:
   IActivityMonitor::Ptr get_activity_monitor() const;
   bool is_user_active() const override;
   std::string get_break_stage(BreakId id);
+  std::vector<workrave::utils::MetricSnapshot> get_metrics() const;
+  bool get_statistics_range(int32_t from,
+                            int32_t to,
+                            const std::vector<std::string> &fields,
+                            std::vector<int32_t> &days,
+                            std::vector<int64_t> &values) const;
+  bool get_statistics_range_chunk(int32_t from,
+                                  int32_t to,
+                                  const std::vector<std::string> &fields,
+                                  int32_t max_days,
+                                  std::vector<int32_t> &days,
+                                  std::vector<int64_t> &values,
+                                  int32_t &next) const;
 
 #ifdef HAVE_DISTRIBUTION
   DistributionManager *get_distribution_manager() const override;
@@ -128,7 +144,7 @@ public:
   bool is_master() const;
 
   // DBus functions.
-  void report_external_activity(std::string who, bool act);
+  void report_external_activity(const std::string &who, bool act);
   void is_timer_running(BreakId id, bool &value);
   void get_timer_elapsed(BreakId id, int *value);
   void get_timer_remaining(BreakId id, int *value);
@@ -168,7 +184,7 @@ private:
   void start_break(BreakId break_id, BreakId resume_this_break = BREAK_ID_NONE);
   void stop_all_breaks();
   void daily_reset();
-  void save_state() const;
+  void save_state();
   void load_state();
   void load_misc();
   void do_postpone_break(BreakId break_id);
@@ -223,6 +239,15 @@ private:
   //! The time we last processed the timers.
   int64_t last_process_time{0};
 
+  //! Duration of the heartbeat in microseconds.
+  workrave::utils::Histogram &heartbeat_duration{workrave::utils::Metrics::instance().histogram("core.heartbeat_us")};
+
+  //! Location of the timer state, resolved on the first save.
+  std::filesystem::path state_path;
+
+  //! Timer state snapshot, reused on every save.
+  std::string state_buffer;
+
   //! Are we the master node??
   TracedField<bool> master_node{"core.master_node", true};
 
@@ -296,20 +321,26 @@ private:
   //! Manager that collects idle times of all clients.
   IdleLogManager *idlelog_manager{nullptr};
 
+  //! Buffer for the state broadcasts of the heartbeat, allocated once.
+  PacketBuffer dist_buffer;
+
 #  ifndef NDEBUG
   //! A fake activity monitor for testing puposes.
   FakeActivityMonitor *fake_monitor{nullptr};
 #  endif
 #endif
 
-  //! External activity
-  std::map<std::string, int64_t> external_activity;
+  //! Activity reported by other applications.
+  ExternalActivity external_activity;
+
+  //! Reports of other applications dropped by the rate limit.
+  workrave::utils::Counter &external_activity_dropped{workrave::utils::Metrics::instance().counter("core.external_activity_dropped")};
 
   //! Operation mode changed notification.
-  boost::signals2::signal<void(workrave::OperationMode)> operation_mode_changed_signal;
+  workrave::utils::Signal<void(workrave::OperationMode)> operation_mode_changed_signal;
 
   //! Usage mode changed notification.
-  boost::signals2::signal<void(workrave::UsageMode)> usage_mode_changed_signal;
+  workrave::utils::Signal<void(workrave::UsageMode)> usage_mode_changed_signal;
 
 #ifdef HAVE_TESTS
   friend class Test;
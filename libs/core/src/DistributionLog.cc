@@ -0,0 +1,137 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#ifdef HAVE_DISTRIBUTION
+
+#  include <cstdio>
+#  include <cstring>
+#  include <ctime>
+
+#  include "nls.h"
+
+#  include "DistributionLog.hh"
+
+#  ifdef PLATFORM_OS_WINDOWS
+#    define snprintf _snprintf
+#  endif
+
+#  define MAX_LOG_LEN (256)
+
+namespace
+{
+  const char *get_template(DistributionLogEvent event)
+  {
+    switch (event)
+      {
+      case DistributionLogEvent::NetworkStarted:
+        return N_("Network operation started.");
+      case DistributionLogEvent::NetworkEnableFailed:
+        return N_("Could not enable network operation.");
+      case DistributionLogEvent::NetworkDisabled:
+        return N_("Disabling network operation.");
+      case DistributionLogEvent::Connecting:
+        return N_("Connecting to %s.");
+      case DistributionLogEvent::Reconnecting:
+        return N_("Reconnecting to %s.");
+      case DistributionLogEvent::ConnectFailed:
+        return N_("Could not connect to client %s.");
+      case DistributionLogEvent::Connected:
+        return N_("Client %s connected.");
+      case DistributionLogEvent::Accepted:
+        return N_("Accepted new client.");
+      case DistributionLogEvent::Disconnecting:
+        return N_("Disconnecting %s");
+      case DistributionLogEvent::ConnectionClosed:
+        return N_("Client %s closed connection.");
+      case DistributionLogEvent::ReadError:
+        return N_("Client %s read error, closing.");
+      case DistributionLogEvent::Timeout:
+        return N_("Client timeout from %s.");
+      case DistributionLogEvent::Removing:
+        return N_("Removing client %s.");
+      case DistributionLogEvent::Hello:
+        return N_("Client %s saying hello.");
+      case DistributionLogEvent::Welcome:
+        return N_("Client %s is welcoming us.");
+      case DistributionLogEvent::AccessDenied:
+        return N_("Client %s access denied.");
+      case DistributionLogEvent::Duplicate:
+        return N_("Client %s is duplicate.");
+      case DistributionLogEvent::SignedOff:
+        return N_("Client %s signed off.");
+      case DistributionLogEvent::ClientIsMaster:
+        return N_("Client %s is now master.");
+      case DistributionLogEvent::IAmMaster:
+        return N_("I'm now master.");
+      case DistributionLogEvent::NewMaster:
+        return N_("Client %s is now the new master.");
+      case DistributionLogEvent::RequestingMaster:
+        return N_("Requesting master status from %s.");
+      case DistributionLogEvent::RejectingMasterRequest:
+        return N_("Rejecting master request from client %s.");
+      case DistributionLogEvent::AcknowledgingMasterRequest:
+        return N_("Acknowledging master request from client %s.");
+      case DistributionLogEvent::NonMasterRejectedMasterRequest:
+        return N_("Non-master client %s rejected master request.");
+      case DistributionLogEvent::MasterRequestRejected:
+        return N_("Client %s rejected master request, delaying.");
+      }
+    return "";
+  }
+} // namespace
+
+void
+DistributionLogRecord::set_peer(const char *id)
+{
+  if (id == nullptr)
+    {
+      peer[0] = '\0';
+      return;
+    }
+
+  strncpy(peer, id, MAX_PEER_LEN - 1);
+  peer[MAX_PEER_LEN - 1] = '\0';
+}
+
+std::string
+DistributionLogRecord::format() const
+{
+  time_t t = time;
+  struct tm *lt = localtime(&t);
+
+  char log_str[MAX_LOG_LEN - 32];
+  snprintf(log_str, sizeof(log_str), _(get_template(event)), peer[0] != '\0' ? peer : "Unknown");
+
+  char str[MAX_LOG_LEN];
+  snprintf(str,
+           sizeof(str),
+           "[%02d/%02d/%02d %02d:%02d:%02d] %s\n",
+           lt->tm_mday,
+           lt->tm_mon + 1,
+           lt->tm_year + 1900,
+           lt->tm_hour,
+           lt->tm_min,
+           lt->tm_sec,
+           log_str);
+  return str;
+}
+
+#endif
@@ -0,0 +1,77 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef DISTRIBUTIONLOG_HH
+#define DISTRIBUTIONLOG_HH
+
+#include <cstdint>
+#include <string>
+
+//! Events logged by the distribution layer.
+enum class DistributionLogEvent : uint8_t
+{
+  NetworkStarted,
+  NetworkEnableFailed,
+  NetworkDisabled,
+  Connecting,
+  Reconnecting,
+  ConnectFailed,
+  Connected,
+  Accepted,
+  Disconnecting,
+  ConnectionClosed,
+  ReadError,
+  Timeout,
+  Removing,
+  Hello,
+  Welcome,
+  AccessDenied,
+  Duplicate,
+  SignedOff,
+  ClientIsMaster,
+  IAmMaster,
+  NewMaster,
+  RequestingMaster,
+  RejectingMasterRequest,
+  AcknowledgingMasterRequest,
+  NonMasterRejectedMasterRequest,
+  MasterRequestRejected,
+};
+
+//! A log entry of the distribution layer.
+/*!
+ *  Entries are stored unformatted; format() produces the text only when
+ *  the log is viewed.
+ */
+struct DistributionLogRecord
+{
+  static constexpr std::size_t MAX_PEER_LEN = 64;
+
+  //! Wall-clock time of the event, in seconds.
+  int64_t time;
+
+  //! What happened.
+  DistributionLogEvent event;
+
+  //! Id or hostname of the peer, empty if unknown or not applicable.
+  char peer[MAX_PEER_LEN];
+
+  void set_peer(const char *id);
+  std::string format() const;
+};
+
+#endif // DISTRIBUTIONLOG_HH
@@ -24,7 +24,6 @@
 #  include "debug.hh"
 #  include <algorithm>
 #  include <cassert>
-#  include <cstdarg>
 #  include <cstdio>
 #  include <cstdlib>
 #  include <cstring>
@@ -36,15 +35,10 @@
 #  include "config/IConfigurator.hh"
 #  include "core/CoreConfig.hh"
 #  include "utils/AssetPath.hh"
-
-#  ifdef PLATFORM_OS_WINDOWS
-#    define snprintf _snprintf
-#    define vsnprintf _vsnprintf
-#  endif
-
-#  define MAX_LOG_LEN (256)
+#  include "utils/TimeSource.hh"
 
 using namespace std;
+using namespace workrave::utils;
 
 //! Destructs this DistributionManager.
 DistributionManager::~DistributionManager()
@@ -79,6 +73,9 @@ DistributionManager::heartbeart()
     {
       link->heartbeat();
     }
+
+  // Deliver log messages held back by the rate limit.
+  fire_log_event();
 }
 
 //! Returns the current distribution state of this node.
@@ -520,39 +517,18 @@ DistributionManager::config_changed_notify(const string &key)
 
 //!
 void
-DistributionManager::log(const char *fmt, ...)
+DistributionManager::log(DistributionLogEvent event, const char *peer)
 {
-  va_list va;
-
-  va_start(va, fmt);
-
-  time_t current_time = time(nullptr);
-  struct tm *lt = localtime(&current_time);
+  DistributionLogRecord &record = log_records.next();
+  record.time = TimeSource::get_real_time_sec();
+  record.event = event;
+  record.set_peer(peer);
+  log_records.publish();
 
-  char log_str[MAX_LOG_LEN - 32];
-  vsnprintf(log_str, MAX_LOG_LEN - 32 - 1, fmt, va);
-  log_str[MAX_LOG_LEN - 32 - 1] = '\0';
-
-  char str[MAX_LOG_LEN];
-  snprintf(str,
-           MAX_LOG_LEN - 1,
-           "[%02d/%02d/%02d %02d:%02d:%02d] %s\n",
-           lt->tm_mday,
-           lt->tm_mon + 1,
-           lt->tm_year + 1900,
-           lt->tm_hour,
-           lt->tm_min,
-           lt->tm_sec,
-           log_str);
-  str[MAX_LOG_LEN - 1] = '\0';
-
-  log_messages.push_back(str);
-
-  if (log_messages.size() > 500)
+  if (TimeSource::get_monotonic_time_usec() - log_notify_time >= TimeSource::TIME_USEC_PER_SEC / LOG_NOTIFY_RATE)
     {
-      log_messages.erase(log_messages.begin());
+      fire_log_event();
     }
-  fire_log_event(str);
 }
 
 //! Adds the log listener.
@@ -622,21 +598,38 @@ DistributionManager::remove_log_listener(DistributionLogListener *listener)
   return ret;
 }
 
-//! Fire a log event.
+//! Sends the log messages that arrived since the last notification to the listeners.
 void
-DistributionManager::fire_log_event(string message)
+DistributionManager::fire_log_event()
 {
-  TRACE_ENTER_MSG("DistributionManager::fire_log_event", message);
+  TRACE_ENTER("DistributionManager::fire_log_event");
 
-  LogListenerIter i = log_listeners.begin();
-  while (i != log_listeners.end())
+  if (log_records.get_head() == log_notify_seq)
+    {
+      TRACE_EXIT();
+      return;
+    }
+
+  log_notify_time = TimeSource::get_monotonic_time_usec();
+
+  if (log_listeners.empty())
+    {
+      log_notify_seq = log_records.get_head();
+      TRACE_EXIT();
+      return;
+    }
+
+  list<string> messages;
+  log_notify_seq = log_records.for_each(log_notify_seq, [&messages](uint64_t, const DistributionLogRecord &record) {
+    messages.push_back(record.format());
+  });
+
+  for (auto *l: log_listeners)
     {
-      DistributionLogListener *l = *i;
       if (l != nullptr)
         {
-          l->distribution_log(message);
+          l->distribution_log(messages);
         }
-      i++;
     }
 
   TRACE_EXIT();
@@ -696,7 +689,9 @@ DistributionManager::signoff_remote_client(char *client_id)
 list<string>
 DistributionManager::get_logs() const
 {
-  return log_messages;
+  list<string> messages;
+  log_records.for_each(0, [&messages](uint64_t, const DistributionLogRecord &record) { messages.push_back(record.format()); });
+  return messages;
 }
 
 //! Returns all peers.
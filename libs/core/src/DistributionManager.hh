@@ -22,7 +22,9 @@
 
 #include "config/IConfigurator.hh"
 #include "config/IConfiguratorListener.hh"
+#include "utils/RingBuffer.hh"
 #include "IDistributionClientMessage.hh"
+#include "DistributionLog.hh"
 #include "core/IDistributionManager.hh"
 
 using namespace workrave;
@@ -107,7 +109,7 @@ public:
   void master_changed(bool result, std::string id);
   void signon_remote_client(char *client_id);
   void signoff_remote_client(char *client_id);
-  void log(const char *fmt, ...);
+  void log(DistributionLogEvent event, const char *peer = nullptr);
 
 private:
   void sanitize_peer(std::string &peer);
@@ -116,7 +118,7 @@ private:
   void read_configuration();
   void config_changed_notify(const std::string &key) override;
 
-  void fire_log_event(std::string message);
+  void fire_log_event();
   void fire_signon_client(char *id);
   void fire_signoff_client(char *id);
 
@@ -143,8 +145,17 @@ private:
   //! All peers
   std::list<std::string> peer_urls;
 
-  // ! All log messages
-  std::list<std::string> log_messages;
+  //! Number of log notifications per second.
+  static constexpr int LOG_NOTIFY_RATE = 4;
+
+  //! Recent log messages.
+  workrave::utils::RingBuffer<DistributionLogRecord, 512> log_records;
+
+  //! Sequence number of the first log message not yet sent to the listeners.
+  uint64_t log_notify_seq{0};
+
+  //! Time of the last notification of the listeners.
+  int64_t log_notify_time{0};
 
   //! Log listeners.
   LogListeners log_listeners;
@@ -30,6 +30,7 @@
 #  include <iostream>
 #  include <fstream>
 #  include <algorithm>
+#  include <vector>
 #  include <filesystem>
 
 #  include "nls.h"
@@ -43,6 +44,7 @@
 #  include "config/IConfigurator.hh"
 #  include "core/CoreConfig.hh"
 #  include "utils/Paths.hh"
+#  include "utils/TimeSource.hh"
 
 #  include "DistributionManager.hh"
 #  include "DistributionLink.hh"
@@ -95,6 +97,13 @@ DistributionSocketLink::init()
 void
 DistributionSocketLink::heartbeat()
 {
+  if (new_master_pending)
+    {
+      // Announce once per heartbeat, however many claims were handled.
+      new_master_pending = false;
+      send_new_master();
+    }
+
   if (server_enabled)
     {
       TRACE_ENTER("DistributionSocketLink::heartbeat");
@@ -113,7 +122,7 @@ DistributionSocketLink::heartbeat()
               c->reconnect_count--;
               c->reconnect_time = 0;
 
-              dist_manager->log(_("Reconnecting to %s."), c->id == nullptr ? "Unknown" : c->id);
+              dist_manager->log(DistributionLogEvent::Reconnecting, c->id);
 
               if (c->socket != nullptr)
                 {
@@ -136,6 +145,8 @@ DistributionSocketLink::heartbeat()
         {
           send_client_message(DCMT_MASTER);
         }
+
+      check_peer_health();
       TRACE_EXIT();
     }
 }
@@ -400,7 +411,7 @@ DistributionSocketLink::set_server_enabled(bool enabled)
       if (!start_async_server())
         {
           // We did not succeed in starting the server. Arghh.
-          dist_manager->log(_("Could not enable network operation."));
+          dist_manager->log(DistributionLogEvent::NetworkEnableFailed);
           enabled = false;
         }
     }
@@ -409,7 +420,7 @@ DistributionSocketLink::set_server_enabled(bool enabled)
       // Switching from enabled to disabled.
       if (server_socket != nullptr)
         {
-          dist_manager->log(_("Disabling network operation."));
+          dist_manager->log(DistributionLogEvent::NetworkDisabled);
 
           delete server_socket;
         }
@@ -515,7 +526,7 @@ DistributionSocketLink::add_client(gchar *id, gchar *host, gint port, ClientType
         }
 
       c->type = type;
-      dist_manager->log(_("Connecting to %s."), host);
+      dist_manager->log(DistributionLogEvent::Connecting, host);
 
       if (c->socket != nullptr)
         {
@@ -544,6 +555,7 @@ DistributionSocketLink::add_client(gchar *id, gchar *host, gint port, ClientType
       client->port = port;
 
       clients.push_back(client);
+      index_client(client);
 
       if (client->id != nullptr)
         {
@@ -552,7 +564,7 @@ DistributionSocketLink::add_client(gchar *id, gchar *host, gint port, ClientType
 
       if (type == CLIENTTYPE_DIRECT)
         {
-          dist_manager->log(_("Connecting to %s."), host);
+          dist_manager->log(DistributionLogEvent::Connecting, host);
 
           if (client->socket != nullptr)
             {
@@ -629,11 +641,13 @@ DistributionSocketLink::set_client_id(Client *client, gchar *id)
   if (ret)
     {
       // No duplicate, so change the canonical name.
+      unindex_client(client);
       g_free(client->id);
       g_free(client->hostname);
       client->id = g_strdup(id);
       client->hostname = nullptr;
       client->port = 0;
+      index_client(client);
 
       if (client->id != nullptr)
         {
@@ -667,7 +681,8 @@ DistributionSocketLink::remove_client(Client *client)
               dist_manager->signoff_remote_client((*i)->id);
             }
 
-          dist_manager->log(_("Removing client %s."), (*i)->id == nullptr ? "Unknown" : (*i)->id);
+          dist_manager->log(DistributionLogEvent::Removing, (*i)->id);
+          unindex_client(*i);
           delete *i;
           i = clients.erase(i);
         }
@@ -698,7 +713,7 @@ DistributionSocketLink::remove_peer_clients(Client *client)
         {
           TRACE_MSG("Client " << (*i)->peer->id << " is peer of " << client->id);
 
-          dist_manager->log(_("Removing client %s."), (*i)->id == nullptr ? "Unknown" : (*i)->id);
+          dist_manager->log(DistributionLogEvent::Removing, (*i)->id);
           send_signoff(nullptr, *i);
 
           if ((*i)->id != nullptr)
@@ -712,6 +727,7 @@ DistributionSocketLink::remove_peer_clients(Client *client)
               set_master(nullptr);
             }
 
+          unindex_client(*i);
           delete *i;
           i = clients.erase(i);
         }
@@ -744,7 +760,7 @@ DistributionSocketLink::close_client(Client *client, bool reconnect /* = false*/
     {
       TRACE_MSG("Is direct");
       // Closing direct connection.
-      dist_manager->log(_("Disconnecting %s"), client->id != nullptr ? client->id : "Unknown");
+      dist_manager->log(DistributionLogEvent::Disconnecting, client->id);
 
       // Inform the client that we are disconnecting.
       send_signoff(client, nullptr);
@@ -760,7 +776,7 @@ DistributionSocketLink::close_client(Client *client, bool reconnect /* = false*/
             {
               TRACE_MSG("must reconnected");
               client->reconnect_count = reconnect_attempts;
-              client->reconnect_time = time(nullptr) + 5;
+              client->reconnect_time = time(nullptr) + std::max<int64_t>(1, client->health.next_reconnect_delay() / PeerHealth::USEC_PER_SEC);
             }
           else
             {
@@ -798,55 +814,90 @@ DistributionSocketLink::close_client(Client *client, bool reconnect /* = false*/
 bool
 DistributionSocketLink::is_client_valid(Client *client)
 {
-  list<Client *>::iterator i = clients.begin();
-  bool ret = false;
-
-  while (!ret && i != clients.end())
-    {
-      if (*i == client)
-        {
-          ret = true;
-        }
-      i++;
-    }
-
-  return ret;
+  return client_set.find(client) != client_set.end();
 }
 
 //! Finds a remote client by its canonical name and port.
 DistributionSocketLink::Client *
 DistributionSocketLink::find_client_by_canonicalname(gchar *name, gint port)
 {
-  Client *ret = nullptr;
-  list<Client *>::iterator i = clients.begin();
-
-  while (i != clients.end())
+  if (name == nullptr)
     {
-      if ((*i)->port == port && (*i)->hostname != nullptr && strcmp((*i)->hostname, name) == 0)
-        {
-          ret = *i;
-        }
-      i++;
+      return nullptr;
     }
-  return ret;
+
+  auto i = clients_by_address.find(get_address_key(name, port));
+  return i != clients_by_address.end() ? i->second : nullptr;
 }
 
 //! Finds a remote client by its id.
 DistributionSocketLink::Client *
 DistributionSocketLink::find_client_by_id(gchar *id)
 {
-  Client *ret = nullptr;
-  list<Client *>::iterator i = clients.begin();
+  if (id == nullptr)
+    {
+      return nullptr;
+    }
 
-  while (i != clients.end())
+  auto i = clients_by_id.find(id);
+  return i != clients_by_id.end() ? i->second : nullptr;
+}
+
+//! Adds a client to the lookup tables.
+/*!
+ *  Must be called after the client is added to the list of clients and
+ *  after its id, hostname or port changed.
+ */
+void
+DistributionSocketLink::index_client(Client *client)
+{
+  client_set.insert(client);
+
+  if (client->id != nullptr)
+    {
+      clients_by_id[client->id] = client;
+    }
+
+  if (client->hostname != nullptr)
+    {
+      clients_by_address[get_address_key(client->hostname, client->port)] = client;
+    }
+}
+
+//! Removes a client from the lookup tables.
+/*!
+ *  Must be called before the client is deleted and before its id,
+ *  hostname or port changes.
+ */
+void
+DistributionSocketLink::unindex_client(Client *client)
+{
+  client_set.erase(client);
+
+  if (client->id != nullptr)
     {
-      if ((*i)->id != nullptr && strcmp((*i)->id, id) == 0)
+      auto i = clients_by_id.find(client->id);
+      if (i != clients_by_id.end() && i->second == client)
         {
-          ret = *i;
+          clients_by_id.erase(i);
         }
-      i++;
     }
-  return ret;
+
+  if (client->hostname != nullptr)
+    {
+      auto i = clients_by_address.find(get_address_key(client->hostname, client->port));
+      if (i != clients_by_address.end() && i->second == client)
+        {
+          clients_by_address.erase(i);
+        }
+    }
+}
+
+//! Returns the key of a client in the address table.
+std::string
+DistributionSocketLink::get_address_key(const gchar *name, gint port)
+{
+  return std::string(name) + ":" + std::to_string(port);
 }
 
 //! Returns the master client.
@@ -907,13 +958,13 @@ DistributionSocketLink::set_master_by_id(gchar *id)
   if (c != nullptr)
     {
       // It's a remote client. mark it master.
-      dist_manager->log(_("Client %s is now master."), c->id == nullptr ? "Unknown" : c->id);
+      dist_manager->log(DistributionLogEvent::ClientIsMaster, c->id);
       set_master(c);
     }
   else if (strcmp(id, get_my_id().c_str()) == 0)
     {
       // Its ME!
-      dist_manager->log(_("I'm now master."));
+      dist_manager->log(DistributionLogEvent::IAmMaster);
       set_me_master();
     }
   else
@@ -968,6 +1019,8 @@ DistributionSocketLink::send_packet_except(PacketBuffer &packet, Client *client)
 
       if (c != client && c->socket != nullptr)
         {
+          c->health.packet_sent(TimeSource::get_monotonic_time_usec());
+
           int bytes_written = 0;
           try
             {
@@ -1028,6 +1081,8 @@ DistributionSocketLink::send_packet(Client *client, PacketBuffer &packet)
       // Length.
       packet.poke_ushort(0, size);
 
+      client->health.packet_sent(TimeSource::get_monotonic_time_usec());
+
       int bytes_written = 0;
       try
         {
@@ -1050,6 +1105,7 @@ DistributionSocketLink::process_client_packet(Client *client)
   PacketBuffer &packet = client->packet;
 
   client->claim_count = 0;
+  client->health.packet_received(TimeSource::get_monotonic_time_usec());
 
   gint size = packet.unpack_ushort();
   g_assert(size == packet.bytes_written());
@@ -1171,15 +1227,20 @@ DistributionSocketLink::process_client_packet(Client *client)
         case PACKET_CLAIM_REJECT:
           handle_claim_reject(packet, source);
           break;
+
+        case PACKET_KEEPALIVE:
+          handle_keepalive(packet, source);
+          forward = false;
+          break;
         }
 
-      if (forward && find(clients.begin(), clients.end(), client) != clients.end())
+      if (forward && is_client_valid(client))
         {
           forward_packet_except(packet, client, source);
         }
     }
 
-  if (find(clients.begin(), clients.end(), client) != clients.end())
+  if (is_client_valid(client))
     {
       // hack... client may have been removed...
       packet.clear();
@@ -1276,7 +1337,7 @@ DistributionSocketLink::handle_hello1(PacketBuffer &packet, Client *client)
 
   TRACE_MSG(user << " " << id << " " << rnd);
 
-  dist_manager->log(_("Client %s saying hello."), id != nullptr ? id : "Unknown");
+  dist_manager->log(DistributionLogEvent::Hello, id);
 
   if (user != nullptr && (username == nullptr || (strcmp(username, user) == 0)))
     {
@@ -1285,7 +1346,7 @@ DistributionSocketLink::handle_hello1(PacketBuffer &packet, Client *client)
   else
     {
       // Incorrect user.
-      dist_manager->log(_("Client %s access denied."), id != nullptr ? id : "Unknown");
+      dist_manager->log(DistributionLogEvent::AccessDenied, id);
       remove_client(client);
     }
 
@@ -1335,7 +1396,7 @@ DistributionSocketLink::handle_hello2(PacketBuffer &packet, Client *client)
 
   TRACE_MSG(user << " " << pass << " " << id << " " << client->challenge);
 
-  dist_manager->log(_("Client %s saying hello."), id != nullptr ? id : "Unknown");
+  dist_manager->log(DistributionLogEvent::Hello, id);
 
   GHmac *hmac = g_hmac_new(G_CHECKSUM_SHA1, (const guchar *)password, strlen(password));
   g_hmac_update(hmac, (const guchar *)username, strlen(username));
@@ -1356,7 +1417,7 @@ DistributionSocketLink::handle_hello2(PacketBuffer &packet, Client *client)
       else
         {
           // Duplicate client. inform client that it's bogus and close.
-          dist_manager->log(_("Client %s is duplicate."), id != nullptr ? id : "Unknown");
+          dist_manager->log(DistributionLogEvent::Duplicate, id);
 
           send_duplicate(client);
           remove_client(client);
@@ -1365,7 +1426,7 @@ DistributionSocketLink::handle_hello2(PacketBuffer &packet, Client *client)
   else
     {
       // Incorrect password.
-      dist_manager->log(_("Client %s access denied."), id != nullptr ? id : "Unknown");
+      dist_manager->log(DistributionLogEvent::AccessDenied, id);
       remove_client(client);
     }
 
@@ -1435,7 +1496,7 @@ DistributionSocketLink::handle_signoff(PacketBuffer &packet, Client *client)
 
   if (c != nullptr)
     {
-      dist_manager->log(_("Client %s signed off."), c->id == nullptr ? "Unknown" : c->id);
+      dist_manager->log(DistributionLogEvent::SignedOff, c->id);
 
       if (c->type == CLIENTTYPE_DIRECT)
         {
@@ -1483,7 +1544,7 @@ DistributionSocketLink::handle_duplicate(PacketBuffer &packet, Client *client)
 {
   (void)packet;
   TRACE_ENTER("DistributionSocketLink::handle_duplicate");
-  dist_manager->log(_("Client %s is duplicate."), client->id == nullptr ? "Unknown" : client->id);
+  dist_manager->log(DistributionLogEvent::Duplicate, client->id);
   remove_client(client);
 
   TRACE_EXIT();
@@ -1519,7 +1580,7 @@ DistributionSocketLink::handle_welcome(PacketBuffer &packet, Client *client)
   gchar *name = packet.unpack_string();
   /*gint port = */ packet.unpack_ushort();
 
-  dist_manager->log(_("Client %s is welcoming us."), id == nullptr ? "Unknown" : id);
+  dist_manager->log(DistributionLogEvent::Welcome, id);
 
   bool ok = set_client_id(client, id);
 
@@ -1568,48 +1629,20 @@ DistributionSocketLink::send_client_list(Client *client, bool except)
       packet.pack_ushort(0); // flags.
 
       // Put muself in list.
-      gint pos = packet.bytes_written();
-
       TRACE_MSG("client me: " << my_id.str() << " " << server_port << " " << i_am_master);
+      std::string me = get_my_id();
       int flags = CLIENTLIST_ME | (i_am_master ? CLIENTLIST_MASTER : 0);
-      packet.pack_ushort(0);           // Length
-      packet.pack_ushort(flags);       // Flags
-      packet.pack_string(get_my_id()); // ID
-      packet.pack_string(get_my_id()); // Canonical name
-      packet.pack_ushort(server_port); // Listen port.
-
-      // Size of the client data.
-      packet.poke_ushort(pos, packet.bytes_written() - pos);
+      pack_client_list_entry(packet, flags, me.c_str(), me.c_str(), server_port);
 
       // Put known client in the list.
-      list<Client *>::iterator i = clients.begin();
-      while (i != clients.end())
+      for (Client *c: clients)
         {
-          Client *c = *i;
-
           if (c->id != nullptr)
             {
               count++;
-              pos = packet.bytes_written();
-
-              int flags = 0;
-              if (c == master_client)
-                {
-                  flags |= CLIENTLIST_MASTER;
-                }
-
               TRACE_MSG("Send client: " << c->id);
-
-              packet.pack_ushort(0);           // Length
-              packet.pack_ushort(flags);       // Flags
-              packet.pack_string(c->id);       // ID
-              packet.pack_string(c->hostname); // Canonical name
-              packet.pack_ushort(c->port);     // Listen port.
-
-              // Size of the client data.
-              packet.poke_ushort(pos, packet.bytes_written() - pos);
+              pack_client_list_entry(packet, c == master_client ? CLIENTLIST_MASTER : 0, c->id, c->hostname, c->port);
             }
-          i++;
         }
 
       // Put packet size in the packet and send.
@@ -1628,38 +1661,67 @@ DistributionSocketLink::send_client_list(Client *client, bool except)
   TRACE_EXIT();
 }
 
+//! Adds a single client to a client list packet.
+void
+DistributionSocketLink::pack_client_list_entry(PacketBuffer &packet, int flags, const gchar *id, const gchar *name, gint port)
+{
+  gint pos = packet.bytes_written();
+
+  packet.pack_ushort(0);     // Length
+  packet.pack_ushort(flags); // Flags
+  packet.pack_string(id);    // ID
+  packet.pack_string(name);  // Canonical name
+  packet.pack_ushort(port);  // Listen port.
+
+  // Size of the client data.
+  packet.poke_ushort(pos, packet.bytes_written() - pos);
+}
+
 //! Handles a client list from the specified client.
+/*!
+ *  The received list is not forwarded as is. Instead, only the clients
+ *  that were unknown to us are forwarded to our other clients, together
+ *  with the sender and the master. Clients further away already know the
+ *  rest, so gossip about a new peer costs one small packet per link
+ *  instead of a full list.
+ *
+ *  \return always false; forwarding is handled here.
+ */
 bool
 DistributionSocketLink::handle_client_list(PacketBuffer &packet, Client *client, Client *direct)
 {
   TRACE_ENTER("DistributionSocketLink::handle_client_list");
 
-  if (!client->welcome)
+  if (client == nullptr || !client->welcome)
     {
       TRACE_EXIT();
       return false;
     }
 
+  struct Entry
+  {
+    int flags;
+    std::string id;
+    std::string name;
+    gint port;
+    bool is_new;
+  };
+
   // Extract data.
   gint num_clients = packet.unpack_ushort();
-  gint flags = packet.unpack_ushort();
-  (void)flags;
+  gint list_flags = packet.unpack_ushort();
+  TRACE_MSG("delta = " << ((list_flags & CLIENTLIST_DELTA) != 0));
 
-  gchar *master_id = nullptr;
-
-  gchar **names = new gchar *[num_clients];
-  gchar **ids = new gchar *[num_clients];
-  gint *ports = new gint[num_clients];
+  std::vector<Entry> entries;
+  entries.reserve(num_clients);
 
+  std::string master_id;
+  bool any_new = false;
   bool ok = true;
 
   // Loop over remote clients.
   for (int i = 0; i < num_clients; i++)
     {
-      names[i] = nullptr;
-      ids[i] = nullptr;
-      ports[i] = 0;
-
       // Extract data.
       gint pos = packet.bytes_read();
       gint size = packet.unpack_ushort();
@@ -1668,27 +1730,32 @@ DistributionSocketLink::handle_client_list(PacketBuffer &packet, Client *client,
       gchar *name = packet.unpack_string();
       gint port = packet.unpack_ushort();
 
-      if (flags & CLIENTLIST_MASTER)
-        {
-          master_id = g_strdup(id);
-          TRACE_MSG("Master: " << master_id);
-        }
-
       if (id != nullptr)
         {
-          if (!exists_client(id))
+          bool is_new = !exists_client(id);
+
+          if (flags & CLIENTLIST_MASTER)
+            {
+              master_id = id;
+              TRACE_MSG("Master: " << master_id);
+            }
+
+          if (is_new)
             {
               // A new client
               TRACE_MSG("new client: " << id);
-              names[i] = name;
-              ids[i] = id;
-              ports[i] = port;
+              any_new = true;
             }
-          else if (client != nullptr && direct == client && !client_is_me(id) && strcmp(client->id, id) != 0)
+          else if (direct == client && !client_is_me(id) && strcmp(client->id, id) != 0)
             {
               TRACE_MSG("Strange client: " << id);
               ok = false;
             }
+
+          if (is_new || (flags & (CLIENTLIST_ME | CLIENTLIST_MASTER)))
+            {
+              entries.push_back(Entry{flags, id, name != nullptr ? name : "", port, is_new});
+            }
         }
 
       // Skip trailing junk...
@@ -1702,53 +1769,56 @@ DistributionSocketLink::handle_client_list(PacketBuffer &packet, Client *client,
   if (ok)
     {
       // And send the list of client we are connected to.
-      if (client != nullptr && direct == client && !client->sent_client_list)
+      if (direct == client && !client->sent_client_list)
         {
           client->sent_client_list = true;
           send_client_list(client);
         }
 
       TRACE_MSG("Adding: ");
-      for (int i = 0; i < num_clients; i++)
+      for (Entry &e: entries)
         {
-          if (ids[i] != nullptr && names[i] != nullptr)
+          if (e.is_new && !e.name.empty())
             {
-              add_client(ids[i], names[i], ports[i], CLIENTTYPE_ROUTED, direct);
+              add_client(const_cast<gchar *>(e.id.c_str()), const_cast<gchar *>(e.name.c_str()), e.port, CLIENTTYPE_ROUTED, direct);
             }
         }
 
-      if (master_id != nullptr)
+      if (!master_id.empty())
         {
-          set_master_by_id(master_id);
+          set_master_by_id(const_cast<gchar *>(master_id.c_str()));
           TRACE_MSG(master_id << " is now master");
         }
 
       send_client_message(DCMT_SIGNON);
+
+      if (any_new || direct == client)
+        {
+          PacketBuffer delta;
+          delta.create();
+          init_packet(delta, PACKET_CLIENT_LIST);
+          delta.pack_ushort(entries.size());
+          delta.pack_ushort(CLIENTLIST_DELTA);
+
+          for (Entry &e: entries)
+            {
+              pack_client_list_entry(delta, e.flags, e.id.c_str(), e.name.c_str(), e.port);
+            }
+
+          forward_packet_except(delta, direct, client);
+        }
     }
   else
     {
       TRACE_MSG("Dup: ");
-      dist_manager->log(_("Client %s is duplicate."), client->id != nullptr ? client->id : "Unknown");
+      dist_manager->log(DistributionLogEvent::Duplicate, client->id);
 
       send_duplicate(client);
       remove_client(client);
     }
 
-  TRACE_MSG("Ok: ");
-
-  for (int i = 0; i < num_clients; i++)
-    {
-      g_free(ids[i]);
-      g_free(names[i]);
-    }
-
-  g_free(master_id);
-  delete[] names;
-  delete[] ids;
-  delete[] ports;
-
   TRACE_EXIT();
-  return ok;
+  return false;
 }
 
 //! Requests to become master.
@@ -1761,7 +1831,7 @@ DistributionSocketLink::send_claim(Client *client)
     {
       PacketBuffer packet;
 
-      dist_manager->log(_("Requesting master status from %s."), client->id == nullptr ? "Unknown" : client->id);
+      dist_manager->log(DistributionLogEvent::RequestingMaster, client->id);
 
       packet.create();
       init_packet(packet, PACKET_CLAIM);
@@ -1774,7 +1844,7 @@ DistributionSocketLink::send_claim(Client *client)
 
       if (client->claim_count >= 3)
         {
-          dist_manager->log(_("Client timeout from %s."), client->id == nullptr ? "Unknown" : client->id);
+          dist_manager->log(DistributionLogEvent::Timeout, client->id);
 
           close_client(client, client->outbound);
         }
@@ -1800,12 +1870,12 @@ DistributionSocketLink::handle_claim(PacketBuffer &packet, Client *client)
 
   if (i_am_master && master_locked)
     {
-      dist_manager->log(_("Rejecting master request from client %s."), client->id == nullptr ? "Unknown" : client->id);
+      dist_manager->log(DistributionLogEvent::RejectingMasterRequest, client->id);
       send_claim_reject(client);
     }
   else
     {
-      dist_manager->log(_("Acknowledging master request from client %s."), client->id == nullptr ? "Unknown" : client->id);
+      dist_manager->log(DistributionLogEvent::AcknowledgingMasterRequest, client->id);
 
       bool was_master = i_am_master;
 
@@ -1821,8 +1891,8 @@ DistributionSocketLink::handle_claim(PacketBuffer &packet, Client *client)
           send_client_message(DCMT_MASTER);
         }
 
-      // And tell everyone we have a new master.
-      send_new_master();
+      // And tell everyone we have a new master on the next heartbeat.
+      new_master_pending = true;
     }
 
   TRACE_EXIT();
@@ -1858,11 +1928,11 @@ DistributionSocketLink::handle_claim_reject(PacketBuffer &packet, Client *client
 
   if (client != master_client)
     {
-      dist_manager->log(_("Non-master client %s rejected master request."), client->id == nullptr ? "Unknown" : client->id);
+      dist_manager->log(DistributionLogEvent::NonMasterRejectedMasterRequest, client->id);
     }
   else
     {
-      dist_manager->log(_("Client %s rejected master request, delaying."), client->id == nullptr ? "Unknown" : client->id);
+      dist_manager->log(DistributionLogEvent::MasterRequestRejected, client->id);
       client->reject_count++;
       int count = client->reject_count;
 
@@ -1877,12 +1947,93 @@ DistributionSocketLink::handle_claim_reject(PacketBuffer &packet, Client *client
   TRACE_EXIT();
 }
 
+//! Sends a keepalive to a directly connected client.
+void
+DistributionSocketLink::send_keepalive(Client *client)
+{
+  TRACE_ENTER("DistributionSocketLink::send_keepalive");
+
+  PacketBuffer packet;
+
+  packet.create();
+  init_packet(packet, PACKET_KEEPALIVE);
+
+  send_packet(client, packet);
+  TRACE_EXIT();
+}
+
+//! Handles a keepalive.
+void
+DistributionSocketLink::handle_keepalive(PacketBuffer &packet, Client *client)
+{
+  TRACE_ENTER("DistributionSocketLink::handle_keepalive");
+  (void)packet;
+
+  // The peer sends keepalives, so its silence means something. Older
+  // peers forward keepalives they do not understand; ignore those.
+  if (client->type == CLIENTTYPE_DIRECT)
+    {
+      client->health.set_monitored(true);
+    }
+
+  TRACE_EXIT();
+}
+
+//! Sends keepalives where needed and disconnects clients that stopped responding.
+/*!
+ *  Keepalives are only sent to clients to which nothing else was sent
+ *  recently; any packet proves that we are alive.
+ */
+void
+DistributionSocketLink::check_peer_health()
+{
+  TRACE_ENTER("DistributionSocketLink::check_peer_health");
+
+  int64_t now = TimeSource::get_monotonic_time_usec();
+  std::vector<Client *> suspects;
+
+  for (Client *c: clients)
+    {
+      if (c->type != CLIENTTYPE_DIRECT || c->socket == nullptr || !c->welcome)
+        {
+          continue;
+        }
+
+      if (c->health.is_suspected(now))
+        {
+          TRACE_MSG("Suspected " << c->id << " phi = " << c->health.get_phi(now));
+          suspects.push_back(c);
+        }
+      else if (c->health.needs_keepalive(now))
+        {
+          send_keepalive(c);
+        }
+    }
+
+  for (Client *c: suspects)
+    {
+      // Closing a client can remove others.
+      if (is_client_valid(c))
+        {
+          dist_manager->log(DistributionLogEvent::Timeout, c->id);
+          close_client(c, c->outbound);
+        }
+    }
+
+  TRACE_EXIT();
+}
+
 //! Informs the specified client (or all remote clients) that a new client is now master.
 void
 DistributionSocketLink::send_new_master(Client *client)
 {
   TRACE_ENTER("DistributionSocketLink::send_new_master");
 
+  if (client == nullptr)
+    {
+      new_master_pending = false;
+    }
+
   PacketBuffer packet;
 
   packet.create();
@@ -1936,7 +2087,7 @@ DistributionSocketLink::handle_new_master(PacketBuffer &packet, Client *client)
   gchar *id = packet.unpack_string();
   /* gint count = */ packet.unpack_ushort();
 
-  dist_manager->log(_("Client %s is now the new master."), id == nullptr ? "Unknown" : id);
+  dist_manager->log(DistributionLogEvent::NewMaster, id);
 
   if (client->id != nullptr)
     {
@@ -2064,7 +2215,7 @@ DistributionSocketLink::start_async_server()
         {
           server_socket->set_listener(this);
           server_socket->listen(server_port);
-          dist_manager->log(_("Network operation started."));
+          dist_manager->log(DistributionLogEvent::NetworkStarted);
           ret = true;
         }
     }
@@ -2084,7 +2235,7 @@ DistributionSocketLink::socket_accepted(ISocketServer *scon, ISocket *ccon)
   TRACE_ENTER("DistributionSocketLink::socket_accepted");
   if (ccon != nullptr)
     {
-      dist_manager->log(_("Accepted new client."));
+      dist_manager->log(DistributionLogEvent::Accepted);
 
       Client *client = new Client;
       client->type = CLIENTTYPE_DIRECT;
@@ -2102,6 +2253,7 @@ DistributionSocketLink::socket_accepted(ISocketServer *scon, ISocket *ccon)
       ccon->set_data(client);
       ccon->set_listener(this);
       clients.push_back(client);
+      index_client(client);
 
       send_hello1(client);
     }
@@ -2159,12 +2311,12 @@ DistributionSocketLink::socket_io(ISocket *con, void *data)
 
   if (!ok)
     {
-      dist_manager->log(_("Client %s read error, closing."), client->id == nullptr ? "Unknown" : client->id);
+      dist_manager->log(DistributionLogEvent::ReadError, client->id);
       ret = false;
     }
   else if (bytes_read == 0)
     {
-      dist_manager->log(_("Client %s closed connection."), client->id == nullptr ? "Unknown" : client->id);
+      dist_manager->log(DistributionLogEvent::ConnectionClosed, client->id);
       ret = false;
     }
   else
@@ -2203,12 +2355,14 @@ DistributionSocketLink::socket_connected(ISocket *con, void *data)
       return;
     }
 
-  dist_manager->log(_("Client %s connected."), client->id != nullptr ? client->id : "Unknown");
+  dist_manager->log(DistributionLogEvent::Connected, client->id);
 
   client->reconnect_count = 0;
   client->reconnect_time = 0;
   client->outbound = true;
   client->socket = con;
+  client->health.reset_backoff();
+  client->health.reset(TimeSource::get_monotonic_time_usec());
 
   TRACE_EXIT();
 }
@@ -2231,12 +2385,12 @@ DistributionSocketLink::socket_closed(ISocket *con, void *data)
   // Socket error. Disable client.
   if (client->socket != nullptr)
     {
-      dist_manager->log(_("Client %s closed connection."), client->id != nullptr ? client->id : "Unknown");
+      dist_manager->log(DistributionLogEvent::ConnectionClosed, client->id);
       close_client(client, client->outbound);
     }
   else
     {
-      dist_manager->log(_("Could not connect to client %s."), client->id != nullptr ? client->id : "Unknown");
+      dist_manager->log(DistributionLogEvent::ConnectFailed, client->id);
       remove_client(client);
     }
 
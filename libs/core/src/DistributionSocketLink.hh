@@ -19,12 +19,16 @@
 
 #include <list>
 #include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <ctime>
 
 #include "DistributionLink.hh"
 #include "IDistributionClientMessage.hh"
 #include "config/IConfiguratorListener.hh"
 #include "PacketBuffer.hh"
+#include "PeerHealth.hh"
 
 #include "SocketDriver.hh"
 #include "utils/WRID.hh"
@@ -53,6 +57,7 @@ private:
     PACKET_CLAIM_REJECT = 0x0008,
     PACKET_SIGNOFF = 0x0009,
     PACKET_HELLO2 = 0x000A,
+    PACKET_KEEPALIVE = 0x000B,
   };
 
   enum PacketFlags
@@ -65,6 +70,7 @@ private:
   {
     CLIENTLIST_ME = 1,
     CLIENTLIST_MASTER = 2,
+    CLIENTLIST_DELTA = 4,
   };
 
   struct ClientMessageListener
@@ -145,6 +151,9 @@ private:
 
     //! Is this an outbound connection
     bool outbound{false};
+
+    //! Failure detection and reconnect backoff.
+    PeerHealth health;
   };
 
 public:
@@ -188,6 +197,9 @@ private:
   Client *find_client_by_id(gchar *id);
   bool client_is_me(gchar *id);
   bool exists_client(gchar *id);
+  void index_client(Client *client);
+  void unindex_client(Client *client);
+  static std::string get_address_key(const gchar *name, gint port);
 
   bool set_client_id(Client *client, gchar *id);
 
@@ -214,6 +226,7 @@ private:
   void handle_new_master(PacketBuffer &packet, Client *client);
   void handle_client_message(PacketBuffer &packet, Client *client);
   void handle_claim_reject(PacketBuffer &packet, Client *client);
+  void handle_keepalive(PacketBuffer &packet, Client *client);
 
   void send_hello1(Client *client);
   void send_hello2(Client *client, gchar *rnd);
@@ -221,9 +234,12 @@ private:
   void send_welcome(Client *client);
   void send_duplicate(Client *client);
   void send_client_list(Client *client, bool except = false);
+  void pack_client_list_entry(PacketBuffer &packet, int flags, const gchar *id, const gchar *name, gint port);
   void send_claim(Client *client);
   void send_new_master(Client *client = nullptr);
   void send_claim_reject(Client *client);
+  void send_keepalive(Client *client);
+  void check_peer_health();
   void send_client_message(DistributionClientMessageType type);
 
   bool start_async_server();
@@ -256,6 +272,15 @@ private:
   //! All clients.
   std::list<Client *> clients;
 
+  //! All clients, for validity checks.
+  std::unordered_set<Client *> client_set;
+
+  //! Clients by id.
+  std::unordered_map<std::string, Client *> clients_by_id;
+
+  //! Clients by canonical name and port.
+  std::unordered_map<std::string, Client *> clients_by_address;
+
   //! Active client
   Client *master_client{nullptr};
 
@@ -286,6 +311,9 @@ private:
 
   //!
   int heartbeat_count{0};
+
+  //! Whether a new master must be announced on the next heartbeat.
+  bool new_master_pending{false};
 };
 
 #endif // DISTRIBUTIONSOCKETLINK_HH
@@ -0,0 +1,207 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "ExternalActivity.hh"
+
+#include <algorithm>
+
+bool
+ExternalActivity::report(const std::string &who, bool active, int64_t now)
+{
+  auto it = clients.find(who);
+  if (it == clients.end())
+    {
+      if (!active)
+        {
+          return true;
+        }
+
+      it = clients.emplace(who, Client()).first;
+      Client &client = it->second;
+      client.name = &it->first;
+      client.last_refill = now;
+      client.tokens--;
+      client.active = true;
+      client.deadline = now + ACTIVITY_TIMEOUT;
+      num_active++;
+      heap_push(&client);
+      return true;
+    }
+
+  // Stops are never dropped: a client that used up its burst must still be able to end its activity.
+  Client &client = it->second;
+  if (active && !take_token(client, now))
+    {
+      dropped_count++;
+      return false;
+    }
+
+  if (active && !client.active)
+    {
+      num_active++;
+    }
+  else if (!active && client.active)
+    {
+      num_active--;
+    }
+  client.active = active;
+
+  // An inactive client is kept until its bucket is full again, so that
+  // toggling between active and inactive does not bypass the rate limit.
+  client.deadline = active ? now + ACTIVITY_TIMEOUT : now + RATE_LIMIT_BURST;
+  heap_update(client.heap_index);
+  return true;
+}
+
+bool
+ExternalActivity::is_active(int64_t now)
+{
+  while (!heap.empty() && heap.front()->deadline < now)
+    {
+      Client *client = heap.front();
+      if (client->active)
+        {
+          num_active--;
+        }
+      heap_remove(0);
+      clients.erase(clients.find(*client->name));
+    }
+
+  return num_active > 0;
+}
+
+std::size_t
+ExternalActivity::size() const
+{
+  return clients.size();
+}
+
+int64_t
+ExternalActivity::get_dropped_count() const
+{
+  return dropped_count;
+}
+
+bool
+ExternalActivity::take_token(Client &client, int64_t now)
+{
+  if (now > client.last_refill)
+    {
+      int64_t refill = std::min<int64_t>(now - client.last_refill, RATE_LIMIT_BURST);
+      client.tokens = static_cast<int>(std::min<int64_t>(client.tokens + refill, RATE_LIMIT_BURST));
+      client.last_refill = now;
+    }
+
+  if (client.tokens == 0)
+    {
+      return false;
+    }
+
+  client.tokens--;
+  return true;
+}
+
+void
+ExternalActivity::heap_push(Client *client)
+{
+  heap.push_back(client);
+  client->heap_index = heap.size() - 1;
+  sift_up(client->heap_index);
+}
+
+void
+ExternalActivity::heap_remove(std::size_t index)
+{
+  std::size_t last = heap.size() - 1;
+  if (index != last)
+    {
+      heap_set(index, heap[last]);
+      heap.pop_back();
+      heap_update(index);
+    }
+  else
+    {
+      heap.pop_back();
+    }
+}
+
+void
+ExternalActivity::heap_update(std::size_t index)
+{
+  if (index > 0 && heap[index]->deadline < heap[(index - 1) / 2]->deadline)
+    {
+      sift_up(index);
+    }
+  else
+    {
+      sift_down(index);
+    }
+}
+
+void
+ExternalActivity::sift_up(std::size_t index)
+{
+  Client *client = heap[index];
+  while (index > 0)
+    {
+      std::size_t parent = (index - 1) / 2;
+      if (heap[parent]->deadline <= client->deadline)
+        {
+          break;
+        }
+      heap_set(index, heap[parent]);
+      index = parent;
+    }
+  heap_set(index, client);
+}
+
+void
+ExternalActivity::sift_down(std::size_t index)
+{
+  Client *client = heap[index];
+  std::size_t count = heap.size();
+  while (true)
+    {
+      std::size_t child = 2 * index + 1;
+      if (child >= count)
+        {
+          break;
+        }
+      if (child + 1 < count && heap[child + 1]->deadline < heap[child]->deadline)
+        {
+          child++;
+        }
+      if (client->deadline <= heap[child]->deadline)
+        {
+          break;
+        }
+      heap_set(index, heap[child]);
+      index = child;
+    }
+  heap_set(index, client);
+}
+
+void
+ExternalActivity::heap_set(std::size_t index, Client *client)
+{
+  heap[index] = client;
+  client->heap_index = index;
+}
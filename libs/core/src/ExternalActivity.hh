@@ -0,0 +1,101 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef EXTERNALACTIVITY_HH
+#define EXTERNALACTIVITY_HH
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//! Activity reported by other applications, e.g. with ReportActivity over D-Bus.
+/*!
+ *  Every report keeps the user active for ACTIVITY_TIMEOUT seconds. The
+ *  clients are kept in a hash map and in a min-heap ordered by the time
+ *  their entry expires, so that checking for activity is O(1) and
+ *  expiring a client is O(log n), regardless of the number of clients.
+ *
+ *  Each client has a token bucket of RATE_LIMIT_BURST reports that refills
+ *  at one report per second. Reports beyond that are dropped, so a chatty
+ *  client costs no more than a hash lookup per report. Only reports of
+ *  activity count; the end of activity is always applied.
+ *
+ *  All times are in seconds.
+ */
+class ExternalActivity
+{
+public:
+  //! Time a report keeps the user active.
+  static constexpr int64_t ACTIVITY_TIMEOUT = 10;
+
+  //! Reports a client may send in a burst.
+  static constexpr int RATE_LIMIT_BURST = 5;
+
+  //! Records the start or end of activity of a client.
+  /*! Returns false if the report was dropped by the rate limit. */
+  bool report(const std::string &who, bool active, int64_t now);
+
+  //! Returns whether any client is active, and forgets expired clients.
+  bool is_active(int64_t now);
+
+  //! Returns the number of clients that are remembered.
+  std::size_t size() const;
+
+  //! Returns the number of reports dropped by the rate limit.
+  int64_t get_dropped_count() const;
+
+private:
+  struct Client
+  {
+    //! Time after which the client expires.
+    int64_t deadline{0};
+
+    //! Whether the client is active until the deadline. Inactive clients are
+    //! only remembered until their rate limit has recovered.
+    bool active{false};
+
+    int tokens{RATE_LIMIT_BURST};
+    int64_t last_refill{0};
+
+    const std::string *name{nullptr};
+    std::size_t heap_index{0};
+  };
+
+  bool take_token(Client &client, int64_t now);
+
+  void heap_push(Client *client);
+  void heap_remove(std::size_t index);
+  void heap_update(std::size_t index);
+  void sift_up(std::size_t index);
+  void sift_down(std::size_t index);
+  void heap_set(std::size_t index, Client *client);
+
+private:
+  //! Clients by name. Elements are not moved by rehashing, so the heap can point to them.
+  std::unordered_map<std::string, Client> clients;
+
+  //! Clients ordered by deadline.
+  std::vector<Client *> heap;
+
+  //! Number of active clients.
+  std::size_t num_active{0};
+
+  int64_t dropped_count{0};
+};
+
+#endif // EXTERNALACTIVITY_HH
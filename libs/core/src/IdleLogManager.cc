@@ -33,7 +33,8 @@
 #include <filesystem>
 
 #include "utils/TimeSource.hh"
-#include "utils/AssetPath.hh"
+#include "utils/Paths.hh"
+#include "utils/StateWriter.hh"
 
 #include "IdleLogManager.hh"
 #include "PacketBuffer.hh"
@@ -42,6 +43,7 @@
 #define IDLELOG_MAXAGE (12 * 60 * 60)
 #define IDLELOG_INTERVAL (30 * 60)
 #define IDLELOG_VERSION (3)
+#define IDLELOG_INDEX_VERSION (4)
 #define IDLELOG_INTERVAL_SIZE (17)
 
 using namespace workrave::utils;
@@ -49,6 +51,7 @@ using namespace std;
 
 //! Constructs a new idlelog manager.
 IdleLogManager::IdleLogManager(string myid)
+  : store(Paths::get_state_directory() / "idlelog", IDLELOG_MAXAGE)
 {
   this->myid = myid;
   this->last_expiration_time = 0;
@@ -139,6 +142,7 @@ void
 IdleLogManager::terminate()
 {
   save();
+  store.close();
 }
 
 //! Expire entries that are too old.
@@ -588,15 +592,8 @@ IdleLogManager::unlink_idlelog(PacketBuffer &buffer) const
 
       if (id != nullptr)
         {
-          stringstream ss;
-          ss << AssetPath::get_home_directory();
-          ss << "idlelog." << id << ".log" << ends;
-
-#ifdef PLATFORM_OS_WINDOWS
-          _unlink(ss.str().c_str());
-#else
-          unlink(ss.str().c_str());
-#endif
+          std::error_code ec;
+          std::filesystem::remove(get_legacy_idlelog_path(id), ec);
 
           g_free(id);
         }
@@ -619,7 +616,7 @@ IdleLogManager::save_index()
   PacketBuffer buffer;
   buffer.create();
 
-  buffer.pack_ushort(IDLELOG_VERSION);
+  buffer.pack_ushort(IDLELOG_INDEX_VERSION);
   buffer.pack_string(myid.c_str());
 
   for (ClientMapIter i = clients.begin(); i != clients.end(); i++)
@@ -631,13 +628,8 @@ IdleLogManager::save_index()
       pack_idlelog(buffer, info);
     }
 
-  stringstream ss;
-  ss << AssetPath::get_home_directory();
-  ss << "idlelog.idx" << ends;
-
-  ofstream file(ss.str().c_str(), ios::binary);
-  file.write(buffer.get_buffer(), buffer.bytes_written());
-  file.close();
+  std::filesystem::path path = Paths::get_state_directory() / "idlelog.idx";
+  StateWriter::instance().write(path, string(buffer.get_buffer(), buffer.bytes_written()));
 
   TRACE_EXIT();
 }
@@ -648,11 +640,7 @@ IdleLogManager::load_index()
 {
   TRACE_ENTER("IdleLogManager::load()");
 
-  stringstream ss;
-  ss << AssetPath::get_home_directory();
-  ss << "idlelog.idx" << ends;
-
-  std::filesystem::path f(ss.str());
+  std::filesystem::path f = Paths::get_state_directory() / "idlelog.idx";
   bool exists = std::filesystem::is_regular_file(f);
 
   if (exists)
@@ -660,7 +648,7 @@ IdleLogManager::load_index()
       TRACE_MSG("File exists - ok");
 
       // Open file
-      ifstream file(ss.str().c_str(), ios::binary);
+      ifstream file(f, ios::binary);
 
       // get file size using buffer's members
       filebuf *pbuf = file.rdbuf();
@@ -680,10 +668,13 @@ IdleLogManager::load_index()
       int version = buffer.unpack_ushort();
       TRACE_MSG("Version - " << version);
 
-      if (version == IDLELOG_VERSION)
+      if (version == IDLELOG_INDEX_VERSION || version == IDLELOG_VERSION)
         {
           TRACE_MSG("Version - ok");
 
+          // The previous version stored a log file per client.
+          legacy_index = version == IDLELOG_VERSION;
+
           char *id = buffer.unpack_string();
           if (id != nullptr)
             {
@@ -729,45 +720,105 @@ IdleLogManager::load_index()
   TRACE_EXIT();
 }
 
-//! Saves the idlelog for the specified client.
-void
-IdleLogManager::save_idlelog(ClientInfo &info)
+//! Converts an idle interval to its representation on disk.
+IdleLogStore::Record
+IdleLogManager::to_record(const IdleInterval &idle)
 {
-  info.update_active_time(TimeSource::get_real_time_sec());
+  IdleLogStore::Record record;
+  record.begin_time = idle.begin_time;
+  record.end_idle_time = idle.end_idle_time;
+  record.end_time = idle.end_time;
+  record.active_time = (uint32_t)idle.active_time;
+  return record;
+}
 
-  PacketBuffer buffer;
-  buffer.create();
+//! Converts an idle interval from its representation on disk.
+IdleLogManager::IdleInterval
+IdleLogManager::from_record(const IdleLogStore::Record &record)
+{
+  IdleInterval idle;
+  idle.begin_time = record.begin_time;
+  idle.end_idle_time = record.end_idle_time;
+  idle.end_time = record.end_time;
+  idle.active_time = record.active_time;
+  return idle;
+}
 
-  for (IdleLogRIter i = info.idlelog.rbegin(); i != info.idlelog.rend(); i++)
+//! Returns the idlelog of the specified client, oldest interval first.
+vector<IdleLogStore::Record>
+IdleLogManager::to_records(const ClientInfo &info) const
+{
+  vector<IdleLogStore::Record> records;
+  records.reserve(info.idlelog.size());
+  for (IdleLog::const_reverse_iterator i = info.idlelog.rbegin(); i != info.idlelog.rend(); i++)
     {
-      IdleInterval &idle = *i;
-
-      pack_idle_interval(buffer, idle);
+      records.push_back(to_record(*i));
     }
+  return records;
+}
 
-  stringstream ss;
-  ss << AssetPath::get_home_directory();
-  ss << "idlelog." << info.client_id << ".log" << ends;
+//! Returns the log file of the specified client used by the previous version.
+std::filesystem::path
+IdleLogManager::get_legacy_idlelog_path(const string &client_id) const
+{
+  return Paths::get_state_directory() / ("idlelog." + client_id + ".log");
+}
+
+//! Saves the idlelog for the specified client.
+void
+IdleLogManager::save_idlelog(ClientInfo &info)
+{
+  int64_t current_time = TimeSource::get_real_time_sec();
+  info.update_active_time(current_time);
 
-  ofstream file(ss.str().c_str(), ios::binary);
-  file.write(buffer.get_buffer(), buffer.bytes_written());
-  file.close();
+  store.replace(info.client_id, to_records(info), current_time);
+  store.flush();
 }
 
 //! Loads the idlelog for the specified client.
 void
-IdleLogManager::load_idlelog(ClientInfo &info)
+IdleLogManager::load_idlelog(ClientInfo &info, const vector<IdleLogStore::Record> &records)
 {
   TRACE_ENTER("IdleLogManager::load_idlelog()");
 
   int64_t current_time = TimeSource::get_real_time_sec();
 
-  stringstream ss;
-  ss << AssetPath::get_home_directory();
-  ss << "idlelog." << info.client_id << ".log" << ends;
+  size_t first = 0;
+  if (records.size() > IDLELOG_MAXSIZE)
+    {
+      TRACE_MSG("Skipping " << (records.size() - IDLELOG_MAXSIZE) << " intervals");
+      first = records.size() - IDLELOG_MAXSIZE;
+    }
+
+  TRACE_MSG("loading " << (records.size() - first) << " intervals");
+  for (size_t i = first; i < records.size(); i++)
+    {
+      IdleInterval idle = from_record(records[i]);
+
+      if (idle.end_idle_time >= current_time - IDLELOG_MAXAGE)
+        {
+          info.idlelog.push_front(idle);
+        }
+    }
+
+  if (info.idlelog.size() > 0)
+    {
+      IdleInterval &idle = info.idlelog.back();
+      idle.begin_time = 1;
+    }
+  TRACE_EXIT();
+}
+
+//! Loads the idlelog for the specified client from the file used by the previous version.
+void
+IdleLogManager::load_legacy_idlelog(ClientInfo &info)
+{
+  TRACE_ENTER("IdleLogManager::load_legacy_idlelog()");
+
+  int64_t current_time = TimeSource::get_real_time_sec();
 
   // Open file
-  ifstream file(ss.str().c_str(), ios::binary);
+  ifstream file(get_legacy_idlelog_path(info.client_id), ios::binary);
 
   // get file size using buffer's members
   filebuf *pbuf = file.rdbuf();
@@ -812,10 +863,32 @@ IdleLogManager::load_idlelog(ClientInfo &info)
           idle.begin_time = 1;
         }
     }
+  TRACE_EXIT();
+}
 
-  dump_idlelog(info);
-  fix_idlelog(info);
-  dump_idlelog(info);
+//! Moves the per-client log files of the previous version into the store.
+void
+IdleLogManager::migrate_idlelogs()
+{
+  TRACE_ENTER("IdleLogManager::migrate_idlelogs()");
+
+  int64_t current_time = TimeSource::get_real_time_sec();
+  for (ClientMapIter i = clients.begin(); i != clients.end(); i++)
+    {
+      ClientInfo &info = (*i).second;
+      load_legacy_idlelog(info);
+      store.replace(info.client_id, to_records(info), current_time);
+    }
+  store.flush();
+
+  legacy_index = false;
+  save_index();
+
+  for (ClientMapIter i = clients.begin(); i != clients.end(); i++)
+    {
+      std::error_code ec;
+      std::filesystem::remove(get_legacy_idlelog_path(i->first), ec);
+    }
   TRACE_EXIT();
 }
 
@@ -823,12 +896,30 @@ IdleLogManager::load_idlelog(ClientInfo &info)
 void
 IdleLogManager::load()
 {
+  store.open(TimeSource::get_real_time_sec());
   load_index();
 
+  if (legacy_index)
+    {
+      migrate_idlelogs();
+    }
+  else
+    {
+      store.load([this](const string &client_id, const vector<IdleLogStore::Record> &records) {
+        ClientMapIter i = clients.find(client_id);
+        if (i != clients.end())
+          {
+            load_idlelog(i->second, records);
+          }
+      });
+    }
+
   for (ClientMapIter i = clients.begin(); i != clients.end(); i++)
     {
       ClientInfo &info = (*i).second;
-      load_idlelog(info);
+      dump_idlelog(info);
+      fix_idlelog(info);
+      dump_idlelog(info);
     }
 }
 
@@ -838,31 +929,35 @@ IdleLogManager::save()
 {
   save_index();
 
+  int64_t current_time = TimeSource::get_real_time_sec();
   for (ClientMapIter i = clients.begin(); i != clients.end(); i++)
     {
       ClientInfo &info = (*i).second;
-      save_idlelog(info);
+
+      // All other intervals are already stored.
+      vector<IdleLogStore::Record> records;
+      for (IdleLogRIter j = info.idlelog.rbegin(); j != info.idlelog.rend(); j++)
+        {
+          if (j->to_be_saved)
+            {
+              records.push_back(to_record(*j));
+              j->to_be_saved = false;
+            }
+        }
+      store.append(info.client_id, records, current_time);
     }
+  store.flush();
 }
 
 //! Adds the specified idle interval to persistent storage.
 void
 IdleLogManager::update_idlelog(ClientInfo &info, const IdleInterval &idle)
 {
-  info.update_active_time(TimeSource::get_real_time_sec());
-
-  PacketBuffer buffer;
-  buffer.create();
-
-  pack_idle_interval(buffer, idle);
-
-  stringstream ss;
-  ss << AssetPath::get_home_directory();
-  ss << "idlelog." << info.client_id << ".log" << ends;
+  int64_t current_time = TimeSource::get_real_time_sec();
+  info.update_active_time(current_time);
 
-  ofstream file(ss.str().c_str(), ios::app | ios::binary);
-  file.write(buffer.get_buffer(), buffer.bytes_written());
-  file.close();
+  store.append(info.client_id, {to_record(idle)}, current_time);
+  store.flush();
 
   save_index();
 }
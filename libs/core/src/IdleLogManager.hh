@@ -23,8 +23,10 @@
 #include <string>
 #include <list>
 #include <map>
+#include <vector>
 
 #include "LocalActivityMonitor.hh"
+#include "IdleLogStore.hh"
 
 class PacketBuffer;
 
@@ -122,6 +124,12 @@ private:
   //! Last time we performed an expiration run.
   int64_t last_expiration_time{0};
 
+  //! Idle logs of all clients on disk.
+  IdleLogStore store;
+
+  //! Whether the index refers to the per-client log files of the previous version.
+  bool legacy_index{false};
+
 public:
   IdleLogManager(std::string myid);
 
@@ -152,10 +160,17 @@ private:
   void unpack_idlelog(PacketBuffer &buffer, ClientInfo &ci, int64_t &pack_time, int &num_intervals) const;
   void unlink_idlelog(PacketBuffer &buffer) const;
 
+  static IdleLogStore::Record to_record(const IdleInterval &idle);
+  static IdleInterval from_record(const IdleLogStore::Record &record);
+  std::vector<IdleLogStore::Record> to_records(const ClientInfo &info) const;
+  std::filesystem::path get_legacy_idlelog_path(const std::string &client_id) const;
+
   void save_index();
   void load_index();
   void save_idlelog(ClientInfo &info);
-  void load_idlelog(ClientInfo &info);
+  void load_idlelog(ClientInfo &info, const std::vector<IdleLogStore::Record> &records);
+  void load_legacy_idlelog(ClientInfo &info);
+  void migrate_idlelogs();
 
   void save();
   void load();
@@ -0,0 +1,521 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "IdleLogStore.hh"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(PLATFORM_OS_WINDOWS)
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+#include "utils/StateWriter.hh"
+
+using namespace workrave::utils;
+
+namespace
+{
+  constexpr char SEGMENT_MAGIC[4] = {'W', 'R', 'I', 'L'};
+  constexpr char INDEX_MAGIC[4] = {'W', 'R', 'I', 'X'};
+  constexpr uint32_t FORMAT_VERSION = 1;
+
+  struct SegmentHeader
+  {
+    char magic[4]{};
+    uint32_t version{0};
+    int64_t created{0};
+  };
+
+  struct IndexHeader
+  {
+    char magic[4]{};
+    uint32_t version{0};
+    uint32_t num_clients{0};
+  };
+
+  struct IndexEntry
+  {
+    uint32_t number{0};
+    uint32_t start_segment{0};
+    uint32_t start_record{0};
+    uint32_t id_length{0};
+  };
+
+  //! Read-only memory mapping of a file.
+  class MappedFile
+  {
+  public:
+    explicit MappedFile(const std::filesystem::path &path)
+    {
+#if defined(PLATFORM_OS_WINDOWS)
+      HANDLE file = CreateFileW(path.c_str(),
+                                GENERIC_READ,
+                                FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                nullptr,
+                                OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL,
+                                nullptr);
+      if (file == INVALID_HANDLE_VALUE)
+        {
+          return;
+        }
+
+      LARGE_INTEGER file_size;
+      if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0)
+        {
+          HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+          if (mapping != nullptr)
+            {
+              ptr = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+              length = ptr != nullptr ? static_cast<std::size_t>(file_size.QuadPart) : 0;
+              CloseHandle(mapping);
+            }
+        }
+      CloseHandle(file);
+#else
+      int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd == -1)
+        {
+          return;
+        }
+
+      struct stat st{};
+      if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+          void *addr = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+          if (addr != MAP_FAILED)
+            {
+              ptr = static_cast<const char *>(addr);
+              length = static_cast<std::size_t>(st.st_size);
+              madvise(addr, length, MADV_SEQUENTIAL);
+            }
+        }
+      ::close(fd);
+#endif
+    }
+
+    ~MappedFile()
+    {
+      if (ptr != nullptr)
+        {
+#if defined(PLATFORM_OS_WINDOWS)
+          UnmapViewOfFile(ptr);
+#else
+          munmap(const_cast<char *>(ptr), length);
+#endif
+        }
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const char *data() const
+    {
+      return ptr;
+    }
+
+    std::size_t size() const
+    {
+      return length;
+    }
+
+  private:
+    const char *ptr{nullptr};
+    std::size_t length{0};
+  };
+
+  template<typename T>
+  bool read_value(const std::string &data, std::size_t &pos, T &value)
+  {
+    if (data.size() - pos < sizeof(T))
+      {
+        return false;
+      }
+    std::memcpy(&value, data.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+  }
+
+  template<typename T>
+  void write_value(std::string &data, const T &value)
+  {
+    data.append(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+} // namespace
+
+IdleLogStore::IdleLogStore(std::filesystem::path directory, int64_t max_age)
+  : directory(std::move(directory))
+  , max_age(max_age)
+{
+}
+
+bool
+IdleLogStore::open(int64_t now)
+{
+  close();
+
+  clients.clear();
+  numbers.clear();
+  segments.clear();
+
+  std::error_code ec;
+  std::filesystem::create_directories(directory, ec);
+  if (ec)
+    {
+      return false;
+    }
+
+  load_index();
+  scan_segments();
+  expire(now);
+  return true;
+}
+
+void
+IdleLogStore::close()
+{
+  if (segment_file.is_open())
+    {
+      segment_file.close();
+    }
+}
+
+bool
+IdleLogStore::has_client(const std::string &client_id) const
+{
+  return numbers.find(client_id) != numbers.end();
+}
+
+void
+IdleLogStore::append(const std::string &client_id, const std::vector<Record> &records, int64_t now)
+{
+  if (records.empty())
+    {
+      return;
+    }
+
+  uint32_t number = get_client(client_id).number;
+  prepare_append(now, records.size());
+  write_records(number, records);
+}
+
+void
+IdleLogStore::replace(const std::string &client_id, const std::vector<Record> &records, int64_t now)
+{
+  uint32_t number = get_client(client_id).number;
+  prepare_append(now, records.size());
+
+  // Move the start before writing, so that a crash loses the new log rather than duplicating the old one.
+  Client &client = clients[number];
+  client.start_segment = segments.back().number;
+  client.start_record = segments.back().records;
+  save_index();
+
+  write_records(number, records);
+}
+
+void
+IdleLogStore::load(const std::function<void(const std::string &client_id, const std::vector<Record> &records)> &func)
+{
+  flush();
+
+  std::vector<std::vector<Record>> logs(clients.size());
+  for (const Segment &segment: segments)
+    {
+      MappedFile file(get_segment_path(segment.number));
+      if (file.size() < sizeof(SegmentHeader))
+        {
+          continue;
+        }
+
+      std::size_t count = std::min<std::size_t>(segment.records, (file.size() - sizeof(SegmentHeader)) / sizeof(Record));
+      const char *data = file.data() + sizeof(SegmentHeader);
+
+      for (std::size_t i = 0; i < count; i++)
+        {
+          Record record;
+          std::memcpy(&record, data + i * sizeof(Record), sizeof(Record));
+
+          if (record.client >= clients.size())
+            {
+              continue;
+            }
+
+          const Client &client = clients[record.client];
+          if (segment.number < client.start_segment || (segment.number == client.start_segment && i < client.start_record))
+            {
+              continue;
+            }
+
+          logs[record.client].push_back(record);
+        }
+    }
+
+  for (std::size_t i = 0; i < logs.size(); i++)
+    {
+      if (!logs[i].empty())
+        {
+          func(clients[i].client_id, logs[i]);
+        }
+    }
+}
+
+void
+IdleLogStore::flush()
+{
+  if (segment_file.is_open())
+    {
+      segment_file.flush();
+    }
+}
+
+std::size_t
+IdleLogStore::get_segment_count() const
+{
+  return segments.size();
+}
+
+std::filesystem::path
+IdleLogStore::get_segment_path(uint32_t number) const
+{
+  return directory / ("segment." + std::to_string(number));
+}
+
+std::filesystem::path
+IdleLogStore::get_index_path() const
+{
+  return directory / "index";
+}
+
+//! Loads the client numbers and log positions.
+bool
+IdleLogStore::load_index()
+{
+  std::ifstream file(get_index_path(), std::ios::binary);
+  if (!file)
+    {
+      return false;
+    }
+
+  std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  std::size_t pos = 0;
+  IndexHeader header;
+  if (!read_value(data, pos, header) || std::memcmp(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0
+      || header.version != FORMAT_VERSION)
+    {
+      return false;
+    }
+
+  for (uint32_t i = 0; i < header.num_clients; i++)
+    {
+      IndexEntry entry;
+      if (!read_value(data, pos, entry) || entry.number != i || data.size() - pos < entry.id_length)
+        {
+          clients.clear();
+          numbers.clear();
+          return false;
+        }
+
+      Client client;
+      client.client_id = data.substr(pos, entry.id_length);
+      client.number = entry.number;
+      client.start_segment = entry.start_segment;
+      client.start_record = entry.start_record;
+      pos += entry.id_length;
+
+      numbers[client.client_id] = client.number;
+      clients.push_back(client);
+    }
+  return true;
+}
+
+//! Saves the client numbers and log positions.
+void
+IdleLogStore::save_index()
+{
+  std::string data;
+
+  IndexHeader header;
+  std::memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+  header.version = FORMAT_VERSION;
+  header.num_clients = static_cast<uint32_t>(clients.size());
+  write_value(data, header);
+
+  for (const Client &client: clients)
+    {
+      IndexEntry entry;
+      entry.number = client.number;
+      entry.start_segment = client.start_segment;
+      entry.start_record = client.start_record;
+      entry.id_length = static_cast<uint32_t>(client.client_id.size());
+      write_value(data, entry);
+      data += client.client_id;
+    }
+
+  StateWriter::write_atomic(get_index_path(), data);
+}
+
+//! Finds all segments and drops incomplete records left behind by a crash.
+void
+IdleLogStore::scan_segments()
+{
+  static const std::string prefix = "segment.";
+
+  std::error_code ec;
+  for (const auto &entry: std::filesystem::directory_iterator(directory, ec))
+    {
+      std::string name = entry.path().filename().string();
+      if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0
+          || !std::all_of(name.begin() + prefix.size(), name.end(), [](char c) { return c >= '0' && c <= '9'; }))
+        {
+          continue;
+        }
+
+      std::ifstream file(entry.path(), std::ios::binary);
+      SegmentHeader header;
+      if (!file.read(reinterpret_cast<char *>(&header), sizeof(header))
+          || std::memcmp(header.magic, SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC)) != 0 || header.version != FORMAT_VERSION)
+        {
+          continue;
+        }
+      file.close();
+
+      uintmax_t size = std::filesystem::file_size(entry.path(), ec);
+      if (ec)
+        {
+          continue;
+        }
+
+      Segment segment;
+      segment.number = static_cast<uint32_t>(std::stoul(name.substr(prefix.size())));
+      segment.created = header.created;
+      segment.records = static_cast<uint32_t>((size - sizeof(SegmentHeader)) / sizeof(Record));
+
+      uintmax_t complete_size = sizeof(SegmentHeader) + segment.records * sizeof(Record);
+      if (size != complete_size)
+        {
+          std::filesystem::resize_file(entry.path(), complete_size, ec);
+        }
+
+      segments.push_back(segment);
+    }
+
+  std::sort(segments.begin(), segments.end(), [](const Segment &a, const Segment &b) { return a.number < b.number; });
+}
+
+//! Removes segments that only contain expired records.
+void
+IdleLogStore::expire(int64_t now)
+{
+  // All records in a segment were written before the next segment was started.
+  while (segments.size() > 1 && segments[1].created < now - max_age)
+    {
+      std::error_code ec;
+      std::filesystem::remove(get_segment_path(segments.front().number), ec);
+      segments.erase(segments.begin());
+    }
+}
+
+void
+IdleLogStore::start_segment(int64_t now)
+{
+  close();
+
+  uint32_t number = 1;
+  if (!segments.empty())
+    {
+      number = segments.back().number + 1;
+    }
+  for (const Client &client: clients)
+    {
+      number = std::max(number, client.start_segment + 1);
+    }
+
+  SegmentHeader header;
+  std::memcpy(header.magic, SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC));
+  header.version = FORMAT_VERSION;
+  header.created = now;
+
+  std::ofstream file(get_segment_path(number), std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.close();
+
+  Segment segment;
+  segment.number = number;
+  segment.created = now;
+  segments.push_back(segment);
+
+  expire(now);
+}
+
+//! Makes sure the current segment is open and can take the specified number of records.
+void
+IdleLogStore::prepare_append(int64_t now, std::size_t count)
+{
+  if (segments.empty() || segments.back().created < now - max_age / 2
+      || (segments.back().records > 0 && segments.back().records + count > SEGMENT_MAX_RECORDS))
+    {
+      start_segment(now);
+    }
+
+  if (!segment_file.is_open())
+    {
+      segment_file.open(get_segment_path(segments.back().number), std::ios::binary | std::ios::app);
+    }
+}
+
+void
+IdleLogStore::write_records(uint32_t number, const std::vector<Record> &records)
+{
+  for (Record record: records)
+    {
+      record.client = number;
+      segment_file.write(reinterpret_cast<const char *>(&record), sizeof(record));
+    }
+  segments.back().records += static_cast<uint32_t>(records.size());
+}
+
+IdleLogStore::Client &
+IdleLogStore::get_client(const std::string &client_id)
+{
+  auto it = numbers.find(client_id);
+  if (it != numbers.end())
+    {
+      return clients[it->second];
+    }
+
+  Client client;
+  client.client_id = client_id;
+  client.number = static_cast<uint32_t>(clients.size());
+
+  numbers[client_id] = client.number;
+  clients.push_back(client);
+  save_index();
+
+  return clients.back();
+}
@@ -0,0 +1,135 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef IDLELOGSTORE_HH
+#define IDLELOGSTORE_HH
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+//! Append-only storage of the idle logs of all clients.
+/*!
+ *  Idle intervals of all clients are appended as fixed-size records to
+ *  a sequence of segment files in a single directory. A small index
+ *  maps each client to a number, and records where the current log of
+ *  the client starts. Replacing the log of a client appends the new log
+ *  and moves its start; nothing is ever rewritten.
+ *
+ *  A new segment is started periodically. A segment is deleted once the
+ *  segment after it was started more than max_age ago, at which point
+ *  all of its records have expired.
+ *
+ *  Segments are memory mapped for reading. All times are in seconds.
+ */
+class IdleLogStore
+{
+public:
+  //! A single idle interval, as stored on disk.
+  struct Record
+  {
+    int64_t begin_time{0};
+    int64_t end_idle_time{0};
+    int64_t end_time{0};
+    uint32_t active_time{0};
+
+    //! Number of the client in the index.
+    uint32_t client{0};
+  };
+
+  static_assert(sizeof(Record) == 32, "idle log records must have a fixed size");
+
+  //! Maximum number of records in a segment.
+  static constexpr uint32_t SEGMENT_MAX_RECORDS = 65536;
+
+  IdleLogStore(std::filesystem::path directory, int64_t max_age);
+
+  //! Opens the store, creating it if needed, and removes expired segments.
+  bool open(int64_t now);
+
+  //! Closes the store.
+  void close();
+
+  //! Returns whether the store contains a log of the specified client.
+  bool has_client(const std::string &client_id) const;
+
+  //! Appends records to the log of the specified client.
+  void append(const std::string &client_id, const std::vector<Record> &records, int64_t now);
+
+  //! Replaces the log of the specified client.
+  void replace(const std::string &client_id, const std::vector<Record> &records, int64_t now);
+
+  //! Calls func with the current log of each client, oldest record first.
+  void load(const std::function<void(const std::string &client_id, const std::vector<Record> &records)> &func);
+
+  //! Writes appended records to disk.
+  void flush();
+
+  //! Returns the number of segment files.
+  std::size_t get_segment_count() const;
+
+private:
+  struct Client
+  {
+    std::string client_id;
+    uint32_t number{0};
+
+    //! Position of the first record of the current log.
+    uint32_t start_segment{0};
+    uint32_t start_record{0};
+  };
+
+  struct Segment
+  {
+    uint32_t number{0};
+    int64_t created{0};
+    uint32_t records{0};
+  };
+
+  std::filesystem::path get_segment_path(uint32_t number) const;
+  std::filesystem::path get_index_path() const;
+
+  bool load_index();
+  void save_index();
+  void scan_segments();
+  void expire(int64_t now);
+  void start_segment(int64_t now);
+  void prepare_append(int64_t now, std::size_t count);
+  void write_records(uint32_t number, const std::vector<Record> &records);
+  Client &get_client(const std::string &client_id);
+
+private:
+  std::filesystem::path directory;
+  int64_t max_age;
+
+  //! Clients by number.
+  std::vector<Client> clients;
+
+  //! Client numbers by ID.
+  std::map<std::string, uint32_t> numbers;
+
+  //! Segments, oldest first. The last one receives new records.
+  std::vector<Segment> segments;
+
+  std::ofstream segment_file;
+};
+
+#endif // IDLELOGSTORE_HH
@@ -0,0 +1,148 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "PeerHealth.hh"
+
+#include <algorithm>
+#include <cmath>
+
+PeerHealth::PeerHealth(uint32_t seed)
+  : random(seed)
+{
+}
+
+void
+PeerHealth::packet_received(int64_t now)
+{
+  if (last_received != 0 && now > last_received)
+    {
+      int64_t interval = now - last_received;
+
+      if (num_intervals == WINDOW_SIZE)
+        {
+          int64_t old = intervals[next_interval];
+          interval_sum -= static_cast<double>(old);
+          interval_square_sum -= static_cast<double>(old) * static_cast<double>(old);
+        }
+      else
+        {
+          num_intervals++;
+        }
+
+      intervals[next_interval] = interval;
+      next_interval = (next_interval + 1) % WINDOW_SIZE;
+
+      interval_sum += static_cast<double>(interval);
+      interval_square_sum += static_cast<double>(interval) * static_cast<double>(interval);
+    }
+  last_received = now;
+}
+
+void
+PeerHealth::packet_sent(int64_t now)
+{
+  last_sent = now;
+}
+
+bool
+PeerHealth::is_monitored() const
+{
+  return monitored;
+}
+
+void
+PeerHealth::set_monitored(bool monitored)
+{
+  this->monitored = monitored;
+}
+
+double
+PeerHealth::get_phi(int64_t now) const
+{
+  if (last_received == 0)
+    {
+      return 0.0;
+    }
+
+  // Until enough samples are collected, assume the peer sends keepalives.
+  double mean = static_cast<double>(KEEPALIVE_INTERVAL);
+  double variance = 0.0;
+  if (num_intervals > 0)
+    {
+      mean = interval_sum / static_cast<double>(num_intervals);
+      variance = std::max(0.0, interval_square_sum / static_cast<double>(num_intervals) - mean * mean);
+    }
+
+  double std_deviation = std::max(std::sqrt(variance), static_cast<double>(MIN_STD_DEVIATION));
+  mean += static_cast<double>(ACCEPTABLE_PAUSE);
+
+  // Logistic approximation of the cumulative normal distribution.
+  double elapsed = static_cast<double>(now - last_received);
+  double y = (elapsed - mean) / std_deviation;
+  double e = std::exp(-y * (1.5976 + 0.070566 * y * y));
+
+  if (elapsed > mean)
+    {
+      return -std::log10(e / (1.0 + e));
+    }
+  return -std::log10(1.0 - 1.0 / (1.0 + e));
+}
+
+bool
+PeerHealth::is_suspected(int64_t now) const
+{
+  return monitored && get_phi(now) > PHI_THRESHOLD;
+}
+
+bool
+PeerHealth::needs_keepalive(int64_t now) const
+{
+  return now - last_sent >= KEEPALIVE_INTERVAL;
+}
+
+int64_t
+PeerHealth::next_reconnect_delay()
+{
+  int64_t delay = BACKOFF_MIN << std::min(backoff_count, 7);
+  delay = std::min(delay, BACKOFF_MAX);
+  backoff_count++;
+
+  // Equal jitter: half fixed, half random.
+  std::uniform_int_distribution<int64_t> jitter(0, delay / 2);
+  return delay / 2 + jitter(random);
+}
+
+void
+PeerHealth::reset_backoff()
+{
+  backoff_count = 0;
+}
+
+void
+PeerHealth::reset(int64_t now)
+{
+  num_intervals = 0;
+  next_interval = 0;
+  interval_sum = 0;
+  interval_square_sum = 0;
+  last_received = now;
+  last_sent = now;
+}
@@ -0,0 +1,115 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef PEERHEALTH_HH
+#define PEERHEALTH_HH
+
+#include <array>
+#include <cstdint>
+#include <random>
+
+//! Liveness bookkeeping for a single peer.
+/*!
+ *  Failure detection uses the phi accrual detector: the inter-arrival
+ *  times of packets from the peer are modelled as a normal distribution,
+ *  and phi expresses how unlikely the current silence is. Any packet
+ *  counts as a sign of life, so keepalives are only needed when nothing
+ *  else was sent for a while.
+ *
+ *  Reconnects back off exponentially with random jitter, so that peers
+ *  that lost the same link do not retry in lockstep.
+ *
+ *  All times are in microseconds.
+ */
+class PeerHealth
+{
+public:
+  static constexpr int64_t USEC_PER_SEC = 1000000;
+
+  //! Interval after which a keepalive is sent if nothing else was.
+  static constexpr int64_t KEEPALIVE_INTERVAL = 5 * USEC_PER_SEC;
+
+  //! Phi above which a peer is suspected to have failed.
+  static constexpr double PHI_THRESHOLD = 8.0;
+
+  //! Lower bound of the standard deviation, to avoid a hair trigger on a very regular peer.
+  static constexpr int64_t MIN_STD_DEVIATION = USEC_PER_SEC / 2;
+
+  //! Extra silence tolerated on top of the expected interval, e.g. for a busy network.
+  static constexpr int64_t ACCEPTABLE_PAUSE = 2 * USEC_PER_SEC;
+
+  static constexpr int64_t BACKOFF_MIN = 1 * USEC_PER_SEC;
+  static constexpr int64_t BACKOFF_MAX = 120 * USEC_PER_SEC;
+
+  explicit PeerHealth(uint32_t seed = std::random_device()());
+
+  //! Records that a packet was received from the peer.
+  void packet_received(int64_t now);
+
+  //! Records that a packet was sent to the peer.
+  void packet_sent(int64_t now);
+
+  //! Returns whether the peer is known to send keepalives.
+  /*! Older peers do not, so they must not be judged by their silence. */
+  bool is_monitored() const;
+  void set_monitored(bool monitored);
+
+  //! Returns the suspicion level of the peer.
+  double get_phi(int64_t now) const;
+
+  //! Returns whether the peer is suspected to have failed.
+  bool is_suspected(int64_t now) const;
+
+  //! Returns whether a keepalive must be sent to the peer.
+  bool needs_keepalive(int64_t now) const;
+
+  //! Returns the delay until the next reconnect attempt and backs off further.
+  int64_t next_reconnect_delay();
+
+  //! Resets the reconnect backoff after a successful connect.
+  void reset_backoff();
+
+  //! Forgets all history, e.g. after a reconnect.
+  void reset(int64_t now);
+
+private:
+  static constexpr std::size_t WINDOW_SIZE = 64;
+
+  //! Recent inter-arrival times.
+  std::array<int64_t, WINDOW_SIZE> intervals{};
+
+  //! Number of valid entries in intervals.
+  std::size_t num_intervals{0};
+
+  //! Position of the next entry in intervals.
+  std::size_t next_interval{0};
+
+  //! Running sums of the intervals in the window.
+  double interval_sum{0};
+  double interval_square_sum{0};
+
+  int64_t last_received{0};
+  int64_t last_sent{0};
+  bool monitored{false};
+
+  //! Number of consecutive reconnect attempts.
+  int backoff_count{0};
+
+  std::mt19937 random;
+};
+
+#endif // PEERHEALTH_HH
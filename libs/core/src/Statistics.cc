@@ -37,7 +37,9 @@
 #include "Core.hh"
 #include "Timer.hh"
 
+#include "utils/Calendar.hh"
 #include "utils/Paths.hh"
+#include "utils/StateWriter.hh"
 #include "input-monitor/InputMonitorFactory.hh"
 #include "input-monitor/IInputMonitor.hh"
 
@@ -56,11 +58,7 @@ using namespace workrave::utils;
 Statistics::~Statistics()
 {
   update();
-
-  for (auto &item: history)
-    {
-      delete item;
-    }
+  StateWriter::instance().flush();
 
   delete current_day;
 
@@ -107,11 +105,10 @@ Statistics::update()
 
   if (state == ACTIVITY_ACTIVE && !been_active)
     {
-      const time_t now = time(nullptr);
-      struct tm *tmnow = localtime(&now);
+      struct tm tmnow = Calendar::to_local(time(nullptr));
 
-      current_day->start = *tmnow;
-      current_day->stop = *tmnow;
+      current_day->start = tmnow;
+      current_day->stop = tmnow;
 
       been_active = true;
     }
@@ -133,9 +130,6 @@ Statistics::delete_all_history()
     }
   else
     {
-      for (vector<DailyStatsImpl *>::iterator i = history.begin(); (i != history.end()); delete *i++)
-        ;
-
       history.clear();
     }
 
@@ -162,11 +156,10 @@ void
 Statistics::start_new_day()
 {
   TRACE_ENTER("Statistics::start_new_day");
-  const time_t now = time(nullptr);
-  struct tm *tmnow = localtime(&now);
+  struct tm tmnow = Calendar::to_local(time(nullptr));
 
-  if (current_day == nullptr || tmnow->tm_mday != current_day->start.tm_mday || tmnow->tm_mon != current_day->start.tm_mon
-      || tmnow->tm_year != current_day->start.tm_year)
+  if (current_day == nullptr || tmnow.tm_mday != current_day->start.tm_mday || tmnow.tm_mon != current_day->start.tm_mon
+      || tmnow.tm_year != current_day->start.tm_year)
     {
       TRACE_MSG("New day");
       if (current_day != nullptr)
@@ -174,13 +167,14 @@ Statistics::start_new_day()
           TRACE_MSG("Save old day");
           day_to_history(current_day);
           day_to_remote_history(current_day);
+          delete current_day;
         }
 
       current_day = new DailyStatsImpl();
       been_active = false;
 
-      current_day->start = *tmnow;
-      current_day->stop = *tmnow;
+      current_day->start = tmnow;
+      current_day->stop = tmnow;
     }
 
   update_current_day(false);
@@ -190,7 +184,7 @@ Statistics::start_new_day()
 }
 
 void
-Statistics::day_to_history(DailyStatsImpl *stats)
+Statistics::day_to_history(const DailyStatsImpl *stats)
 {
   add_history(stats);
 
@@ -233,7 +227,7 @@ Statistics::day_to_remote_history(DailyStatsImpl *stats)
 
 //! Saves the current day to the specified stream.
 void
-Statistics::save_day(DailyStatsImpl *stats, ofstream &stats_file)
+Statistics::save_day(const DailyStatsImpl *stats, ostream &stats_file)
 {
   stats_file << "D " << stats->start.tm_mday << " " << stats->start.tm_mon << " " << stats->start.tm_year << " " << stats->start.tm_hour
              << " " << stats->start.tm_min << " " << stats->stop.tm_mday << " " << stats->stop.tm_mon << " " << stats->stop.tm_year << " "
@@ -241,7 +235,7 @@ Statistics::save_day(DailyStatsImpl *stats, ofstream &stats_file)
 
   for (int i = 0; i < BREAK_ID_SIZEOF; i++)
     {
-      BreakStats &bs = stats->break_stats[i];
+      const BreakStats &bs = stats->break_stats[i];
 
       stats_file << "B " << i << " " << STATS_BREAKVALUE_SIZEOF << " ";
       for (int j = 0; j < STATS_BREAKVALUE_SIZEOF; j++)
@@ -257,71 +251,32 @@ Statistics::save_day(DailyStatsImpl *stats, ofstream &stats_file)
       stats_file << stats->misc_stats[j] << " ";
     }
   stats_file << endl;
-
-  stats_file.close();
 }
 
 //! Saves the statistics of the specified day.
 void
 Statistics::save_day(DailyStatsImpl *stats)
 {
-  std::filesystem::path path = Paths::get_state_directory() / "todaystats";
-  ofstream stats_file(path.u8string());
+  if (today_path.empty())
+    {
+      today_path = Paths::get_state_directory() / "todaystats";
+    }
 
-  stats_file << WORKRAVESTATS << " " << STATSVERSION << endl;
+  today_stream.reset();
+  today_stream << WORKRAVESTATS << " " << STATSVERSION << endl;
 
-  save_day(stats, stats_file);
+  save_day(stats, today_stream);
+
+  StateWriter::instance().write(today_path, today_stream.str());
 }
 
 //! Add the stats the the history list.
 void
-Statistics::add_history(DailyStatsImpl *stats)
+Statistics::add_history(const DailyStatsImpl *stats)
 {
-  if (history.size() == 0)
-    {
-      history.push_back(stats);
-    }
-  else
-    {
-      bool found = false;
-      auto i = history.rbegin();
-      while (i != history.rend())
-        {
-          DailyStatsImpl *ref = *i;
-
-          if (stats->start.tm_year == ref->start.tm_year && stats->start.tm_mon == ref->start.tm_mon
-              && stats->start.tm_mday == ref->start.tm_mday)
-            {
-              delete *i;
-              *i = stats;
-              found = true;
-              break;
-            }
-
-          else if (stats->start.tm_year > ref->start.tm_year
-                   || (stats->start.tm_year == ref->start.tm_year
-                       && (stats->start.tm_mon > ref->start.tm_mon
-                           || (stats->start.tm_mon == ref->start.tm_mon && stats->start.tm_mday > ref->start.tm_mday))))
-            {
-              if (i == history.rbegin())
-                {
-                  history.push_back(stats);
-                }
-              else
-                {
-                  history.insert(i.base(), stats);
-                }
-              found = true;
-              break;
-            }
-          i++;
-        }
-
-      if (!found)
-        {
-          history.insert(history.begin(), stats);
-        }
-    }
+  int64_t fields[DailyStatsView::FIELD_SIZEOF];
+  int32_t day = DailyStatsView::encode(*stats, fields);
+  history.put(day, fields);
 }
 
 //! Load the statistics of the current day.
@@ -351,6 +306,7 @@ Statistics::load_history()
   ifstream stats_file(path.u8string());
 
   load(stats_file, true);
+  history.shrink_to_fit();
   TRACE_EXIT();
 }
 
@@ -397,6 +353,7 @@ Statistics::load(ifstream &infile, bool history)
               if (history && stats != nullptr)
                 {
                   add_history(stats);
+                  delete stats;
                   stats = nullptr;
                 }
               else if (!history && stats != nullptr)
@@ -478,6 +435,7 @@ Statistics::load(ifstream &infile, bool history)
   if (history && stats != nullptr)
     {
       add_history(stats);
+      delete stats;
     }
 
   TRACE_EXIT();
@@ -571,34 +529,29 @@ Statistics::get_current_day() const
   return current_day;
 }
 
-Statistics::DailyStatsImpl *
+IStatistics::DailyStatsView
 Statistics::get_day(int day) const
 {
-  DailyStatsImpl *ret = nullptr;
-
   if (day == 0)
     {
-      ret = current_day;
+      return DailyStatsView(current_day);
+    }
+
+  if (day > 0)
+    {
+      day = history.size() - day;
     }
   else
     {
-      if (day > 0)
-        {
-          day = history.size() - day;
-        }
-      else
-        {
-          day = -day;
-          day--;
-        }
-
-      if (day < int(history.size()) && day >= 0)
-        {
-          ret = history[day];
-        }
+      day = -day;
+      day--;
     }
 
-  return ret;
+  if (day < int(history.size()) && day >= 0)
+    {
+      return DailyStatsView(&history, day);
+    }
+  return DailyStatsView();
 }
 
 void
@@ -609,12 +562,12 @@ Statistics::get_day_index_by_date(int y, int m, int d, int &idx, int &next, int
   for (int i = 0; i <= int(history.size()); i++)
     {
       int j = history.size() - i;
-      DailyStatsImpl *stats = j == 0 ? current_day : history[i];
-      if (idx < 0 && stats->starts_at_date(y, m, d))
+      DailyStatsView stats = j == 0 ? DailyStatsView(current_day) : DailyStatsView(&history, i);
+      if (idx < 0 && stats.starts_at_date(y, m, d))
         {
           idx = j;
         }
-      else if (stats->starts_before_date(y, m, d))
+      else if (stats.starts_before_date(y, m, d))
         {
           prev = j;
         }
@@ -624,11 +577,12 @@ Statistics::get_day_index_by_date(int y, int m, int d, int &idx, int &next, int
         }
     }
 
-  if (prev < 0 && current_day->starts_before_date(y, m, d))
+  DailyStatsView today(current_day);
+  if (prev < 0 && today.starts_before_date(y, m, d))
     {
       prev = 0;
     }
-  if (next < 0 && !current_day->starts_at_date(y, m, d) && !current_day->starts_before_date(y, m, d))
+  if (next < 0 && !today.starts_at_date(y, m, d) && !today.starts_before_date(y, m, d))
     {
       next = 0;
     }
@@ -641,6 +595,17 @@ Statistics::get_history_size() const
   return history.size();
 }
 
+int32_t
+Statistics::get_range(int32_t from,
+                      int32_t to,
+                      const std::vector<int> &fields,
+                      int max_days,
+                      std::vector<int32_t> &days,
+                      std::vector<int64_t> &values) const
+{
+  return collect_range(history, current_day, from, to, fields, max_days, days, values);
+}
+
 void
 Statistics::update_current_day(bool active)
 {
@@ -653,9 +618,7 @@ Statistics::update_current_day(bool active)
 
       if (active)
         {
-          const time_t now = time(nullptr);
-          struct tm *tmnow = localtime(&now);
-          current_day->stop = *tmnow;
+          current_day->stop = Calendar::to_local(time(nullptr));
         }
 
       for (int i = 0; i < BREAK_ID_SIZEOF; i++)
@@ -860,6 +823,7 @@ Statistics::client_message(DistributionClientMessageID id, bool master, const ch
             {
               TRACE_MSG("Save to history");
               day_to_history(stats);
+              delete stats;
               stats_to_history = false;
             }
           break;
@@ -879,6 +843,7 @@ Statistics::client_message(DistributionClientMessageID id, bool master, const ch
       // this should not happened. but just to avoid a potential memory leak...
       TRACE_MSG("Save to history");
       day_to_history(stats);
+      delete stats;
       stats_to_history = false;
     }
 
@@ -890,19 +855,6 @@ Statistics::client_message(DistributionClientMessageID id, bool master, const ch
 
 #endif
 
-bool
-Statistics::DailyStatsImpl::starts_at_date(int y, int m, int d)
-{
-  return (start.tm_year + 1900 == y && start.tm_mon + 1 == m && start.tm_mday == d);
-}
-
-bool
-Statistics::DailyStatsImpl::starts_before_date(int y, int m, int d)
-{
-  return (start.tm_year + 1900 < y
-          || (start.tm_year + 1900 == y && (start.tm_mon + 1 < m || (start.tm_mon + 1 == m && start.tm_mday < d))));
-}
-
 //! Activity is reported by the input monitor.
 void
 Statistics::action_notify()
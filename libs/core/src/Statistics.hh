@@ -26,11 +26,14 @@
 
 #include <iostream>
 #include <fstream>
+#include <filesystem>
 #include <vector>
 #include <ctime>
 #include <cstring>
 
 #include "core/IStatistics.hh"
+#include "utils/RecordArena.hh"
+#include "utils/StringOutputStream.hh"
 #include "input-monitor/IInputMonitor.hh"
 #include "input-monitor/IInputMonitorListener.hh"
 #include "core/IStatistics.hh"
@@ -97,18 +100,12 @@ private:
       start.tm_year = 0;
     }
 
-    bool starts_at_date(int y, int m, int d);
-    bool starts_before_date(int y, int m, int d);
     bool is_empty() const
     {
       return start.tm_year == 0;
     }
   };
 
-  typedef std::vector<DailyStatsImpl *> History;
-  typedef std::vector<DailyStatsImpl *>::iterator HistoryIter;
-  typedef std::vector<DailyStatsImpl *>::reverse_iterator HistoryRIter;
-
 public:
   Statistics() = default;
   ~Statistics() override;
@@ -126,10 +123,16 @@ public:
   void add_break_counter(workrave::BreakId bt, StatsBreakValueType st, int value);
 
   DailyStatsImpl *get_current_day() const override;
-  DailyStatsImpl *get_day(int day) const override;
+  DailyStatsView get_day(int day) const override;
   void get_day_index_by_date(int y, int m, int d, int &idx, int &next, int &prev) const override;
 
   int get_history_size() const override;
+  int32_t get_range(int32_t from,
+                    int32_t to,
+                    const std::vector<int> &fields,
+                    int max_days,
+                    std::vector<int32_t> &days,
+                    std::vector<int64_t> &values) const override;
   void set_counter(StatsValueType t, int value);
   int64_t get_counter(StatsValueType t);
 
@@ -145,13 +148,13 @@ private:
 
 private:
   void save_day(DailyStatsImpl *stats);
-  void save_day(DailyStatsImpl *stats, std::ofstream &stats_file);
+  void save_day(const DailyStatsImpl *stats, std::ostream &stats_file);
   void load(std::ifstream &infile, bool history);
 
-  void day_to_history(DailyStatsImpl *stats);
+  void day_to_history(const DailyStatsImpl *stats);
   void day_to_remote_history(DailyStatsImpl *stats);
 
-  void add_history(DailyStatsImpl *stats);
+  void add_history(const DailyStatsImpl *stats);
 
 #ifdef HAVE_DISTRIBUTION
   void init_distribution_manager();
@@ -176,8 +179,14 @@ private:
   //! Has the user been active on the current day?
   bool been_active{false};
 
-  //! History
-  History history;
+  //! History, one record per day, sorted by date.
+  workrave::utils::RecordArena history{DailyStatsView::FIELD_SIZEOF};
+
+  //! Location of the statistics of the current day, resolved on the first save.
+  std::filesystem::path today_path;
+
+  //! Snapshot of the statistics of the current day, reused on every save.
+  workrave::utils::StringOutputStream today_stream;
 
   //! Internal locking
   std::mutex lock;
@@ -822,40 +822,47 @@ Timer::serialize_state() const
 bool
 Timer::deserialize_state(const std::string &state, int version)
 {
-  TRACE_ENTER("Timer::deserialize_state");
   istringstream ss(state);
 
-  int64_t saveTime = 0;
-  int64_t elapsed = 0;
-  int64_t lastReset = 0;
-  int64_t overdue = 0;
-  int64_t now = TimeSource::get_real_time_sec_sync();
-  int64_t llt = 0;
-  int64_t lle = 0;
+  TimerStateData data{};
   int64_t tz = 0;
-  bool si = false;
 
-  ss >> saveTime >> elapsed >> lastReset >> overdue >> si >> llt >> lle;
+  ss >> data.current_time >> data.elapsed_time >> data.last_pred_reset_time >> data.total_overdue_time >> data.snooze_inhibited
+    >> data.last_limit_time >> data.last_limit_elapsed;
 
   if (version == 3)
     {
+      // Ignored.
       ss >> tz;
-      tz -= timezone;
     }
 
+  return deserialize_state(data);
+}
+
+//! Restores the timer from a saved state.
+/*!
+ *  \param data the saved state. data.current_time is the time at which the state was saved.
+ */
+bool
+Timer::deserialize_state(const TimerStateData &data)
+{
+  TRACE_ENTER("Timer::deserialize_state");
+
+  int64_t saveTime = data.current_time;
+  int64_t lastReset = data.last_pred_reset_time;
+  int64_t now = TimeSource::get_real_time_sec_sync();
+
   // Sanity check...
   if (lastReset > saveTime)
     {
       lastReset = saveTime;
     }
 
-  // lastReset -= tz;
-
-  TRACE_MSG(si << " " << llt << " " << lle);
+  TRACE_MSG(data.snooze_inhibited << " " << data.last_limit_time << " " << data.last_limit_elapsed);
   TRACE_MSG(snooze_inhibited);
 
   last_pred_reset_time = lastReset;
-  total_overdue_time = overdue;
+  total_overdue_time = data.total_overdue_time;
   elapsed_time = 0;
   last_start_time = 0;
   last_stop_time = 0;
@@ -868,15 +875,15 @@ Timer::deserialize_state(const std::string &state, int version)
         {
           next_reset_time = now + autoreset_interval;
         }
-      elapsed_time = elapsed;
-      snooze_inhibited = si;
+      elapsed_time = data.elapsed_time;
+      snooze_inhibited = data.snooze_inhibited;
     }
 
   // overdue, so snooze
   if (limit_enabled && get_elapsed_time() >= limit_interval)
     {
-      last_limit_time = llt;
-      last_limit_elapsed = lle;
+      last_limit_time = data.last_limit_time;
+      last_limit_elapsed = data.last_limit_elapsed;
 
       compute_next_limit_time();
     }
@@ -884,6 +891,7 @@ Timer::deserialize_state(const std::string &state, int version)
   compute_next_predicate_reset_time();
 
   TRACE_MSG("elapsed = " << elapsed_time);
+  TRACE_EXIT();
   return true;
 }
 
@@ -991,7 +999,7 @@ Timer::set_state_data(const TimerStateData &data)
 }
 
 void
-Timer::get_state_data(TimerStateData &data)
+Timer::get_state_data(TimerStateData &data) const
 {
   TRACE_ENTER("Timer::get_state_data");
   data.current_time = TimeSource::get_real_time_sec_sync();
@@ -175,10 +175,11 @@ public:
   // State serialization.
   std::string serialize_state() const;
   bool deserialize_state(const std::string &state, int version);
+  bool deserialize_state(const TimerStateData &data);
   void set_state(int elapsed, int idle, int overdue = -1);
 
   void set_state_data(const TimerStateData &data);
-  void get_state_data(TimerStateData &data);
+  void get_state_data(TimerStateData &data) const;
   void set_values(int64_t elapsed, int64_t idle);
 
   // Misc
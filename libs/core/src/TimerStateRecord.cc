@@ -0,0 +1,177 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "TimerStateRecord.hh"
+
+#include <array>
+
+using namespace workrave;
+
+namespace
+{
+  constexpr uint8_t MAGIC[4] = {'W', 'R', 'T', 'S'};
+  constexpr size_t CRC_OFFSET = TimerStateRecord::SIZE - 4;
+  constexpr uint8_t FLAG_SNOOZE_INHIBITED = 0x01;
+
+  constexpr std::array<uint32_t, 256> make_crc_table()
+  {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; i++)
+      {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++)
+          {
+            c = (c & 1) ? (0xedb88320U ^ (c >> 1)) : (c >> 1);
+          }
+        table[i] = c;
+      }
+    return table;
+  }
+
+  constexpr std::array<uint32_t, 256> crc_table = make_crc_table();
+
+  void put_u16(uint8_t *p, uint16_t v)
+  {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+  }
+
+  void put_u32(uint8_t *p, uint32_t v)
+  {
+    for (int i = 0; i < 4; i++)
+      {
+        p[i] = static_cast<uint8_t>(v >> (8 * i));
+      }
+  }
+
+  void put_i64(uint8_t *p, int64_t v)
+  {
+    auto u = static_cast<uint64_t>(v);
+    for (int i = 0; i < 8; i++)
+      {
+        p[i] = static_cast<uint8_t>(u >> (8 * i));
+      }
+  }
+
+  uint16_t get_u16(const uint8_t *p)
+  {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+  }
+
+  uint32_t get_u32(const uint8_t *p)
+  {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++)
+      {
+        v |= static_cast<uint32_t>(p[i]) << (8 * i);
+      }
+    return v;
+  }
+
+  int64_t get_i64(const uint8_t *p)
+  {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++)
+      {
+        v |= static_cast<uint64_t>(p[i]) << (8 * i);
+      }
+    return static_cast<int64_t>(v);
+  }
+} // namespace
+
+uint32_t
+TimerStateRecord::crc32(const uint8_t *data, size_t size)
+{
+  uint32_t c = 0xffffffffU;
+  for (size_t i = 0; i < size; i++)
+    {
+      c = crc_table[(c ^ data[i]) & 0xff] ^ (c >> 8);
+    }
+  return c ^ 0xffffffffU;
+}
+
+void
+TimerStateRecord::encode(BreakId break_id, const Timer::TimerStateData &data, uint8_t *buffer)
+{
+  for (int i = 0; i < 4; i++)
+    {
+      buffer[i] = MAGIC[i];
+    }
+  put_u16(buffer + 4, VERSION);
+  put_u16(buffer + 6, SIZE);
+  buffer[8] = static_cast<uint8_t>(break_id);
+  buffer[9] = data.snooze_inhibited ? FLAG_SNOOZE_INHIBITED : 0;
+  put_u16(buffer + 10, 0);
+
+  put_i64(buffer + 12, data.current_time);
+  put_i64(buffer + 20, data.elapsed_time);
+  put_i64(buffer + 28, data.elapsed_idle_time);
+  put_i64(buffer + 36, data.last_pred_reset_time);
+  put_i64(buffer + 44, data.total_overdue_time);
+  put_i64(buffer + 52, data.last_limit_time);
+  put_i64(buffer + 60, data.last_limit_elapsed);
+
+  put_u32(buffer + CRC_OFFSET, crc32(buffer, CRC_OFFSET));
+}
+
+bool
+TimerStateRecord::decode(const uint8_t *buffer, size_t size, BreakId &break_id, Timer::TimerStateData &data)
+{
+  if (size < SIZE)
+    {
+      return false;
+    }
+
+  for (int i = 0; i < 4; i++)
+    {
+      if (buffer[i] != MAGIC[i])
+        {
+          return false;
+        }
+    }
+
+  if (get_u16(buffer + 4) != VERSION || get_u16(buffer + 6) != SIZE)
+    {
+      return false;
+    }
+
+  if (get_u32(buffer + CRC_OFFSET) != crc32(buffer, CRC_OFFSET))
+    {
+      return false;
+    }
+
+  int id = buffer[8];
+  if (id >= BREAK_ID_SIZEOF)
+    {
+      return false;
+    }
+
+  break_id = static_cast<BreakId>(id);
+  data.snooze_inhibited = (buffer[9] & FLAG_SNOOZE_INHIBITED) != 0;
+  data.current_time = get_i64(buffer + 12);
+  data.elapsed_time = get_i64(buffer + 20);
+  data.elapsed_idle_time = get_i64(buffer + 28);
+  data.last_pred_reset_time = get_i64(buffer + 36);
+  data.total_overdue_time = get_i64(buffer + 44);
+  data.last_limit_time = get_i64(buffer + 52);
+  data.last_limit_elapsed = get_i64(buffer + 60);
+  return true;
+}
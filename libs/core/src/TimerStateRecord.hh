@@ -0,0 +1,65 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef TIMERSTATERECORD_HH
+#define TIMERSTATERECORD_HH
+
+#include <cstdint>
+#include <cstddef>
+
+#include "core/CoreTypes.hh"
+#include "Timer.hh"
+
+//! Binary record of the state of a timer.
+/*!
+ *  The record has a fixed size and layout. All fields are stored in
+ *  little-endian byte order and the record ends with a CRC-32 of the
+ *  preceding bytes. The same record is used in the state file and in the
+ *  DCM_TIMERS distribution packet.
+ *
+ *  Offset  Size  Field
+ *       0     4  magic "WRTS"
+ *       4     2  record version
+ *       6     2  record size
+ *       8     1  break id
+ *       9     1  flags (bit 0: snooze inhibited)
+ *      10     2  reserved
+ *      12     8  current time
+ *      20     8  elapsed time
+ *      28     8  elapsed idle time
+ *      36     8  last predicate reset time
+ *      44     8  total overdue time
+ *      52     8  last limit time
+ *      60     8  last limit elapsed
+ *      68     4  CRC-32
+ */
+class TimerStateRecord
+{
+public:
+  static constexpr uint16_t VERSION = 1;
+  static constexpr size_t SIZE = 72;
+
+  //! Encodes the timer state into buffer, which must hold at least SIZE bytes.
+  static void encode(workrave::BreakId break_id, const Timer::TimerStateData &data, uint8_t *buffer);
+
+  //! Decodes a timer state. Returns false if the record is truncated, corrupt or of an unknown version.
+  static bool decode(const uint8_t *buffer, size_t size, workrave::BreakId &break_id, Timer::TimerStateData &data);
+
+  static uint32_t crc32(const uint8_t *data, size_t size);
+};
+
+#endif // TIMERSTATERECORD_HH
@@ -0,0 +1,201 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#define BOOST_TEST_MODULE workrave_external_activity
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <map>
+#include <random>
+#include <string>
+
+#include "ExternalActivity.hh"
+
+BOOST_AUTO_TEST_SUITE(external_activity)
+
+BOOST_AUTO_TEST_CASE(test_expiry)
+{
+  ExternalActivity activity;
+  BOOST_CHECK(!activity.is_active(100));
+
+  activity.report("build", true, 100);
+  BOOST_CHECK(activity.is_active(100));
+  BOOST_CHECK(activity.is_active(100 + ExternalActivity::ACTIVITY_TIMEOUT));
+  BOOST_CHECK(!activity.is_active(101 + ExternalActivity::ACTIVITY_TIMEOUT));
+  BOOST_CHECK_EQUAL(activity.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_report_extends)
+{
+  ExternalActivity activity;
+
+  activity.report("media", true, 100);
+  activity.report("media", true, 108);
+  BOOST_CHECK(activity.is_active(115));
+  BOOST_CHECK(activity.is_active(118));
+  BOOST_CHECK(!activity.is_active(119));
+}
+
+BOOST_AUTO_TEST_CASE(test_stop)
+{
+  ExternalActivity activity;
+
+  activity.report("ide", true, 100);
+  activity.report("build", true, 102);
+  activity.report("build", false, 103);
+  BOOST_CHECK(activity.is_active(104));
+
+  activity.report("ide", false, 105);
+  BOOST_CHECK(!activity.is_active(105));
+
+  // Stopped clients are remembered until their rate limit recovered.
+  BOOST_CHECK_EQUAL(activity.size(), 2);
+  BOOST_CHECK(!activity.is_active(200));
+  BOOST_CHECK_EQUAL(activity.size(), 0);
+
+  // Stopping an unknown client does nothing.
+  BOOST_CHECK(activity.report("unknown", false, 200));
+  BOOST_CHECK_EQUAL(activity.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_stop_after_burst)
+{
+  ExternalActivity activity;
+
+  for (int i = 0; i < ExternalActivity::RATE_LIMIT_BURST; i++)
+    {
+      BOOST_CHECK(activity.report("burst", true, 100));
+    }
+  BOOST_CHECK(!activity.report("burst", true, 100));
+
+  // The stop is applied although the bucket is empty.
+  BOOST_CHECK(activity.report("burst", false, 100));
+  BOOST_CHECK(!activity.is_active(100));
+
+  // The bucket is not refilled by stopping.
+  BOOST_CHECK(!activity.report("burst", true, 100));
+  BOOST_CHECK(!activity.is_active(100));
+}
+
+BOOST_AUTO_TEST_CASE(test_rate_limit)
+{
+  ExternalActivity activity;
+
+  int accepted = 0;
+  int stops = 0;
+  for (int64_t now = 100; now < 110; now++)
+    {
+      for (int i = 0; i < 1000; i++)
+        {
+          bool active = i % 2 == 0;
+          bool ok = activity.report("chatty", active, now);
+          accepted += active && ok ? 1 : 0;
+          stops += !active && ok ? 1 : 0;
+        }
+    }
+
+  // A burst, then one report per second. Toggling does not bypass the limit.
+  BOOST_CHECK_EQUAL(accepted, ExternalActivity::RATE_LIMIT_BURST + 9);
+  BOOST_CHECK_EQUAL(stops, 5000);
+  BOOST_CHECK_EQUAL(activity.get_dropped_count(), 5000 - accepted);
+
+  // Other clients are not affected.
+  BOOST_CHECK(activity.report("quiet", true, 109));
+}
+
+BOOST_AUTO_TEST_CASE(test_many_reporters)
+{
+  constexpr int NUM_REPORTERS = 10000;
+  constexpr int64_t START = 1000;
+  constexpr int64_t DURATION = 600;
+
+  ExternalActivity activity;
+  std::map<std::string, int64_t> reference;
+  std::vector<std::string> names;
+  for (int i = 0; i < NUM_REPORTERS; i++)
+    {
+      names.push_back("reporter-" + std::to_string(i));
+    }
+
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> reporter(0, NUM_REPORTERS - 1);
+  std::uniform_int_distribution<int> reports_per_second(0, 2000);
+  std::uniform_int_distribution<int> pause(0, 3);
+
+  std::chrono::nanoseconds report_time{0};
+  std::chrono::nanoseconds check_time{0};
+  std::chrono::nanoseconds scan_time{0};
+  int64_t num_reports = 0;
+
+  int64_t now = START;
+  while (now < START + DURATION)
+    {
+      // Quiet periods, so that all reporters expire now and then.
+      int reports = pause(random) == 0 ? 0 : reports_per_second(random);
+      for (int i = 0; i < reports; i++)
+        {
+          // One in ten reports comes from a single chatty reporter.
+          const std::string &name = names[i % 10 == 0 ? 0 : reporter(random)];
+          bool active = pause(random) != 0;
+
+          auto start = std::chrono::steady_clock::now();
+          bool accepted = activity.report(name, active, now);
+          report_time += std::chrono::steady_clock::now() - start;
+          num_reports++;
+
+          if (accepted)
+            {
+              if (active)
+                {
+                  reference[name] = now + ExternalActivity::ACTIVITY_TIMEOUT;
+                }
+              else
+                {
+                  reference.erase(name);
+                }
+            }
+        }
+
+      auto start = std::chrono::steady_clock::now();
+      bool active = activity.is_active(now);
+      check_time += std::chrono::steady_clock::now() - start;
+
+      // The reference walks all reporters every second.
+      start = std::chrono::steady_clock::now();
+      for (auto it = reference.begin(); it != reference.end();)
+        {
+          it = it->second < now ? reference.erase(it) : std::next(it);
+        }
+      scan_time += std::chrono::steady_clock::now() - start;
+
+      BOOST_REQUIRE_EQUAL(active, !reference.empty());
+      BOOST_REQUIRE_LE(activity.size(), static_cast<std::size_t>(NUM_REPORTERS));
+
+      now += reports == 0 ? ExternalActivity::ACTIVITY_TIMEOUT + 1 : 1;
+    }
+
+  BOOST_TEST_MESSAGE(num_reports << " reports: " << report_time.count() / std::max<int64_t>(num_reports, 1) << " ns per report, "
+                                 << check_time.count() / DURATION << " ns per check (" << scan_time.count() / DURATION
+                                 << " ns for a full scan), " << activity.get_dropped_count() << " dropped");
+  BOOST_CHECK_GT(activity.get_dropped_count(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,235 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#define BOOST_TEST_MODULE workrave_heartbeat_allocation
+#include <boost/test/unit_test.hpp>
+
+#include "core/ICore.hh"
+#include "core/IApp.hh"
+
+#include "config/Config.hh"
+#include "config/SettingCache.hh"
+
+#include "utils/TimeSource.hh"
+
+#include "Timer.hh"
+#include "ICoreTestHooks.hh"
+#include "Core.hh"
+
+#include "testsupport/AllocationCounter.hh"
+#include "SimulatedTime.hh"
+#include "ActivityMonitorStub.hh"
+
+using namespace workrave::utils;
+using namespace workrave::config;
+using namespace workrave;
+
+namespace
+{
+  //! Heartbeats before measuring, so that the first save has set up all buffers.
+  constexpr int WARMUP_TIME = 150;
+
+  //! Heartbeats measured, including one save of the state every minute.
+  constexpr int MEASURE_TIME = 3600;
+} // namespace
+
+class Backend : public workrave::IApp
+{
+public:
+  struct Result
+  {
+    //! Most allocations made by a single heartbeat.
+    int64_t max_allocations{0};
+
+    //! Number of heartbeats that allocated.
+    int allocating_heartbeats{0};
+
+    //! Second, relative to the start of the run, of the first heartbeat that allocated.
+    int first_allocation_time{-1};
+  };
+
+  ~Backend() override
+  {
+    Core::reset_instance();
+  }
+
+  void init()
+  {
+    sim = SimulatedTime::create();
+    sim->reset();
+    TimeSource::sync();
+
+    SettingCache::reset();
+    core = Core::get_instance();
+
+    ICoreTestHooks::Ptr test_hooks = std::dynamic_pointer_cast<ICoreTestHooks>(core->get_hooks());
+    test_hooks->hook_create_configurator() = std::bind(&Backend::on_create_configurator, this);
+    test_hooks->hook_create_monitor() = std::bind(&Backend::on_create_monitor, this);
+    test_hooks->hook_load_timer_state() = [](Timer **) { return true; };
+
+    core->init(0, NULL, this, "");
+    core->set_operation_mode(OperationMode::Normal);
+    core->set_usage_mode(UsageMode::Normal);
+  }
+
+  Result run(int seconds, bool active)
+  {
+    Result result;
+
+    monitor->set_active(active);
+    for (int i = 0; i < seconds; i++)
+      {
+        TimeSource::sync();
+
+        int64_t count = AllocationCounter::get_count();
+        monitor->heartbeat();
+        core->heartbeat();
+        int64_t allocations = AllocationCounter::get_count() - count;
+
+        if (allocations > 0)
+          {
+            result.max_allocations = std::max(result.max_allocations, allocations);
+            result.allocating_heartbeats++;
+            if (result.first_allocation_time == -1)
+              {
+                result.first_allocation_time = i;
+              }
+          }
+
+        sim->current_time += 1000000;
+      }
+    return result;
+  }
+
+  void create_prelude_window(BreakId break_id) override
+  {
+  }
+
+  void create_break_window(BreakId break_id, workrave::utils::Flags<BreakHint> break_hint) override
+  {
+  }
+
+  void hide_break_window() override
+  {
+  }
+
+  void show_break_window() override
+  {
+  }
+
+  void refresh_break_window() override
+  {
+  }
+
+  void set_break_progress(int value, int max_value) override
+  {
+  }
+
+  void set_prelude_stage(PreludeStage stage) override
+  {
+  }
+
+  void set_prelude_progress_text(PreludeProgressText text) override
+  {
+  }
+
+  IActivityMonitor::Ptr on_create_monitor()
+  {
+    monitor = std::make_shared<ActivityMonitorStub>();
+    return monitor;
+  }
+
+  //! No break becomes due during the tests, so every heartbeat is a steady-state one.
+  IConfigurator::Ptr on_create_configurator()
+  {
+    config = ConfiguratorFactory::create(ConfigFileFormat::Ini);
+
+    config->set_value("timers/micro_pause/limit", 7200);
+    config->set_value("timers/micro_pause/auto_reset", 20);
+    config->set_value("timers/micro_pause/reset_pred", "");
+    config->set_value("timers/micro_pause/snooze", 150);
+
+    config->set_value("timers/rest_break/limit", 7200);
+    config->set_value("timers/rest_break/auto_reset", 300);
+    config->set_value("timers/rest_break/reset_pred", "");
+    config->set_value("timers/rest_break/snooze", 180);
+
+    config->set_value("timers/daily_limit/limit", 14400);
+    config->set_value("timers/daily_limit/auto_reset", 0);
+    config->set_value("timers/daily_limit/reset_pred", "day/4:00");
+    config->set_value("timers/daily_limit/snooze", 1200);
+
+    config->set_value("breaks/micro_pause/max_preludes", 3);
+    config->set_value("breaks/micro_pause/enabled", true);
+    config->set_value("breaks/rest_break/max_preludes", 6);
+    config->set_value("breaks/rest_break/enabled", true);
+    config->set_value("breaks/daily_limit/max_preludes", 3);
+    config->set_value("breaks/daily_limit/enabled", true);
+
+    config->set_value("timers/daily_limit/use_microbreak_activity", false);
+    config->set_value("general/usage-mode", 0);
+    config->set_value("general/operation-mode", 0);
+
+    return config;
+  }
+
+  ICore *core{nullptr};
+  IConfigurator::Ptr config;
+  SimulatedTime::Ptr sim;
+  ActivityMonitorStub::Ptr monitor;
+};
+
+//! Trace output of a heartbeat allocates, so traced builds only warn about allocations.
+static void
+check_allocation_free(int64_t max_allocations, int64_t first_allocation_time)
+{
+#ifdef TRACING
+  BOOST_WARN_EQUAL(max_allocations, 0);
+  BOOST_WARN_EQUAL(first_allocation_time, -1);
+#else
+  BOOST_CHECK_EQUAL(max_allocations, 0);
+  BOOST_CHECK_EQUAL(first_allocation_time, -1);
+#endif
+}
+
+BOOST_FIXTURE_TEST_SUITE(heartbeat_allocation, Backend)
+
+BOOST_AUTO_TEST_CASE(test_idle_heartbeat)
+{
+  init();
+  run(WARMUP_TIME, false);
+
+  Result result = run(MEASURE_TIME, false);
+  BOOST_TEST_MESSAGE("idle: " << result.allocating_heartbeats << " heartbeats allocated, at most " << result.max_allocations);
+  check_allocation_free(result.max_allocations, result.first_allocation_time);
+}
+
+BOOST_AUTO_TEST_CASE(test_active_heartbeat)
+{
+  init();
+  run(WARMUP_TIME, true);
+
+  Result result = run(MEASURE_TIME, true);
+  BOOST_TEST_MESSAGE("active: " << result.allocating_heartbeats << " heartbeats allocated, at most " << result.max_allocations);
+  check_allocation_free(result.max_allocations, result.first_allocation_time);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,188 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "IdleLogStore.hh"
+
+namespace
+{
+  constexpr int64_t MAX_AGE = 12 * 60 * 60;
+  constexpr int64_t START = 1700000000;
+
+  //! Size of an interval in the per-client files: size, version, 3 times and the active time.
+  constexpr int LEGACY_INTERVAL_SIZE = 17;
+
+  using Logs = std::map<std::string, std::vector<IdleLogStore::Record>>;
+
+  std::string get_client_id(int client)
+  {
+    return "client-" + std::to_string(client);
+  }
+
+  void pack(std::string &buffer, uint32_t value, int bytes)
+  {
+    for (int i = bytes - 1; i >= 0; i--)
+      {
+        buffer += static_cast<char>((value >> (8 * i)) & 0xff);
+      }
+  }
+
+  uint32_t unpack(const char *data, int bytes)
+  {
+    uint32_t value = 0;
+    for (int i = 0; i < bytes; i++)
+      {
+        value = (value << 8) | static_cast<uint8_t>(data[i]);
+      }
+    return value;
+  }
+
+  //! Writes the logs as one file per client, the way IdleLogManager used to.
+  void write_legacy(const std::filesystem::path &directory, const Logs &logs)
+  {
+    for (const auto &[client_id, records]: logs)
+      {
+        std::string buffer;
+        for (const IdleLogStore::Record &record: records)
+          {
+            pack(buffer, LEGACY_INTERVAL_SIZE, 2);
+            pack(buffer, 3, 1);
+            pack(buffer, static_cast<uint32_t>(record.begin_time), 4);
+            pack(buffer, static_cast<uint32_t>(record.end_idle_time), 4);
+            pack(buffer, static_cast<uint32_t>(record.end_time), 4);
+            pack(buffer, record.active_time, 2);
+          }
+
+        std::ofstream file(directory / ("idlelog." + client_id + ".log"), std::ios::binary);
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      }
+  }
+
+  Logs load_legacy(const std::filesystem::path &directory, int num_clients)
+  {
+    Logs logs;
+    for (int client = 0; client < num_clients; client++)
+      {
+        std::string client_id = get_client_id(client);
+        std::ifstream file(directory / ("idlelog." + client_id + ".log"), std::ios::binary);
+        std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        std::vector<IdleLogStore::Record> &records = logs[client_id];
+        for (std::size_t pos = 0; pos + LEGACY_INTERVAL_SIZE <= buffer.size(); pos += LEGACY_INTERVAL_SIZE)
+          {
+            const char *data = buffer.data() + pos;
+            IdleLogStore::Record record;
+            record.begin_time = unpack(data + 3, 4);
+            record.end_idle_time = unpack(data + 7, 4);
+            record.end_time = unpack(data + 11, 4);
+            record.active_time = unpack(data + 15, 2);
+            records.push_back(record);
+          }
+      }
+    return logs;
+  }
+
+  Logs load_store(const std::filesystem::path &directory, int64_t now)
+  {
+    Logs logs;
+    IdleLogStore store(directory, MAX_AGE);
+    store.open(now);
+    store.load([&logs](const std::string &client_id, const std::vector<IdleLogStore::Record> &records) { logs[client_id] = records; });
+    return logs;
+  }
+
+  template<typename Func>
+  void run(const std::string &name, int iterations, Func func)
+  {
+    double best = 0;
+    std::size_t check = 0;
+    for (int i = 0; i < iterations; i++)
+      {
+        auto start = std::chrono::steady_clock::now();
+        Logs logs = func();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        best = (i == 0 || ms < best) ? ms : best;
+        check = 0;
+        for (const auto &log: logs)
+          {
+            check += log.second.size();
+          }
+      }
+    std::cout << name << ": " << best << " ms (" << check << " intervals)" << std::endl;
+  }
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+  int num_clients = argc > 1 ? std::atoi(argv[1]) : 200;
+  int num_intervals = argc > 2 ? std::atoi(argv[2]) : 400;
+  int iterations = 10;
+
+  std::random_device random;
+  std::filesystem::path directory = std::filesystem::temp_directory_path() / ("workrave-idlelog-benchmark-" + std::to_string(random()));
+  std::filesystem::path legacy_directory = directory / "legacy";
+  std::filesystem::path store_directory = directory / "store";
+  std::filesystem::create_directories(legacy_directory);
+
+  // Intervals of all clients, spread over the maximum age of the log.
+  Logs logs;
+  IdleLogStore store(store_directory, MAX_AGE);
+  store.open(START);
+  int64_t step = MAX_AGE / num_intervals;
+  for (int i = 0; i < num_intervals; i++)
+    {
+      for (int client = 0; client < num_clients; client++)
+        {
+          IdleLogStore::Record record;
+          record.begin_time = START + i * step + client % step;
+          record.end_idle_time = record.begin_time + step / 4;
+          record.end_time = record.begin_time + step / 2;
+          record.active_time = static_cast<uint32_t>(step / 4);
+
+          logs[get_client_id(client)].push_back(record);
+          store.append(get_client_id(client), {record}, record.end_time);
+        }
+    }
+  store.close();
+  write_legacy(legacy_directory, logs);
+
+  int64_t now = START + MAX_AGE;
+  std::cout << num_clients << " clients, " << num_intervals << " intervals each, " << store.get_segment_count() << " segments"
+            << std::endl;
+
+  run("per-client files", iterations, [&]() { return load_legacy(legacy_directory, num_clients); });
+  run("segmented store", iterations, [&]() { return load_store(store_directory, now); });
+
+  std::error_code ec;
+  std::filesystem::remove_all(directory, ec);
+  return 0;
+}
@@ -0,0 +1,203 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#define BOOST_TEST_MODULE workrave_idlelog_store
+#include <boost/test/unit_test.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "IdleLogStore.hh"
+
+namespace
+{
+  constexpr int64_t MAX_AGE = 12 * 60 * 60;
+  constexpr int64_t START = 1700000000;
+
+  using Logs = std::map<std::string, std::vector<IdleLogStore::Record>>;
+
+  struct Fixture
+  {
+    Fixture()
+    {
+      std::random_device random;
+      directory = std::filesystem::temp_directory_path() / ("workrave-idlelog-test-" + std::to_string(random()));
+    }
+
+    ~Fixture()
+    {
+      std::error_code ec;
+      std::filesystem::remove_all(directory, ec);
+    }
+
+    static IdleLogStore::Record make_record(int64_t begin)
+    {
+      IdleLogStore::Record record;
+      record.begin_time = begin;
+      record.end_idle_time = begin + 10;
+      record.end_time = begin + 20;
+      record.active_time = 10;
+      return record;
+    }
+
+    static Logs load(IdleLogStore &store)
+    {
+      Logs logs;
+      store.load([&logs](const std::string &client_id, const std::vector<IdleLogStore::Record> &records) { logs[client_id] = records; });
+      return logs;
+    }
+
+    std::filesystem::path directory;
+  };
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(idlelog_store, Fixture)
+
+BOOST_AUTO_TEST_CASE(test_append_and_load)
+{
+  {
+    IdleLogStore store(directory, MAX_AGE);
+    BOOST_REQUIRE(store.open(START));
+    BOOST_CHECK(!store.has_client("a"));
+
+    store.append("a", {make_record(START), make_record(START + 30)}, START + 50);
+    store.append("b", {make_record(START + 40)}, START + 60);
+    store.append("a", {make_record(START + 70)}, START + 90);
+    store.close();
+  }
+
+  IdleLogStore store(directory, MAX_AGE);
+  BOOST_REQUIRE(store.open(START + 100));
+  BOOST_CHECK(store.has_client("a"));
+  BOOST_CHECK(store.has_client("b"));
+
+  Logs logs = load(store);
+  BOOST_REQUIRE_EQUAL(logs["a"].size(), 3U);
+  BOOST_REQUIRE_EQUAL(logs["b"].size(), 1U);
+  BOOST_CHECK_EQUAL(logs["a"][0].begin_time, START);
+  BOOST_CHECK_EQUAL(logs["a"][1].begin_time, START + 30);
+  BOOST_CHECK_EQUAL(logs["a"][2].begin_time, START + 70);
+  BOOST_CHECK_EQUAL(logs["a"][2].end_idle_time, START + 80);
+  BOOST_CHECK_EQUAL(logs["a"][2].end_time, START + 90);
+  BOOST_CHECK_EQUAL(logs["a"][2].active_time, 10U);
+  BOOST_CHECK_EQUAL(logs["b"][0].begin_time, START + 40);
+}
+
+BOOST_AUTO_TEST_CASE(test_replace)
+{
+  IdleLogStore store(directory, MAX_AGE);
+  BOOST_REQUIRE(store.open(START));
+
+  store.append("a", {make_record(START), make_record(START + 30)}, START + 50);
+  store.append("b", {make_record(START + 40)}, START + 60);
+  store.replace("a", {make_record(START + 100)}, START + 120);
+  store.append("a", {make_record(START + 130)}, START + 150);
+
+  Logs logs = load(store);
+  BOOST_REQUIRE_EQUAL(logs["a"].size(), 2U);
+  BOOST_CHECK_EQUAL(logs["a"][0].begin_time, START + 100);
+  BOOST_CHECK_EQUAL(logs["a"][1].begin_time, START + 130);
+  BOOST_CHECK_EQUAL(logs["b"].size(), 1U);
+
+  store.close();
+  BOOST_REQUIRE(store.open(START + 200));
+  BOOST_CHECK_EQUAL(load(store)["a"].size(), 2U);
+
+  // An empty log replaces the old one as well.
+  store.replace("b", {}, START + 210);
+  BOOST_CHECK_EQUAL(load(store).count("b"), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(test_rotation)
+{
+  IdleLogStore store(directory, MAX_AGE);
+  BOOST_REQUIRE(store.open(START));
+
+  // A new segment is started every max_age / 2.
+  int64_t step = MAX_AGE / 2 + 1;
+  for (int i = 0; i < 3; i++)
+    {
+      store.append("a", {make_record(START + i * step)}, START + i * step);
+    }
+  BOOST_CHECK_EQUAL(store.get_segment_count(), 3U);
+
+  // The first segment expires once the second one is older than max_age.
+  store.append("a", {make_record(START + 3 * step)}, START + 3 * step);
+  BOOST_CHECK_EQUAL(store.get_segment_count(), 3U);
+
+  Logs logs = load(store);
+  BOOST_REQUIRE_EQUAL(logs["a"].size(), 3U);
+  BOOST_CHECK_EQUAL(logs["a"][0].begin_time, START + step);
+
+  // Expiry also happens when opening the store.
+  store.close();
+  BOOST_REQUIRE(store.open(START + 6 * step));
+  BOOST_CHECK_EQUAL(store.get_segment_count(), 1U);
+}
+
+BOOST_AUTO_TEST_CASE(test_full_segment)
+{
+  IdleLogStore store(directory, MAX_AGE);
+  BOOST_REQUIRE(store.open(START));
+
+  std::vector<IdleLogStore::Record> records(IdleLogStore::SEGMENT_MAX_RECORDS, make_record(START));
+  store.append("a", records, START);
+  BOOST_CHECK_EQUAL(store.get_segment_count(), 1U);
+
+  store.append("a", {make_record(START + 1)}, START + 1);
+  BOOST_CHECK_EQUAL(store.get_segment_count(), 2U);
+  BOOST_CHECK_EQUAL(load(store)["a"].size(), IdleLogStore::SEGMENT_MAX_RECORDS + 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_incomplete_record)
+{
+  {
+    IdleLogStore store(directory, MAX_AGE);
+    BOOST_REQUIRE(store.open(START));
+    store.append("a", {make_record(START), make_record(START + 30)}, START + 50);
+    store.close();
+  }
+
+  // Simulate a crash halfway through writing a record.
+  for (const auto &entry: std::filesystem::directory_iterator(directory))
+    {
+      if (entry.path().filename().string().rfind("segment.", 0) == 0)
+        {
+          std::ofstream file(entry.path(), std::ios::binary | std::ios::app);
+          file.write("crash", 5);
+        }
+    }
+
+  IdleLogStore store(directory, MAX_AGE);
+  BOOST_REQUIRE(store.open(START + 100));
+  store.append("a", {make_record(START + 100)}, START + 120);
+
+  Logs logs = load(store);
+  BOOST_REQUIRE_EQUAL(logs["a"].size(), 3U);
+  BOOST_CHECK_EQUAL(logs["a"][2].begin_time, START + 100);
+  BOOST_CHECK_EQUAL(logs["a"][2].active_time, 10U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,334 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#define BOOST_TEST_MODULE workrave_peer_health
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <vector>
+
+#include "PeerHealth.hh"
+
+namespace
+{
+  constexpr int64_t SEC = PeerHealth::USEC_PER_SEC;
+
+  //! Simulation of a full mesh of peers that elect the lowest live peer as master.
+  /*!
+   *  Every tick corresponds to one heartbeat of the distribution link. The
+   *  master sends state every few seconds; everyone else only sends
+   *  keepalives. Packets are dropped at random.
+   */
+  class ElectionSimulation
+  {
+  public:
+    struct Result
+    {
+      bool converged{false};
+      int64_t election_time{0};
+      int state_messages{0};
+      int keepalive_messages{0};
+      int master_keepalive_messages{0};
+      int new_master_messages{0};
+    };
+
+    ElectionSimulation(int num_peers, double loss, uint32_t seed)
+      : loss(loss)
+      , random(seed)
+    {
+      for (int i = 0; i < num_peers; i++)
+        {
+          Peer peer;
+          for (int j = 0; j < num_peers; j++)
+            {
+              peer.health.emplace_back(seed + i * num_peers + j);
+              peer.health.back().set_monitored(true);
+            }
+          peers.push_back(std::move(peer));
+        }
+    }
+
+    Result run(int64_t crash_time, int64_t max_time)
+    {
+      Result result;
+
+      for (int64_t now = SEC; now <= max_time; now += SEC)
+        {
+          if (now == crash_time)
+            {
+              peers[0].alive = false;
+            }
+
+          for (int i = 0; i < static_cast<int>(peers.size()); i++)
+            {
+              tick(i, now, now >= crash_time ? &result : nullptr);
+            }
+
+          if (now > crash_time && !result.converged && is_converged())
+            {
+              result.converged = true;
+              result.election_time = now - crash_time;
+            }
+        }
+      return result;
+    }
+
+  private:
+    struct Peer
+    {
+      bool alive{true};
+      int master{0};
+      bool announce{false};
+      std::vector<PeerHealth> health;
+    };
+
+    enum class Message
+    {
+      State,
+      Keepalive,
+      NewMaster
+    };
+
+    void tick(int self, int64_t now, Result *result)
+    {
+      Peer &peer = peers[self];
+      if (!peer.alive)
+        {
+          return;
+        }
+
+      // Master: lowest peer that is not suspected.
+      int master = self;
+      for (int i = 0; i < self; i++)
+        {
+          if (!peer.health[i].is_suspected(now))
+            {
+              master = i;
+              break;
+            }
+        }
+
+      if (master == self && peer.master != self)
+        {
+          peer.announce = true;
+        }
+      peer.master = master;
+
+      for (int i = 0; i < static_cast<int>(peers.size()); i++)
+        {
+          if (i == self)
+            {
+              continue;
+            }
+
+          if (peer.announce)
+            {
+              send(self, i, Message::NewMaster, now, result);
+            }
+          else if (peer.master == self && (now / SEC) % 3 == 0)
+            {
+              send(self, i, Message::State, now, result);
+            }
+          else if (peer.health[i].needs_keepalive(now))
+            {
+              send(self, i, Message::Keepalive, now, result);
+            }
+        }
+      peer.announce = false;
+    }
+
+    void send(int from, int to, Message message, int64_t now, Result *result)
+    {
+      peers[from].health[to].packet_sent(now);
+
+      if (result != nullptr)
+        {
+          switch (message)
+            {
+            case Message::State:
+              result->state_messages++;
+              break;
+            case Message::Keepalive:
+              result->keepalive_messages++;
+              if (peers[from].master == from)
+                {
+                  result->master_keepalive_messages++;
+                }
+              break;
+            case Message::NewMaster:
+              result->new_master_messages++;
+              break;
+            }
+        }
+
+      std::uniform_real_distribution<double> dist(0.0, 1.0);
+      if (!peers[to].alive || dist(random) < loss)
+        {
+          return;
+        }
+
+      peers[to].health[from].packet_received(now);
+      if (message == Message::NewMaster || message == Message::State)
+        {
+          peers[to].master = from;
+        }
+    }
+
+    bool is_converged() const
+    {
+      int master = -1;
+      for (const Peer &peer: peers)
+        {
+          if (!peer.alive)
+            {
+              continue;
+            }
+          if (master == -1)
+            {
+              master = peer.master;
+            }
+          if (peer.master != master || !peers[master].alive)
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+
+    double loss;
+    std::mt19937 random;
+    std::vector<Peer> peers;
+  };
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(peer_health)
+
+BOOST_AUTO_TEST_CASE(test_phi_regular_peer)
+{
+  PeerHealth health(1);
+  health.set_monitored(true);
+
+  int64_t now = SEC;
+  for (int i = 0; i < 20; i++)
+    {
+      health.packet_received(now);
+      now += 5 * SEC;
+    }
+  now -= 5 * SEC;
+
+  BOOST_CHECK_LT(health.get_phi(now + 5 * SEC), 1.0);
+  BOOST_CHECK(!health.is_suspected(now + 6 * SEC));
+  BOOST_CHECK(health.is_suspected(now + 20 * SEC));
+}
+
+BOOST_AUTO_TEST_CASE(test_phi_increases)
+{
+  PeerHealth health(1);
+  health.set_monitored(true);
+
+  for (int i = 0; i < 10; i++)
+    {
+      health.packet_received((i + 1) * 5 * SEC);
+    }
+
+  double last = -1.0;
+  for (int64_t t = 50 * SEC; t < 80 * SEC; t += SEC)
+    {
+      double phi = health.get_phi(t);
+      BOOST_CHECK_GE(phi, last);
+      last = phi;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_phi_unmonitored)
+{
+  PeerHealth health(1);
+  health.packet_received(SEC);
+  health.packet_received(2 * SEC);
+
+  BOOST_CHECK_GT(health.get_phi(1000 * SEC), PeerHealth::PHI_THRESHOLD);
+  BOOST_CHECK(!health.is_suspected(1000 * SEC));
+}
+
+BOOST_AUTO_TEST_CASE(test_keepalive_coalescing)
+{
+  PeerHealth health(1);
+  health.reset(SEC);
+
+  BOOST_CHECK(!health.needs_keepalive(SEC + PeerHealth::KEEPALIVE_INTERVAL - 1));
+  BOOST_CHECK(health.needs_keepalive(SEC + PeerHealth::KEEPALIVE_INTERVAL));
+
+  health.packet_sent(4 * SEC);
+  BOOST_CHECK(!health.needs_keepalive(SEC + PeerHealth::KEEPALIVE_INTERVAL));
+}
+
+BOOST_AUTO_TEST_CASE(test_backoff)
+{
+  PeerHealth health(42);
+
+  int64_t previous_max = 0;
+  for (int i = 0; i < 12; i++)
+    {
+      int64_t max = std::min(PeerHealth::BACKOFF_MIN << std::min(i, 7), PeerHealth::BACKOFF_MAX);
+      int64_t delay = health.next_reconnect_delay();
+      BOOST_CHECK_GE(delay, max / 2);
+      BOOST_CHECK_LE(delay, max);
+      BOOST_CHECK_GE(max, previous_max);
+      previous_max = max;
+    }
+
+  health.reset_backoff();
+  BOOST_CHECK_LE(health.next_reconnect_delay(), PeerHealth::BACKOFF_MIN);
+}
+
+BOOST_AUTO_TEST_CASE(test_backoff_jitter)
+{
+  PeerHealth a(1);
+  PeerHealth b(2);
+
+  bool differ = false;
+  for (int i = 0; i < 5; i++)
+    {
+      differ = differ || a.next_reconnect_delay() != b.next_reconnect_delay();
+    }
+  BOOST_CHECK(differ);
+}
+
+BOOST_AUTO_TEST_CASE(test_election)
+{
+  for (double loss: {0.0, 0.1, 0.3})
+    {
+      ElectionSimulation sim(8, loss, 1234);
+      auto result = sim.run(120 * SEC, 600 * SEC);
+
+      BOOST_TEST_MESSAGE("loss " << loss << ": election " << result.election_time / SEC << " s, " << result.state_messages
+                                 << " state, " << result.keepalive_messages << " keepalive (" << result.master_keepalive_messages
+                                 << " from master), " << result.new_master_messages << " new master messages");
+
+      BOOST_CHECK(result.converged);
+      BOOST_CHECK_LE(result.election_time, 60 * SEC);
+
+      // The master's state packets double as keepalives.
+      BOOST_CHECK_EQUAL(result.master_keepalive_messages, 0);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
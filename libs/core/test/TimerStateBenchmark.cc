@@ -0,0 +1,96 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "utils/TimeSource.hh"
+
+#include "Timer.hh"
+#include "TimerStateRecord.hh"
+
+using namespace workrave;
+using namespace workrave::utils;
+
+namespace
+{
+  template<typename Func>
+  void run(const std::string &name, int iterations, Func func)
+  {
+    auto start = std::chrono::steady_clock::now();
+    int64_t check = 0;
+    for (int i = 0; i < iterations; i++)
+      {
+        check += func(i);
+      }
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+    std::cout << name << ": " << ns << " ns/op, " << (1e9 / ns) << " ops/s (" << check << ")" << std::endl;
+  }
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+  int iterations = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+  TimeSource::sync();
+
+  Timer timer("micro_pause");
+  timer.set_limit(300);
+  timer.set_limit_enabled(true);
+  timer.set_auto_reset(20);
+  timer.set_auto_reset_enabled(true);
+  timer.enable();
+
+  Timer::TimerStateData data{};
+  timer.get_state_data(data);
+
+  std::vector<uint8_t> record(TimerStateRecord::SIZE);
+  std::string text = timer.serialize_state();
+  text = text.substr(text.find_first_of(' ') + 1);
+
+  run("binary encode", iterations, [&](int i) {
+    data.elapsed_time = i;
+    TimerStateRecord::encode(BREAK_ID_MICRO_BREAK, data, record.data());
+    return record[20];
+  });
+
+  run("binary decode", iterations, [&](int) {
+    BreakId break_id = BREAK_ID_NONE;
+    Timer::TimerStateData out{};
+    TimerStateRecord::decode(record.data(), record.size(), break_id, out);
+    return out.elapsed_time;
+  });
+
+  run("text encode", iterations, [&](int) { return static_cast<int64_t>(timer.serialize_state().size()); });
+
+  run("text decode", iterations, [&](int) {
+    timer.deserialize_state(text, 3);
+    return timer.get_elapsed_time();
+  });
+
+  return 0;
+}
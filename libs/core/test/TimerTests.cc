@@ -29,6 +29,7 @@
 #include "utils/TimeSource.hh"
 
 #include "Timer.hh"
+#include "TimerStateRecord.hh"
 #include "TimePred.hh"
 #include "SimulatedTime.hh"
 
@@ -2150,4 +2151,70 @@ BOOST_AUTO_TEST_CASE(test_timer_serialize)
   BOOST_REQUIRE_EQUAL(s1, s2);
 }
 
+BOOST_AUTO_TEST_CASE(test_timer_serialize_binary)
+{
+  init();
+
+  tick(true, 120, [=](int count, TimerEvent event) {});
+  tick(false, 5, [=](int count, TimerEvent event) {});
+
+  Timer::TimerStateData d1{};
+  timer->get_state_data(d1);
+
+  uint8_t record[TimerStateRecord::SIZE];
+  TimerStateRecord::encode(BREAK_ID_REST_BREAK, d1, record);
+
+  BreakId break_id = BREAK_ID_NONE;
+  Timer::TimerStateData d2{};
+  BOOST_REQUIRE(TimerStateRecord::decode(record, sizeof(record), break_id, d2));
+  BOOST_REQUIRE_EQUAL(break_id, BREAK_ID_REST_BREAK);
+  BOOST_REQUIRE_EQUAL(d1.current_time, d2.current_time);
+  BOOST_REQUIRE_EQUAL(d1.elapsed_time, d2.elapsed_time);
+  BOOST_REQUIRE_EQUAL(d1.elapsed_idle_time, d2.elapsed_idle_time);
+  BOOST_REQUIRE_EQUAL(d1.last_pred_reset_time, d2.last_pred_reset_time);
+  BOOST_REQUIRE_EQUAL(d1.total_overdue_time, d2.total_overdue_time);
+  BOOST_REQUIRE_EQUAL(d1.last_limit_time, d2.last_limit_time);
+  BOOST_REQUIRE_EQUAL(d1.last_limit_elapsed, d2.last_limit_elapsed);
+  BOOST_REQUIRE_EQUAL(d1.snooze_inhibited, d2.snooze_inhibited);
+
+  // Little-endian on every platform.
+  BOOST_REQUIRE_EQUAL(record[4], TimerStateRecord::VERSION);
+  BOOST_REQUIRE_EQUAL(record[5], 0);
+  BOOST_REQUIRE_EQUAL(record[20], d1.elapsed_time & 0xff);
+
+  Timer::Ptr t = make_timer();
+  BOOST_REQUIRE(t->deserialize_state(d2));
+  BOOST_REQUIRE_EQUAL(t->get_elapsed_time(), timer->get_elapsed_time());
+  BOOST_REQUIRE_EQUAL(t->get_total_overdue_time(), timer->get_total_overdue_time());
+
+  std::string s1 = timer->serialize_state();
+  std::string s2 = t->serialize_state();
+  BOOST_REQUIRE_EQUAL(s1, s2);
+}
+
+BOOST_AUTO_TEST_CASE(test_timer_serialize_binary_corrupt)
+{
+  init();
+
+  Timer::TimerStateData d1{};
+  timer->get_state_data(d1);
+
+  uint8_t record[TimerStateRecord::SIZE];
+  TimerStateRecord::encode(BREAK_ID_MICRO_BREAK, d1, record);
+
+  BreakId break_id = BREAK_ID_NONE;
+  Timer::TimerStateData d2{};
+
+  BOOST_REQUIRE(!TimerStateRecord::decode(record, sizeof(record) - 1, break_id, d2));
+
+  for (size_t i = 0; i < sizeof(record); i++)
+    {
+      record[i] ^= 0x10;
+      BOOST_REQUIRE(!TimerStateRecord::decode(record, sizeof(record), break_id, d2));
+      record[i] ^= 0x10;
+    }
+
+  BOOST_REQUIRE(TimerStateRecord::decode(record, sizeof(record), break_id, d2));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -20,7 +20,7 @@
 
 #include <cstring>
 
-#include <boost/signals2.hpp>
+#include "utils/Signals.hh"
 
 #include "core/CoreTypes.hh"
 
@@ -95,7 +95,7 @@ namespace workrave
 
     virtual ~IBreak() = default;
 
-    virtual boost::signals2::signal<void(workrave::BreakEvent)> &signal_break_event() = 0;
+    virtual workrave::utils::Signal<void(workrave::BreakEvent)> &signal_break_event() = 0;
 
     //! Returns the name of the break.
     [[nodiscard]] virtual std::string get_name() const = 0;
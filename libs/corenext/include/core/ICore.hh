@@ -20,7 +20,7 @@
 
 #include <memory>
 #include <string>
-#include <boost/signals2.hpp>
+#include "utils/Signals.hh"
 
 #include "config/IConfigurator.hh"
 #include "core/CoreTypes.hh"
@@ -40,8 +40,8 @@ namespace workrave
     using Ptr = std::shared_ptr<ICore>;
     virtual ~ICore() = default;
 
-    virtual boost::signals2::signal<void(workrave::OperationMode)> &signal_operation_mode_changed() = 0;
-    virtual boost::signals2::signal<void(workrave::UsageMode)> &signal_usage_mode_changed() = 0;
+    virtual workrave::utils::Signal<void(workrave::OperationMode)> &signal_operation_mode_changed() = 0;
+    virtual workrave::utils::Signal<void(workrave::UsageMode)> &signal_usage_mode_changed() = 0;
 
     //! Initialize the Core. Must be called first.
     virtual void init(IApp *app, const char *display) = 0;
@@ -18,7 +18,11 @@
 #ifndef WORKRAVE_BACKEND_ISTATISTICS_HH
 #define WORKRAVE_BACKEND_ISTATISTICS_HH
 
+#include <cstddef>
 #include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
 
 #ifdef PLATFORM_OS_WINDOWS_NATIVE
 typedef __int64 int64_t;
@@ -28,6 +32,11 @@ typedef __int64 int64_t;
 
 #include "core/CoreTypes.hh"
 
+namespace workrave::utils
+{
+  class RecordArena;
+}
+
 namespace workrave
 {
   class IStatistics
@@ -76,16 +85,114 @@ namespace workrave
       MiscStats misc_stats;
     };
 
+    //! Read-only view of the statistics of one day.
+    /*!
+     *  The view refers either to the statistics of the current day, or to a
+     *  day in the history arena. It does not copy the statistics, so it is
+     *  only valid until the statistics are changed.
+     */
+    class DailyStatsView
+    {
+    public:
+      //! Fields of a day in the history arena. The key of a day is its date in days since 1970-01-01.
+      enum Field
+      {
+        //! Start of the day in minutes since midnight.
+        FIELD_START = 0,
+        //! End of the day in minutes since midnight of the start date.
+        FIELD_STOP,
+        FIELD_BREAK_STATS,
+        FIELD_MISC_STATS = FIELD_BREAK_STATS + BREAK_ID_SIZEOF * STATS_BREAKVALUE_SIZEOF,
+        FIELD_SIZEOF = FIELD_MISC_STATS + STATS_VALUE_SIZEOF
+      };
+
+      DailyStatsView() = default;
+
+      explicit DailyStatsView(const DailyStats *stats)
+        : stats(stats)
+      {
+      }
+
+      DailyStatsView(const workrave::utils::RecordArena *history, std::size_t index)
+        : history(history)
+        , index(index)
+      {
+      }
+
+      //! Returns false if the view does not refer to any day.
+      explicit operator bool() const
+      {
+        return stats != nullptr || history != nullptr;
+      }
+
+      //! Returns true if the user has not been active on this day.
+      bool is_empty() const;
+
+      struct tm get_start() const;
+      struct tm get_stop() const;
+      int get_break_stat(BreakId break_id, StatsBreakValueType type) const;
+      int64_t get_misc_stat(StatsValueType type) const;
+
+      bool starts_at_date(int y, int m, int d) const;
+      bool starts_before_date(int y, int m, int d) const;
+
+      //! Encodes the statistics of a day as fields of the history arena. Returns the key.
+      static int32_t encode(const DailyStats &stats, int64_t *fields);
+
+      //! Returns the number of days between 1970-01-01 and the specified date.
+      static int32_t days_from_date(int y, int m, int d);
+
+      //! Returns the name of a field, e.g. "start", "restbreak.taken" or "total_keystrokes".
+      static std::string get_field_name(int field);
+
+      //! Returns the field with the specified name, or -1.
+      static int find_field(const std::string &name);
+
+    private:
+      struct tm get_time(int64_t minutes) const;
+
+    private:
+      const DailyStats *stats{nullptr};
+      const workrave::utils::RecordArena *history{nullptr};
+      std::size_t index{0};
+    };
+
   public:
     virtual ~IStatistics() = default;
 
     virtual bool delete_all_history() = 0;
     virtual void update() = 0;
     virtual DailyStats *get_current_day() const = 0;
-    virtual DailyStats *get_day(int day) const = 0;
+    virtual DailyStatsView get_day(int day) const = 0;
     virtual void get_day_index_by_date(int y, int m, int d, int &idx, int &next, int &prev) const = 0;
     virtual int get_history_size() const = 0;
     virtual void dump() = 0;
+
+    //! Returns the statistics of the days from 'from' up to and including 'to', in days since 1970-01-01.
+    /*!
+     *  Only days with statistics are returned, in ascending order, and at
+     *  most max_days of them unless max_days is 0. The values are stored
+     *  field by field: the value of fields[f] on days[i] is at
+     *  values[f * days.size() + i]. Returns the day from which to continue
+     *  when more days are available, or to + 1.
+     */
+    virtual int32_t get_range(int32_t from,
+                              int32_t to,
+                              const std::vector<int> &fields,
+                              int max_days,
+                              std::vector<int32_t> &days,
+                              std::vector<int64_t> &values) const = 0;
+
+  protected:
+    //! Implements get_range() for the history arena and the current day.
+    static int32_t collect_range(const workrave::utils::RecordArena &history,
+                                 const DailyStats *today,
+                                 int32_t from,
+                                 int32_t to,
+                                 const std::vector<int> &fields,
+                                 int max_days,
+                                 std::vector<int32_t> &days,
+                                 std::vector<int64_t> &values);
   };
 } // namespace workrave
 
@@ -0,0 +1,161 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <glib.h>
+#include <glib-unix.h>
+
+#include "config/ConfiguratorFactory.hh"
+#include "config/IConfigurator.hh"
+#include "core/CoreConfig.hh"
+#include "dbus/DBusFactory.hh"
+#include "debug.hh"
+#include "utils/StateWriter.hh"
+
+#include "SessionServer.hh"
+#include "SessionSocket.hh"
+
+using namespace workrave;
+using namespace workrave::config;
+
+namespace
+{
+  struct Daemon
+  {
+    IConfigurator::Ptr config;
+    SessionServer::Ptr server;
+    std::unique_ptr<SessionSocket> socket;
+    GMainLoop *loop{nullptr};
+  };
+
+  gboolean on_heartbeat(gpointer data)
+  {
+    auto *daemon = static_cast<Daemon *>(data);
+    daemon->config->heartbeat();
+    daemon->socket->process();
+    daemon->server->heartbeat();
+    return G_SOURCE_CONTINUE;
+  }
+
+  gboolean on_signal(gpointer data)
+  {
+    auto *daemon = static_cast<Daemon *>(data);
+    g_main_loop_quit(daemon->loop);
+    return G_SOURCE_REMOVE;
+  }
+
+  void usage(const char *name)
+  {
+    std::cerr << "Usage: " << name << " [--socket PATH] [--state DIRECTORY] [--config FILE] [--threads N]" << std::endl;
+  }
+} // namespace
+
+//! Headless daemon that runs the breaks of all users of a machine.
+/*!
+ *  Sessions are added and fed with activity through SessionSocket, or
+ *  through org.workrave.SessionServerInterface if a D-Bus session bus
+ *  is available.
+ */
+int
+main(int argc, char **argv)
+{
+  std::filesystem::path socket_path = "/run/workrave/session-server.sock";
+  std::filesystem::path state_directory = "/var/lib/workrave/sessions";
+  std::filesystem::path config_file = "/etc/workrave/session-server.ini";
+  int num_threads = 0;
+
+  for (int i = 1; i < argc; i++)
+    {
+      std::string arg = argv[i];
+      if (i + 1 < argc && arg == "--socket")
+        {
+          socket_path = argv[++i];
+        }
+      else if (i + 1 < argc && arg == "--state")
+        {
+          state_directory = argv[++i];
+        }
+      else if (i + 1 < argc && arg == "--config")
+        {
+          config_file = argv[++i];
+        }
+      else if (i + 1 < argc && arg == "--threads")
+        {
+          num_threads = std::atoi(argv[++i]);
+        }
+      else
+        {
+          usage(argv[0]);
+          return arg == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+#ifdef TRACING
+  Debug::init("session-server-");
+#endif
+
+  Daemon daemon;
+
+  // All sessions share the configuration of the server.
+  daemon.config = ConfiguratorFactory::create(ConfigFileFormat::Ini);
+  if (std::filesystem::is_regular_file(config_file))
+    {
+      daemon.config->load(config_file.u8string());
+    }
+  CoreConfig::init(daemon.config);
+
+  dbus::IDBus::Ptr dbus = dbus::DBusFactory::create();
+  dbus->init();
+
+  daemon.server = std::make_shared<SessionServer>(dbus, state_directory, num_threads);
+  daemon.server->init();
+  if (dbus->is_available())
+    {
+      dbus->register_service("org.workrave.SessionServer");
+    }
+
+  daemon.socket = std::make_unique<SessionSocket>(daemon.server, socket_path);
+  if (!daemon.socket->init())
+    {
+      std::cerr << argv[0] << ": cannot listen on " << socket_path.u8string() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+  daemon.loop = g_main_loop_new(nullptr, FALSE);
+  g_unix_signal_add(SIGINT, on_signal, &daemon);
+  g_unix_signal_add(SIGTERM, on_signal, &daemon);
+  g_timeout_add_seconds(1, on_heartbeat, &daemon);
+
+  g_main_loop_run(daemon.loop);
+  g_main_loop_unref(daemon.loop);
+
+  // Sessions store their state when they are destroyed.
+  daemon.socket.reset();
+  daemon.server.reset();
+  workrave::utils::StateWriter::instance().shutdown();
+  return EXIT_SUCCESS;
+}
@@ -33,17 +33,18 @@ Break::Break(BreakId break_id,
              IActivityMonitor::Ptr activity_monitor,
              Statistics::Ptr statistics,
              IDBus::Ptr dbus,
-             CoreHooks::Ptr hooks)
+             CoreHooks::Ptr hooks,
+             const std::string &dbus_path)
   : break_id(break_id)
   , timer(timer)
 {
   break_state_model = std::make_shared<BreakStateModel>(break_id, app, timer, activity_monitor, hooks);
   break_statistics = std::make_shared<BreakStatistics>(break_id, break_state_model, timer, statistics);
   break_configuration = std::make_shared<BreakConfig>(break_id, break_state_model, timer);
-  break_dbus = std::make_shared<BreakDBus>(break_id, break_state_model, dbus);
+  break_dbus = std::make_shared<BreakDBus>(break_id, break_state_model, dbus, dbus_path);
 }
 
-boost::signals2::signal<void(BreakEvent)> &
+workrave::utils::Signal<void(BreakEvent)> &
 Break::signal_break_event()
 {
   return break_state_model->signal_break_event();
@@ -44,10 +44,11 @@ public:
         IActivityMonitor::Ptr activity_monitor,
         Statistics::Ptr statistics,
         workrave::dbus::IDBus::Ptr dbus,
-        CoreHooks::Ptr hooks);
+        CoreHooks::Ptr hooks,
+        const std::string &dbus_path = "/org/workrave/Workrave");
 
   // IBreak
-  boost::signals2::signal<void(workrave::BreakEvent)> &signal_break_event() override;
+  workrave::utils::Signal<void(workrave::BreakEvent)> &signal_break_event() override;
   [[nodiscard]] std::string get_name() const override;
   [[nodiscard]] bool is_enabled() const override;
   [[nodiscard]] bool is_running() const override;
@@ -33,12 +33,12 @@ using namespace workrave;
 using namespace workrave::dbus;
 using namespace std;
 
-BreakDBus::BreakDBus(BreakId break_id, BreakStateModel::Ptr break_state_model, IDBus::Ptr dbus)
+BreakDBus::BreakDBus(BreakId break_id, BreakStateModel::Ptr break_state_model, IDBus::Ptr dbus, const std::string &dbus_path)
   : break_id(break_id)
   , break_state_model(break_state_model)
   , dbus(dbus)
+  , path(dbus_path + "/Break/" + CoreConfig::get_break_name(break_id))
 {
-  string break_name = CoreConfig::get_break_name(break_id);
 
   connect(break_state_model->signal_break_stage_changed(), this, [this](auto &&stage) {
     on_break_stage_changed(std::forward<decltype(stage)>(stage));
@@ -47,7 +47,6 @@ BreakDBus::BreakDBus(BreakId break_id, BreakStateModel::Ptr break_state_model, I
 
   try
     {
-      string path = string("/org/workrave/Workrave/Break/" + break_name);
       dbus->connect(path, "org.workrave.BreakInterface", this);
       dbus->register_object_path(path);
     }
@@ -56,6 +55,17 @@ BreakDBus::BreakDBus(BreakId break_id, BreakStateModel::Ptr break_state_model, I
     }
 }
 
+BreakDBus::~BreakDBus()
+{
+  try
+    {
+      dbus->disconnect(path, "org.workrave.BreakInterface");
+    }
+  catch (dbus::DBusException &)
+    {
+    }
+}
+
 void
 BreakDBus::on_break_event(BreakEvent event)
 {
@@ -63,8 +73,7 @@ BreakDBus::on_break_event(BreakEvent event)
   org_workrave_BreakInterface *iface = org_workrave_BreakInterface::instance(dbus);
   if (iface != nullptr)
     {
-      string break_name = CoreConfig::get_break_name(break_id);
-      iface->BreakEvent("/org/workrave/Workrave/Break/" + break_name, event);
+      iface->BreakEvent(path, event);
     }
 #endif
 }
@@ -83,8 +92,7 @@ BreakDBus::on_break_stage_changed(BreakStage stage)
       org_workrave_BreakInterface *iface = org_workrave_BreakInterface::instance(dbus);
       if (iface != nullptr)
         {
-          string break_name = CoreConfig::get_break_name(break_id);
-          iface->BreakStateChanged("/org/workrave/Workrave/Break/" + break_name, progress);
+          iface->BreakStateChanged(path, progress);
         }
     }
 #endif
@@ -19,6 +19,7 @@
 #define BREAKDBUS_HH
 
 #include <memory>
+#include <string>
 
 #include "dbus/IDBus.hh"
 #include "utils/Signals.hh"
@@ -31,8 +32,11 @@ public:
   using Ptr = std::shared_ptr<BreakDBus>;
 
 public:
-  BreakDBus(workrave::BreakId break_id, BreakStateModel::Ptr break_state_model, workrave::dbus::IDBus::Ptr dbus);
-  virtual ~BreakDBus() = default;
+  BreakDBus(workrave::BreakId break_id,
+            BreakStateModel::Ptr break_state_model,
+            workrave::dbus::IDBus::Ptr dbus,
+            const std::string &dbus_path = "/org/workrave/Workrave");
+  virtual ~BreakDBus();
 
 private:
   void on_break_stage_changed(BreakStage stage);
@@ -42,6 +46,9 @@ private:
   workrave::BreakId break_id;
   BreakStateModel::Ptr break_state_model;
   workrave::dbus::IDBus::Ptr dbus;
+
+  //! Object path of the break.
+  std::string path;
 };
 
 #endif // BREAKDBUS_HH
@@ -298,13 +298,13 @@ BreakStateModel::override(BreakId id)
   TRACE_EXIT();
 }
 
-boost::signals2::signal<void(BreakEvent)> &
+workrave::utils::Signal<void(BreakEvent)> &
 BreakStateModel::signal_break_event()
 {
   return break_event_signal;
 }
 
-boost::signals2::signal<void(BreakStage)> &
+workrave::utils::Signal<void(BreakStage)> &
 BreakStateModel::signal_break_stage_changed()
 {
   return break_stage_changed_signal;
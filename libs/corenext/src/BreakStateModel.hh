@@ -19,7 +19,8 @@
 #define BREAKSTATEMODEL_HH
 
 #include <memory>
-#include <boost/signals2.hpp>
+
+#include "utils/Signals.hh"
 
 #include "config/IConfigurator.hh"
 
@@ -96,8 +97,8 @@ public:
   void stop_break();
   void override(workrave::BreakId id);
 
-  boost::signals2::signal<void(workrave::BreakEvent)> &signal_break_event();
-  boost::signals2::signal<void(BreakStage)> &signal_break_stage_changed();
+  workrave::utils::Signal<void(workrave::BreakEvent)> &signal_break_event();
+  workrave::utils::Signal<void(BreakStage)> &signal_break_stage_changed();
 
   bool is_taking() const;
   bool is_active() const;
@@ -170,8 +171,8 @@ private:
   bool enabled;
 
   //!
-  boost::signals2::signal<void(workrave::BreakEvent)> break_event_signal;
-  boost::signals2::signal<void(BreakStage)> break_stage_changed_signal;
+  workrave::utils::Signal<void(workrave::BreakEvent)> break_event_signal;
+  workrave::utils::Signal<void(BreakStage)> break_stage_changed_signal;
 };
 
 #endif // BREAKSTATEMODEL_HH
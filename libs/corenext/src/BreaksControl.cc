@@ -23,9 +23,10 @@
 
 #include <iostream>
 #include <fstream>
-#include <sstream>
+#include <utility>
 
 #include "utils/Paths.hh"
+#include "utils/StateWriter.hh"
 #include "utils/TimeSource.hh"
 #include "dbus/IDBus.hh"
 
@@ -46,13 +47,17 @@ BreaksControl::BreaksControl(IApp *app,
                              CoreModes::Ptr modes,
                              Statistics::Ptr statistics,
                              IDBus::Ptr dbus,
-                             CoreHooks::Ptr hooks)
+                             CoreHooks::Ptr hooks,
+                             std::filesystem::path state_directory,
+                             std::string dbus_path)
   : application(app)
   , activity_monitor(activity_monitor)
   , modes(modes)
   , statistics(statistics)
   , dbus(dbus)
   , hooks(hooks)
+  , state_directory(std::move(state_directory))
+  , dbus_path(std::move(dbus_path))
   , insist_policy(InsistPolicy::Halt)
   , active_insist_policy(InsistPolicy::Invalid)
 {
@@ -61,6 +66,7 @@ BreaksControl::BreaksControl(IApp *app,
 BreaksControl::~BreaksControl()
 {
   save_state();
+  StateWriter::instance().flush();
 }
 
 void
@@ -70,14 +76,16 @@ BreaksControl::init()
     on_operation_mode_changed(std::forward<decltype(mode)>(mode));
   });
 
+  timer_bank = std::make_shared<TimerBank>();
   for (BreakId break_id = BREAK_ID_MICRO_BREAK; break_id < BREAK_ID_SIZEOF; break_id++)
     {
       string break_name = CoreConfig::get_break_name(break_id);
 
-      timers[break_id] = std::make_shared<Timer>(break_name);
+      timers[break_id] = std::make_shared<Timer>(break_name, timer_bank);
       timers[break_id]->enable();
 
-      breaks[break_id] = std::make_shared<Break>(break_id, application, timers[break_id], activity_monitor, statistics, dbus, hooks);
+      breaks[break_id] =
+        std::make_shared<Break>(break_id, application, timers[break_id], activity_monitor, statistics, dbus, hooks, dbus_path);
       connect(breaks[break_id]->signal_break_event(), this, [this, break_id](auto &&event) {
         on_break_event(break_id, std::forward<decltype(event)>(event));
       });
@@ -179,50 +187,66 @@ BreaksControl::process_timers(bool user_is_active)
 {
   TRACE_ENTER("BreaksControl::process_timers");
 
+  // From the daily limit down: the event of a break is handled before the
+  // timers of the shorter breaks run in the same second, e.g. a daily reset
+  // or the start of a rest break.
   for (int i = BREAK_ID_DAILY_LIMIT; i > BREAK_ID_NONE; i--)
     {
       BreakId break_id = static_cast<BreakId>(i);
+      TimerEvent event = timers[break_id]->process(is_user_active_for_break(break_id, user_is_active));
+      process_timer_event(break_id, event);
+    }
 
-      bool user_is_active_for_break = user_is_active;
-      if (breaks[break_id]->is_microbreak_used_for_activity())
-        {
-          user_is_active_for_break = microbreak_activity_monitor->is_active();
-        }
+  TRACE_EXIT();
+}
+
+bool
+BreaksControl::is_user_active_for_break(BreakId break_id, bool user_is_active)
+{
+  if (breaks[break_id]->is_microbreak_used_for_activity())
+    {
+      return microbreak_activity_monitor->is_active();
+    }
+  return user_is_active;
+}
 
-      TimerEvent event = timers[break_id]->process(user_is_active_for_break);
+//! Starts or stops a break on an event of its timer.
+void
+BreaksControl::process_timer_event(BreakId break_id, TimerEvent event)
+{
+  TRACE_ENTER_MSG("BreaksControl::process_timer_event", break_id << " " << event);
 
-      if (breaks[break_id]->is_enabled())
+  if (breaks[break_id]->is_enabled())
+    {
+      switch (event)
         {
-          switch (event)
+        case TIMER_EVENT_LIMIT_REACHED:
+          TRACE_MSG("limit reached" << break_id);
+          if (!breaks[break_id]->is_active() && modes->get_operation_mode() == OperationMode::Normal)
             {
-            case TIMER_EVENT_LIMIT_REACHED:
-              TRACE_MSG("limit reached" << break_id);
-              if (!breaks[break_id]->is_active() && modes->get_operation_mode() == OperationMode::Normal)
-                {
-                  start_break(break_id);
-                }
-              break;
+              start_break(break_id);
+            }
+          break;
 
-            case TIMER_EVENT_NATURAL_RESET:
-            case TIMER_EVENT_RESET:
-              TRACE_MSG("limi reset" << break_id);
-              if (breaks[break_id]->is_active())
-                {
-                  breaks[break_id]->stop_break();
-                }
+        case TIMER_EVENT_NATURAL_RESET:
+        case TIMER_EVENT_RESET:
+          TRACE_MSG("limi reset" << break_id);
+          if (breaks[break_id]->is_active())
+            {
+              breaks[break_id]->stop_break();
+            }
 
-              if (break_id == BREAK_ID_DAILY_LIMIT)
+          if (break_id == BREAK_ID_DAILY_LIMIT)
+            {
+              for (BreakId i = BREAK_ID_MICRO_BREAK; i < BREAK_ID_SIZEOF; i++)
                 {
-                  for (BreakId i = BREAK_ID_MICRO_BREAK; i < BREAK_ID_SIZEOF; i++)
-                    {
-                      breaks[i]->daily_reset();
-                    }
+                  breaks[i]->daily_reset();
                 }
-              break;
-
-            case TIMER_EVENT_NONE:
-              break;
             }
+          break;
+
+        case TIMER_EVENT_NONE:
+          break;
         }
     }
 
@@ -437,28 +461,30 @@ BreaksControl::on_break_event(BreakId break_id, BreakEvent event)
 
 //! Saves the current state.
 void
-BreaksControl::save_state() const
+BreaksControl::save_state()
 {
-  std::filesystem::path path = Paths::get_state_directory() / "state";
-  ofstream stateFile(path.u8string());
+  if (state_path.empty())
+    {
+      state_path = get_state_directory() / "state";
+    }
 
-  stateFile << "WorkRaveState 3" << endl << TimeSource::get_real_time_sec() << endl;
+  state_stream.reset();
+  state_stream << "WorkRaveState 3" << endl << TimeSource::get_real_time_sec() << endl;
 
   for (BreakId break_id = BREAK_ID_MICRO_BREAK; break_id < BREAK_ID_SIZEOF; break_id++)
     {
-      const string stateStr = timers[break_id]->serialize_state();
-
-      stateFile << stateStr << endl;
+      timers[break_id]->serialize_state(state_stream);
+      state_stream << endl;
     }
 
-  stateFile.close();
+  StateWriter::instance().write(state_path, state_stream.str());
 }
 
 //! Loads the current state.
 void
 BreaksControl::load_state()
 {
-  std::filesystem::path path = Paths::get_state_directory() / "state";
+  std::filesystem::path path = get_state_directory() / "state";
 
 #ifdef HAVE_TESTS
   if (hooks->hook_load_timer_state())
@@ -513,3 +539,9 @@ BreaksControl::load_state()
         }
     }
 }
+
+std::filesystem::path
+BreaksControl::get_state_directory() const
+{
+  return state_directory.empty() ? Paths::get_state_directory() : state_directory;
+}
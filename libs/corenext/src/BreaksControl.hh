@@ -18,11 +18,16 @@
 #ifndef BREAKSCONTROL_HH
 #define BREAKSCONTROL_HH
 
+#include <filesystem>
+#include <string>
+
 #include "config/Config.hh"
+#include "utils/StringOutputStream.hh"
 #include "dbus/IDBus.hh"
 
 #include "Break.hh"
 #include "Timer.hh"
+#include "TimerBank.hh"
 
 #include "core/ICore.hh"
 #include "CoreModes.hh"
@@ -43,12 +48,14 @@ public:
                 CoreModes::Ptr modes,
                 Statistics::Ptr statistics,
                 workrave::dbus::IDBus::Ptr dbus,
-                CoreHooks::Ptr hooks);
+                CoreHooks::Ptr hooks,
+                std::filesystem::path state_directory = {},
+                std::string dbus_path = "/org/workrave/Workrave");
   virtual ~BreaksControl();
 
   void init();
   void heartbeat();
-  void save_state() const;
+  void save_state();
 
   void force_break(workrave::BreakId id, workrave::utils::Flags<workrave::BreakHint> break_hint);
 
@@ -59,12 +66,15 @@ public:
 private:
   void set_freeze_all_breaks(bool freeze);
   void process_timers(bool user_is_active);
+  bool is_user_active_for_break(workrave::BreakId break_id, bool user_is_active);
+  void process_timer_event(workrave::BreakId break_id, TimerEvent event);
   void start_break(workrave::BreakId break_id, workrave::BreakId resume_this_break = workrave::BREAK_ID_NONE);
   void load_state();
   void defrost();
   void freeze();
   void force_idle();
   void stop_all_breaks();
+  std::filesystem::path get_state_directory() const;
 
   void on_operation_mode_changed(const workrave::OperationMode m);
   void on_break_event(workrave::BreakId break_id, workrave::BreakEvent event);
@@ -81,7 +91,20 @@ private:
   workrave::dbus::IDBus::Ptr dbus;
   CoreHooks::Ptr hooks;
 
+  //! Directory of the timer state, empty for the default.
+  std::filesystem::path state_directory;
+
+  //! Location of the timer state, resolved on the first save.
+  std::filesystem::path state_path;
+
+  //! Timer state snapshot, reused on every save.
+  workrave::utils::StringOutputStream state_stream;
+
+  //! Object path prefix of the breaks.
+  std::string dbus_path;
+
   Break::Ptr breaks[workrave::BREAK_ID_SIZEOF];
+  TimerBank::Ptr timer_bank;
   Timer::Ptr timers[workrave::BREAK_ID_SIZEOF];
 
   workrave::InsistPolicy insist_policy;
@@ -219,6 +219,9 @@ Core::heartbeat()
   // Process breaks
   breaks_control->heartbeat();
 
+  // Drop expired operation mode overrides
+  core_modes->heartbeat();
+
   TRACE_EXIT();
 }
 
@@ -226,13 +229,13 @@ Core::heartbeat()
 /**** ICore Interface                                                      ******/
 /********************************************************************************/
 
-boost::signals2::signal<void(OperationMode)> &
+workrave::utils::Signal<void(OperationMode)> &
 Core::signal_operation_mode_changed()
 {
   return core_modes->signal_operation_mode_changed();
 }
 
-boost::signals2::signal<void(UsageMode)> &
+workrave::utils::Signal<void(UsageMode)> &
 Core::signal_usage_mode_changed()
 {
   return core_modes->signal_usage_mode_changed();
@@ -321,6 +324,13 @@ Core::set_operation_mode_override(OperationMode mode, const std::string &id)
   core_modes->set_operation_mode_override(mode, id);
 }
 
+//! Temporarily overrides the operation mode, until the lifetime (in seconds) expires.
+void
+Core::set_operation_mode_override_with_lifetime(OperationMode mode, const std::string &id, int32_t lifetime)
+{
+  core_modes->set_operation_mode_override(mode, id, lifetime);
+}
+
 //! Removes the overridden operation mode.
 void
 Core::remove_operation_mode_override(const std::string &id)
@@ -44,8 +44,8 @@ public:
   ~Core() override;
 
   // ICore
-  boost::signals2::signal<void(workrave::OperationMode)> &signal_operation_mode_changed() override;
-  boost::signals2::signal<void(workrave::UsageMode)> &signal_usage_mode_changed() override;
+  workrave::utils::Signal<void(workrave::OperationMode)> &signal_operation_mode_changed() override;
+  workrave::utils::Signal<void(workrave::UsageMode)> &signal_usage_mode_changed() override;
   void init(workrave::IApp *application, const char *display_name) override;
   void heartbeat() override;
   void force_break(workrave::BreakId id, workrave::utils::Flags<workrave::BreakHint> break_hint) override;
@@ -61,6 +61,7 @@ public:
   void set_operation_mode(workrave::OperationMode mode) override;
   void set_operation_mode_override(workrave::OperationMode mode, const std::string &id) override;
   void remove_operation_mode_override(const std::string &id) override;
+  void set_operation_mode_override_with_lifetime(workrave::OperationMode mode, const std::string &id, int32_t lifetime);
   workrave::UsageMode get_usage_mode() override;
   void set_usage_mode(workrave::UsageMode mode) override;
   void set_powersave(bool down) override;
@@ -23,14 +23,17 @@
 
 #include "CoreModes.hh"
 #include "core/CoreConfig.hh"
+#include "utils/TimeSource.hh"
 
 using namespace std;
 using namespace workrave;
+using namespace workrave::utils;
 
-CoreModes::CoreModes(IActivityMonitor::Ptr monitor)
+CoreModes::CoreModes(IActivityMonitor::Ptr monitor, bool persistent)
   : operation_mode(OperationMode::Normal)
   , operation_mode_regular(OperationMode::Normal)
   , usage_mode(UsageMode::Normal)
+  , persistent(persistent)
   , monitor(monitor)
 {
   TRACE_ENTER("CoreModes::CoreModes");
@@ -44,13 +47,13 @@ CoreModes::~CoreModes()
   TRACE_EXIT();
 }
 
-boost::signals2::signal<void(OperationMode)> &
+workrave::utils::Signal<void(OperationMode)> &
 CoreModes::signal_operation_mode_changed()
 {
   return operation_mode_changed_signal;
 }
 
-boost::signals2::signal<void(UsageMode)> &
+workrave::utils::Signal<void(UsageMode)> &
 CoreModes::signal_usage_mode_changed()
 {
   return usage_mode_changed_signal;
@@ -80,160 +83,109 @@ CoreModes::get_operation_mode_regular()
 bool
 CoreModes::is_operation_mode_an_override()
 {
-  return !!operation_mode_overrides.size();
+  return !operation_mode_overrides.empty();
 }
 
 //! Sets the operation mode.
 void
 CoreModes::set_operation_mode(OperationMode mode)
 {
-  set_operation_mode_internal(mode, true);
+  set_operation_mode_internal(mode, persistent);
 }
 
 //! Temporarily overrides the operation mode.
+/*!
+ *  Setting an override with the same id again replaces it. If lifetime
+ *  (in seconds) is not 0, the override is removed automatically unless it
+ *  is set again within that time.
+ */
 void
-CoreModes::set_operation_mode_override(OperationMode mode, const std::string &id)
+CoreModes::set_operation_mode_override(OperationMode mode, const std::string &id, int64_t lifetime)
 {
-  if (!id.size())
+  TRACE_ENTER_MSG("CoreModes::set_operation_mode_override", id << " " << mode << " " << lifetime);
+
+  if (!id.size() || !is_valid(mode))
     {
+      TRACE_RETURN("No change: incoming invalid");
       return;
     }
 
-  set_operation_mode_internal(mode, false, id);
+  int64_t expires_at = 0;
+  if (lifetime > 0)
+    {
+      expires_at = TimeSource::get_monotonic_time_usec() + lifetime * TimeSource::TIME_USEC_PER_SEC;
+    }
+
+  operation_mode_overrides.set(id, mode, expires_at);
+  update_operation_mode();
+
+  TRACE_EXIT();
 }
 
 //! Removes the overridden operation mode.
 void
 CoreModes::remove_operation_mode_override(const std::string &id)
 {
-  TRACE_ENTER("CoreModes::remove_operation_mode_override");
+  TRACE_ENTER_MSG("CoreModes::remove_operation_mode_override", id);
 
-  if (!id.size() || !operation_mode_overrides.count(id))
+  if (operation_mode_overrides.remove(id))
     {
-      return;
-    }
-
-  operation_mode_overrides.erase(id);
-
-  /* If there are other overrides still in the queue then pass in the first
-     override in the map. set_operation_mode_internal() will then search the
-     map for the most important override and set it as the active operation mode.
-  */
-  if (operation_mode_overrides.size())
-    {
-      set_operation_mode_internal(operation_mode_overrides.begin()->second, false, operation_mode_overrides.begin()->first);
-    }
-  else
-    {
-      /* if operation_mode_regular is the same as the active operation mode then just
-         signal the mode has changed. During overrides the signal is not sent so it needs to
-         be sent now. Because the modes are the same it would not be called by
-         set_operation_mode_internal().
-      */
-      if (operation_mode_regular == operation_mode)
-        {
-          TRACE_MSG("Only calling core_event_operation_mode_changed().");
-
-          operation_mode_changed_signal(operation_mode_regular);
-        }
-      else
-        {
-          set_operation_mode_internal(operation_mode_regular, false);
-        }
+      update_operation_mode();
     }
 
   TRACE_EXIT();
 }
 
-//! Set the operation mode.
+//! Removes expired overrides.
 void
-CoreModes::set_operation_mode_internal(OperationMode mode, bool persistent, const std::string &override_id /* default param: empty string */
-)
+CoreModes::heartbeat()
 {
-  TRACE_ENTER_MSG("CoreModes::set_operation_mode", (persistent ? "persistent" : ""));
-
-  if (override_id.size())
+  if (operation_mode_overrides.expire(TimeSource::get_monotonic_time_usec()))
     {
-      TRACE_MSG("override_id: " << override_id);
+      update_operation_mode();
     }
+}
 
-  TRACE_MSG("Incoming/requested mode is " << (mode == OperationMode::Normal      ? "OperationMode::Normal"
-                                              : mode == OperationMode::Suspended ? "OperationMode::Suspended"
-                                              : mode == OperationMode::Quiet     ? "OperationMode::Quiet"
-                                                                                 : "???")
-                                          << (override_id.size() ? " (override)" : " (regular)"));
-
-  TRACE_MSG("Current mode is " << (operation_mode == OperationMode::Normal      ? "OperationMode::Normal"
-                                   : operation_mode == OperationMode::Suspended ? "OperationMode::Suspended"
-                                   : operation_mode == OperationMode::Quiet     ? "OperationMode::Quiet"
-                                                                                : "???")
-                               << (operation_mode_overrides.size() ? " (override)" : " (regular)"));
+//! Sets the regular operation mode.
+void
+CoreModes::set_operation_mode_internal(OperationMode mode, bool persistent)
+{
+  TRACE_ENTER_MSG("CoreModes::set_operation_mode_internal", mode << " " << (persistent ? "persistent" : ""));
 
-  if ((mode != OperationMode::Normal) && (mode != OperationMode::Quiet) && (mode != OperationMode::Suspended))
+  if (!is_valid(mode))
     {
       TRACE_RETURN("No change: incoming invalid");
       return;
     }
 
-  /* If the incoming operation mode is regular and the current operation mode is an
-     override then save the incoming operation mode and return.
-  */
-  if (!override_id.size() && operation_mode_overrides.size())
-    {
-      operation_mode_regular = mode;
+  operation_mode_regular = mode;
 
-      operation_mode_changed_signal(operation_mode);
+  // Storing the mode calls back into this function; by then the regular mode is already up to date.
+  if (persistent && CoreConfig::operation_mode()() != mode)
+    {
+      CoreConfig::operation_mode().set(mode);
+    }
 
-      OperationMode cm = CoreConfig::operation_mode()();
-      if (persistent && (cm != mode))
-        {
-          CoreConfig::operation_mode().set(mode);
-        }
+  update_operation_mode();
 
-      TRACE_RETURN("No change: current is an override type but incoming is regular");
-      return;
-    }
+  TRACE_EXIT();
+}
 
-  // If the incoming operation mode is tagged as an override
-  if (override_id.size())
-    {
-      // Add this override to the map
-      operation_mode_overrides[override_id] = mode;
+//! Activates the most important override, or the regular mode if there is none.
+void
+CoreModes::update_operation_mode()
+{
+  TRACE_ENTER("CoreModes::update_operation_mode");
 
-      /* Find the most important override. Override modes in order of importance:
-         OperationMode::Suspended, OperationMode::Quiet, OperationMode::Normal
-      */
-      for (auto i = operation_mode_overrides.begin(); (i != operation_mode_overrides.end()); ++i)
-        {
-          if (i->second == OperationMode::Suspended)
-            {
-              mode = OperationMode::Suspended;
-              break;
-            }
-
-          if ((i->second == OperationMode::Quiet) && (mode == OperationMode::Normal))
-            {
-              mode = OperationMode::Quiet;
-            }
-        }
-    }
+  OperationMode mode = operation_mode_overrides.empty() ? operation_mode_regular : operation_mode_overrides.get_mode();
 
   if (operation_mode != mode)
     {
-      TRACE_MSG("Changing active operation mode to " << (mode == OperationMode::Normal      ? "OperationMode::Normal"
-                                                         : mode == OperationMode::Suspended ? "OperationMode::Suspended"
-                                                         : mode == OperationMode::Quiet     ? "OperationMode::Quiet"
-                                                                                            : "???"));
+      TRACE_MSG("Changing active operation mode to " << mode);
 
       OperationMode previous_mode = operation_mode;
-
       operation_mode = mode;
 
-      if (!operation_mode_overrides.size())
-        {
-          operation_mode_regular = operation_mode;
-        }
-
       if (operation_mode == OperationMode::Suspended)
         {
           monitor->suspend();
@@ -243,26 +195,18 @@ CoreModes::set_operation_mode_internal(OperationMode mode, bool persistent, cons
           monitor->resume();
         }
 
-      if (!operation_mode_overrides.size())
-        {
-          /* The two functions in this block will trigger signals that can call back into this function.
-             Only if there are no overrides in place will that reentrancy be ok from here.
-             Otherwise the regular/user mode to restore would be overwritten.
-          */
-
-          if (persistent)
-            {
-              CoreConfig::operation_mode().set(operation_mode);
-            }
-
-          TRACE_MSG("Send event");
-          operation_mode_changed_signal(operation_mode);
-        }
+      operation_mode_changed_signal(operation_mode);
     }
 
   TRACE_EXIT();
 }
 
+bool
+CoreModes::is_valid(OperationMode mode)
+{
+  return mode == OperationMode::Normal || mode == OperationMode::Quiet || mode == OperationMode::Suspended;
+}
+
 //! Retrieves the usage mode.
 UsageMode
 CoreModes::get_usage_mode()
@@ -274,7 +218,7 @@ CoreModes::get_usage_mode()
 void
 CoreModes::set_usage_mode(UsageMode mode)
 {
-  set_usage_mode_internal(mode, true);
+  set_usage_mode_internal(mode, persistent);
 }
 
 //! Sets the usage mode.
@@ -19,11 +19,10 @@
 #define COREMODES_HH
 
 #include <string>
-#include <map>
 #include <memory>
-#include <boost/signals2.hpp>
 
 #include "IActivityMonitor.hh"
+#include "OperationModeOverrides.hh"
 
 #include "core/CoreTypes.hh"
 #include "utils/Signals.hh"
@@ -33,23 +32,27 @@ class CoreModes : public workrave::utils::Trackable
 public:
   using Ptr = std::shared_ptr<CoreModes>;
 
-  explicit CoreModes(IActivityMonitor::Ptr monitor);
+  //! Modes set on a non-persistent instance are not stored in the configuration.
+  explicit CoreModes(IActivityMonitor::Ptr monitor, bool persistent = true);
   virtual ~CoreModes();
 
-  boost::signals2::signal<void(workrave::OperationMode)> &signal_operation_mode_changed();
-  boost::signals2::signal<void(workrave::UsageMode)> &signal_usage_mode_changed();
+  workrave::utils::Signal<void(workrave::OperationMode)> &signal_operation_mode_changed();
+  workrave::utils::Signal<void(workrave::UsageMode)> &signal_usage_mode_changed();
 
   workrave::OperationMode get_operation_mode();
   workrave::OperationMode get_operation_mode_regular();
   bool is_operation_mode_an_override();
   void set_operation_mode(workrave::OperationMode mode);
-  void set_operation_mode_override(workrave::OperationMode mode, const std::string &id);
+  void set_operation_mode_override(workrave::OperationMode mode, const std::string &id, int64_t lifetime = 0);
   void remove_operation_mode_override(const std::string &id);
+  void heartbeat();
   workrave::UsageMode get_usage_mode();
   void set_usage_mode(workrave::UsageMode mode);
 
 private:
-  void set_operation_mode_internal(workrave::OperationMode mode, bool persistent, const std::string &override_id = "");
+  void set_operation_mode_internal(workrave::OperationMode mode, bool persistent);
+  void update_operation_mode();
+  static bool is_valid(workrave::OperationMode mode);
   void set_usage_mode_internal(workrave::UsageMode mode, bool persistent);
   void load_config();
 
@@ -61,19 +64,22 @@ private:
   workrave::OperationMode operation_mode_regular;
 
   //! Active operation mode overrides.
-  std::map<std::string, workrave::OperationMode> operation_mode_overrides;
+  OperationModeOverrides operation_mode_overrides;
 
   //! Current usage mode.
   workrave::UsageMode usage_mode;
 
+  //! Store modes in the configuration?
+  bool persistent;
+
   //!
   IActivityMonitor::Ptr monitor;
 
   //! Operation mode changed notification.
-  boost::signals2::signal<void(workrave::OperationMode)> operation_mode_changed_signal;
+  workrave::utils::Signal<void(workrave::OperationMode)> operation_mode_changed_signal;
 
   //! Usage mode changed notification.
-  boost::signals2::signal<void(workrave::UsageMode)> usage_mode_changed_signal;
+  workrave::utils::Signal<void(workrave::UsageMode)> usage_mode_changed_signal;
 };
 
 #endif // COREMODES_HH
@@ -0,0 +1,281 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "core/IStatistics.hh"
+
+#include <algorithm>
+#include <limits>
+
+#include "utils/Calendar.hh"
+#include "utils/RecordArena.hh"
+
+using namespace workrave;
+
+bool
+IStatistics::DailyStatsView::is_empty() const
+{
+  return stats != nullptr ? stats->start.tm_year == 0 : history == nullptr;
+}
+
+struct tm
+IStatistics::DailyStatsView::get_start() const
+{
+  if (stats != nullptr)
+    {
+      return stats->start;
+    }
+  return get_time(history != nullptr ? history->get_field(index, FIELD_START) : 0);
+}
+
+struct tm
+IStatistics::DailyStatsView::get_stop() const
+{
+  if (stats != nullptr)
+    {
+      return stats->stop;
+    }
+  return get_time(history != nullptr ? history->get_field(index, FIELD_STOP) : 0);
+}
+
+int
+IStatistics::DailyStatsView::get_break_stat(BreakId break_id, StatsBreakValueType type) const
+{
+  if (stats != nullptr)
+    {
+      return stats->break_stats[break_id][type];
+    }
+  if (history != nullptr)
+    {
+      return static_cast<int>(history->get_field(index, FIELD_BREAK_STATS + break_id * STATS_BREAKVALUE_SIZEOF + type));
+    }
+  return 0;
+}
+
+int64_t
+IStatistics::DailyStatsView::get_misc_stat(StatsValueType type) const
+{
+  if (stats != nullptr)
+    {
+      return stats->misc_stats[type];
+    }
+  return history != nullptr ? history->get_field(index, FIELD_MISC_STATS + type) : 0;
+}
+
+bool
+IStatistics::DailyStatsView::starts_at_date(int y, int m, int d) const
+{
+  if (history != nullptr)
+    {
+      return history->get_key(index) == days_from_date(y, m, d);
+    }
+  return workrave::utils::Calendar::days_from_tm(get_start()) == days_from_date(y, m, d);
+}
+
+bool
+IStatistics::DailyStatsView::starts_before_date(int y, int m, int d) const
+{
+  if (history != nullptr)
+    {
+      return history->get_key(index) < days_from_date(y, m, d);
+    }
+  return workrave::utils::Calendar::days_from_tm(get_start()) < days_from_date(y, m, d);
+}
+
+int32_t
+IStatistics::DailyStatsView::encode(const DailyStats &stats, int64_t *fields)
+{
+  int32_t day = workrave::utils::Calendar::days_from_tm(stats.start);
+  int32_t stop_day = workrave::utils::Calendar::days_from_tm(stats.stop);
+
+  fields[FIELD_START] = stats.start.tm_hour * 60 + stats.start.tm_min;
+  fields[FIELD_STOP] = (stop_day - day) * 24 * 60 + stats.stop.tm_hour * 60 + stats.stop.tm_min;
+
+  for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+    {
+      for (int j = 0; j < STATS_BREAKVALUE_SIZEOF; j++)
+        {
+          fields[FIELD_BREAK_STATS + i * STATS_BREAKVALUE_SIZEOF + j] = stats.break_stats[i][j];
+        }
+    }
+  for (int j = 0; j < STATS_VALUE_SIZEOF; j++)
+    {
+      fields[FIELD_MISC_STATS + j] = stats.misc_stats[j];
+    }
+  return day;
+}
+
+int32_t
+IStatistics::DailyStatsView::days_from_date(int y, int m, int d)
+{
+  return workrave::utils::Calendar::days_from_civil(y, m, d);
+}
+
+std::string
+IStatistics::DailyStatsView::get_field_name(int field)
+{
+  static constexpr const char *breaks[] = {"microbreak", "restbreak", "dailylimit"};
+  static constexpr const char *break_values[] =
+    {"prompted", "taken", "natural_taken", "skipped", "postponed", "unique_breaks", "total_overdue"};
+  static constexpr const char *misc_values[] =
+    {"total_active_time", "total_mouse_movement", "total_click_movement", "total_movement_time", "total_clicks", "total_keystrokes"};
+  static_assert(sizeof(breaks) / sizeof(breaks[0]) == BREAK_ID_SIZEOF);
+  static_assert(sizeof(break_values) / sizeof(break_values[0]) == STATS_BREAKVALUE_SIZEOF);
+  static_assert(sizeof(misc_values) / sizeof(misc_values[0]) == STATS_VALUE_SIZEOF);
+
+  if (field == FIELD_START)
+    {
+      return "start";
+    }
+  if (field == FIELD_STOP)
+    {
+      return "stop";
+    }
+  if (field >= FIELD_BREAK_STATS && field < FIELD_MISC_STATS)
+    {
+      int index = field - FIELD_BREAK_STATS;
+      return std::string(breaks[index / STATS_BREAKVALUE_SIZEOF]) + "." + break_values[index % STATS_BREAKVALUE_SIZEOF];
+    }
+  if (field >= FIELD_MISC_STATS && field < FIELD_SIZEOF)
+    {
+      return misc_values[field - FIELD_MISC_STATS];
+    }
+  return "";
+}
+
+int
+IStatistics::DailyStatsView::find_field(const std::string &name)
+{
+  for (int field = 0; field < FIELD_SIZEOF; field++)
+    {
+      if (get_field_name(field) == name)
+        {
+          return field;
+        }
+    }
+  return -1;
+}
+
+int32_t
+IStatistics::collect_range(const workrave::utils::RecordArena &history,
+                          const DailyStats *today,
+                          int32_t from,
+                          int32_t to,
+                          const std::vector<int> &fields,
+                          int max_days,
+                          std::vector<int32_t> &days,
+                          std::vector<int64_t> &values)
+{
+  constexpr std::size_t TODAY = std::numeric_limits<std::size_t>::max();
+
+  to = std::min(to, std::numeric_limits<int32_t>::max() - 1);
+  int32_t next = to + 1;
+  days.clear();
+  values.clear();
+
+  // The current day is not in the history yet, and replaces it if it is.
+  bool with_today = today != nullptr && !DailyStatsView(today).is_empty();
+  int32_t today_day = with_today ? workrave::utils::Calendar::days_from_tm(today->start) : 0;
+  with_today = with_today && today_day >= from && today_day <= to;
+
+  // First select the days, then decode each of them once.
+  std::size_t limit = max_days > 0 ? static_cast<std::size_t>(max_days) : TODAY;
+  std::vector<std::size_t> records;
+  std::size_t index = history.lower_bound(from);
+  for (;;)
+    {
+      bool have_history = index < history.size() && history.get_key(index) <= to;
+      if (have_history && with_today && history.get_key(index) == today_day)
+        {
+          index++;
+          continue;
+        }
+
+      int32_t day = 0;
+      std::size_t record = TODAY;
+      if (with_today && (!have_history || today_day < history.get_key(index)))
+        {
+          day = today_day;
+          with_today = false;
+        }
+      else if (have_history)
+        {
+          day = history.get_key(index);
+          record = index++;
+        }
+      else
+        {
+          break;
+        }
+
+      if (days.size() == limit)
+        {
+          next = day;
+          break;
+        }
+      days.push_back(day);
+      records.push_back(record);
+    }
+
+  std::size_t num_days = days.size();
+  values.resize(fields.size() * num_days);
+
+  int64_t buffer[DailyStatsView::FIELD_SIZEOF];
+  for (std::size_t i = 0; i < num_days; i++)
+    {
+      if (records[i] == TODAY)
+        {
+          DailyStatsView::encode(*today, buffer);
+        }
+      else
+        {
+          history.get_fields(records[i], buffer);
+        }
+
+      for (std::size_t f = 0; f < fields.size(); f++)
+        {
+          int field = fields[f];
+          values[f * num_days + i] = field >= 0 && field < DailyStatsView::FIELD_SIZEOF ? buffer[field] : 0;
+        }
+    }
+  return next;
+}
+
+//! Returns the local time at the specified number of minutes after midnight of the start date.
+struct tm
+IStatistics::DailyStatsView::get_time(int64_t minutes) const
+{
+  int32_t days = history != nullptr ? history->get_key(index) : 0;
+  days += static_cast<int32_t>(minutes / (24 * 60));
+  minutes %= 24 * 60;
+
+  workrave::utils::CivilDate date = workrave::utils::Calendar::civil_from_days(days);
+
+  struct tm ret = {};
+  ret.tm_year = date.year - 1900;
+  ret.tm_mon = date.month - 1;
+  ret.tm_mday = date.day;
+  ret.tm_hour = static_cast<int>(minutes / 60);
+  ret.tm_min = static_cast<int>(minutes % 60);
+  ret.tm_wday = workrave::utils::Calendar::weekday(days);
+  ret.tm_yday = days - days_from_date(date.year, 1, 1);
+  ret.tm_isdst = -1;
+  return ret;
+}
@@ -26,31 +26,9 @@
 
 #include "DayTimePred.hh"
 
-using namespace std;
-
-int
-DayTimePred::time_cmp(int h1, int m1, int h2, int m2)
-{
-  if (h1 < h2)
-    {
-      return -1;
-    }
-  if (h1 > h2)
-    {
-      return 1;
-    }
-
-  if (m1 < m2)
-    {
-      return -1;
-    }
-  if (m1 > m2)
-    {
-      return 1;
-    }
+#include "utils/Calendar.hh"
 
-  return 0;
-}
+using namespace std;
 
 bool
 DayTimePred::init(int hour, int min)
@@ -81,61 +59,8 @@ DayTimePred::init(std::string spec)
   return ret;
 }
 
-int
-DayTimePred::days_in_month(int month, int year)
-{
-  if (month == 1)
-    {
-      // Feb
-
-      if (year % 4 == 0 && ((year % 100 != 0) || (year % 400) == 0))
-        {
-          return 29;
-        }
-      else
-        {
-          return 28;
-        }
-    }
-  else
-    {
-      int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
-      return days[month];
-    }
-}
-
 time_t
 DayTimePred::get_next(time_t last_time)
 {
-  struct tm *ret;
-
-  ret = localtime(&last_time);
-
-  if (ret != nullptr)
-    {
-      if (time_cmp(ret->tm_hour, ret->tm_min, pred_hour, pred_min) >= 0)
-        {
-          ret->tm_mday++;
-        }
-
-      ret->tm_sec = 0;
-      ret->tm_min = pred_min;
-      ret->tm_hour = pred_hour;
-
-      if (ret->tm_mday > days_in_month(ret->tm_mon, ret->tm_year + 1900))
-        {
-          ret->tm_mday = 1;
-          ret->tm_mon++;
-        }
-
-      if (ret->tm_mon > 11)
-        {
-          ret->tm_mon = 0;
-          ret->tm_year++;
-        }
-
-      return mktime(ret);
-    }
-
-  return 0;
+  return workrave::utils::Calendar::get_next_local_time(last_time, pred_hour, pred_min);
 }
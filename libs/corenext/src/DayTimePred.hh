@@ -28,8 +28,6 @@ public:
 
 private:
   bool init(int hour, int min);
-  int days_in_month(int month, int year);
-  int time_cmp(int h1, int m1, int h2, int m2);
 
   int pred_hour{0};
   int pred_min{0};
@@ -0,0 +1,112 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "ExternalActivityMonitor.hh"
+
+#include <algorithm>
+
+#include "debug.hh"
+#include "utils/TimeSource.hh"
+
+using namespace workrave::utils;
+
+void
+ExternalActivityMonitor::report_activity(const std::string &who, bool active)
+{
+  TRACE_ENTER_MSG("ExternalActivityMonitor::report_activity", who << " " << active);
+
+  int64_t now = TimeSource::get_monotonic_time_sec_sync();
+  reporters.erase(std::remove_if(reporters.begin(), reporters.end(), [now](const auto &r) { return r.second <= now; }), reporters.end());
+
+  auto it = std::find_if(reporters.begin(), reporters.end(), [&who](const auto &r) { return r.first == who; });
+  if (active)
+    {
+      int64_t expires_at = now + ACTIVITY_TIMEOUT;
+      if (it != reporters.end())
+        {
+          it->second = expires_at;
+        }
+      else
+        {
+          reporters.emplace_back(who, expires_at);
+        }
+      forced_idle = false;
+
+      IActivityMonitorListener::Ptr l = listener;
+      if (l && !suspended && !l->action_notify())
+        {
+          listener.reset();
+        }
+    }
+  else if (it != reporters.end())
+    {
+      reporters.erase(it);
+    }
+
+  TRACE_EXIT();
+}
+
+void
+ExternalActivityMonitor::init()
+{
+}
+
+void
+ExternalActivityMonitor::terminate()
+{
+  reporters.clear();
+}
+
+void
+ExternalActivityMonitor::suspend()
+{
+  suspended = true;
+}
+
+void
+ExternalActivityMonitor::resume()
+{
+  suspended = false;
+}
+
+void
+ExternalActivityMonitor::force_idle()
+{
+  forced_idle = true;
+}
+
+bool
+ExternalActivityMonitor::is_active()
+{
+  if (suspended || forced_idle)
+    {
+      return false;
+    }
+
+  int64_t now = TimeSource::get_monotonic_time_sec_sync();
+  return std::any_of(reporters.begin(), reporters.end(), [now](const auto &r) { return r.second > now; });
+}
+
+void
+ExternalActivityMonitor::set_listener(IActivityMonitorListener::Ptr l)
+{
+  listener = l;
+}
@@ -0,0 +1,68 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef EXTERNALACTIVITYMONITOR_HH
+#define EXTERNALACTIVITYMONITOR_HH
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "IActivityMonitor.hh"
+
+//! Activity monitor of a user whose activity is reported by other processes.
+/*!
+ *  The user is active as long as one of the reporters says so. A reporter
+ *  that stops reporting is considered idle after ACTIVITY_TIMEOUT
+ *  seconds, so it must repeat its report while the user stays active.
+ */
+class ExternalActivityMonitor : public IActivityMonitor
+{
+public:
+  using Ptr = std::shared_ptr<ExternalActivityMonitor>;
+
+  //! Seconds after which an active report expires.
+  static constexpr int64_t ACTIVITY_TIMEOUT = 10;
+
+public:
+  ExternalActivityMonitor() = default;
+  ~ExternalActivityMonitor() override = default;
+
+  //! Reports the activity of the user as seen by the specified reporter.
+  void report_activity(const std::string &who, bool active);
+
+  // IActivityMonitor
+  void init() override;
+  void terminate() override;
+  void suspend() override;
+  void resume() override;
+  void force_idle() override;
+  bool is_active() override;
+  void set_listener(IActivityMonitorListener::Ptr l) override;
+
+private:
+  //! Reporters that reported activity, with the time at which their report expires.
+  std::vector<std::pair<std::string, int64_t>> reporters;
+
+  bool suspended{false};
+  bool forced_idle{false};
+  IActivityMonitorListener::Ptr listener;
+};
+
+#endif // EXTERNALACTIVITYMONITOR_HH
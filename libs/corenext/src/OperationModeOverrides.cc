@@ -0,0 +1,135 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "OperationModeOverrides.hh"
+
+using namespace workrave;
+
+void
+OperationModeOverrides::set(const std::string &id, OperationMode mode, int64_t expires_at)
+{
+  auto i = entries.find(id);
+  if (i != entries.end())
+    {
+      Entry &entry = i->second;
+      if (entry.expires_at != 0)
+        {
+          expiries.erase(std::make_pair(entry.expires_at, id));
+        }
+
+      if (entry.mode != mode)
+        {
+          order.erase(entry.order);
+          entry.mode = mode;
+          entry.order = OrderKey(-get_importance(mode), sequence++);
+          order.emplace(entry.order, mode);
+        }
+      entry.expires_at = expires_at;
+    }
+  else
+    {
+      Entry entry{mode, expires_at, OrderKey(-get_importance(mode), sequence++)};
+      order.emplace(entry.order, mode);
+      entries.emplace(id, entry);
+    }
+
+  if (expires_at != 0)
+    {
+      expiries.emplace(expires_at, id);
+    }
+}
+
+bool
+OperationModeOverrides::remove(const std::string &id)
+{
+  auto i = entries.find(id);
+  if (i == entries.end())
+    {
+      return false;
+    }
+
+  if (i->second.expires_at != 0)
+    {
+      expiries.erase(std::make_pair(i->second.expires_at, id));
+    }
+  order.erase(i->second.order);
+  entries.erase(i);
+  return true;
+}
+
+bool
+OperationModeOverrides::expire(int64_t now)
+{
+  bool removed = false;
+  while (!expiries.empty() && expiries.begin()->first <= now)
+    {
+      // Copy, remove() erases the element.
+      std::string id = expiries.begin()->second;
+      remove(id);
+      removed = true;
+    }
+  return removed;
+}
+
+bool
+OperationModeOverrides::empty() const
+{
+  return entries.empty();
+}
+
+std::size_t
+OperationModeOverrides::size() const
+{
+  return entries.size();
+}
+
+bool
+OperationModeOverrides::contains(const std::string &id) const
+{
+  return entries.find(id) != entries.end();
+}
+
+OperationMode
+OperationModeOverrides::get_mode() const
+{
+  return order.begin()->second;
+}
+
+int64_t
+OperationModeOverrides::get_next_expiry() const
+{
+  return expiries.empty() ? 0 : expiries.begin()->first;
+}
+
+int
+OperationModeOverrides::get_importance(OperationMode mode)
+{
+  switch (mode)
+    {
+    case OperationMode::Suspended:
+      return 2;
+    case OperationMode::Quiet:
+      return 1;
+    case OperationMode::Normal:
+      break;
+    }
+  return 0;
+}
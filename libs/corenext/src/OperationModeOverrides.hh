@@ -0,0 +1,79 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef OPERATIONMODEOVERRIDES_HH
+#define OPERATIONMODEOVERRIDES_HH
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "core/CoreTypes.hh"
+
+//! Registry of temporary operation mode overrides.
+/*!
+ *  Overrides are ordered by importance (Suspended, Quiet, Normal) and
+ *  then by the order in which they were set, so the active override is
+ *  always the first one. Setting, removing and expiring an override is
+ *  O(log n).
+ */
+class OperationModeOverrides
+{
+public:
+  //! Sets or replaces an override. The override expires at the specified monotonic time in microseconds, or never if 0.
+  void set(const std::string &id, workrave::OperationMode mode, int64_t expires_at = 0);
+
+  //! Removes an override. Returns whether it existed.
+  bool remove(const std::string &id);
+
+  //! Removes all overrides that expired at the specified time. Returns whether any was removed.
+  bool expire(int64_t now);
+
+  bool empty() const;
+  std::size_t size() const;
+  bool contains(const std::string &id) const;
+
+  //! Returns the mode of the most important override. The registry must not be empty.
+  workrave::OperationMode get_mode() const;
+
+  //! Returns the time at which the first override expires, or 0 if none does.
+  int64_t get_next_expiry() const;
+
+private:
+  //! Importance, negated so that the most important override sorts first, and insertion sequence.
+  using OrderKey = std::pair<int, uint64_t>;
+
+  struct Entry
+  {
+    workrave::OperationMode mode;
+    int64_t expires_at;
+    OrderKey order;
+  };
+
+  static int get_importance(workrave::OperationMode mode);
+
+private:
+  std::unordered_map<std::string, Entry> entries;
+  std::map<OrderKey, workrave::OperationMode> order;
+  std::set<std::pair<int64_t, std::string>> expiries;
+  uint64_t sequence{0};
+};
+
+#endif // OPERATIONMODEOVERRIDES_HH
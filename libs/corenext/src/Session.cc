@@ -0,0 +1,117 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "Session.hh"
+
+#include <system_error>
+#include <utility>
+
+#include "debug.hh"
+
+using namespace workrave;
+
+Session::Session(std::string id,
+                 IApp *app,
+                 workrave::dbus::IDBus::Ptr dbus,
+                 std::filesystem::path state_directory,
+                 std::string dbus_path)
+  : id(std::move(id))
+  , application(app)
+  , dbus(std::move(dbus))
+  , state_directory(std::move(state_directory))
+  , dbus_path(std::move(dbus_path))
+{
+}
+
+Session::~Session()
+{
+  if (breaks_control)
+    {
+      breaks_control->save_state();
+    }
+}
+
+void
+Session::init()
+{
+  TRACE_ENTER_MSG("Session::init", id);
+
+  std::error_code ec;
+  std::filesystem::create_directories(state_directory, ec);
+
+  hooks = std::make_shared<CoreHooks>();
+  monitor = std::make_shared<ExternalActivityMonitor>();
+  monitor->init();
+
+  statistics = std::make_shared<Statistics>(monitor, state_directory, false);
+  statistics->init();
+
+  core_modes = std::make_shared<CoreModes>(monitor, false);
+
+  breaks_control = std::make_shared<BreaksControl>(application, monitor, core_modes, statistics, dbus, hooks, state_directory, dbus_path);
+  breaks_control->init();
+
+  TRACE_EXIT();
+}
+
+//! Periodic heartbeat. The session server synchronizes the time source.
+void
+Session::heartbeat()
+{
+  breaks_control->heartbeat();
+  core_modes->heartbeat();
+}
+
+void
+Session::report_activity(const std::string &who, bool active)
+{
+  monitor->report_activity(who, active);
+}
+
+std::string
+Session::get_id() const
+{
+  return id;
+}
+
+bool
+Session::is_user_active() const
+{
+  return monitor->is_active();
+}
+
+IBreak::Ptr
+Session::get_break(BreakId id)
+{
+  return breaks_control->get_break(id);
+}
+
+IStatistics::Ptr
+Session::get_statistics() const
+{
+  return statistics;
+}
+
+CoreModes::Ptr
+Session::get_modes() const
+{
+  return core_modes;
+}
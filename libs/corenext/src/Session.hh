@@ -0,0 +1,93 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef SESSION_HH
+#define SESSION_HH
+
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "dbus/IDBus.hh"
+
+#include "core/IBreak.hh"
+#include "core/IStatistics.hh"
+#include "BreaksControl.hh"
+#include "CoreHooks.hh"
+#include "CoreModes.hh"
+#include "ExternalActivityMonitor.hh"
+#include "Statistics.hh"
+
+namespace workrave
+{
+  class IApp;
+}
+
+//! The timers, breaks and statistics of one user of the session server.
+/*!
+ *  A session is a Core without configuration, input monitor and D-Bus
+ *  service of its own: the session server shares these between all
+ *  sessions. The activity of the user is reported by the processes of
+ *  the user's desktop session.
+ */
+class Session
+{
+public:
+  using Ptr = std::shared_ptr<Session>;
+
+  Session(std::string id,
+          workrave::IApp *app,
+          workrave::dbus::IDBus::Ptr dbus,
+          std::filesystem::path state_directory,
+          std::string dbus_path);
+  ~Session();
+
+  void init();
+  void heartbeat();
+
+  void report_activity(const std::string &who, bool active);
+
+  std::string get_id() const;
+  bool is_user_active() const;
+  workrave::IBreak::Ptr get_break(workrave::BreakId id);
+  workrave::IStatistics::Ptr get_statistics() const;
+  CoreModes::Ptr get_modes() const;
+
+private:
+  //! Id of the session, usually the user name.
+  std::string id;
+
+  //! Presentation of breaks.
+  workrave::IApp *application;
+
+  //! DBUS bridge, shared by all sessions.
+  workrave::dbus::IDBus::Ptr dbus;
+
+  //! Directory of the timer state and statistics of this session.
+  std::filesystem::path state_directory;
+
+  //! Object path prefix of the breaks of this session.
+  std::string dbus_path;
+
+  ExternalActivityMonitor::Ptr monitor;
+  CoreHooks::Ptr hooks;
+  CoreModes::Ptr core_modes;
+  Statistics::Ptr statistics;
+  BreaksControl::Ptr breaks_control;
+};
+
+#endif // SESSION_HH
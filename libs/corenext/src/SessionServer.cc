@@ -0,0 +1,320 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "SessionServer.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+#include "core/IApp.hh"
+#include "utils/TimeSource.hh"
+#include "debug.hh"
+
+#ifdef HAVE_DBUS
+#  include "DBusWorkraveNext.hh"
+#endif
+
+#define DBUS_PATH_SERVER "/org/workrave/Workrave/Server"
+#define DBUS_PATH_SESSION "/org/workrave/Workrave/Session/"
+
+using namespace workrave;
+using namespace workrave::dbus;
+using namespace workrave::utils;
+
+namespace
+{
+  //! Presentation of a session that has no user interface.
+  class HeadlessApp : public IApp
+  {
+  public:
+    void create_prelude_window(BreakId break_id) override
+    {
+      (void)break_id;
+    }
+    void create_break_window(BreakId break_id, workrave::utils::Flags<BreakHint> break_hint) override
+    {
+      (void)break_id;
+      (void)break_hint;
+    }
+    void hide_break_window() override
+    {
+    }
+    void show_break_window() override
+    {
+    }
+    void refresh_break_window() override
+    {
+    }
+    void set_break_progress(int value, int max_value) override
+    {
+      (void)value;
+      (void)max_value;
+    }
+    void set_prelude_stage(PreludeStage stage) override
+    {
+      (void)stage;
+    }
+    void set_prelude_progress_text(PreludeProgressText text) override
+    {
+      (void)text;
+    }
+  };
+
+  HeadlessApp headless_app;
+} // namespace
+
+SessionServer::SessionServer(IDBus::Ptr dbus, std::filesystem::path state_directory, int num_threads)
+  : dbus(std::move(dbus))
+  , state_directory(std::move(state_directory))
+  , num_threads(num_threads > 0 ? num_threads : static_cast<int>(std::max(1U, std::thread::hardware_concurrency())))
+{
+}
+
+SessionServer::~SessionServer()
+{
+  {
+    std::unique_lock<std::mutex> lock(pool_mutex);
+    stopping = true;
+  }
+  work_cond.notify_all();
+  for (auto &t: workers)
+    {
+      t.join();
+    }
+
+#ifdef HAVE_DBUS
+  try
+    {
+      dbus->disconnect(DBUS_PATH_SERVER, "org.workrave.SessionServerInterface");
+    }
+  catch (DBusException &)
+    {
+    }
+#endif
+}
+
+void
+SessionServer::init()
+{
+  TRACE_ENTER_MSG("SessionServer::init", num_threads);
+
+#ifdef HAVE_DBUS
+  try
+    {
+      extern void init_DBusWorkraveNext(IDBus::Ptr dbus);
+      init_DBusWorkraveNext(dbus);
+
+      dbus->connect(DBUS_PATH_SERVER, "org.workrave.SessionServerInterface", this);
+      dbus->register_object_path(DBUS_PATH_SERVER);
+    }
+  catch (DBusException &)
+    {
+    }
+#endif
+
+  // The calling thread runs the first shard.
+  for (int i = 1; i < num_threads; i++)
+    {
+      workers.emplace_back([this, i]() { worker(i); });
+    }
+
+  TRACE_EXIT();
+}
+
+//! Periodic heartbeat of all sessions.
+void
+SessionServer::heartbeat()
+{
+  TimeSource::sync();
+  apply_reports();
+
+  if (workers.empty() || schedule.size() < 2)
+    {
+      run_shard(-1);
+      return;
+    }
+
+  {
+    std::unique_lock<std::mutex> lock(pool_mutex);
+    generation++;
+    busy_workers = static_cast<int>(workers.size());
+  }
+  work_cond.notify_all();
+
+  run_shard(0);
+
+  std::unique_lock<std::mutex> lock(pool_mutex);
+  done_cond.wait(lock, [this]() { return busy_workers == 0; });
+}
+
+Session::Ptr
+SessionServer::add_session(const std::string &id, IApp *app)
+{
+  TRACE_ENTER_MSG("SessionServer::add_session", id);
+
+  auto it = sessions.find(id);
+  if (it != sessions.end())
+    {
+      TRACE_EXIT();
+      return it->second;
+    }
+
+  std::string name = escape(id);
+  auto session = std::make_shared<Session>(id,
+                                           app != nullptr ? app : &headless_app,
+                                           dbus,
+                                           state_directory / name,
+                                           DBUS_PATH_SESSION + name);
+  session->init();
+
+  sessions[id] = session;
+  schedule.push_back(session.get());
+
+  TRACE_EXIT();
+  return session;
+}
+
+void
+SessionServer::remove_session(const std::string &id)
+{
+  TRACE_ENTER_MSG("SessionServer::remove_session", id);
+
+  auto it = sessions.find(id);
+  if (it != sessions.end())
+    {
+      schedule.erase(std::find(schedule.begin(), schedule.end(), it->second.get()));
+      sessions.erase(it);
+    }
+
+  TRACE_EXIT();
+}
+
+Session::Ptr
+SessionServer::get_session(const std::string &id) const
+{
+  auto it = sessions.find(id);
+  return it != sessions.end() ? it->second : Session::Ptr();
+}
+
+int32_t
+SessionServer::get_session_count() const
+{
+  return static_cast<int32_t>(sessions.size());
+}
+
+void
+SessionServer::report_activity(const std::string &id, const std::string &who, bool active)
+{
+  std::unique_lock<std::mutex> lock(report_mutex);
+  reports.push_back(Report{id, who, active});
+}
+
+int
+SessionServer::get_num_threads() const
+{
+  return num_threads;
+}
+
+void
+SessionServer::apply_reports()
+{
+  std::vector<Report> pending;
+  {
+    std::unique_lock<std::mutex> lock(report_mutex);
+    pending.swap(reports);
+  }
+
+  for (const Report &report: pending)
+    {
+      auto it = sessions.find(report.id);
+      if (it != sessions.end())
+        {
+          it->second->report_activity(report.who, report.active);
+        }
+    }
+}
+
+//! Runs the heartbeat of a contiguous part of the sessions, or of all sessions if shard is -1.
+void
+SessionServer::run_shard(int shard)
+{
+  size_t begin = 0;
+  size_t end = schedule.size();
+  if (shard >= 0)
+    {
+      begin = schedule.size() * shard / num_threads;
+      end = schedule.size() * (shard + 1) / num_threads;
+    }
+
+  for (size_t i = begin; i < end; i++)
+    {
+      schedule[i]->heartbeat();
+    }
+}
+
+void
+SessionServer::worker(int shard)
+{
+  uint64_t last_generation = 0;
+
+  for (;;)
+    {
+      {
+        std::unique_lock<std::mutex> lock(pool_mutex);
+        work_cond.wait(lock, [&]() { return stopping || generation != last_generation; });
+        if (stopping)
+          {
+            return;
+          }
+        last_generation = generation;
+      }
+
+      run_shard(shard);
+
+      std::unique_lock<std::mutex> lock(pool_mutex);
+      if (--busy_workers == 0)
+        {
+          done_cond.notify_one();
+        }
+    }
+}
+
+//! Returns the id as a valid D-Bus object path element and file name.
+std::string
+SessionServer::escape(const std::string &id)
+{
+  std::string ret;
+  for (unsigned char c: id)
+    {
+      if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'))
+        {
+          ret += static_cast<char>(c);
+        }
+      else
+        {
+          char buf[4];
+          std::snprintf(buf, sizeof(buf), "_%02x", c);
+          ret += buf;
+        }
+    }
+  return ret;
+}
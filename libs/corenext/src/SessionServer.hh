@@ -0,0 +1,119 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef SESSIONSERVER_HH
+#define SESSIONSERVER_HH
+
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dbus/IDBus.hh"
+
+#include "Session.hh"
+
+namespace workrave
+{
+  class IApp;
+}
+
+//! Headless server that runs the breaks of many users.
+/*!
+ *  Every user has a Session with its own timers, breaks and statistics.
+ *  The activity of the users is reported with ReportActivity on the
+ *  org.workrave.SessionServerInterface D-Bus interface, or directly with
+ *  report_activity().
+ *
+ *  Sessions are added, removed and fed with activity on the thread that
+ *  calls heartbeat(). The heartbeats of the sessions themselves run on a
+ *  pool of worker threads, so the IApp of a session is called from a
+ *  worker thread, and never concurrently for the same session.
+ *
+ *  All sessions share the configuration of the server. Modes that are
+ *  set for a session are not stored.
+ */
+class SessionServer
+{
+public:
+  using Ptr = std::shared_ptr<SessionServer>;
+
+  //! Creates a server that stores the state of the sessions below state_directory.
+  /*!
+   *  num_threads is the number of threads running the session heartbeats,
+   *  including the thread that calls heartbeat(). 0 selects the number of
+   *  processors.
+   */
+  SessionServer(workrave::dbus::IDBus::Ptr dbus, std::filesystem::path state_directory, int num_threads = 0);
+  ~SessionServer();
+
+  void init();
+  void heartbeat();
+
+  //! Adds a session. Breaks are presented by app, or not at all if it is null.
+  Session::Ptr add_session(const std::string &id, workrave::IApp *app = nullptr);
+  void remove_session(const std::string &id);
+  Session::Ptr get_session(const std::string &id) const;
+  int32_t get_session_count() const;
+
+  //! Queues a report of user activity. May be called from any thread.
+  void report_activity(const std::string &id, const std::string &who, bool active);
+
+  int get_num_threads() const;
+
+private:
+  struct Report
+  {
+    std::string id;
+    std::string who;
+    bool active;
+  };
+
+  void apply_reports();
+  void run_shard(int shard);
+  void worker(int shard);
+  static std::string escape(const std::string &id);
+
+private:
+  workrave::dbus::IDBus::Ptr dbus;
+  std::filesystem::path state_directory;
+  int num_threads;
+
+  std::map<std::string, Session::Ptr> sessions;
+
+  //! The sessions in the order in which they are distributed over the threads.
+  std::vector<Session *> schedule;
+
+  //! Activity reported since the last heartbeat.
+  std::mutex report_mutex;
+  std::vector<Report> reports;
+
+  std::vector<std::thread> workers;
+  std::mutex pool_mutex;
+  std::condition_variable work_cond;
+  std::condition_variable done_cond;
+  uint64_t generation{0};
+  int busy_workers{0};
+  bool stopping{false};
+};
+
+#endif // SESSIONSERVER_HH
@@ -0,0 +1,340 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "SessionSocket.hh"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <utility>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <pwd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "debug.hh"
+
+namespace
+{
+  //! Output that a client does not read is dropped together with the client beyond this size.
+  constexpr std::size_t MAX_OUTPUT = 64 * 1024;
+
+  bool set_nonblocking(int fd)
+  {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0 && fcntl(fd, F_SETFD, FD_CLOEXEC) == 0;
+  }
+
+  bool get_peer_uid(int fd, uid_t &uid)
+  {
+#if defined(SO_PEERCRED)
+    struct ucred cred
+    {
+    };
+    socklen_t len = sizeof(cred);
+    if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0)
+      {
+        return false;
+      }
+    uid = cred.uid;
+    return true;
+#else
+    gid_t gid = 0;
+    return getpeereid(fd, &uid, &gid) == 0;
+#endif
+  }
+} // namespace
+
+SessionSocket::SessionSocket(SessionServer::Ptr server, std::filesystem::path path)
+  : server(std::move(server))
+  , path(std::move(path))
+{
+}
+
+SessionSocket::~SessionSocket()
+{
+  for (Client &client: clients)
+    {
+      close(client.fd);
+    }
+
+  if (listen_fd >= 0)
+    {
+      close(listen_fd);
+      std::error_code ec;
+      std::filesystem::remove(path, ec);
+    }
+}
+
+bool
+SessionSocket::init()
+{
+  TRACE_ENTER_MSG("SessionSocket::init", path.u8string());
+
+  struct sockaddr_un addr
+  {
+  };
+  std::string name = path.u8string();
+  if (name.size() >= sizeof(addr.sun_path))
+    {
+      TRACE_RETURN("path too long");
+      return false;
+    }
+  addr.sun_family = AF_UNIX;
+  std::memcpy(addr.sun_path, name.c_str(), name.size() + 1);
+
+  listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listen_fd < 0 || !set_nonblocking(listen_fd))
+    {
+      TRACE_RETURN("cannot create socket");
+      return false;
+    }
+
+  std::error_code ec;
+  std::filesystem::create_directories(path.parent_path(), ec);
+  std::filesystem::remove(path, ec);
+
+  if (bind(listen_fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0 || listen(listen_fd, SOMAXCONN) != 0)
+    {
+      close(listen_fd);
+      listen_fd = -1;
+      TRACE_RETURN("cannot listen: " << std::strerror(errno));
+      return false;
+    }
+
+  // Every user may connect. Commands are checked against the user of the client.
+  chmod(name.c_str(), 0666);
+
+  TRACE_RETURN(true);
+  return true;
+}
+
+void
+SessionSocket::process()
+{
+  if (listen_fd < 0)
+    {
+      return;
+    }
+
+  accept_clients();
+  if (clients.empty())
+    {
+      return;
+    }
+
+  std::vector<struct pollfd> fds;
+  fds.reserve(clients.size());
+  for (const Client &client: clients)
+    {
+      fds.push_back({client.fd, static_cast<short>(client.output.empty() ? POLLIN : POLLIN | POLLOUT), 0});
+    }
+
+  if (poll(fds.data(), fds.size(), 0) <= 0)
+    {
+      return;
+    }
+
+  for (std::size_t i = 0; i < clients.size(); i++)
+    {
+      Client &client = clients[i];
+      bool ok = true;
+      if ((fds[i].revents & (POLLIN | POLLHUP | POLLERR)) != 0)
+        {
+          ok = read_client(client);
+        }
+
+      // A client that closed its end may still read the replies.
+      bool written = write_client(client);
+      if (!ok || !written)
+        {
+          close_client(client);
+        }
+    }
+
+  clients.erase(std::remove_if(clients.begin(), clients.end(), [](const Client &client) { return client.fd < 0; }), clients.end());
+}
+
+bool
+SessionSocket::is_allowed(uid_t peer, const std::string &session)
+{
+  if (peer == 0 || peer == geteuid())
+    {
+      return true;
+    }
+
+  struct passwd pwd
+  {
+  };
+  struct passwd *result = nullptr;
+  char buffer[1024];
+  return getpwuid_r(peer, &pwd, buffer, sizeof(buffer), &result) == 0 && result != nullptr && session == result->pw_name;
+}
+
+void
+SessionSocket::accept_clients()
+{
+  TRACE_ENTER("SessionSocket::accept_clients");
+  while (clients.size() < MAX_CLIENTS)
+    {
+      int fd = accept(listen_fd, nullptr, nullptr);
+      if (fd < 0)
+        {
+          break;
+        }
+
+      Client client;
+      client.fd = fd;
+      if (!set_nonblocking(fd) || !get_peer_uid(fd, client.uid))
+        {
+          close(fd);
+          continue;
+        }
+
+      TRACE_MSG("uid " << client.uid);
+      clients.push_back(std::move(client));
+    }
+  TRACE_EXIT();
+}
+
+//! Reads and executes the commands of a client. Returns false if the client is gone or misbehaves.
+bool
+SessionSocket::read_client(Client &client)
+{
+  char buffer[4096];
+  for (;;)
+    {
+      ssize_t size = recv(client.fd, buffer, sizeof(buffer), 0);
+      if (size == 0)
+        {
+          return false;
+        }
+      if (size < 0)
+        {
+          if (errno == EINTR)
+            {
+              continue;
+            }
+          return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+
+      client.input.append(buffer, static_cast<std::size_t>(size));
+
+      std::string::size_type pos = 0;
+      std::string::size_type eol = 0;
+      while ((eol = client.input.find('\n', pos)) != std::string::npos)
+        {
+          std::string line = client.input.substr(pos, eol - pos);
+          if (!line.empty() && line.back() == '\r')
+            {
+              line.pop_back();
+            }
+          execute(client, line);
+          pos = eol + 1;
+        }
+      client.input.erase(0, pos);
+
+      if (client.input.size() > MAX_LINE || client.output.size() > MAX_OUTPUT)
+        {
+          return false;
+        }
+    }
+}
+
+bool
+SessionSocket::write_client(Client &client)
+{
+  while (!client.output.empty())
+    {
+      ssize_t size = send(client.fd, client.output.data(), client.output.size(), MSG_NOSIGNAL);
+      if (size < 0)
+        {
+          if (errno == EINTR)
+            {
+              continue;
+            }
+          return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+      client.output.erase(0, static_cast<std::size_t>(size));
+    }
+  return true;
+}
+
+void
+SessionSocket::execute(Client &client, const std::string &line)
+{
+  TRACE_ENTER_MSG("SessionSocket::execute", line);
+
+  std::vector<std::string> args;
+  std::istringstream ss(line);
+  for (std::string arg; ss >> arg;)
+    {
+      args.push_back(arg);
+    }
+
+  std::string error;
+  if (args.size() < 2)
+    {
+      error = "missing session";
+    }
+  else if (!is_allowed(client.uid, args[1]))
+    {
+      error = "not allowed";
+    }
+  else if (args[0] == "add" && args.size() == 2)
+    {
+      server->add_session(args[1]);
+    }
+  else if (args[0] == "remove" && args.size() == 2)
+    {
+      server->remove_session(args[1]);
+    }
+  else if (args[0] == "activity" && args.size() == 4 && (args[3] == "0" || args[3] == "1"))
+    {
+      if (server->get_session(args[1]))
+        {
+          server->report_activity(args[1], args[2], args[3] == "1");
+        }
+      else
+        {
+          error = "unknown session";
+        }
+    }
+  else
+    {
+      error = "invalid command";
+    }
+
+  client.output += error.empty() ? "ok\n" : "error " + error + "\n";
+  TRACE_EXIT();
+}
+
+void
+SessionSocket::close_client(Client &client)
+{
+  close(client.fd);
+  client.fd = -1;
+}
@@ -0,0 +1,94 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef SESSIONSOCKET_HH
+#define SESSIONSOCKET_HH
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+#include "SessionServer.hh"
+
+//! Local socket through which the sessions of a SessionServer are managed.
+/*!
+ *  Clients connect to a Unix domain socket and send commands of one
+ *  line each:
+ *
+ *    add <session>
+ *    remove <session>
+ *    activity <session> <who> <0|1>
+ *
+ *  Every command is answered with "ok" or "error <reason>". A session
+ *  belongs to the user it is named after: a client may only use the
+ *  session of its own user, unless it runs as root or as the user of
+ *  the server.
+ *
+ *  The socket is serviced by process(), which does not block. It is
+ *  meant to be called before every heartbeat of the server, which is
+ *  when reported activity is applied anyway.
+ */
+class SessionSocket
+{
+public:
+  SessionSocket(SessionServer::Ptr server, std::filesystem::path path);
+  ~SessionSocket();
+
+  SessionSocket(const SessionSocket &) = delete;
+  SessionSocket &operator=(const SessionSocket &) = delete;
+
+  //! Starts listening. Replaces a socket left behind by an earlier server.
+  bool init();
+
+  //! Accepts new clients and executes the commands they sent.
+  void process();
+
+  //! Returns whether a client running as user peer may use the specified session.
+  static bool is_allowed(uid_t peer, const std::string &session);
+
+  //! Maximum length of a command.
+  static constexpr std::size_t MAX_LINE = 1024;
+
+  //! Maximum number of connected clients.
+  static constexpr std::size_t MAX_CLIENTS = 4096;
+
+private:
+  struct Client
+  {
+    int fd{-1};
+    uid_t uid{0};
+    std::string input;
+    std::string output;
+  };
+
+  void accept_clients();
+  bool read_client(Client &client);
+  bool write_client(Client &client);
+  void execute(Client &client, const std::string &line);
+  void close_client(Client &client);
+
+private:
+  SessionServer::Ptr server;
+  std::filesystem::path path;
+  int listen_fd{-1};
+  std::vector<Client> clients;
+};
+
+#endif // SESSIONSOCKET_HH
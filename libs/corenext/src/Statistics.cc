@@ -28,13 +28,16 @@
 #endif
 
 #include <cstring>
+#include <utility>
 #include <sstream>
 #include <cassert>
 #include <cmath>
 
 #include "debug.hh"
 
+#include "utils/Calendar.hh"
 #include "utils/Paths.hh"
+#include "utils/StateWriter.hh"
 #include "Timer.hh"
 #include "input-monitor/InputMonitorFactory.hh"
 #include "input-monitor/IInputMonitor.hh"
@@ -49,8 +52,10 @@ using namespace workrave;
 using namespace workrave::utils;
 using namespace workrave::input_monitor;
 
-Statistics::Statistics(IActivityMonitor::Ptr monitor)
+Statistics::Statistics(IActivityMonitor::Ptr monitor, std::filesystem::path state_directory, bool use_input_monitor)
   : monitor(monitor)
+  , state_directory(std::move(state_directory))
+  , use_input_monitor(use_input_monitor)
   , current_day(nullptr)
   , been_active(false)
   , prev_x(-1)
@@ -64,11 +69,7 @@ Statistics::Statistics(IActivityMonitor::Ptr monitor)
 Statistics::~Statistics()
 {
   update();
-
-  for (auto &item: history)
-    {
-      delete item;
-    }
+  StateWriter::instance().flush();
 
   delete current_day;
 
@@ -82,10 +83,13 @@ Statistics::~Statistics()
 void
 Statistics::init()
 {
-  input_monitor = InputMonitorFactory::create_monitor(MonitorCapability::Statistics);
-  if (input_monitor != nullptr)
+  if (use_input_monitor)
     {
-      input_monitor->subscribe(this);
+      input_monitor = InputMonitorFactory::create_monitor(MonitorCapability::Statistics);
+      if (input_monitor != nullptr)
+        {
+          input_monitor->subscribe(this);
+        }
     }
 
   current_day = nullptr;
@@ -106,13 +110,12 @@ Statistics::update()
 
   if (monitor->is_active())
     {
-      const time_t now = time(nullptr);
-      struct tm *tmnow = localtime(&now);
-      current_day->stop = *tmnow;
+      struct tm tmnow = Calendar::to_local(time(nullptr));
+      current_day->stop = tmnow;
 
       if (!been_active)
         {
-          current_day->start = *tmnow;
+          current_day->start = tmnow;
           been_active = true;
         }
     }
@@ -125,22 +128,17 @@ Statistics::delete_all_history()
 {
   update();
 
-  std::filesystem::path histpath = Paths::get_state_directory() / "historystats";
+  std::filesystem::path histpath = get_state_directory() / "historystats";
   if (std::filesystem::is_regular_file(histpath) && std::filesystem::remove(histpath))
     {
       return false;
     }
   else
     {
-      for (auto i = history.begin(); (i != history.end()); ++i)
-        {
-          delete *i;
-        }
-
       history.clear();
     }
 
-  std::filesystem::path todaypath = Paths::get_state_directory() / "todaystats";
+  std::filesystem::path todaypath = get_state_directory() / "todaystats";
   if (std::filesystem::is_regular_file(todaypath) && std::filesystem::remove(todaypath))
     {
       return false;
@@ -163,11 +161,10 @@ void
 Statistics::start_new_day()
 {
   TRACE_ENTER("Statistics::start_new_day");
-  const time_t now = time(nullptr);
-  struct tm *tmnow = localtime(&now);
+  struct tm tmnow = Calendar::to_local(time(nullptr));
 
-  if (current_day == nullptr || tmnow->tm_mday != current_day->start.tm_mday || tmnow->tm_mon != current_day->start.tm_mon
-      || tmnow->tm_year != current_day->start.tm_year)
+  if (current_day == nullptr || tmnow.tm_mday != current_day->start.tm_mday || tmnow.tm_mon != current_day->start.tm_mon
+      || tmnow.tm_year != current_day->start.tm_year)
     {
       TRACE_MSG("New day");
       if (current_day != nullptr)
@@ -175,13 +172,14 @@ Statistics::start_new_day()
           TRACE_MSG("Save old day");
           day_to_history(current_day);
           day_to_remote_history(current_day);
+          delete current_day;
         }
 
       current_day = new DailyStatsImpl();
       been_active = false;
 
-      current_day->start = *tmnow;
-      current_day->stop = *tmnow;
+      current_day->start = tmnow;
+      current_day->stop = tmnow;
     }
 
   update();
@@ -191,11 +189,11 @@ Statistics::start_new_day()
 }
 
 void
-Statistics::day_to_history(DailyStatsImpl *stats)
+Statistics::day_to_history(const DailyStatsImpl *stats)
 {
   add_history(stats);
 
-  std::filesystem::path path = Paths::get_state_directory() / "historystats";
+  std::filesystem::path path = get_state_directory() / "historystats";
 
   bool exists = std::filesystem::is_regular_file(path);
   ofstream stats_file(path.u8string(), ios::app);
@@ -211,14 +209,14 @@ Statistics::day_to_history(DailyStatsImpl *stats)
 
 //! Adds the current day to this history.
 void
-Statistics::day_to_remote_history(DailyStatsImpl *stats)
+Statistics::day_to_remote_history(const DailyStatsImpl *stats)
 {
   (void)stats;
 }
 
 //! Saves the current day to the specified stream.
 void
-Statistics::save_day(DailyStatsImpl *stats, ofstream &stats_file)
+Statistics::save_day(const DailyStatsImpl *stats, ostream &stats_file)
 {
   stats_file << "D " << stats->start.tm_mday << " " << stats->start.tm_mon << " " << stats->start.tm_year << " " << stats->start.tm_hour
              << " " << stats->start.tm_min << " " << stats->stop.tm_mday << " " << stats->stop.tm_mon << " " << stats->stop.tm_year << " "
@@ -226,7 +224,7 @@ Statistics::save_day(DailyStatsImpl *stats, ofstream &stats_file)
 
   for (int i = 0; i < BREAK_ID_SIZEOF; i++)
     {
-      BreakStats &bs = stats->break_stats[i];
+      const BreakStats &bs = stats->break_stats[i];
 
       stats_file << "B " << i << " " << STATS_BREAKVALUE_SIZEOF << " ";
       for (auto &b: bs)
@@ -242,71 +240,32 @@ Statistics::save_day(DailyStatsImpl *stats, ofstream &stats_file)
       stats_file << misc_stat << " ";
     }
   stats_file << endl;
-
-  stats_file.close();
 }
 
 //! Saves the statistics of the specified day.
 void
 Statistics::save_day(DailyStatsImpl *stats)
 {
-  std::filesystem::path path = Paths::get_state_directory() / "todaystats";
-  ofstream stats_file(path.u8string());
+  if (today_path.empty())
+    {
+      today_path = get_state_directory() / "todaystats";
+    }
 
-  stats_file << WORKRAVESTATS << " " << STATSVERSION << endl;
+  today_stream.reset();
+  today_stream << WORKRAVESTATS << " " << STATSVERSION << endl;
 
-  save_day(stats, stats_file);
+  save_day(stats, today_stream);
+
+  StateWriter::instance().write(today_path, today_stream.str());
 }
 
 //! Add the stats the the history list.
 void
-Statistics::add_history(DailyStatsImpl *stats)
+Statistics::add_history(const DailyStatsImpl *stats)
 {
-  if (history.size() == 0)
-    {
-      history.push_back(stats);
-    }
-  else
-    {
-      bool found = false;
-      auto i = history.rbegin();
-      while (i != history.rend())
-        {
-          DailyStatsImpl *ref = *i;
-
-          if (stats->start.tm_year == ref->start.tm_year && stats->start.tm_mon == ref->start.tm_mon
-              && stats->start.tm_mday == ref->start.tm_mday)
-            {
-              delete *i;
-              *i = stats;
-              found = true;
-              break;
-            }
-
-          else if (stats->start.tm_year > ref->start.tm_year
-                   || (stats->start.tm_year == ref->start.tm_year
-                       && (stats->start.tm_mon > ref->start.tm_mon
-                           || (stats->start.tm_mon == ref->start.tm_mon && stats->start.tm_mday > ref->start.tm_mday))))
-            {
-              if (i == history.rbegin())
-                {
-                  history.push_back(stats);
-                }
-              else
-                {
-                  history.insert(i.base(), stats);
-                }
-              found = true;
-              break;
-            }
-          ++i;
-        }
-
-      if (!found)
-        {
-          history.insert(history.begin(), stats);
-        }
-    }
+  int64_t fields[DailyStatsView::FIELD_SIZEOF];
+  int32_t day = DailyStatsView::encode(*stats, fields);
+  history.put(day, fields);
 }
 
 //! Load the statistics of the current day.
@@ -314,7 +273,7 @@ bool
 Statistics::load_current_day()
 {
   TRACE_ENTER("Statistics::load_current_day");
-  std::filesystem::path path = Paths::get_state_directory() / "todaystats";
+  std::filesystem::path path = get_state_directory() / "todaystats";
   ifstream stats_file(path.u8string());
 
   load(stats_file, false);
@@ -331,11 +290,12 @@ Statistics::load_history()
 {
   TRACE_ENTER("Statistics::load_history");
 
-  std::filesystem::path path = Paths::get_state_directory() / "historystats";
+  std::filesystem::path path = get_state_directory() / "historystats";
 
   ifstream stats_file(path.u8string());
 
   load(stats_file, true);
+  history.shrink_to_fit();
   TRACE_EXIT();
 }
 
@@ -382,6 +342,7 @@ Statistics::load(ifstream &infile, bool history)
               if (history && stats != nullptr)
                 {
                   add_history(stats);
+                  delete stats;
                   stats = nullptr;
                 }
               else if (!history && stats != nullptr)
@@ -463,6 +424,7 @@ Statistics::load(ifstream &infile, bool history)
   if (history && stats != nullptr)
     {
       add_history(stats);
+      delete stats;
     }
 
   TRACE_EXIT();
@@ -552,34 +514,29 @@ Statistics::get_current_day() const
   return current_day;
 }
 
-Statistics::DailyStatsImpl *
+IStatistics::DailyStatsView
 Statistics::get_day(int day) const
 {
-  DailyStatsImpl *ret = nullptr;
-
   if (day == 0)
     {
-      ret = current_day;
+      return DailyStatsView(current_day);
+    }
+
+  if (day > 0)
+    {
+      day = static_cast<int>(history.size()) - day;
     }
   else
     {
-      if (day > 0)
-        {
-          day = static_cast<int>(history.size()) - day;
-        }
-      else
-        {
-          day = -day;
-          day--;
-        }
-
-      if (day < int(history.size()) && day >= 0)
-        {
-          ret = history[day];
-        }
+      day = -day;
+      day--;
     }
 
-  return ret;
+  if (day < int(history.size()) && day >= 0)
+    {
+      return DailyStatsView(&history, day);
+    }
+  return DailyStatsView();
 }
 
 void
@@ -590,12 +547,12 @@ Statistics::get_day_index_by_date(int y, int m, int d, int &idx, int &next, int
   for (int i = 0; i <= static_cast<int>(history.size()); i++)
     {
       int j = static_cast<int>(history.size() - i);
-      DailyStatsImpl *stats = j == 0 ? current_day : history[i];
-      if (idx < 0 && stats->starts_at_date(y, m, d))
+      DailyStatsView stats = j == 0 ? DailyStatsView(current_day) : DailyStatsView(&history, i);
+      if (idx < 0 && stats.starts_at_date(y, m, d))
         {
           idx = j;
         }
-      else if (stats->starts_before_date(y, m, d))
+      else if (stats.starts_before_date(y, m, d))
         {
           prev = j;
         }
@@ -605,11 +562,12 @@ Statistics::get_day_index_by_date(int y, int m, int d, int &idx, int &next, int
         }
     }
 
-  if (prev < 0 && current_day->starts_before_date(y, m, d))
+  DailyStatsView today(current_day);
+  if (prev < 0 && today.starts_before_date(y, m, d))
     {
       prev = 0;
     }
-  if (next < 0 && !current_day->starts_at_date(y, m, d) && !current_day->starts_before_date(y, m, d))
+  if (next < 0 && !today.starts_at_date(y, m, d) && !today.starts_before_date(y, m, d))
     {
       next = 0;
     }
@@ -622,17 +580,15 @@ Statistics::get_history_size() const
   return static_cast<int>(history.size());
 }
 
-bool
-Statistics::DailyStatsImpl::starts_at_date(int y, int m, int d)
-{
-  return (start.tm_year + 1900 == y && start.tm_mon + 1 == m && start.tm_mday == d);
-}
-
-bool
-Statistics::DailyStatsImpl::starts_before_date(int y, int m, int d)
+int32_t
+Statistics::get_range(int32_t from,
+                      int32_t to,
+                      const std::vector<int> &fields,
+                      int max_days,
+                      std::vector<int32_t> &days,
+                      std::vector<int64_t> &values) const
 {
-  return (start.tm_year + 1900 < y
-          || (start.tm_year + 1900 == y && (start.tm_mon + 1 < m || (start.tm_mon + 1 == m && start.tm_mday < d))));
+  return collect_range(history, current_day, from, to, fields, max_days, days, values);
 }
 
 //! Activity is reported by the input monitor.
@@ -741,3 +697,9 @@ Statistics::keyboard_notify(bool repeat)
     }
   lock.unlock();
 }
+
+std::filesystem::path
+Statistics::get_state_directory() const
+{
+  return state_directory.empty() ? Paths::get_state_directory() : state_directory;
+}
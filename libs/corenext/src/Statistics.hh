@@ -24,6 +24,7 @@
 
 #include <chrono>
 
+#include <filesystem>
 #include <iostream>
 #include <fstream>
 #include <vector>
@@ -34,6 +35,8 @@
 #include "input-monitor/IInputMonitorListener.hh"
 
 #include "core/IStatistics.hh"
+#include "utils/RecordArena.hh"
+#include "utils/StringOutputStream.hh"
 #include "IActivityMonitor.hh"
 
 class Statistics
@@ -82,21 +85,20 @@ private:
       start.tm_year = 0;
     }
 
-    bool starts_at_date(int y, int m, int d);
-    bool starts_before_date(int y, int m, int d);
     bool is_empty() const
     {
       return start.tm_year == 0;
     }
   };
 
-  using History = std::vector<DailyStatsImpl *>;
-  using HistoryIter = std::vector<DailyStatsImpl *>::iterator;
-  using HistoryRIter = std::vector<DailyStatsImpl *>::reverse_iterator;
-
 public:
   //! Constructor.
-  explicit Statistics(IActivityMonitor::Ptr monitor);
+  /*!
+   *  The statistics are stored in the state directory of Workrave unless
+   *  another directory is specified. Sessions of the session server have
+   *  no input devices, so they do not use the input monitor.
+   */
+  explicit Statistics(IActivityMonitor::Ptr monitor, std::filesystem::path state_directory = {}, bool use_input_monitor = true);
 
   //! Destructor
   ~Statistics() override;
@@ -114,10 +116,16 @@ public:
   void add_break_counter(workrave::BreakId bt, StatsBreakValueType st, int value);
 
   DailyStatsImpl *get_current_day() const override;
-  DailyStatsImpl *get_day(int day) const override;
+  DailyStatsView get_day(int day) const override;
   void get_day_index_by_date(int y, int m, int d, int &idx, int &next, int &prev) const override;
 
   int get_history_size() const override;
+  int32_t get_range(int32_t from,
+                    int32_t to,
+                    const std::vector<int> &fields,
+                    int max_days,
+                    std::vector<int32_t> &days,
+                    std::vector<int64_t> &values) const override;
   void set_counter(StatsValueType t, int value);
   int64_t get_counter(StatsValueType t);
 
@@ -132,17 +140,31 @@ private:
 
 private:
   void save_day(DailyStatsImpl *stats);
-  void save_day(DailyStatsImpl *stats, std::ofstream &stats_file);
+  void save_day(const DailyStatsImpl *stats, std::ostream &stats_file);
   void load(std::ifstream &infile, bool history);
 
-  void day_to_history(DailyStatsImpl *stats);
-  void day_to_remote_history(DailyStatsImpl *stats);
+  void day_to_history(const DailyStatsImpl *stats);
+  void day_to_remote_history(const DailyStatsImpl *stats);
+
+  void add_history(const DailyStatsImpl *stats);
 
-  void add_history(DailyStatsImpl *stats);
+  std::filesystem::path get_state_directory() const;
 
 private:
   IActivityMonitor::Ptr monitor;
 
+  //! Directory of the statistics files, empty for the default.
+  std::filesystem::path state_directory;
+
+  //! Location of the statistics of the current day, resolved on the first save.
+  std::filesystem::path today_path;
+
+  //! Snapshot of the statistics of the current day, reused on every save.
+  workrave::utils::StringOutputStream today_stream;
+
+  //! Subscribe to the input monitor for mouse and keyboard statistics?
+  bool use_input_monitor;
+
   //! Mouse/Keyboard monitoring.
   workrave::input_monitor::IInputMonitor::Ptr input_monitor;
 
@@ -155,8 +177,8 @@ private:
   //! Has the user been active on the current day?
   bool been_active;
 
-  //! History
-  History history;
+  //! History, one record per day, sorted by date.
+  workrave::utils::RecordArena history{DailyStatsView::FIELD_SIZEOF};
 
   //! Internal locking
   std::mutex lock;
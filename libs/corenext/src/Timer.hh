@@ -22,36 +22,17 @@
 #include <memory>
 #include <string>
 
-class TimePred;
-
-enum TimerState
-{
-  STATE_INVALID,
-  STATE_RUNNING,
-  STATE_STOPPED
-};
-
-//! Event generated by the timer.
-enum TimerEvent
-{
-  //! No event occurred.
-  TIMER_EVENT_NONE,
-
-  //! The timer was reset back to 0 after the limit was reached.
-  TIMER_EVENT_RESET,
-
-  //! The timer was reset back to 0 before the limit was reached.
-  TIMER_EVENT_NATURAL_RESET,
+#include "TimerBank.hh"
 
-  //! The timer reached its limit.
-  TIMER_EVENT_LIMIT_REACHED,
-};
+class TimePred;
 
 //! The Timer class.
 /*!
  *  The Timer receives 'active' and 'idle' events from an activity monitor.
  *  Based on these events, the timer will start or stop the clock.
  *
+ *  A timer is a view of a slot in a TimerBank, which holds the actual
+ *  state. A timer created without a bank has a bank of its own.
  */
 class Timer
 {
@@ -61,7 +42,8 @@ public:
 public:
   // Construction/Destruction.
   explicit Timer(std::string id);
-  virtual ~Timer();
+  Timer(std::string id, TimerBank::Ptr bank);
+  virtual ~Timer() = default;
 
   // Control
   void enable();
@@ -107,82 +89,23 @@ public:
   // Timer ID
   std::string get_id() const;
 
+  //! Slot of the timer in its bank.
+  std::size_t get_slot() const;
+
   // State serialization.
   std::string serialize_state() const;
+  void serialize_state(std::ostream &out) const;
   bool deserialize_state(const std::string &state, int version);
-  // void set_state(int elapsed, int idle, int overdue = -1);
 
   int64_t get_total_overdue_time() const;
   void daily_reset();
 
 private:
-  void compute_next_limit_time();
-  void compute_next_reset_time();
-  void compute_next_daily_reset_time();
-
-private:
-  //! Is this timer enabled ?
-  bool timer_enabled;
-
-  //! Is the timer frozen? A frozen timer only counts idle time.
-  bool timer_frozen;
-
-  //! State of the timer.
-  TimerState timer_state;
-
-  //! Default snooze time
-  int64_t snooze_interval;
-
-  //! Don't snooze til next reset or changes.
-  bool snooze_inhibited;
-
-  //! Is the timer limit enabled?
-  bool limit_enabled;
-
-  //! Timer limit interval.
-  int64_t limit_interval;
-
-  //! Is the timer auto reset enabled?
-  bool auto_reset_enabled;
-
-  //! Automatic reset time interval.
-  int64_t auto_reset_interval;
-
-  //! Daily auto reset checker (NULL if not used)
-  TimePred *daily_auto_reset;
-
-  //! Elapsed time.
-  int64_t elapsed_timespan;
-
-  //! The total elapsed time the last time the limit was reached.
-  int64_t elapsed_timespan_at_last_limit;
-
-  //! Elapsed Idle time.
-  int64_t elapsed_idle_timespan;
-
-  //! Total overdue time.
-  int64_t total_overdue_timespan;
-
-  //! Time when the timer was last started.
-  int64_t last_start_time;
-
-  //! Time when the timer was last stopped.
-  int64_t last_stop_time;
-
-  //! Time when the timer was last reset.
-  int64_t last_reset_time;
-
-  //! Time when the timer was last reset because of a daily reset.
-  int64_t last_daily_reset_time;
-
-  //! Next automatic reset time.
-  int64_t next_reset_time;
-
-  //! Next daily reset time.
-  int64_t next_daily_reset_time;
+  //! Bank that holds the state of the timer.
+  TimerBank::Ptr bank;
 
-  //! Next limit time.
-  int64_t next_limit_time;
+  //! Slot of the timer in the bank.
+  std::size_t slot;
 
   //! Id of the timer.
   std::string timer_id;
@@ -0,0 +1,807 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#ifdef PLATFORM_OS_MACOS
+#  include "MacOSHelpers.hh"
+#endif
+
+#include "TimerBank.hh"
+
+#include <sstream>
+
+#include "debug.hh"
+#include "utils/TimeSource.hh"
+
+#include "TimePred.hh"
+
+using namespace std;
+using namespace workrave::utils;
+
+namespace
+{
+  //! Returns 1 if the deadline is set (not 0) and passed, 0 otherwise.
+  /*!
+   *  Only uses 64 bit operations that plain SSE2 has, so the compiler can
+   *  vectorize the loop in TimerBank::process().
+   */
+  inline uint64_t is_due(int64_t deadline, int64_t now)
+  {
+    auto d = static_cast<uint64_t>(deadline);
+    uint64_t set = (d | (0 - d)) >> 63;
+    uint64_t passed = (~(static_cast<uint64_t>(now) - d)) >> 63;
+    return set & passed;
+  }
+} // namespace
+
+TimerBank::TimerBank() = default;
+TimerBank::~TimerBank() = default;
+
+std::size_t
+TimerBank::add()
+{
+  std::size_t slot = timer_enabled.size();
+
+  timer_enabled.push_back(false);
+  timer_state.push_back(STATE_INVALID);
+  user_active.push_back(false);
+  next_limit_time.push_back(0);
+  next_reset_time.push_back(0);
+  next_daily_reset_time.push_back(0);
+  elapsed_timespan.push_back(0);
+  elapsed_idle_timespan.push_back(0);
+
+  timer_frozen.push_back(false);
+  snooze_interval.push_back(60);
+  snooze_inhibited.push_back(false);
+  limit_enabled.push_back(true);
+  limit_interval.push_back(600);
+  auto_reset_enabled.push_back(true);
+  auto_reset_interval.push_back(120);
+  daily_auto_reset.emplace_back();
+  elapsed_timespan_at_last_limit.push_back(0);
+  total_overdue_timespan.push_back(0);
+  last_start_time.push_back(0);
+  last_stop_time.push_back(0);
+  last_reset_time.push_back(0);
+  last_daily_reset_time.push_back(0);
+
+  due.push_back(0);
+
+  // Every timer reports at most one event per process(), so that never allocates.
+  events.reserve(due.size());
+  return slot;
+}
+
+std::size_t
+TimerBank::size() const
+{
+  return timer_enabled.size();
+}
+
+void
+TimerBank::reserve(std::size_t capacity)
+{
+  timer_enabled.reserve(capacity);
+  timer_state.reserve(capacity);
+  user_active.reserve(capacity);
+  next_limit_time.reserve(capacity);
+  next_reset_time.reserve(capacity);
+  next_daily_reset_time.reserve(capacity);
+  elapsed_timespan.reserve(capacity);
+  elapsed_idle_timespan.reserve(capacity);
+
+  timer_frozen.reserve(capacity);
+  snooze_interval.reserve(capacity);
+  snooze_inhibited.reserve(capacity);
+  limit_enabled.reserve(capacity);
+  limit_interval.reserve(capacity);
+  auto_reset_enabled.reserve(capacity);
+  auto_reset_interval.reserve(capacity);
+  daily_auto_reset.reserve(capacity);
+  elapsed_timespan_at_last_limit.reserve(capacity);
+  total_overdue_timespan.reserve(capacity);
+  last_start_time.reserve(capacity);
+  last_stop_time.reserve(capacity);
+  last_reset_time.reserve(capacity);
+  last_daily_reset_time.reserve(capacity);
+
+  due.reserve(capacity);
+  events.reserve(capacity);
+}
+
+void
+TimerBank::set_user_active(std::size_t slot, bool active)
+{
+  user_active[slot] = active;
+}
+
+const std::vector<TimerBank::Event> &
+TimerBank::process()
+{
+  int64_t now = TimeSource::get_monotonic_time_sec_sync();
+  int64_t real_now = TimeSource::get_real_time_sec_sync();
+  std::size_t count = size();
+
+  // A timer needs attention when it must start or stop, or when one of its
+  // deadlines passed. For all other timers process(slot) would do nothing.
+  const uint8_t *enabled = timer_enabled.data();
+  const TimerState *state = timer_state.data();
+  const uint8_t *active = user_active.data();
+  const int64_t *limit = next_limit_time.data();
+  const int64_t *reset = next_reset_time.data();
+  const int64_t *daily = next_daily_reset_time.data();
+  uint8_t *flags = due.data();
+
+  for (std::size_t i = 0; i < count; i++)
+    {
+      uint8_t running = state[i] == STATE_RUNNING;
+      uint8_t transition = (enabled[i] != 0) & ((active[i] != 0) ^ running);
+      uint64_t deadline = is_due(limit[i], now) | is_due(reset[i], now) | is_due(daily[i], real_now);
+      flags[i] = transition | static_cast<uint8_t>(deadline);
+    }
+
+  events.clear();
+  for (std::size_t i = 0; i < count; i++)
+    {
+      if (flags[i] != 0)
+        {
+          TimerEvent event = process(i, user_active[i] != 0);
+          if (event != TIMER_EVENT_NONE)
+            {
+              events.push_back(Event{i, event});
+            }
+        }
+    }
+
+  return events;
+}
+
+void
+TimerBank::enable(std::size_t slot)
+{
+  TRACE_ENTER_MSG("TimerBank::enable", slot << " " << static_cast<int>(timer_enabled[slot]));
+  if (!timer_enabled[slot])
+    {
+      timer_enabled[slot] = true;
+      snooze_inhibited[slot] = false;
+      stop_timer(slot);
+
+      if (is_auto_reset_enabled(slot) && get_elapsed_time(slot) == 0)
+        {
+          // Start with idle time at maximum.
+          elapsed_idle_timespan[slot] = auto_reset_interval[slot];
+        }
+
+      if (is_limit_enabled(slot) && get_elapsed_time(slot) >= limit_interval[slot])
+        {
+          // Break is overdue, force a snooze.
+          elapsed_timespan_at_last_limit[slot] = 0;
+          compute_next_limit_time(slot);
+        }
+
+      compute_next_reset_time(slot);
+      compute_next_daily_reset_time(slot);
+    }
+
+  TRACE_EXIT();
+}
+
+void
+TimerBank::disable(std::size_t slot)
+{
+  TRACE_ENTER_MSG("TimerBank::disable", slot << " " << static_cast<int>(timer_enabled[slot]));
+
+  if (timer_enabled[slot])
+    {
+      timer_enabled[slot] = false;
+      stop_timer(slot);
+
+      last_start_time[slot] = 0;
+      last_stop_time[slot] = 0;
+      last_reset_time[slot] = 0;
+      next_limit_time[slot] = 0;
+      next_reset_time[slot] = 0;
+
+      timer_state[slot] = STATE_INVALID;
+    }
+
+  TRACE_EXIT();
+}
+
+void
+TimerBank::snooze_timer(std::size_t slot)
+{
+  TRACE_ENTER_MSG("TimerBank::snooze_timer", slot);
+  TRACE_MSG(dump_state(slot));
+
+  if (timer_enabled[slot])
+    {
+      next_limit_time[slot] = 0;
+      elapsed_timespan_at_last_limit[slot] = get_elapsed_time(slot);
+      compute_next_limit_time(slot);
+    }
+
+  TRACE_EXIT();
+}
+
+//! Prevents 'limit reached' snoozing until timer reset.
+void
+TimerBank::inhibit_snooze(std::size_t slot)
+{
+  TRACE_ENTER_MSG("TimerBank::inhibit_snooze", slot);
+  TRACE_MSG(dump_state(slot));
+  snooze_inhibited[slot] = true;
+  compute_next_limit_time(slot);
+  TRACE_EXIT();
+}
+
+void
+TimerBank::start_timer(std::size_t slot)
+{
+  TRACE_ENTER_MSG("TimerBank::start_timer", slot << " " << timer_state[slot]);
+  TRACE_MSG(dump_state(slot));
+
+  if (timer_state[slot] != STATE_RUNNING)
+    {
+      // Set last start and stop times.
+      if (!timer_frozen[slot])
+        {
+          // Timer is not frozen, so let's start.
+          last_start_time[slot] = TimeSource::get_monotonic_time_sec_sync();
+          elapsed_idle_timespan[slot] = 0;
+        }
+      else
+        {
+          TRACE_MSG("Timer is frozen");
+          // The timer is frozen, so we don't start counting 'active' time.
+          // Instead, update the elapsed idle time.
+          if (last_stop_time[slot] != 0)
+            {
+              elapsed_idle_timespan[slot] += (TimeSource::get_monotonic_time_sec_sync() - last_stop_time[slot]);
+            }
+          last_start_time[slot] = 0;
+        }
+
+      // Reset values that are only used when the timer is not running.
+      last_stop_time[slot] = 0;
+      next_reset_time[slot] = 0;
+
+      // update state.
+      timer_state[slot] = STATE_RUNNING;
+
+      // When to generate a limit-reached-event.
+      compute_next_limit_time(slot);
+    }
+  TRACE_EXIT();
+}
+
+void
+TimerBank::stop_timer(std::size_t slot)
+{
+  TRACE_ENTER_MSG("TimerBank::stop_timer", slot << " " << timer_state[slot] << " " << timer_state[slot]);
+  TRACE_MSG(dump_state(slot));
+
+  if (timer_state[slot] != STATE_STOPPED)
+    {
+      // Update last stop time.
+      last_stop_time[slot] = TimeSource::get_monotonic_time_sec_sync();
+
+      // Update elapsed time.
+      if (last_start_time[slot] != 0)
+        {
+          // But only if we are running...
+          elapsed_timespan[slot] += (last_stop_time[slot] - last_start_time[slot]);
+        }
+
+      // Reset last start time.
+      last_start_time[slot] = 0;
+      next_limit_time[slot] = 0;
+
+      // Update state.
+      timer_state[slot] = STATE_STOPPED;
+
+      // When to reset the timer.
+      compute_next_reset_time(slot);
+    }
+  TRACE_EXIT();
+}
+
+void
+TimerBank::reset_timer(std::size_t slot)
+{
+  TRACE_ENTER_MSG("TimerBank::reset", slot << " " << timer_state[slot]);
+  TRACE_MSG(dump_state(slot));
+
+  // Update total overdue.
+  int64_t elapsed = get_elapsed_time(slot);
+  if (is_limit_enabled(slot) && elapsed > limit_interval[slot])
+    {
+      total_overdue_timespan[slot] += (elapsed - limit_interval[slot]);
+    }
+
+  // Full reset.
+  elapsed_timespan[slot] = 0;
+  elapsed_timespan_at_last_limit[slot] = 0;
+  last_reset_time[slot] = TimeSource::get_monotonic_time_sec_sync();
+  snooze_inhibited[slot] = false;
+
+  if (timer_state[slot] == STATE_RUNNING)
+    {
+      // The timer is reset while running, Pretend the timer just started.
+      last_start_time[slot] = TimeSource::get_monotonic_time_sec_sync();
+      last_stop_time[slot] = 0;
+      next_reset_time[slot] = 0;
+
+      compute_next_limit_time(slot);
+      elapsed_idle_timespan[slot] = 0;
+    }
+  else
+    {
+      // The timer is reset while it is not running.
+      last_start_time[slot] = 0;
+      next_reset_time[slot] = 0;
+      next_limit_time[slot] = 0;
+
+      if (is_auto_reset_enabled(slot))
+        {
+          elapsed_idle_timespan[slot] = auto_reset_interval[slot];
+          last_stop_time[slot] = TimeSource::get_monotonic_time_sec_sync();
+        }
+    }
+
+  next_daily_reset_time[slot] = 0;
+  compute_next_daily_reset_time(slot);
+  TRACE_EXIT();
+}
+
+void
+TimerBank::freeze_timer(std::size_t slot, bool freeze)
+{
+  TRACE_ENTER_MSG("TimerBank::freeze_timer", slot << freeze << " " << static_cast<int>(timer_enabled[slot]) << " ");
+  TRACE_MSG(dump_state(slot));
+
+  if (timer_enabled[slot])
+    {
+      if (freeze && !timer_frozen[slot])
+        {
+          TRACE_MSG("freezing");
+          // freeze timer.
+          if (last_start_time[slot] != 0 && timer_state[slot] == STATE_RUNNING)
+            {
+              elapsed_timespan[slot] += (TimeSource::get_monotonic_time_sec_sync() - last_start_time[slot]);
+              last_start_time[slot] = 0;
+            }
+        }
+      else if (!freeze && timer_frozen[slot])
+        {
+          TRACE_MSG("unfreezing");
+          // defrost timer.
+          if (timer_state[slot] == STATE_RUNNING)
+            {
+              last_start_time[slot] = TimeSource::get_monotonic_time_sec_sync();
+              elapsed_idle_timespan[slot] = 0;
+
+              compute_next_limit_time(slot);
+            }
+        }
+    }
+
+  timer_frozen[slot] = freeze;
+  TRACE_MSG(dump_state(slot));
+  TRACE_EXIT();
+}
+
+TimerEvent
+TimerBank::process(std::size_t slot, bool user_is_active)
+{
+  TRACE_ENTER_MSG("TimerBank::process", slot << " " << user_is_active);
+  TRACE_MSG(dump_state(slot));
+
+  int64_t current_time = TimeSource::get_monotonic_time_sec_sync();
+  TimerEvent event = TIMER_EVENT_NONE;
+
+  if (timer_enabled[slot])
+    {
+      if (user_is_active && timer_state[slot] != STATE_RUNNING)
+        {
+          start_timer(slot);
+        }
+      else if (!user_is_active && timer_state[slot] == STATE_RUNNING)
+        {
+          stop_timer(slot);
+        }
+    }
+
+  if (daily_auto_reset[slot] && next_daily_reset_time[slot] != 0 && TimeSource::get_real_time_sec_sync() >= next_daily_reset_time[slot])
+    {
+      TRACE_MSG("daily reset");
+      // A next reset time was set and the current time >= reset time.
+      // So reset the timer and send a reset event.
+      reset_timer(slot);
+
+      last_daily_reset_time[slot] = TimeSource::get_real_time_sec_sync();
+      next_daily_reset_time[slot] = 0;
+
+      compute_next_daily_reset_time(slot);
+      event = TIMER_EVENT_RESET;
+    }
+  else if (next_limit_time[slot] != 0 && current_time >= next_limit_time[slot])
+    {
+      TRACE_MSG("limit");
+      // A next limit time was set and the current time >= limit time.
+      next_limit_time[slot] = 0;
+      elapsed_timespan_at_last_limit[slot] = get_elapsed_time(slot);
+
+      compute_next_limit_time(slot);
+      event = TIMER_EVENT_LIMIT_REACHED;
+    }
+  else if (next_reset_time[slot] != 0 && current_time >= next_reset_time[slot])
+    {
+      TRACE_MSG("reset");
+      bool natural = is_limit_enabled(slot) && limit_interval[slot] >= get_elapsed_time(slot);
+
+      // A next reset time was set and the current time >= reset time.
+      next_reset_time[slot] = 0;
+      reset_timer(slot);
+
+      event = natural ? TIMER_EVENT_NATURAL_RESET : TIMER_EVENT_RESET;
+      if (natural)
+        {
+          TRACE_MSG("natural");
+        }
+    }
+
+  TRACE_RETURN(event);
+  return event;
+}
+
+int64_t
+TimerBank::get_elapsed_time(std::size_t slot) const
+{
+  int64_t ret = elapsed_timespan[slot];
+
+  if (timer_enabled[slot] && last_start_time[slot] != 0)
+    {
+      ret += (TimeSource::get_monotonic_time_sec_sync() - last_start_time[slot]);
+    }
+
+  return ret;
+}
+
+int64_t
+TimerBank::get_elapsed_idle_time(std::size_t slot) const
+{
+  int64_t ret = elapsed_idle_timespan[slot];
+
+  if (timer_enabled[slot] && last_stop_time[slot] != 0)
+    {
+      ret += (TimeSource::get_monotonic_time_sec_sync() - last_stop_time[slot]);
+    }
+
+  return ret;
+}
+
+bool
+TimerBank::is_running(std::size_t slot) const
+{
+  return timer_state[slot] == STATE_RUNNING;
+}
+
+bool
+TimerBank::is_enabled(std::size_t slot) const
+{
+  return timer_enabled[slot];
+}
+
+void
+TimerBank::set_auto_reset(std::size_t slot, int reset_time)
+{
+  if (reset_time > auto_reset_interval[slot])
+    {
+      // increasing reset_time, re-enable limit-reached snoozing.
+      snooze_inhibited[slot] = false;
+    }
+
+  auto_reset_interval[slot] = reset_time;
+  compute_next_reset_time(slot);
+}
+
+void
+TimerBank::set_daily_reset(std::size_t slot, TimePred *predicate)
+{
+  daily_auto_reset[slot].reset(predicate);
+  compute_next_daily_reset_time(slot);
+}
+
+void
+TimerBank::set_auto_reset_enabled(std::size_t slot, bool b)
+{
+  auto_reset_enabled[slot] = b;
+  compute_next_reset_time(slot);
+}
+
+bool
+TimerBank::is_auto_reset_enabled(std::size_t slot) const
+{
+  return auto_reset_enabled[slot] && auto_reset_interval[slot] > 0;
+}
+
+int64_t
+TimerBank::get_auto_reset(std::size_t slot) const
+{
+  return auto_reset_interval[slot];
+}
+
+int64_t
+TimerBank::get_next_reset_time(std::size_t slot) const
+{
+  return next_reset_time[slot];
+}
+
+void
+TimerBank::set_limit(std::size_t slot, int limit_time)
+{
+  limit_interval[slot] = limit_time;
+
+  if (get_elapsed_time(slot) < limit_time)
+    {
+      // limit increased, pretend there was no limit-reached yet.
+      elapsed_timespan_at_last_limit[slot] = 0;
+    }
+
+  compute_next_limit_time(slot);
+}
+
+void
+TimerBank::set_limit_enabled(std::size_t slot, bool b)
+{
+  if (limit_enabled[slot] != b)
+    {
+      limit_enabled[slot] = b;
+      compute_next_limit_time(slot);
+    }
+}
+
+bool
+TimerBank::is_limit_enabled(std::size_t slot) const
+{
+  return limit_enabled[slot] && limit_interval[slot] > 0;
+}
+
+int64_t
+TimerBank::get_limit(std::size_t slot) const
+{
+  return limit_interval[slot];
+}
+
+int64_t
+TimerBank::get_next_limit_time(std::size_t slot) const
+{
+  return next_limit_time[slot];
+}
+
+void
+TimerBank::set_snooze(std::size_t slot, int64_t t)
+{
+  snooze_interval[slot] = t;
+}
+
+int64_t
+TimerBank::get_snooze(std::size_t slot) const
+{
+  return snooze_interval[slot];
+}
+
+std::string
+TimerBank::serialize_state(std::size_t slot) const
+{
+  stringstream ss;
+  serialize_state(slot, ss);
+  return ss.str();
+}
+
+void
+TimerBank::serialize_state(std::size_t slot, std::ostream &out) const
+{
+  out << TimeSource::get_real_time_sec_sync() << " " << get_elapsed_time(slot) << " " << last_daily_reset_time[slot] << " "
+      << total_overdue_timespan[slot] << " " << static_cast<int>(snooze_inhibited[slot]) << " " << 0 << " "
+      << elapsed_timespan_at_last_limit[slot] << " " << 0 /* timezone */;
+}
+
+bool
+TimerBank::deserialize_state(std::size_t slot, const std::string &state, int version)
+{
+  TRACE_ENTER("TimerBank::deserialize_state");
+  istringstream ss(state);
+
+  int64_t save_time = 0;
+  int64_t elapsed = 0;
+  int64_t last_reset = 0;
+  int64_t overdue = 0;
+  int64_t llt = 0;
+  int64_t lle = 0;
+  bool si = false;
+
+  ss >> save_time >> elapsed >> last_reset >> overdue >> si >> llt >> lle;
+
+  if (version == 3)
+    {
+      // Ignored.
+      int64_t tz = 0;
+      ss >> tz;
+    }
+
+  // Sanity check...
+  if (last_reset > save_time)
+    {
+      last_reset = save_time;
+    }
+
+  TRACE_MSG(si << " " << llt << " " << lle);
+  TRACE_MSG(static_cast<int>(snooze_inhibited[slot]));
+
+  last_daily_reset_time[slot] = last_reset;
+  total_overdue_timespan[slot] = overdue;
+  elapsed_timespan[slot] = 0;
+  last_start_time[slot] = 0;
+  last_stop_time[slot] = 0;
+
+  bool tooOld = (is_auto_reset_enabled(slot) && (TimeSource::get_real_time_sec_sync() - save_time > auto_reset_interval[slot]));
+
+  if (!tooOld)
+    {
+      if (is_auto_reset_enabled(slot))
+        {
+          next_reset_time[slot] = TimeSource::get_monotonic_time_sec_sync() + auto_reset_interval[slot];
+        }
+      elapsed_timespan[slot] = elapsed;
+      snooze_inhibited[slot] = si;
+    }
+
+  // overdue, so snooze
+  if (is_limit_enabled(slot) && get_elapsed_time(slot) >= limit_interval[slot])
+    {
+      elapsed_timespan_at_last_limit[slot] = lle;
+      compute_next_limit_time(slot);
+    }
+
+  compute_next_daily_reset_time(slot);
+
+  TRACE_MSG("elapsed = " << elapsed_timespan[slot]);
+  return true;
+}
+
+int64_t
+TimerBank::get_total_overdue_time(std::size_t slot) const
+{
+  int64_t ret = total_overdue_timespan[slot];
+  int64_t elapsed = get_elapsed_time(slot);
+
+  if (is_limit_enabled(slot) && elapsed > limit_interval[slot])
+    {
+      ret += (elapsed - limit_interval[slot]);
+    }
+
+  return ret;
+}
+
+void
+TimerBank::daily_reset(std::size_t slot)
+{
+  total_overdue_timespan[slot] = 0;
+}
+
+std::string
+TimerBank::dump_state(std::size_t slot) const
+{
+  stringstream ss;
+  ss << TimeSource::get_real_time_sec_sync() << " f:" << static_cast<int>(timer_frozen[slot]) << " s:" << timer_state[slot]
+     << " si:" << static_cast<int>(snooze_inhibited[slot]) << " e:" << elapsed_timespan[slot]
+     << " ell:" << elapsed_timespan_at_last_limit[slot] << " i:" << elapsed_idle_timespan[slot] << " ls:" << last_start_time[slot]
+     << " " << last_stop_time[slot] << " lr:" << last_reset_time[slot] << " nr:" << next_reset_time[slot]
+     << " nl:" << next_limit_time[slot];
+  return ss.str();
+}
+
+void
+TimerBank::compute_next_limit_time(std::size_t slot)
+{
+  TRACE_ENTER_MSG("TimerBank::compute_next_limit_time", slot);
+  TRACE_MSG(dump_state(slot));
+
+  // default action. No next limit.
+  next_limit_time[slot] = 0;
+
+  if (timer_enabled[slot])
+    {
+      if (timer_state[slot] == STATE_RUNNING && last_start_time[slot] != 0 && is_limit_enabled(slot))
+        {
+          // The timer is running and a limit != 0 is set.
+
+          if (get_elapsed_time(slot) >= limit_interval[slot])
+            {
+              // The timer already reached its limit. We need to re-send the
+              // limit-reached event after 'snooze_interval[slot]' seconds of
+              // activity after the previous event. Unless snoozing is
+              // inhibted. This is dependent of user activity.
+              if (!snooze_inhibited[slot])
+                {
+                  next_limit_time[slot] =
+                    (last_start_time[slot] - elapsed_timespan[slot] + elapsed_timespan_at_last_limit[slot] + snooze_interval[slot]);
+                }
+              TRACE_MSG("Next limit time (1) = " << next_limit_time[slot] << " "
+                                                 << (next_limit_time[slot] - TimeSource::get_real_time_sec_sync()));
+            }
+          else
+            {
+              // The timer did not yet reaches its limit.
+              // new limit = last start time + limit - elapsed.
+              next_limit_time[slot] = last_start_time[slot] + limit_interval[slot] - elapsed_timespan[slot];
+              TRACE_MSG("Next limit time (2) = " << next_limit_time[slot] << " "
+                                                 << (next_limit_time[slot] - TimeSource::get_real_time_sec_sync()));
+            }
+        }
+    }
+  TRACE_EXIT();
+}
+
+void
+TimerBank::compute_next_reset_time(std::size_t slot)
+{
+  TRACE_ENTER_MSG("TimerBank::compute_next_reset_time", slot);
+  TRACE_MSG(dump_state(slot));
+  // default action. No next reset.
+  next_reset_time[slot] = 0;
+
+  if (timer_enabled[slot] && timer_state[slot] == STATE_STOPPED && last_stop_time[slot] != 0 && is_auto_reset_enabled(slot))
+    {
+      // We are enabled, not running and a reset time != 0 was set.
+
+      // next reset time = last stop time + auto reset
+      next_reset_time[slot] = last_stop_time[slot] + auto_reset_interval[slot] - elapsed_idle_timespan[slot];
+      TRACE_MSG("Next reset time = " << next_reset_time[slot] << " " << (next_reset_time[slot] - TimeSource::get_real_time_sec_sync()));
+      if (next_reset_time[slot] <= last_reset_time[slot] || next_reset_time[slot] <= last_stop_time[slot])
+        {
+          // Just is sanity check, can't reset before the previous one..
+          next_reset_time[slot] = 0;
+          TRACE_MSG("Next reset time in past, setting to 0 ");
+        }
+    }
+  TRACE_EXIT();
+}
+
+void
+TimerBank::compute_next_daily_reset_time(std::size_t slot)
+{
+  // This one ALWAYS sends a reset, also when the timer is disabled.
+
+  if (daily_auto_reset[slot])
+    {
+      if (last_daily_reset_time[slot] == 0)
+        {
+          // The timer did not reach a predicate reset before. Just take
+          // the current time as the last reset time...
+          last_daily_reset_time[slot] = TimeSource::get_real_time_sec_sync();
+        }
+
+      next_daily_reset_time[slot] = daily_auto_reset[slot]->get_next(last_daily_reset_time[slot]);
+    }
+}
@@ -0,0 +1,224 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef TIMERBANK_HH
+#define TIMERBANK_HH
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+class TimePred;
+
+enum TimerState
+{
+  STATE_INVALID,
+  STATE_RUNNING,
+  STATE_STOPPED
+};
+
+//! Event generated by the timer.
+enum TimerEvent
+{
+  //! No event occurred.
+  TIMER_EVENT_NONE,
+
+  //! The timer was reset back to 0 after the limit was reached.
+  TIMER_EVENT_RESET,
+
+  //! The timer was reset back to 0 before the limit was reached.
+  TIMER_EVENT_NATURAL_RESET,
+
+  //! The timer reached its limit.
+  TIMER_EVENT_LIMIT_REACHED,
+};
+
+//! The state of a set of timers, stored as a structure of arrays.
+/*!
+ *  Every timer is a slot in the bank. Each field of a timer is stored in
+ *  its own contiguous array, so that process() can find the timers that
+ *  need attention in a single branch-free pass over the deadlines. Only
+ *  those timers are then updated, one by one, with the same logic as a
+ *  single timer.
+ *
+ *  Slots are never removed; they live as long as the bank.
+ */
+class TimerBank
+{
+public:
+  using Ptr = std::shared_ptr<TimerBank>;
+
+  //! Event generated by process().
+  struct Event
+  {
+    std::size_t slot;
+    TimerEvent event;
+  };
+
+public:
+  TimerBank();
+  ~TimerBank();
+  TimerBank(const TimerBank &) = delete;
+  TimerBank &operator=(const TimerBank &) = delete;
+
+  //! Adds a new disabled timer and returns its slot.
+  std::size_t add();
+  std::size_t size() const;
+  void reserve(std::size_t capacity);
+
+  //! Sets whether the user is active for the timer in the specified slot during the next process().
+  void set_user_active(std::size_t slot, bool active);
+
+  //! Processes all timers. Returns the events in slot order; the list is valid until the next call.
+  const std::vector<Event> &process();
+
+  // Control
+  void enable(std::size_t slot);
+  void disable(std::size_t slot);
+
+  void snooze_timer(std::size_t slot);
+  void inhibit_snooze(std::size_t slot);
+
+  void start_timer(std::size_t slot);
+  void stop_timer(std::size_t slot);
+  void reset_timer(std::size_t slot);
+
+  void freeze_timer(std::size_t slot, bool f);
+
+  // Processing of a single timer.
+  TimerEvent process(std::size_t slot, bool user_is_active);
+
+  // State inquiry
+  int64_t get_elapsed_time(std::size_t slot) const;
+  int64_t get_elapsed_idle_time(std::size_t slot) const;
+  bool is_running(std::size_t slot) const;
+  bool is_enabled(std::size_t slot) const;
+
+  // Auto-resetting.
+  void set_auto_reset(std::size_t slot, int t);
+  void set_auto_reset_enabled(std::size_t slot, bool b);
+  void set_daily_reset(std::size_t slot, TimePred *daily_reset);
+  bool is_auto_reset_enabled(std::size_t slot) const;
+  int64_t get_auto_reset(std::size_t slot) const;
+  int64_t get_next_reset_time(std::size_t slot) const;
+
+  // Limiting.
+  void set_limit(std::size_t slot, int t);
+  void set_limit_enabled(std::size_t slot, bool b);
+  bool is_limit_enabled(std::size_t slot) const;
+  int64_t get_limit(std::size_t slot) const;
+  int64_t get_next_limit_time(std::size_t slot) const;
+
+  // Snoozing.
+  void set_snooze(std::size_t slot, int64_t time);
+  int64_t get_snooze(std::size_t slot) const;
+
+  // State serialization, without the timer id.
+  std::string serialize_state(std::size_t slot) const;
+  void serialize_state(std::size_t slot, std::ostream &out) const;
+  bool deserialize_state(std::size_t slot, const std::string &state, int version);
+
+  int64_t get_total_overdue_time(std::size_t slot) const;
+  void daily_reset(std::size_t slot);
+
+private:
+  void compute_next_limit_time(std::size_t slot);
+  void compute_next_reset_time(std::size_t slot);
+  void compute_next_daily_reset_time(std::size_t slot);
+  std::string dump_state(std::size_t slot) const;
+
+private:
+  // Fields read by every process(). Flags are bytes to keep the scan vectorizable.
+
+  //! Is this timer enabled ?
+  std::vector<uint8_t> timer_enabled;
+
+  //! State of the timer.
+  std::vector<TimerState> timer_state;
+
+  //! Is the user active for this timer?
+  std::vector<uint8_t> user_active;
+
+  //! Next limit time.
+  std::vector<int64_t> next_limit_time;
+
+  //! Next automatic reset time.
+  std::vector<int64_t> next_reset_time;
+
+  //! Next daily reset time.
+  std::vector<int64_t> next_daily_reset_time;
+
+  //! Elapsed time.
+  std::vector<int64_t> elapsed_timespan;
+
+  //! Elapsed Idle time.
+  std::vector<int64_t> elapsed_idle_timespan;
+
+  // Fields only used when a timer changes state.
+
+  //! Is the timer frozen? A frozen timer only counts idle time.
+  std::vector<uint8_t> timer_frozen;
+
+  //! Default snooze time
+  std::vector<int64_t> snooze_interval;
+
+  //! Don't snooze til next reset or changes.
+  std::vector<uint8_t> snooze_inhibited;
+
+  //! Is the timer limit enabled?
+  std::vector<uint8_t> limit_enabled;
+
+  //! Timer limit interval.
+  std::vector<int64_t> limit_interval;
+
+  //! Is the timer auto reset enabled?
+  std::vector<uint8_t> auto_reset_enabled;
+
+  //! Automatic reset time interval.
+  std::vector<int64_t> auto_reset_interval;
+
+  //! Daily auto reset checker (NULL if not used)
+  std::vector<std::unique_ptr<TimePred>> daily_auto_reset;
+
+  //! The total elapsed time the last time the limit was reached.
+  std::vector<int64_t> elapsed_timespan_at_last_limit;
+
+  //! Total overdue time.
+  std::vector<int64_t> total_overdue_timespan;
+
+  //! Time when the timer was last started.
+  std::vector<int64_t> last_start_time;
+
+  //! Time when the timer was last stopped.
+  std::vector<int64_t> last_stop_time;
+
+  //! Time when the timer was last reset.
+  std::vector<int64_t> last_reset_time;
+
+  //! Time when the timer was last reset because of a daily reset.
+  std::vector<int64_t> last_daily_reset_time;
+
+  //! Timers found by the last scan of process().
+  std::vector<uint8_t> due;
+
+  //! Events of the last process().
+  std::vector<Event> events;
+};
+
+#endif // TIMERBANK_HH
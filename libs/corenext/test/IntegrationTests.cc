@@ -44,6 +44,7 @@
 #include "utils/TimeSource.hh"
 #include "debug.hh"
 
+#include "Core.hh"
 #include "Timer.hh"
 #include "ICoreTestHooks.hh"
 
@@ -756,6 +757,7 @@ BOOST_AUTO_TEST_CASE(test_operation_mode_override)
 {
   init();
 
+  expect(0, "operationmode", "mode=1");
   core->set_operation_mode_override(OperationMode::Suspended, "ov1");
   tick(false, 1);
 
@@ -784,6 +786,7 @@ BOOST_AUTO_TEST_CASE(test_operation_mode_override)
   BOOST_CHECK_EQUAL(core->get_operation_mode_regular(), OperationMode::Normal);
   BOOST_CHECK(core->is_operation_mode_an_override());
 
+  expect(4, "operationmode", "mode=2");
   core->remove_operation_mode_override("ov1");
   tick(false, 1);
 
@@ -791,7 +794,7 @@ BOOST_AUTO_TEST_CASE(test_operation_mode_override)
   BOOST_CHECK_EQUAL(core->get_operation_mode_regular(), OperationMode::Normal);
   BOOST_CHECK(core->is_operation_mode_an_override());
 
-  expect(5, "operationmode", "mode=0"); // FIXME: why this event?
+  expect(5, "operationmode", "mode=0");
   core->remove_operation_mode_override("ov2");
   tick(false, 1);
 
@@ -821,6 +824,7 @@ BOOST_AUTO_TEST_CASE(test_operation_mode_override_change_while_overridden)
   BOOST_CHECK_EQUAL(core->get_operation_mode_regular(), OperationMode::Quiet);
   BOOST_CHECK(!core->is_operation_mode_an_override());
 
+  expect(1, "operationmode", "mode=1");
   core->set_operation_mode_override(OperationMode::Suspended, "ov1");
   tick(false, 1);
 
@@ -828,9 +832,8 @@ BOOST_AUTO_TEST_CASE(test_operation_mode_override_change_while_overridden)
   BOOST_CHECK_EQUAL(core->get_operation_mode_regular(), OperationMode::Quiet);
   BOOST_CHECK(core->is_operation_mode_an_override());
 
+  // The active mode does not change.
   core->set_operation_mode(OperationMode::Normal);
-  expect(2, "operationmode", "mode=1"); // FIXME: Why this event?
-  expect(2, "operationmode", "mode=1"); // FIXME: Why this event?
   tick(false, 1);
 
   BOOST_CHECK_EQUAL(core->get_operation_mode(), OperationMode::Suspended);
@@ -851,6 +854,33 @@ BOOST_AUTO_TEST_CASE(test_operation_mode_override_change_while_overridden)
   verify();
 }
 
+BOOST_AUTO_TEST_CASE(test_operation_mode_override_expiry)
+{
+  init();
+
+  auto next = std::dynamic_pointer_cast<Core>(core);
+  BOOST_REQUIRE(next);
+
+  expect(0, "operationmode", "mode=1");
+  next->set_operation_mode_override_with_lifetime(OperationMode::Suspended, "client", 10);
+  tick(false, 8);
+
+  // Renewing keeps the override alive without a change notification.
+  next->set_operation_mode_override_with_lifetime(OperationMode::Suspended, "client", 10);
+  tick(false, 8);
+
+  BOOST_CHECK_EQUAL(core->get_operation_mode(), OperationMode::Suspended);
+  BOOST_CHECK(core->is_operation_mode_an_override());
+
+  expect(18, "operationmode", "mode=0");
+  tick(false, 4);
+
+  BOOST_CHECK_EQUAL(core->get_operation_mode(), OperationMode::Normal);
+  BOOST_CHECK(!core->is_operation_mode_an_override());
+
+  verify();
+}
+
 BOOST_AUTO_TEST_CASE(test_usage_mode)
 {
   init();
@@ -1423,6 +1453,38 @@ BOOST_AUTO_TEST_CASE(test_overdue_time)
   verify();
 }
 
+BOOST_AUTO_TEST_CASE(test_overdue_time_daily_reset)
+{
+  init();
+
+  // Let the daily limit reset in the same second as the micro break.
+  config->set_value("timers/daily_limit/auto_reset", 20);
+  config->set_value("timers/daily_limit/reset_pred", "");
+
+  expect(300, "prelude", "break_id=micro_pause");
+  expect(300, "show");
+  expect(300, "break_event", "break_id=micro_pause event=ShowPrelude");
+  expect(300, "break_event", "break_id=micro_pause event=BreakStart");
+  expect(315, "hide");
+  expect(315, "break", "break_id=micro_pause break_hint=normal");
+  expect(315, "show");
+  expect(315, "break_event", "break_id=micro_pause event=ShowBreak");
+  expect(335, "hide");
+  expect(335, "break_event", "break_id=micro_pause event=BreakTaken");
+  expect(335, "break_event", "break_id=micro_pause event=BreakIdle");
+  expect(335, "break_event", "break_id=micro_pause event=BreakStop");
+  tick(true, 315);
+  tick(false, 40);
+
+  // The daily reset is handled before the micro break timer runs, so the
+  // overdue time of the micro break that ends in that second is kept.
+  IBreak::Ptr b = core->get_break(BREAK_ID_MICRO_BREAK);
+  BOOST_CHECK_EQUAL(b->get_total_overdue_time(), 14);
+  BOOST_CHECK_EQUAL(core->get_break(BREAK_ID_DAILY_LIMIT)->get_elapsed_time(), 0);
+
+  verify();
+}
+
 BOOST_AUTO_TEST_CASE(test_insist_policy_halt)
 {
   init();
@@ -0,0 +1,217 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#define BOOST_TEST_MODULE workrave_operation_mode_overrides
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <map>
+#include <random>
+#include <string>
+
+#include "OperationModeOverrides.hh"
+
+using namespace workrave;
+
+namespace
+{
+  //! The linear scan that CoreModes used before the registry.
+  struct Reference
+  {
+    struct Entry
+    {
+      OperationMode mode;
+      uint64_t sequence;
+      int64_t expires_at;
+    };
+
+    void set(const std::string &id, OperationMode mode, int64_t expires_at)
+    {
+      auto i = entries.find(id);
+      if (i == entries.end() || i->second.mode != mode)
+        {
+          entries[id] = Entry{mode, sequence++, expires_at};
+        }
+      else
+        {
+          i->second.expires_at = expires_at;
+        }
+    }
+
+    void expire(int64_t now)
+    {
+      for (auto i = entries.begin(); i != entries.end();)
+        {
+          if (i->second.expires_at != 0 && i->second.expires_at <= now)
+            {
+              i = entries.erase(i);
+            }
+          else
+            {
+              ++i;
+            }
+        }
+    }
+
+    OperationMode get_mode() const
+    {
+      OperationMode mode = OperationMode::Normal;
+      for (const auto &i: entries)
+        {
+          if (i.second.mode == OperationMode::Suspended)
+            {
+              return OperationMode::Suspended;
+            }
+          if (i.second.mode == OperationMode::Quiet)
+            {
+              mode = OperationMode::Quiet;
+            }
+        }
+      return mode;
+    }
+
+    std::map<std::string, Entry> entries;
+    uint64_t sequence{0};
+  };
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(operation_mode_overrides)
+
+BOOST_AUTO_TEST_CASE(test_importance)
+{
+  OperationModeOverrides overrides;
+  BOOST_CHECK(overrides.empty());
+
+  overrides.set("a", OperationMode::Normal);
+  BOOST_CHECK_EQUAL(overrides.get_mode(), OperationMode::Normal);
+
+  overrides.set("b", OperationMode::Quiet);
+  BOOST_CHECK_EQUAL(overrides.get_mode(), OperationMode::Quiet);
+
+  overrides.set("c", OperationMode::Suspended);
+  BOOST_CHECK_EQUAL(overrides.get_mode(), OperationMode::Suspended);
+
+  overrides.set("c", OperationMode::Normal);
+  BOOST_CHECK_EQUAL(overrides.get_mode(), OperationMode::Quiet);
+  BOOST_CHECK_EQUAL(overrides.size(), 3U);
+
+  BOOST_CHECK(overrides.remove("b"));
+  BOOST_CHECK(!overrides.remove("b"));
+  BOOST_CHECK_EQUAL(overrides.get_mode(), OperationMode::Normal);
+  BOOST_CHECK(overrides.contains("a"));
+  BOOST_CHECK(!overrides.contains("b"));
+}
+
+BOOST_AUTO_TEST_CASE(test_expiry)
+{
+  OperationModeOverrides overrides;
+  overrides.set("dbus", OperationMode::Suspended, 100);
+  overrides.set("powersave", OperationMode::Quiet);
+  BOOST_CHECK_EQUAL(overrides.get_next_expiry(), 100);
+
+  BOOST_CHECK(!overrides.expire(99));
+  BOOST_CHECK_EQUAL(overrides.get_mode(), OperationMode::Suspended);
+
+  // Setting the override again renews it.
+  overrides.set("dbus", OperationMode::Suspended, 200);
+  BOOST_CHECK(!overrides.expire(150));
+  BOOST_CHECK_EQUAL(overrides.get_next_expiry(), 200);
+
+  BOOST_CHECK(overrides.expire(200));
+  BOOST_CHECK_EQUAL(overrides.get_mode(), OperationMode::Quiet);
+  BOOST_CHECK_EQUAL(overrides.get_next_expiry(), 0);
+
+  // Without a lifetime, an override no longer expires.
+  overrides.set("powersave", OperationMode::Quiet, 300);
+  overrides.set("powersave", OperationMode::Quiet);
+  BOOST_CHECK(!overrides.expire(1000));
+  BOOST_CHECK_EQUAL(overrides.size(), 1U);
+}
+
+BOOST_AUTO_TEST_CASE(test_stress)
+{
+  const int num_ids = 2000;
+  const int num_events = 200000;
+
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> id_dist(0, num_ids - 1);
+  std::uniform_int_distribution<int> op_dist(0, 9);
+  std::uniform_int_distribution<int> mode_dist(0, 2);
+  std::uniform_int_distribution<int> lifetime_dist(0, 50);
+
+  OperationModeOverrides overrides;
+  Reference reference;
+  std::chrono::steady_clock::duration registry_time{};
+  std::chrono::steady_clock::duration reference_time{};
+  int changes = 0;
+  OperationMode last = OperationMode::Normal;
+
+  for (int now = 1; now <= num_events; now++)
+    {
+      std::string id = "client" + std::to_string(id_dist(random));
+      int op = op_dist(random);
+      auto mode = static_cast<OperationMode>(mode_dist(random));
+      int lifetime = lifetime_dist(random);
+      int64_t expires_at = lifetime == 0 ? 0 : now + lifetime * 100;
+
+      auto start = std::chrono::steady_clock::now();
+      if (op < 5)
+        {
+          overrides.set(id, mode, expires_at);
+        }
+      else if (op < 9)
+        {
+          overrides.remove(id);
+        }
+      overrides.expire(now);
+      OperationMode mode_registry = overrides.empty() ? OperationMode::Normal : overrides.get_mode();
+      registry_time += std::chrono::steady_clock::now() - start;
+
+      start = std::chrono::steady_clock::now();
+      if (op < 5)
+        {
+          reference.set(id, mode, expires_at);
+        }
+      else if (op < 9)
+        {
+          reference.entries.erase(id);
+        }
+      reference.expire(now);
+      OperationMode mode_reference = reference.get_mode();
+      reference_time += std::chrono::steady_clock::now() - start;
+
+      BOOST_REQUIRE_EQUAL(mode_registry, mode_reference);
+      BOOST_REQUIRE_EQUAL(overrides.size(), reference.entries.size());
+
+      if (mode_registry != last)
+        {
+          changes++;
+          last = mode_registry;
+        }
+    }
+
+  using namespace std::chrono;
+  BOOST_TEST_MESSAGE(num_events << " events, " << overrides.size() << " overrides left, " << changes << " mode changes");
+  BOOST_TEST_MESSAGE("registry " << duration_cast<milliseconds>(registry_time).count() << " ms, linear scan "
+                                 << duration_cast<milliseconds>(reference_time).count() << " ms");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,171 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "config/Config.hh"
+#include "core/CoreConfig.hh"
+#include "dbus/DBusFactory.hh"
+
+#include "SessionServer.hh"
+#include "SimulatedTime.hh"
+
+using namespace std;
+using namespace workrave;
+using namespace workrave::config;
+using namespace workrave::utils;
+
+namespace
+{
+  //! Returns the resident set size in bytes, or 0 if the platform has no /proc.
+  int64_t get_resident_size()
+  {
+    ifstream statm("/proc/self/statm");
+    int64_t size = 0;
+    int64_t resident = 0;
+    if (statm >> size >> resident)
+      {
+        return resident * 4096;
+      }
+    return 0;
+  }
+
+  struct Result
+  {
+    double rss_per_session{0};
+    double wall_usec_per_tick{0};
+    double cpu_usec_per_tick{0};
+  };
+
+  //! Runs num_sessions sessions, a tenth of which are active at any time.
+  Result run(dbus::IDBus::Ptr dbus,
+             const filesystem::path &dir,
+             int num_sessions,
+             int num_threads,
+             int num_ticks,
+             const SimulatedTime::Ptr &sim)
+  {
+    Result result;
+
+    sim->reset();
+    TimeSource::sync();
+
+    int64_t rss_before = get_resident_size();
+
+    SessionServer server(dbus, dir, num_threads);
+    server.init();
+    vector<string> ids;
+    for (int i = 0; i < num_sessions; i++)
+      {
+        ids.push_back("user" + to_string(i));
+        server.add_session(ids.back());
+      }
+
+    result.rss_per_session = static_cast<double>(get_resident_size() - rss_before) / num_sessions;
+
+    mt19937 random(42);
+    vector<bool> active(num_sessions);
+    for (int i = 0; i < num_sessions; i++)
+      {
+        active[i] = random() % 10 == 0;
+      }
+
+    chrono::nanoseconds wall{0};
+    clock_t cpu = 0;
+    for (int tick = 0; tick < num_ticks; tick++)
+      {
+        for (int i = 0; i < num_sessions; i++)
+          {
+            if (random() % 100 == 0)
+              {
+                active[i] = !active[i];
+              }
+            if (active[i])
+              {
+                server.report_activity(ids[i], "x11", true);
+              }
+          }
+
+        sim->current_time += TimeSource::TIME_USEC_PER_SEC;
+
+        auto start = chrono::steady_clock::now();
+        clock_t cpu_start = clock();
+        server.heartbeat();
+        cpu += clock() - cpu_start;
+        wall += chrono::steady_clock::now() - start;
+      }
+
+    result.wall_usec_per_tick = static_cast<double>(chrono::duration_cast<chrono::microseconds>(wall).count()) / num_ticks;
+    result.cpu_usec_per_tick = static_cast<double>(cpu) * 1000000.0 / CLOCKS_PER_SEC / num_ticks;
+    return result;
+  }
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+  int num_sessions = argc > 1 ? atoi(argv[1]) : 1000;
+  int num_ticks = argc > 2 ? atoi(argv[2]) : 600;
+
+  auto sim = SimulatedTime::create();
+
+  IConfigurator::Ptr config = ConfiguratorFactory::create(ConfigFileFormat::Ini);
+  config->set_value("timers/daily_limit/reset_pred", "day/4:00");
+  CoreConfig::init(config);
+
+  dbus::IDBus::Ptr dbus = dbus::DBusFactory::create();
+  dbus->init();
+
+  filesystem::path dir = filesystem::temp_directory_path()
+                         / ("workrave-session-server-benchmark-" + to_string(chrono::steady_clock::now().time_since_epoch().count()));
+
+  cout << num_sessions << " sessions, " << num_ticks << " ticks" << endl;
+
+  // Later runs reuse the memory freed by the first one.
+  bool first = true;
+  for (int num_threads: {1, max(4, static_cast<int>(thread::hardware_concurrency()))})
+    {
+      Result result = run(dbus, dir / to_string(num_threads), num_sessions, num_threads, num_ticks, sim);
+      if (first)
+        {
+          cout << "memory: " << result.rss_per_session / 1024 << " KiB/session" << endl;
+          first = false;
+        }
+
+      cout << num_threads << " threads: " << result.wall_usec_per_tick << " usec/tick, " << result.cpu_usec_per_tick / num_sessions
+           << " cpu usec/session/tick" << endl;
+    }
+
+  error_code ec;
+  filesystem::remove_all(dir, ec);
+  return 0;
+}
@@ -0,0 +1,331 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#define BOOST_TEST_MODULE workrave_session_server
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "config/Config.hh"
+#include "config/SettingCache.hh"
+#include "core/CoreConfig.hh"
+#include "dbus/DBusFactory.hh"
+#include "utils/TimeSource.hh"
+
+#include "SessionServer.hh"
+#include "SimulatedTime.hh"
+
+#ifdef PLATFORM_OS_UNIX
+#  include <cstring>
+#  include <pwd.h>
+#  include <sys/socket.h>
+#  include <sys/un.h>
+#  include <unistd.h>
+
+#  include "SessionSocket.hh"
+#endif
+
+using namespace std;
+using namespace workrave;
+using namespace workrave::config;
+using namespace workrave::utils;
+
+class Fixture
+{
+public:
+  Fixture()
+  {
+    sim = SimulatedTime::create();
+    sim->reset();
+    TimeSource::sync();
+
+    SettingCache::reset();
+    config = ConfiguratorFactory::create(ConfigFileFormat::Ini);
+    config->set_value("timers/micro_pause/limit", 300);
+    config->set_value("timers/micro_pause/auto_reset", 20);
+    config->set_value("timers/micro_pause/snooze", 150);
+    config->set_value("timers/rest_break/limit", 1500);
+    config->set_value("timers/rest_break/auto_reset", 300);
+    config->set_value("timers/rest_break/snooze", 180);
+    config->set_value("timers/daily_limit/limit", 14400);
+    config->set_value("timers/daily_limit/auto_reset", 0);
+    config->set_value("timers/daily_limit/reset_pred", "day/4:00");
+    config->set_value("timers/daily_limit/snooze", 1200);
+    CoreConfig::init(config);
+
+    dbus = dbus::DBusFactory::create();
+    dbus->init();
+
+    dir = filesystem::temp_directory_path()
+          / ("workrave-session-server-" + to_string(chrono::steady_clock::now().time_since_epoch().count()));
+  }
+
+  ~Fixture()
+  {
+    error_code ec;
+    filesystem::remove_all(dir, ec);
+  }
+
+  void tick(const vector<SessionServer *> &servers)
+  {
+    sim->current_time += 1000000;
+    for (SessionServer *server: servers)
+      {
+        server->heartbeat();
+      }
+  }
+
+  SimulatedTime::Ptr sim;
+  IConfigurator::Ptr config;
+  dbus::IDBus::Ptr dbus;
+  filesystem::path dir;
+};
+
+#ifdef PLATFORM_OS_UNIX
+namespace
+{
+  int connect_socket(const filesystem::path &path)
+  {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un addr
+    {
+    };
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    BOOST_REQUIRE_EQUAL(connect(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)), 0);
+    return fd;
+  }
+
+  //! Sends a command and returns the reply, or an empty string if the server closed the connection.
+  string send_command(int fd, SessionSocket &socket, const string &command)
+  {
+    BOOST_REQUIRE_EQUAL(send(fd, command.data(), command.size(), 0), static_cast<ssize_t>(command.size()));
+
+    string reply;
+    while (reply.empty() || reply.back() != '\n')
+      {
+        socket.process();
+
+        char buffer[256];
+        ssize_t size = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (size == 0)
+          {
+            break;
+          }
+        if (size > 0)
+          {
+            reply.append(buffer, static_cast<size_t>(size));
+          }
+      }
+    if (!reply.empty())
+      {
+        reply.pop_back();
+      }
+    return reply;
+  }
+} // namespace
+#endif
+
+BOOST_FIXTURE_TEST_SUITE(session_server, Fixture)
+
+BOOST_AUTO_TEST_CASE(test_add_remove)
+{
+  SessionServer server(dbus, dir, 2);
+  server.init();
+
+  server.add_session("alice");
+  server.add_session("bob");
+  server.add_session("alice");
+  BOOST_CHECK_EQUAL(server.get_session_count(), 2);
+
+  server.remove_session("alice");
+  BOOST_CHECK_EQUAL(server.get_session_count(), 1);
+  BOOST_CHECK(!server.get_session("alice"));
+  BOOST_CHECK_EQUAL(server.get_session("bob")->get_id(), "bob");
+
+  // Reports for unknown sessions are dropped.
+  server.report_activity("alice", "x11", true);
+  tick({&server});
+
+  BOOST_CHECK(filesystem::exists(dir / "bob"));
+  BOOST_CHECK(!filesystem::exists(dir / "carol_2fx"));
+  server.add_session("carol/x");
+  BOOST_CHECK(filesystem::exists(dir / "carol_2fx"));
+}
+
+BOOST_AUTO_TEST_CASE(test_activity_timeout)
+{
+  SessionServer server(dbus, dir, 1);
+  server.init();
+  Session::Ptr session = server.add_session("alice");
+
+  server.report_activity("alice", "x11", true);
+  server.report_activity("alice", "wayland", true);
+  tick({&server});
+  BOOST_CHECK(session->is_user_active());
+
+  server.report_activity("alice", "wayland", false);
+  tick({&server});
+  BOOST_CHECK(session->is_user_active());
+
+  for (int i = 0; i < ExternalActivityMonitor::ACTIVITY_TIMEOUT; i++)
+    {
+      tick({&server});
+    }
+  BOOST_CHECK(!session->is_user_active());
+}
+
+BOOST_AUTO_TEST_CASE(test_sessions_are_independent)
+{
+  SessionServer server(dbus, dir, 4);
+  server.init();
+
+  for (int i = 0; i < 8; i++)
+    {
+      server.add_session("user" + to_string(i));
+    }
+
+  for (int t = 0; t < 120; t++)
+    {
+      for (int i = 0; i < 8; i += 2)
+        {
+          server.report_activity("user" + to_string(i), "x11", true);
+        }
+      tick({&server});
+    }
+
+  for (int i = 0; i < 8; i++)
+    {
+      IBreak::Ptr b = server.get_session("user" + to_string(i))->get_break(BREAK_ID_MICRO_BREAK);
+      if (i % 2 == 0)
+        {
+          BOOST_CHECK_GE(b->get_elapsed_time(), 119);
+        }
+      else
+        {
+          BOOST_CHECK_EQUAL(b->get_elapsed_time(), 0);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_threads_match_sequential)
+{
+  const int num_sessions = 24;
+
+  SessionServer sequential(dbus, dir / "sequential", 1);
+  SessionServer parallel(dbus, dir / "parallel", 4);
+  sequential.init();
+  parallel.init();
+
+  for (int i = 0; i < num_sessions; i++)
+    {
+      sequential.add_session("user" + to_string(i));
+      parallel.add_session("user" + to_string(i));
+    }
+
+  mt19937 random(42);
+  uniform_int_distribution<int> dist(0, 99);
+  vector<bool> active(num_sessions, false);
+
+  for (int t = 0; t < 4000; t++)
+    {
+      for (int i = 0; i < num_sessions; i++)
+        {
+          if (dist(random) < 2)
+            {
+              active[i] = !active[i];
+            }
+          if (active[i])
+            {
+              sequential.report_activity("user" + to_string(i), "x11", true);
+              parallel.report_activity("user" + to_string(i), "x11", true);
+            }
+        }
+      tick({&sequential, &parallel});
+    }
+
+  for (int i = 0; i < num_sessions; i++)
+    {
+      Session::Ptr a = sequential.get_session("user" + to_string(i));
+      Session::Ptr b = parallel.get_session("user" + to_string(i));
+      for (int id = 0; id < BREAK_ID_SIZEOF; id++)
+        {
+          BOOST_CHECK_EQUAL(a->get_break(BreakId(id))->get_elapsed_time(), b->get_break(BreakId(id))->get_elapsed_time());
+          BOOST_CHECK_EQUAL(a->get_break(BreakId(id))->is_taking(), b->get_break(BreakId(id))->is_taking());
+        }
+      BOOST_CHECK_EQUAL(a->get_statistics()->get_current_day()->misc_stats[IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME],
+                        b->get_statistics()->get_current_day()->misc_stats[IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME]);
+    }
+}
+
+#ifdef PLATFORM_OS_UNIX
+BOOST_AUTO_TEST_CASE(test_socket)
+{
+  auto server = make_shared<SessionServer>(dbus, dir / "state", 1);
+  server->init();
+
+  SessionSocket socket(server, dir / "server.sock");
+  BOOST_REQUIRE(socket.init());
+
+  int fd = connect_socket(dir / "server.sock");
+
+  BOOST_CHECK_EQUAL(send_command(fd, socket, "add alice\n"), "ok");
+  BOOST_CHECK_EQUAL(server->get_session_count(), 1);
+
+  BOOST_CHECK_EQUAL(send_command(fd, socket, "activity alice x11 1\r\n"), "ok");
+  tick({server.get()});
+  BOOST_CHECK(server->get_session("alice")->is_user_active());
+
+  BOOST_CHECK_EQUAL(send_command(fd, socket, "activity bob x11 1\n"), "error unknown session");
+  BOOST_CHECK_EQUAL(send_command(fd, socket, "activity alice x11 2\n"), "error invalid command");
+  BOOST_CHECK_EQUAL(send_command(fd, socket, "add alice bob\n"), "error invalid command");
+  BOOST_CHECK_EQUAL(send_command(fd, socket, "frobnicate alice\n"), "error invalid command");
+  BOOST_CHECK_EQUAL(send_command(fd, socket, "add\n"), "error missing session");
+
+  BOOST_CHECK_EQUAL(send_command(fd, socket, "remove alice\n"), "ok");
+  BOOST_CHECK_EQUAL(server->get_session_count(), 0);
+
+  // A client that sends a line that is too long is disconnected.
+  BOOST_CHECK_EQUAL(send_command(fd, socket, string(SessionSocket::MAX_LINE + 1, 'x')), "");
+  close(fd);
+}
+
+BOOST_AUTO_TEST_CASE(test_socket_permissions)
+{
+  BOOST_CHECK(SessionSocket::is_allowed(0, "alice"));
+  BOOST_CHECK(SessionSocket::is_allowed(geteuid(), "alice"));
+
+  // Other users may only use the session named after them.
+  struct passwd *pw = getpwnam("nobody");
+  if (pw != nullptr && pw->pw_uid != 0 && pw->pw_uid != geteuid())
+    {
+      BOOST_CHECK(SessionSocket::is_allowed(pw->pw_uid, "nobody"));
+      BOOST_CHECK(!SessionSocket::is_allowed(pw->pw_uid, "alice"));
+    }
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,328 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#define BOOST_TEST_MODULE workrave_statistics
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/IStatistics.hh"
+#include "utils/Calendar.hh"
+#include "utils/RecordArena.hh"
+
+#include "ExternalActivityMonitor.hh"
+#include "Statistics.hh"
+
+using namespace std;
+using namespace workrave;
+using namespace workrave::utils;
+
+using DailyStatsView = IStatistics::DailyStatsView;
+
+class Fixture
+{
+public:
+  Fixture()
+  {
+    dir = filesystem::temp_directory_path() / ("workrave-statistics-" + to_string(chrono::steady_clock::now().time_since_epoch().count()));
+    filesystem::create_directories(dir);
+  }
+
+  ~Fixture()
+  {
+    error_code ec;
+    filesystem::remove_all(dir, ec);
+  }
+
+  //! Generates the statistics of consecutive days starting 1 March 2019.
+  static vector<IStatistics::DailyStats> generate(int num_days, uint32_t seed)
+  {
+    mt19937 random(seed);
+    vector<IStatistics::DailyStats> days(num_days);
+
+    for (int i = 0; i < num_days; i++)
+      {
+        IStatistics::DailyStats &stats = days[i];
+
+        std::tm tm{};
+        tm.tm_year = 119;
+        tm.tm_mon = 2;
+        tm.tm_mday = 1 + i;
+        tm.tm_hour = 12;
+        tm.tm_isdst = -1;
+        std::time_t t = mktime(&tm);
+        localtime_r(&t, &stats.start);
+        stats.start.tm_hour = static_cast<int>(6 + random() % 4);
+        stats.start.tm_min = static_cast<int>(random() % 60);
+
+        // Some days end after midnight.
+        t += (random() % 8 == 0) ? 24 * 60 * 60 : 0;
+        localtime_r(&t, &stats.stop);
+        stats.stop.tm_hour = static_cast<int>(random() % 24);
+        stats.stop.tm_min = static_cast<int>(random() % 60);
+
+        // The user does not work every day.
+        bool idle = random() % 5 == 0;
+        for (auto &break_stats: stats.break_stats)
+          {
+            for (int &value: break_stats)
+              {
+                value = idle ? 0 : static_cast<int>(random() % 40);
+              }
+          }
+        stats.break_stats[BREAK_ID_DAILY_LIMIT][IStatistics::STATS_BREAKVALUE_TOTAL_OVERDUE] = idle ? 0 : static_cast<int>(random() % 3600);
+
+        stats.misc_stats[IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME] = idle ? 0 : static_cast<int64_t>(random() % 30000);
+        stats.misc_stats[IStatistics::STATS_VALUE_TOTAL_MOUSE_MOVEMENT] = idle ? 0 : static_cast<int64_t>(random() % 2000000);
+        stats.misc_stats[IStatistics::STATS_VALUE_TOTAL_CLICK_MOVEMENT] = idle ? 0 : static_cast<int64_t>(random() % 500000);
+        stats.misc_stats[IStatistics::STATS_VALUE_TOTAL_MOVEMENT_TIME] = idle ? 0 : static_cast<int64_t>(random() % 20000);
+        stats.misc_stats[IStatistics::STATS_VALUE_TOTAL_CLICKS] = idle ? 0 : static_cast<int64_t>(random() % 5000);
+        stats.misc_stats[IStatistics::STATS_VALUE_TOTAL_KEYSTROKES] = idle ? 0 : static_cast<int64_t>(random() % 40000);
+      }
+    return days;
+  }
+
+  void write_history(const vector<IStatistics::DailyStats> &days)
+  {
+    ofstream out(dir / "historystats");
+    out << "WorkRaveStats 4" << endl;
+    for (const auto &stats: days)
+      {
+        out << "D " << stats.start.tm_mday << " " << stats.start.tm_mon << " " << stats.start.tm_year << " " << stats.start.tm_hour << " "
+            << stats.start.tm_min << " " << stats.stop.tm_mday << " " << stats.stop.tm_mon << " " << stats.stop.tm_year << " "
+            << stats.stop.tm_hour << " " << stats.stop.tm_min << endl;
+
+        for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+          {
+            out << "B " << i << " " << IStatistics::STATS_BREAKVALUE_SIZEOF << " ";
+            for (int value: stats.break_stats[i])
+              {
+                out << value << " ";
+              }
+            out << endl;
+          }
+
+        out << "m " << IStatistics::STATS_VALUE_SIZEOF << " ";
+        for (int64_t value: stats.misc_stats)
+          {
+            out << value << " ";
+          }
+        out << endl;
+      }
+  }
+
+  static void check_equal(const DailyStatsView &view, const IStatistics::DailyStats &stats)
+  {
+    BOOST_REQUIRE(view);
+    BOOST_CHECK(!view.is_empty());
+
+    struct tm start = view.get_start();
+    struct tm stop = view.get_stop();
+    BOOST_CHECK_EQUAL(start.tm_year, stats.start.tm_year);
+    BOOST_CHECK_EQUAL(start.tm_mon, stats.start.tm_mon);
+    BOOST_CHECK_EQUAL(start.tm_mday, stats.start.tm_mday);
+    BOOST_CHECK_EQUAL(start.tm_wday, stats.start.tm_wday);
+    BOOST_CHECK_EQUAL(start.tm_yday, stats.start.tm_yday);
+    BOOST_CHECK_EQUAL(start.tm_hour, stats.start.tm_hour);
+    BOOST_CHECK_EQUAL(start.tm_min, stats.start.tm_min);
+    BOOST_CHECK_EQUAL(stop.tm_year, stats.stop.tm_year);
+    BOOST_CHECK_EQUAL(stop.tm_mon, stats.stop.tm_mon);
+    BOOST_CHECK_EQUAL(stop.tm_mday, stats.stop.tm_mday);
+    BOOST_CHECK_EQUAL(stop.tm_hour, stats.stop.tm_hour);
+    BOOST_CHECK_EQUAL(stop.tm_min, stats.stop.tm_min);
+
+    for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+      {
+        for (int j = 0; j < IStatistics::STATS_BREAKVALUE_SIZEOF; j++)
+          {
+            BOOST_CHECK_EQUAL(view.get_break_stat(BreakId(i), IStatistics::StatsBreakValueType(j)), stats.break_stats[i][j]);
+          }
+      }
+    for (int j = 0; j < IStatistics::STATS_VALUE_SIZEOF; j++)
+      {
+        BOOST_CHECK_EQUAL(view.get_misc_stat(IStatistics::StatsValueType(j)), stats.misc_stats[j]);
+      }
+  }
+
+  filesystem::path dir;
+};
+
+BOOST_FIXTURE_TEST_SUITE(statistics, Fixture)
+
+BOOST_AUTO_TEST_CASE(test_days_from_date)
+{
+  BOOST_CHECK_EQUAL(DailyStatsView::days_from_date(1970, 1, 1), 0);
+  BOOST_CHECK_EQUAL(DailyStatsView::days_from_date(2000, 3, 1), 11017);
+  BOOST_CHECK_EQUAL(DailyStatsView::days_from_date(1969, 12, 31), -1);
+}
+
+BOOST_AUTO_TEST_CASE(test_history)
+{
+  vector<IStatistics::DailyStats> days = generate(400, 1);
+
+  // A day that occurs twice is replaced by its last occurrence.
+  vector<IStatistics::DailyStats> file = days;
+  file.insert(file.begin() + 10, days[20]);
+  file[10].misc_stats[IStatistics::STATS_VALUE_TOTAL_CLICKS] = 1;
+  write_history(file);
+
+  auto statistics = std::make_shared<Statistics>(std::make_shared<ExternalActivityMonitor>(), dir, false);
+  statistics->init();
+
+  BOOST_REQUIRE_EQUAL(statistics->get_history_size(), 400);
+  for (int i = 0; i < 400; i++)
+    {
+      check_equal(statistics->get_day(-(i + 1)), days[i]);
+      check_equal(statistics->get_day(400 - i), days[i]);
+    }
+  BOOST_CHECK(!statistics->get_day(401));
+  BOOST_CHECK(statistics->get_day(0));
+
+  int idx = 0;
+  int next = 0;
+  int prev = 0;
+  statistics->get_day_index_by_date(2019, 3, 11, idx, next, prev);
+  BOOST_CHECK_EQUAL(idx, 390);
+  BOOST_CHECK_EQUAL(next, 389);
+  BOOST_CHECK_EQUAL(prev, 391);
+}
+
+BOOST_AUTO_TEST_CASE(test_history_memory)
+{
+  const int num_days = 1000;
+  vector<IStatistics::DailyStats> days = generate(num_days, 2);
+
+  RecordArena arena(DailyStatsView::FIELD_SIZEOF);
+  for (const auto &stats: days)
+    {
+      int64_t fields[DailyStatsView::FIELD_SIZEOF];
+      int32_t day = DailyStatsView::encode(stats, fields);
+      arena.put(day, fields);
+    }
+  arena.shrink_to_fit();
+
+  for (int i = 0; i < num_days; i++)
+    {
+      check_equal(DailyStatsView(&arena, i), days[i]);
+    }
+
+  // One heap allocation per day, without allocator overhead.
+  std::size_t legacy = num_days * (sizeof(IStatistics::DailyStats) + sizeof(std::chrono::system_clock::time_point) + sizeof(void *));
+  std::size_t used = arena.get_memory_usage();
+
+  BOOST_TEST_MESSAGE("1000 days: " << used << " bytes in the arena, " << legacy << " bytes as separate days");
+  BOOST_CHECK_LT(used * 4, legacy);
+}
+
+BOOST_AUTO_TEST_CASE(test_field_names)
+{
+  for (int field = 0; field < DailyStatsView::FIELD_SIZEOF; field++)
+    {
+      BOOST_CHECK_EQUAL(DailyStatsView::find_field(DailyStatsView::get_field_name(field)), field);
+    }
+  BOOST_CHECK_EQUAL(DailyStatsView::find_field("start"), DailyStatsView::FIELD_START);
+  BOOST_CHECK_EQUAL(DailyStatsView::find_field("total_keystrokes"),
+                    DailyStatsView::FIELD_MISC_STATS + IStatistics::STATS_VALUE_TOTAL_KEYSTROKES);
+  BOOST_CHECK_EQUAL(DailyStatsView::find_field("restbreak.taken"),
+                    DailyStatsView::FIELD_BREAK_STATS + BREAK_ID_REST_BREAK * IStatistics::STATS_BREAKVALUE_SIZEOF
+                      + IStatistics::STATS_BREAKVALUE_TAKEN);
+  BOOST_CHECK_EQUAL(DailyStatsView::find_field("restbreak"), -1);
+}
+
+BOOST_AUTO_TEST_CASE(test_range)
+{
+  // The history ends well before the current day.
+  const int num_days = 2000;
+  vector<IStatistics::DailyStats> days = generate(num_days, 3);
+  write_history(days);
+
+  auto statistics = std::make_shared<Statistics>(std::make_shared<ExternalActivityMonitor>(), dir, false);
+  statistics->init();
+
+  vector<int> fields{DailyStatsView::find_field("stop"),
+                     DailyStatsView::find_field("restbreak.taken"),
+                     DailyStatsView::find_field("total_keystrokes")};
+  int32_t first = DailyStatsView::days_from_date(2019, 3, 1);
+
+  vector<int32_t> range_days;
+  vector<int64_t> values;
+  auto start = chrono::steady_clock::now();
+  int32_t next = statistics->get_range(first, first + num_days - 1, fields, 0, range_days, values);
+  auto duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+  BOOST_TEST_MESSAGE(num_days << " days, " << fields.size() << " fields: " << duration.count() << " us");
+
+  BOOST_CHECK_EQUAL(next, first + num_days);
+  BOOST_REQUIRE_EQUAL(range_days.size(), static_cast<size_t>(num_days));
+  BOOST_REQUIRE_EQUAL(values.size(), fields.size() * num_days);
+  for (int i = 0; i < num_days; i++)
+    {
+      int64_t fields_of_day[DailyStatsView::FIELD_SIZEOF];
+      BOOST_REQUIRE_EQUAL(DailyStatsView::encode(days[i], fields_of_day), range_days[i]);
+      for (size_t f = 0; f < fields.size(); f++)
+        {
+          BOOST_REQUIRE_EQUAL(values[f * num_days + i], fields_of_day[fields[f]]);
+        }
+    }
+
+  // In chunks.
+  vector<int32_t> chunk_days;
+  vector<int64_t> chunk_values;
+  int32_t from = first;
+  int num_chunks = 0;
+  while (from <= first + num_days - 1)
+    {
+      next = statistics->get_range(from, first + num_days - 1, fields, 64, chunk_days, chunk_values);
+      BOOST_REQUIRE_LE(chunk_days.size(), 64U);
+      BOOST_REQUIRE_GT(next, from);
+      for (size_t i = 0; i < chunk_days.size(); i++)
+        {
+          BOOST_REQUIRE_EQUAL(chunk_days[i], range_days[chunk_days[i] - first]);
+          for (size_t f = 0; f < fields.size(); f++)
+            {
+              BOOST_REQUIRE_EQUAL(chunk_values[f * chunk_days.size() + i], values[f * num_days + chunk_days[i] - first]);
+            }
+        }
+      from = next;
+      num_chunks++;
+    }
+  BOOST_CHECK_EQUAL(num_chunks, (num_days + 63) / 64);
+
+  // The current day comes last.
+  next = statistics->get_range(first + num_days - 2, std::numeric_limits<int32_t>::max(), fields, 0, range_days, values);
+  BOOST_REQUIRE_EQUAL(range_days.size(), 3U);
+  BOOST_CHECK_EQUAL(range_days[2], Calendar::days_from_tm(statistics->get_current_day()->start));
+  BOOST_CHECK_EQUAL(next, std::numeric_limits<int32_t>::max());
+
+  // Empty range.
+  next = statistics->get_range(first - 10, first - 1, fields, 0, range_days, values);
+  BOOST_CHECK(range_days.empty());
+  BOOST_CHECK(values.empty());
+  BOOST_CHECK_EQUAL(next, first);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,138 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "SimulatedTime.hh"
+
+#include "TimerBank.hh"
+
+using namespace std;
+using namespace workrave::utils;
+
+namespace
+{
+  //! Creates a bank of timers with break-like settings.
+  TimerBank::Ptr create_bank(std::size_t num_timers)
+  {
+    std::mt19937 random(42);
+    auto bank = std::make_shared<TimerBank>();
+    bank->reserve(num_timers);
+
+    for (std::size_t i = 0; i < num_timers; i++)
+      {
+        std::size_t slot = bank->add();
+        bank->set_limit(slot, 180 + static_cast<int>(random() % 3000));
+        bank->set_auto_reset(slot, 30 + static_cast<int>(random() % 600));
+        bank->set_snooze(slot, 60 + static_cast<int>(random() % 120));
+        bank->enable(slot);
+      }
+    return bank;
+  }
+
+  //! Changes the activity of about one in fifty timers.
+  void update_activity(TimerBank &bank, std::vector<uint8_t> &active, std::mt19937 &random)
+  {
+    for (std::size_t i = 0; i < active.size(); i++)
+      {
+        if (random() % 50 == 0)
+          {
+            active[i] = !active[i];
+          }
+        bank.set_user_active(i, active[i] != 0);
+      }
+  }
+
+  struct Result
+  {
+    double usec_per_tick{0};
+    int64_t events{0};
+  };
+
+  //! Runs the simulation, either with one batch process() per tick or with process(slot) for every timer.
+  Result run(std::size_t num_timers, int num_ticks, bool batch, const SimulatedTime::Ptr &sim)
+  {
+    sim->reset();
+    TimeSource::sync();
+
+    TimerBank::Ptr bank = create_bank(num_timers);
+    std::vector<uint8_t> active(num_timers, 1);
+    std::mt19937 random(1234);
+
+    Result result;
+    chrono::nanoseconds spent{0};
+    for (int tick = 0; tick < num_ticks; tick++)
+      {
+        update_activity(*bank, active, random);
+        TimeSource::sync();
+
+        auto start = chrono::steady_clock::now();
+        if (batch)
+          {
+            result.events += static_cast<int64_t>(bank->process().size());
+          }
+        else
+          {
+            for (std::size_t i = 0; i < num_timers; i++)
+              {
+                if (bank->process(i, active[i] != 0) != TIMER_EVENT_NONE)
+                  {
+                    result.events++;
+                  }
+              }
+          }
+        spent += chrono::steady_clock::now() - start;
+
+        sim->current_time += TimeSource::TIME_USEC_PER_SEC;
+      }
+
+    result.usec_per_tick = static_cast<double>(chrono::duration_cast<chrono::microseconds>(spent).count()) / num_ticks;
+    return result;
+  }
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+  std::size_t num_timers = argc > 1 ? static_cast<std::size_t>(atol(argv[1])) : 1000000;
+  int num_ticks = argc > 2 ? atoi(argv[2]) : 600;
+
+  auto sim = SimulatedTime::create();
+
+  Result single = run(num_timers, num_ticks, false, sim);
+  Result batch = run(num_timers, num_ticks, true, sim);
+
+  cout << num_timers << " timers, " << num_ticks << " ticks" << endl;
+  cout << "per timer: " << single.usec_per_tick << " usec/tick, " << single.events << " events" << endl;
+  cout << "batch:     " << batch.usec_per_tick << " usec/tick, " << batch.events << " events" << endl;
+
+  if (single.events != batch.events)
+    {
+      cout << "event count mismatch" << endl;
+      return 1;
+    }
+  return 0;
+}
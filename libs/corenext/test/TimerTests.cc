@@ -25,10 +25,14 @@
 #include <boost/signals2.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <random>
+#include <vector>
+
 #include "utils/ITimeSource.hh"
 #include "utils/TimeSource.hh"
 
 #include "Timer.hh"
+#include "TimerBank.hh"
 #include "TimePred.hh"
 #include "SimulatedTime.hh"
 
@@ -2123,4 +2127,108 @@ BOOST_AUTO_TEST_CASE(test_timer_serialize)
   BOOST_REQUIRE_EQUAL(s1, s2);
 }
 
+BOOST_AUTO_TEST_CASE(test_timer_bank_process)
+{
+  init();
+
+  // Timers in a bank must behave exactly like timers processed one by one.
+  const int num_timers = 64;
+  std::mt19937 random(1234);
+
+  auto bank = std::make_shared<TimerBank>();
+  std::vector<Timer::Ptr> batch;
+  std::vector<Timer::Ptr> single;
+
+  for (int i = 0; i < num_timers; i++)
+    {
+      int limit = 10 + static_cast<int>(random() % 100);
+      int auto_reset = 5 + static_cast<int>(random() % 30);
+      int snooze = 5 + static_cast<int>(random() % 50);
+      int64_t daily = (i % 4 == 0) ? TimeSource::get_real_time_sec_sync() + 50 + static_cast<int64_t>(random() % 500) : 0;
+
+      for (auto *timers: {&batch, &single})
+        {
+          Timer::Ptr t = (timers == &batch) ? std::make_shared<Timer>("batch", bank) : std::make_shared<Timer>("single");
+          t->set_limit(limit);
+          t->set_limit_enabled(i % 7 != 0);
+          t->set_auto_reset(auto_reset);
+          t->set_auto_reset_enabled(i % 5 != 0);
+          t->set_snooze(snooze);
+          if (daily != 0)
+            {
+              auto *pred = new TestTimePred();
+              pred->set(daily);
+              t->set_daily_reset(pred);
+            }
+          if (i % 9 != 0)
+            {
+              t->enable();
+            }
+          timers->push_back(t);
+        }
+    }
+
+  BOOST_REQUIRE_EQUAL(bank->size(), static_cast<std::size_t>(num_timers));
+
+  std::vector<bool> active(num_timers, false);
+  int num_events = 0;
+
+  for (int tick = 0; tick < 3000; tick++)
+    {
+      TimeSource::sync();
+
+      for (int i = 0; i < num_timers; i++)
+        {
+          if (random() % 20 == 0)
+            {
+              active[i] = !active[i];
+            }
+          bank->set_user_active(batch[i]->get_slot(), active[i]);
+
+          switch (random() % 400)
+            {
+            case 0:
+              batch[i]->snooze_timer();
+              single[i]->snooze_timer();
+              break;
+            case 1:
+              batch[i]->freeze_timer(true);
+              single[i]->freeze_timer(true);
+              break;
+            case 2:
+              batch[i]->freeze_timer(false);
+              single[i]->freeze_timer(false);
+              break;
+            case 3:
+              batch[i]->inhibit_snooze();
+              single[i]->inhibit_snooze();
+              break;
+            }
+        }
+
+      std::vector<TimerEvent> events(num_timers, TIMER_EVENT_NONE);
+      for (const TimerBank::Event &e: bank->process())
+        {
+          BOOST_REQUIRE_NE(e.event, TIMER_EVENT_NONE);
+          events[e.slot] = e.event;
+          num_events++;
+        }
+
+      for (int i = 0; i < num_timers; i++)
+        {
+          BOOST_TEST_INFO_SCOPE("Tick: " << tick << " Timer: " << i);
+          BOOST_REQUIRE_EQUAL(events[batch[i]->get_slot()], single[i]->process(active[i]));
+          BOOST_REQUIRE_EQUAL(batch[i]->get_elapsed_time(), single[i]->get_elapsed_time());
+          BOOST_REQUIRE_EQUAL(batch[i]->get_elapsed_idle_time(), single[i]->get_elapsed_idle_time());
+          BOOST_REQUIRE_EQUAL(batch[i]->get_next_limit_time(), single[i]->get_next_limit_time());
+          BOOST_REQUIRE_EQUAL(batch[i]->get_next_reset_time(), single[i]->get_next_reset_time());
+          BOOST_REQUIRE_EQUAL(batch[i]->get_total_overdue_time(), single[i]->get_total_overdue_time());
+        }
+
+      sim->current_time += 1000000;
+    }
+
+  BOOST_CHECK_GT(num_events, 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
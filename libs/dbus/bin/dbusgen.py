@@ -27,6 +27,17 @@ import jinja2
 from optparse import OptionParser
 from xml.dom.minidom import parse
 
+# GVariant size (which is also the alignment) and C type of the basic types with a fixed size.
+FIXED_TYPES = { 'y' : (1, 'guint8'),
+                'b' : (1, 'guint8'),
+                'n' : (2, 'gint16'),
+                'q' : (2, 'guint16'),
+                'i' : (4, 'gint32'),
+                'u' : (4, 'guint32'),
+                'x' : (8, 'gint64'),
+                't' : (8, 'guint64'),
+                'd' : (8, 'gdouble') }
+
 class NodeBase(object):
     def sig(self):
         return "undefined"
@@ -438,6 +449,33 @@ class StructNode(TypeNode):
 
         return '(' + struct_sig + ')'
 
+    def is_fixed(self):
+        # A struct of fixed size basic types has a fixed size GVariant layout
+        # that can be written directly into a buffer.
+        return len(self.fields) > 0 and \
+               all(self.top_node.get_type(f.type).sig() in FIXED_TYPES for f in self.fields)
+
+    def fixed_fields(self):
+        # Fields as (field, offset, C type), each aligned to its own size.
+        offset = 0
+        fields = []
+        for f in self.fields:
+            size, ctype = FIXED_TYPES[self.top_node.get_type(f.type).sig()]
+            offset = (offset + size - 1) // size * size
+            fields.append((f, offset, ctype))
+            offset = offset + size
+        return fields
+
+    def fixed_size(self):
+        # The size is padded to a multiple of the largest alignment.
+        alignment = 1
+        end = 0
+        for f, offset, ctype in self.fixed_fields():
+            size = FIXED_TYPES[self.top_node.get_type(f.type).sig()][0]
+            alignment = max(alignment, size)
+            end = offset + size
+        return (end + alignment - 1) // alignment * alignment
+
 
 class SequenceNode(TypeNode):
     def __init__(self, top_node):
@@ -457,6 +495,11 @@ class SequenceNode(TypeNode):
     def sig(self):
         return 'a' + self.top_node.get_type(self.data_type).sig()
 
+    def is_fixed(self):
+        # Basic types with the same size in C++ and GVariant can be copied as one block.
+        return self.container_type == 'std::vector' and \
+               self.top_node.get_type(self.data_type).sig() in ('y', 'n', 'q', 'i', 'u', 'x', 't', 'd')
+
 
 class DictionaryNode(TypeNode):
     def __init__(self, top_node):
@@ -152,4 +152,63 @@ operator>>(const QDBusArgument &argument, DBusTestData::Data &message)
   return argument;
 }
 
+QDBusArgument &
+operator<<(QDBusArgument &argument, const DBusTestData::MenuEntry &message)
+{
+  argument.beginStructure();
+  argument << QString::fromStdString(message.m_text);
+  argument << QString::fromStdString(message.m_action);
+  argument << message.m_command;
+  argument << message.m_type;
+  argument << message.m_flags;
+  argument.endStructure();
+  return argument;
+}
+
+const QDBusArgument &
+operator>>(const QDBusArgument &argument, DBusTestData::MenuEntry &message)
+{
+  argument.beginStructure();
+  QString s;
+  argument >> s;
+  message.m_text = s.toStdString();
+  argument >> s;
+  message.m_action = s.toStdString();
+  argument >> message.m_command;
+  argument >> message.m_type;
+  argument >> message.m_flags;
+  argument.endStructure();
+  return argument;
+}
+
+QDBusArgument &
+operator<<(QDBusArgument &argument, const DBusTestData::Progress &message)
+{
+  argument.beginStructure();
+  argument << message.m_slot;
+  argument << message.m_value;
+  argument << message.m_color;
+  argument << message.m_max;
+  argument << message.m_running;
+  argument << static_cast<qlonglong>(message.m_reference);
+  argument.endStructure();
+  return argument;
+}
+
+const QDBusArgument &
+operator>>(const QDBusArgument &argument, DBusTestData::Progress &message)
+{
+  argument.beginStructure();
+  argument >> message.m_slot;
+  argument >> message.m_value;
+  argument >> message.m_color;
+  argument >> message.m_max;
+  argument >> message.m_running;
+  qlonglong l;
+  argument >> l;
+  message.m_reference = l;
+  argument.endStructure();
+  return argument;
+}
+
 #endif
@@ -19,7 +19,10 @@
 #define DBUSTESTDATA_HH
 
 #include <string>
+#include <cstdint>
+#include <list>
 #include <set>
+#include <utility>
 
 #ifdef DBUS_BACKEND_QT
 #  include <QDBusArgument>
@@ -98,6 +101,49 @@ public:
   typedef std::map<std::string, Data> DataMap;
   typedef std::list<Data> DataList;
 
+  struct MenuEntry
+  {
+    MenuEntry() = default;
+    MenuEntry(std::string text, std::string action, uint32_t command, uint8_t type, uint8_t flags)
+      : m_text(std::move(text))
+      , m_action(std::move(action))
+      , m_command(command)
+      , m_type(type)
+      , m_flags(flags)
+    {
+    }
+
+    bool operator==(const MenuEntry &other) const
+    {
+      return m_text == other.m_text && m_action == other.m_action && m_command == other.m_command && m_type == other.m_type
+             && m_flags == other.m_flags;
+    }
+
+    std::string m_text;
+    std::string m_action;
+    uint32_t m_command{0};
+    uint8_t m_type{0};
+    uint8_t m_flags{0};
+  };
+
+  typedef std::list<MenuEntry> MenuEntryList;
+
+  struct Progress
+  {
+    bool operator==(const Progress &other) const
+    {
+      return m_slot == other.m_slot && m_value == other.m_value && m_color == other.m_color && m_max == other.m_max
+             && m_running == other.m_running && m_reference == other.m_reference;
+    }
+
+    int32_t m_slot{0};
+    int32_t m_value{0};
+    uint32_t m_color{0};
+    int32_t m_max{0};
+    bool m_running{false};
+    int64_t m_reference{0};
+  };
+
   typedef std::map<std::string, std::string> StringMap;
   typedef std::list<std::string> StringList;
 
@@ -162,6 +208,8 @@ public:
 Q_DECLARE_METATYPE(DBusTestData::StructWithAllBasicTypes)
 Q_DECLARE_METATYPE(DBusTestData::StructWithAllBasicTypesReorder)
 Q_DECLARE_METATYPE(DBusTestData::Data)
+Q_DECLARE_METATYPE(DBusTestData::MenuEntry)
+Q_DECLARE_METATYPE(DBusTestData::Progress)
 
 QDBusArgument &operator<<(QDBusArgument &argument, const DBusTestData::StructWithAllBasicTypes &message);
 const QDBusArgument &operator>>(const QDBusArgument &argument, DBusTestData::StructWithAllBasicTypes &message);
@@ -171,6 +219,12 @@ const QDBusArgument &operator>>(const QDBusArgument &argument, DBusTestData::Str
 
 QDBusArgument &operator<<(QDBusArgument &argument, const DBusTestData::Data &message);
 const QDBusArgument &operator>>(const QDBusArgument &argument, DBusTestData::Data &message);
+
+QDBusArgument &operator<<(QDBusArgument &argument, const DBusTestData::MenuEntry &message);
+const QDBusArgument &operator>>(const QDBusArgument &argument, DBusTestData::MenuEntry &message);
+
+QDBusArgument &operator<<(QDBusArgument &argument, const DBusTestData::Progress &message);
+const QDBusArgument &operator>>(const QDBusArgument &argument, DBusTestData::Progress &message);
 #endif
 
 #endif // DBUSTESTDATA_HH
@@ -192,6 +192,72 @@ DBusTestServer::test_list_of_struct(DBusTestData::DataList i_data, DBusTestData:
     }
 }
 
+std::vector<DBusTestData::MenuEntry>
+DBusTestServer::select_menu_mode(uint32_t mode)
+{
+  // Types and flags as in MenuDefs.hh
+  const uint8_t action = 2;
+  const uint8_t radio = 4;
+  const uint8_t visible = 1;
+  const uint8_t active = 2;
+
+  if (menu.empty())
+    {
+      menu.emplace_back("_Open", "workrave.open", 1, action, visible);
+      menu.emplace_back("_Preferences", "workrave.preferences", 2, action, visible);
+      menu.emplace_back("_Rest break", "workrave.restbreak", 3, action, visible);
+      menu.emplace_back("_Exercises", "workrave.exercises", 4, action, visible);
+      menu.emplace_back("S_tatistics", "workrave.statistics", 5, action, visible);
+      menu.emplace_back("", "workrave.separator1", 6, 3, visible);
+      menu.emplace_back("_Mode", "workrave.mode_menu", 7, 0, visible);
+      menu.emplace_back("", "workrave.mode", 8, 6, visible);
+      menu.emplace_back("_Normal", "workrave.mode_normal", 100, radio, visible | active);
+      menu.emplace_back("_Suspended", "workrave.mode_suspended", 101, radio, visible);
+      menu.emplace_back("Q_uiet", "workrave.mode_quiet", 102, radio, visible);
+      menu.emplace_back("", "workrave.mode", 8, 7, visible);
+      menu.emplace_back("_Mode", "workrave.mode_menu", 7, 1, visible);
+      menu.emplace_back("_Reading mode", "workrave.mode_reading", 9, 5, visible);
+      menu.emplace_back("", "workrave.separator2", 10, 3, visible);
+      menu.emplace_back("_About", "workrave.about", 11, action, visible);
+      menu.emplace_back("_Quit", "workrave.quit", 12, action, visible);
+    }
+
+  std::vector<DBusTestData::MenuEntry> changed;
+  for (auto &entry: menu)
+    {
+      if (entry.m_type == radio)
+        {
+          uint8_t flags = entry.m_command == 100 + mode ? (visible | active) : visible;
+          if (flags != entry.m_flags)
+            {
+              entry.m_flags = flags;
+              changed.push_back(entry);
+            }
+        }
+    }
+  return changed;
+}
+
+void
+DBusTestServer::step_progress(uint32_t step)
+{
+  DBusTestData::Progress *timers[] = {&micro, &rest, &daily};
+  const int32_t limits[] = {180, 2700, 14400};
+
+  for (int32_t slot = 0; slot < 3; slot++)
+    {
+      DBusTestData::Progress &p = *timers[slot];
+      p.m_slot = slot;
+      p.m_max = limits[slot];
+      p.m_value = static_cast<int32_t>(step % static_cast<uint32_t>(limits[slot]));
+      p.m_color = p.m_value * 2 > p.m_max ? 2 : 1;
+      p.m_running = step % 10 != 0;
+      p.m_reference = static_cast<int64_t>(step) * 1000000;
+    }
+
+  progress_text = std::to_string(micro.m_value / 60) + ":" + std::to_string(micro.m_value % 60);
+}
+
 void
 DBusTestServer::test_map_of_struct(DBusTestData::DataMap i_data, DBusTestData::DataMap &o_data)
 {
@@ -20,6 +20,7 @@
 
 #include <string>
 #include <set>
+#include <vector>
 
 #if defined(DBUS_BACKEND_QT)
 #  include <QDBusArgument>
@@ -104,6 +105,25 @@ public:
   virtual void test_fire_signal() = 0;
   virtual void test_fire_signal_without_args() = 0;
   virtual void test_fire_signal_with_ref() = 0;
+  virtual void test_fire_menu_snapshot(uint32_t mode) = 0;
+  virtual void test_fire_menu_item_changed(uint32_t mode) = 0;
+  virtual void test_fire_progress_changed(uint32_t count, uint64_t &emit_ns) = 0;
+
+protected:
+  //! Selects an operation mode in a menu like the one of the applets, and returns the items that changed.
+  std::vector<DBusTestData::MenuEntry> select_menu_mode(uint32_t mode);
+
+  //! Advances the timers in a way like the applets see them once a second.
+  void step_progress(uint32_t step);
+
+protected:
+  DBusTestData::MenuEntryList menu;
+  uint32_t menu_version{0};
+
+  DBusTestData::Progress micro;
+  DBusTestData::Progress rest;
+  DBusTestData::Progress daily;
+  std::string progress_text;
 };
 
 #endif // DBUSTESTSERVER_HH
@@ -19,6 +19,8 @@
 #  include "config.h"
 #endif
 
+#include <chrono>
+
 #include "debug.hh"
 
 #include "DBusTestServerGio.hh"
@@ -173,3 +175,52 @@ DBusTestServerGio::test_fire_signal_with_ref()
                           m);
     }
 }
+
+void
+DBusTestServerGio::test_fire_menu_snapshot(uint32_t mode)
+{
+  org_workrave_TestInterface *test = org_workrave_TestInterface::instance(dbus);
+
+  select_menu_mode(mode);
+
+  if (test != NULL)
+    {
+      test->MenuSnapshot(WORKRAVE_TEST_PATH, ++menu_version, menu);
+    }
+}
+
+void
+DBusTestServerGio::test_fire_menu_item_changed(uint32_t mode)
+{
+  org_workrave_TestInterface *test = org_workrave_TestInterface::instance(dbus);
+
+  for (auto &entry: select_menu_mode(mode))
+    {
+      if (test != NULL)
+        {
+          test->MenuItemChanged(WORKRAVE_TEST_PATH, ++menu_version, entry.m_command, entry.m_text, entry.m_flags);
+        }
+    }
+}
+
+void
+DBusTestServerGio::test_fire_progress_changed(uint32_t count, uint64_t &emit_ns)
+{
+  org_workrave_TestInterface *test = org_workrave_TestInterface::instance(dbus);
+
+  std::chrono::steady_clock::duration elapsed{};
+  for (uint32_t i = 0; i < count; i++)
+    {
+      step_progress(i);
+
+      if (test != NULL)
+        {
+          // Only the emission itself, as done by the applet code once a second.
+          auto start = std::chrono::steady_clock::now();
+          test->ProgressChanged(WORKRAVE_TEST_PATH, micro, rest, daily, progress_text);
+          elapsed += std::chrono::steady_clock::now() - start;
+        }
+    }
+
+  emit_ns = count > 0 ? std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / count : 0;
+}
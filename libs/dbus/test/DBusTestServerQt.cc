@@ -22,6 +22,8 @@
 #include <QtCore>
 #include <QtDBus>
 
+#include <chrono>
+
 #include "debug.hh"
 
 #include "DBusTestServerQt.hh"
@@ -57,6 +59,9 @@ DBusTestServerQt::run(int argc, char **argv)
       qDBusRegisterMetaType<DBusTestData::Data>();
       qDBusRegisterMetaType<QList<DBusTestData::Data>>();
       qDBusRegisterMetaType<QMap<QString, DBusTestData::Data>>();
+      qDBusRegisterMetaType<DBusTestData::MenuEntry>();
+      qDBusRegisterMetaType<QList<DBusTestData::MenuEntry>>();
+      qDBusRegisterMetaType<DBusTestData::Progress>();
 
       dbus = std::make_shared<workrave::dbus::DBusQt>();
 
@@ -176,3 +181,52 @@ DBusTestServerQt::test_fire_signal_with_ref()
                           m);
     }
 }
+
+void
+DBusTestServerQt::test_fire_menu_snapshot(uint32_t mode)
+{
+  org_workrave_TestInterface *test = org_workrave_TestInterface::instance(dbus);
+
+  select_menu_mode(mode);
+
+  if (test != nullptr)
+    {
+      test->MenuSnapshot(WORKRAVE_TEST_PATH, ++menu_version, menu);
+    }
+}
+
+void
+DBusTestServerQt::test_fire_menu_item_changed(uint32_t mode)
+{
+  org_workrave_TestInterface *test = org_workrave_TestInterface::instance(dbus);
+
+  for (auto &entry: select_menu_mode(mode))
+    {
+      if (test != nullptr)
+        {
+          test->MenuItemChanged(WORKRAVE_TEST_PATH, ++menu_version, entry.m_command, entry.m_text, entry.m_flags);
+        }
+    }
+}
+
+void
+DBusTestServerQt::test_fire_progress_changed(uint32_t count, uint64_t &emit_ns)
+{
+  org_workrave_TestInterface *test = org_workrave_TestInterface::instance(dbus);
+
+  std::chrono::steady_clock::duration elapsed{};
+  for (uint32_t i = 0; i < count; i++)
+    {
+      step_progress(i);
+
+      if (test != nullptr)
+        {
+          // Only the emission itself, as done by the applet code once a second.
+          auto start = std::chrono::steady_clock::now();
+          test->ProgressChanged(WORKRAVE_TEST_PATH, micro, rest, daily, progress_text);
+          elapsed += std::chrono::steady_clock::now() - start;
+        }
+    }
+
+  emit_ns = count > 0 ? std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / count : 0;
+}
@@ -40,6 +40,9 @@ public:
   void test_fire_signal();
   void test_fire_signal_without_args();
   void test_fire_signal_with_ref();
+  void test_fire_menu_snapshot(uint32_t mode);
+  void test_fire_menu_item_changed(uint32_t mode);
+  void test_fire_progress_changed(uint32_t count, uint64_t &emit_ns);
 
 private:
   QCoreApplication *app;
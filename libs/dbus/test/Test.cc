@@ -61,6 +61,9 @@ struct Fixture
     qDBusRegisterMetaType<DBusTestData::Data>();
     qDBusRegisterMetaType<QList<DBusTestData::Data>>();
     qDBusRegisterMetaType<QMap<QString, DBusTestData::Data>>();
+    qDBusRegisterMetaType<DBusTestData::MenuEntry>();
+    qDBusRegisterMetaType<QList<DBusTestData::MenuEntry>>();
+    qDBusRegisterMetaType<DBusTestData::Progress>();
   }
 
   ~Fixture()
@@ -353,6 +356,124 @@ BOOST_AUTO_TEST_CASE(test_test_signal)
   BOOST_REQUIRE_EQUAL(reply.type(), QDBusMessage::ReplyMessage);
 }
 
+static void
+fire_menu_signals(const char *method, MenuReceiver &receiver, int num_calls, int num_signals)
+{
+  QDBusConnection connection = QDBusConnection::sessionBus();
+
+  for (int i = 0; i < num_calls; i++)
+    {
+      QDBusMessage message = QDBusMessage::createMethodCall(WORKRAVE_TEST_SERVICE, WORKRAVE_TEST_PATH, WORKRAVE_TEST_INTERFACE, method);
+      message << QVariant::fromValue(static_cast<uint32_t>(i % 3));
+      QDBusMessage reply = connection.call(message);
+      BOOST_REQUIRE_EQUAL(reply.type(), QDBusMessage::ReplyMessage);
+    }
+
+  QElapsedTimer timer;
+  timer.start();
+  while (receiver.count < num_signals && timer.elapsed() < 10000)
+    {
+      QCoreApplication::processEvents(QEventLoop::AllEvents, 100);
+    }
+  BOOST_REQUIRE_EQUAL(receiver.count, num_signals);
+}
+
+BOOST_AUTO_TEST_CASE(test_menu_delta_traffic)
+{
+  const int num_updates = 200;
+
+  MenuReceiver full;
+  MenuReceiver delta;
+  QDBusConnection connection = QDBusConnection::sessionBus();
+
+  connection.connect(WORKRAVE_TEST_SERVICE,
+                     WORKRAVE_TEST_PATH,
+                     WORKRAVE_TEST_INTERFACE,
+                     "MenuSnapshot",
+                     &full,
+                     SLOT(on_menu_snapshot(QDBusMessage)));
+  fire_menu_signals("FireMenuSnapshot", full, num_updates, num_updates);
+  connection.disconnect(WORKRAVE_TEST_SERVICE,
+                        WORKRAVE_TEST_PATH,
+                        WORKRAVE_TEST_INTERFACE,
+                        "MenuSnapshot",
+                        &full,
+                        SLOT(on_menu_snapshot(QDBusMessage)));
+
+  // Start the delta client from the same state, as the applet does after GetMenuSnapshot.
+  delta.items = full.items;
+  delta.version = full.version;
+
+  connection.connect(WORKRAVE_TEST_SERVICE,
+                     WORKRAVE_TEST_PATH,
+                     WORKRAVE_TEST_INTERFACE,
+                     "MenuItemChanged",
+                     &delta,
+                     SLOT(on_menu_item_changed(QDBusMessage)));
+  // Every mode switch deactivates one radio item and activates another.
+  fire_menu_signals("FireMenuItemChanged", delta, num_updates, 2 * num_updates);
+
+  using namespace std::chrono;
+  BOOST_TEST_MESSAGE("snapshots: " << full.count << " signals, " << full.bytes << " bytes, "
+                                   << duration_cast<microseconds>(full.update_time).count() << " us");
+  BOOST_TEST_MESSAGE("deltas: " << delta.count << " signals, " << delta.bytes << " bytes, "
+                                << duration_cast<microseconds>(delta.update_time).count() << " us");
+
+  BOOST_CHECK_EQUAL(delta.gaps, 0);
+  BOOST_CHECK_EQUAL(full.gaps, 0);
+  BOOST_CHECK_LT(delta.bytes, full.bytes);
+
+  // Both modes ended in mode (num_updates - 1) % 3.
+  BOOST_CHECK(delta.items == full.items);
+}
+
+BOOST_AUTO_TEST_CASE(test_progress_emit_cost)
+{
+  const uint32_t num_updates = 1000;
+
+  ProgressReceiver r;
+  QDBusConnection connection = QDBusConnection::sessionBus();
+
+  connection.connect(WORKRAVE_TEST_SERVICE,
+                     WORKRAVE_TEST_PATH,
+                     WORKRAVE_TEST_INTERFACE,
+                     "ProgressChanged",
+                     &r,
+                     SLOT(on_progress_changed(QDBusMessage)));
+
+  QDBusMessage message =
+    QDBusMessage::createMethodCall(WORKRAVE_TEST_SERVICE, WORKRAVE_TEST_PATH, WORKRAVE_TEST_INTERFACE, "FireProgressChanged");
+  message << QVariant::fromValue(num_updates);
+  QDBusMessage reply = connection.call(message);
+  BOOST_REQUIRE_EQUAL(reply.type(), QDBusMessage::ReplyMessage);
+  BOOST_REQUIRE_EQUAL(reply.arguments().size(), 1);
+
+  QElapsedTimer timer;
+  timer.start();
+  while (r.count < static_cast<int>(num_updates) && timer.elapsed() < 10000)
+    {
+      QCoreApplication::processEvents(QEventLoop::AllEvents, 100);
+    }
+  BOOST_REQUIRE_EQUAL(r.count, static_cast<int>(num_updates));
+
+  BOOST_TEST_MESSAGE("emit: " << reply.arguments().at(0).value<qulonglong>() << " ns per signal");
+
+  // Same values as DBusTestServer::step_progress for the last step; checks the packed struct layout.
+  const int32_t last = num_updates - 1;
+  BOOST_CHECK_EQUAL(r.micro.m_slot, 0);
+  BOOST_CHECK_EQUAL(r.micro.m_value, last % 180);
+  BOOST_CHECK_EQUAL(r.micro.m_max, 180);
+  BOOST_CHECK_EQUAL(r.micro.m_color, 2U);
+  BOOST_CHECK_EQUAL(r.micro.m_running, true);
+  BOOST_CHECK_EQUAL(r.micro.m_reference, static_cast<int64_t>(last) * 1000000);
+  BOOST_CHECK_EQUAL(r.rest.m_slot, 1);
+  BOOST_CHECK_EQUAL(r.rest.m_value, last);
+  BOOST_CHECK_EQUAL(r.rest.m_color, 1U);
+  BOOST_CHECK_EQUAL(r.daily.m_slot, 2);
+  BOOST_CHECK_EQUAL(r.daily.m_max, 14400);
+  BOOST_CHECK_EQUAL(r.text, "1:39");
+}
+
 BOOST_AUTO_TEST_CASE(test_test_error_basic)
 {
   DBusTestData::StructWithAllBasicTypes inpar;
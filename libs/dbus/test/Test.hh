@@ -19,9 +19,13 @@
 #define TEST_HH
 
 #include <QtCore>
+#include <QtDBus>
 
+#include <chrono>
 #include <iostream>
 
+#include "DBusTestData.hh"
+
 class SignalReceiver : public QObject
 {
   Q_OBJECT
@@ -49,4 +53,111 @@ public:
   bool got;
 };
 
+//! Keeps a copy of a menu up to date from either full snapshots or per item changes.
+class MenuReceiver : public QObject
+{
+  Q_OBJECT
+public:
+  MenuReceiver() = default;
+
+public Q_SLOTS:
+
+  void on_menu_snapshot(const QDBusMessage &message)
+  {
+    auto start = std::chrono::steady_clock::now();
+
+    QList<QVariant> arguments = message.arguments();
+    uint32_t v = arguments.at(0).value<uint32_t>();
+    QList<DBusTestData::MenuEntry> entries;
+    arguments.at(1).value<QDBusArgument>() >> entries;
+
+    check_version(v);
+    std::size_t size = 4 + 4;
+    items.clear();
+    for (const auto &entry: entries)
+      {
+        size = align(size, 8);
+        size = align(size + 4 + entry.m_text.size() + 1, 4);
+        size = align(size + 4 + entry.m_action.size() + 1, 4);
+        size += 4 + 1 + 1;
+        items[entry.m_command] = qMakePair(entry.m_text, entry.m_flags);
+      }
+
+    bytes += size;
+    update_time += std::chrono::steady_clock::now() - start;
+    count++;
+  }
+
+  void on_menu_item_changed(const QDBusMessage &message)
+  {
+    auto start = std::chrono::steady_clock::now();
+
+    QList<QVariant> arguments = message.arguments();
+    uint32_t v = arguments.at(0).value<uint32_t>();
+    uint32_t command = arguments.at(1).value<uint32_t>();
+    std::string text = arguments.at(2).value<QString>().toStdString();
+    uint8_t flags = arguments.at(3).value<uint8_t>();
+
+    check_version(v);
+    items[command] = qMakePair(text, flags);
+
+    bytes += 4 + 4 + 4 + text.size() + 1 + 1;
+    update_time += std::chrono::steady_clock::now() - start;
+    count++;
+  }
+
+private:
+  static std::size_t align(std::size_t size, std::size_t alignment)
+  {
+    return (size + alignment - 1) / alignment * alignment;
+  }
+
+  void check_version(uint32_t v)
+  {
+    if (version != 0 && v != version + 1)
+      {
+        gaps++;
+      }
+    version = v;
+  }
+
+public:
+  //! Menu as seen by the client: command -> (text, flags).
+  QMap<uint32_t, QPair<std::string, uint8_t>> items;
+  uint32_t version{0};
+  int count{0};
+  int gaps{0};
+
+  //! Estimated size of the signal bodies on the wire.
+  std::size_t bytes{0};
+  std::chrono::steady_clock::duration update_time{};
+};
+
+//! Receives the timer progress as sent by the applet interface.
+class ProgressReceiver : public QObject
+{
+  Q_OBJECT
+public:
+  ProgressReceiver() = default;
+
+public Q_SLOTS:
+
+  void on_progress_changed(const QDBusMessage &message)
+  {
+    QList<QVariant> arguments = message.arguments();
+    arguments.at(0).value<QDBusArgument>() >> micro;
+    arguments.at(1).value<QDBusArgument>() >> rest;
+    arguments.at(2).value<QDBusArgument>() >> daily;
+    text = arguments.at(3).value<QString>().toStdString();
+    count++;
+  }
+
+public:
+  DBusTestData::Progress micro;
+  DBusTestData::Progress rest;
+  DBusTestData::Progress daily;
+  std::string text;
+  int count{0};
+};
+
 #endif // TEST_HH
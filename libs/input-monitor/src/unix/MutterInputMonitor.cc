@@ -381,6 +381,7 @@ MutterInputMonitor::on_idle_monitor_signal(GDBusProxy *proxy,
       guint handlerID;
       g_variant_get(parameters, "(u)", &handlerID);
 
+      self->watches_fired.add();
       Diagnostics::instance().log("mutter: watch fired");
       if (handlerID == self->watch_active)
         {
@@ -442,6 +443,7 @@ MutterInputMonitor::run()
 
                 g_variant_get(reply, "(t)", &idletime);
                 g_variant_unref(reply);
+                idle_time.record(static_cast<int64_t>(idletime));
                 Diagnostics::instance().log("mutter: " + std::to_string(idletime));
                 local_active = idletime < 1000;
               }
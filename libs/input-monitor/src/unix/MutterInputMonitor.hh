@@ -71,6 +71,8 @@ private:
   TracedField<bool> trace_inhibited{"monitor.inhibited", false};
   TracedField<guint> watch_active{"monitor.mutter.watch_active", 0};
   TracedField<guint> watch_idle{"monitor.mutter.watch_idle", 0};
+  workrave::utils::Counter &watches_fired{workrave::utils::Metrics::instance().counter("monitor.mutter.watches_fired")};
+  workrave::utils::Histogram &idle_time{workrave::utils::Metrics::instance().histogram("monitor.mutter.idle_time_ms")};
 
   bool abort = false;
   std::shared_ptr<std::thread> monitor_thread;
@@ -0,0 +1,39 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef WORKRAVE_TESTSUPPORT_ALLOCATIONCOUNTER_HH
+#define WORKRAVE_TESTSUPPORT_ALLOCATIONCOUNTER_HH
+
+#include <cstdint>
+
+//! Counts the heap allocations made through operator new.
+/*!
+ *  Linking workrave-libs-test-support into a test replaces the global operator
+ *  new and delete. Allocations are counted per thread, so work done by
+ *  background threads does not show up in the counts of the caller.
+ */
+class AllocationCounter
+{
+public:
+  //! Returns the number of allocations made by the calling thread.
+  static int64_t get_count();
+
+  //! Returns the number of bytes allocated by the calling thread.
+  static int64_t get_bytes();
+};
+
+#endif // WORKRAVE_TESTSUPPORT_ALLOCATIONCOUNTER_HH
@@ -0,0 +1,92 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "testsupport/AllocationCounter.hh"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+  thread_local int64_t allocation_count = 0;
+  thread_local int64_t allocation_bytes = 0;
+
+  void *allocate(std::size_t size)
+  {
+    allocation_count++;
+    allocation_bytes += static_cast<int64_t>(size);
+
+    void *ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr)
+      {
+        throw std::bad_alloc();
+      }
+    return ptr;
+  }
+} // namespace
+
+int64_t
+AllocationCounter::get_count()
+{
+  return allocation_count;
+}
+
+int64_t
+AllocationCounter::get_bytes()
+{
+  return allocation_bytes;
+}
+
+void *
+operator new(std::size_t size)
+{
+  return allocate(size);
+}
+
+void *
+operator new[](std::size_t size)
+{
+  return allocate(size);
+}
+
+void
+operator delete(void *ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void
+operator delete[](void *ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void
+operator delete(void *ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+void
+operator delete[](void *ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+# All rights reserved.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+"""
+Converts a binary trace written by workrave::utils::Trace into text.
+"""
+
+import struct
+import sys
+import datetime
+
+from optparse import OptionParser
+
+MAGIC = b"WRTRACE1"
+
+RECORD_STRING = 1
+RECORD_THREAD = 2
+RECORD_EVENT = 3
+RECORD_LOST = 4
+
+PREFIXES = {1: ">>> ", 2: "<<< ", 3: "<<< ", 4: "    ", 5: "    "}
+
+
+class TraceError(Exception):
+    pass
+
+
+class Reader(object):
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def at_end(self):
+        return self.pos >= len(self.data)
+
+    def read(self, fmt):
+        size = struct.calcsize(fmt)
+        if self.pos + size > len(self.data):
+            raise TraceError("truncated record at offset %d" % self.pos)
+        values = struct.unpack_from(fmt, self.data, self.pos)
+        self.pos += size
+        return values
+
+    def read_text(self, length):
+        if self.pos + length > len(self.data):
+            raise TraceError("truncated text at offset %d" % self.pos)
+        text = self.data[self.pos:self.pos + length].decode("utf-8", "replace")
+        self.pos += length
+        return text
+
+
+def decode(data):
+    """Returns (start, threads, events, lost) of a trace.
+
+    Events are (time_ns, thread, kind, name, text) tuples in the order in
+    which they were traced.
+    """
+    reader = Reader(data)
+    if reader.read_text(len(MAGIC)).encode() != MAGIC:
+        raise TraceError("not a trace file")
+    steady_start, real_start = reader.read("<qq")
+
+    strings = {}
+    threads = {}
+    events = []
+    lost = {}
+
+    while not reader.at_end():
+        (record_type,) = reader.read("<B")
+        if record_type == RECORD_STRING:
+            string_id, length = reader.read("<IH")
+            strings[string_id] = reader.read_text(length)
+        elif record_type == RECORD_THREAD:
+            thread, length = reader.read("<HH")
+            threads[thread] = reader.read_text(length)
+        elif record_type == RECORD_EVENT:
+            kind, thread, time, string_id, length = reader.read("<BHqIB")
+            events.append((time, thread, kind, strings.get(string_id, "?"), reader.read_text(length)))
+        elif record_type == RECORD_LOST:
+            thread, count = reader.read("<HI")
+            lost[thread] = lost.get(thread, 0) + count
+            events.append((None, thread, None, None, count))
+        else:
+            raise TraceError("unknown record type %d at offset %d" % (record_type, reader.pos - 1))
+
+    # Threads are written one after the other; merge them by time. A loss
+    # marker sorts directly before the next event of its thread.
+    last = {}
+    for i in range(len(events) - 1, -1, -1):
+        time, thread = events[i][0], events[i][1]
+        if time is None:
+            events[i] = (last.get(thread, sys.maxsize),) + events[i][1:]
+        else:
+            last[thread] = time
+    events.sort(key=lambda event: event[0])
+
+    return (steady_start, real_start), threads, events, lost
+
+
+def format_time(start, time):
+    steady_start, real_start = start
+    micros = real_start + (time - steady_start) // 1000
+    t = datetime.datetime.fromtimestamp(micros / 1000000.0)
+    return t.strftime("%d%b%Y %H:%M:%S") + ".%06d" % t.microsecond
+
+
+def main():
+    parser = OptionParser(usage="usage: %prog [options] trace-file")
+    parser.add_option("-t", "--thread", dest="thread", type="int", help="only show this thread")
+    (options, args) = parser.parse_args()
+    if len(args) != 1:
+        parser.error("expected one trace file")
+
+    with open(args[0], "rb") as f:
+        data = f.read()
+
+    try:
+        start, threads, events, lost = decode(data)
+    except TraceError as e:
+        sys.stderr.write("%s: %s\n" % (args[0], e))
+        return 1
+
+    for time, thread, kind, name, text in events:
+        if options.thread is not None and options.thread != thread:
+            continue
+        thread_name = threads.get(thread, str(thread))
+        if kind is None:
+            print("%s %s *** %d records lost" % (format_time(start, time) if time != sys.maxsize else "", thread_name, text))
+            continue
+        line = PREFIXES.get(kind, "    ") + name
+        if text:
+            line += (" " if name else "") + text
+        print("%s %s %s" % (format_time(start, time), thread_name, line))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -30,69 +30,72 @@
 #  define TRACE_GERROR(x)
 #else
 
-#  include <iostream>
-#  include <iomanip>
-#  include <fstream>
-#  include <ctime>
+#  include <string>
 
-#  include <map>
-#  include <thread>
-#  include <mutex>
-
-extern std::recursive_mutex g_log_mutex;
-extern std::map<std::thread::id, std::ofstream *> g_log_streams;
+#  include "utils/Trace.hh"
 
 class Debug
 {
 public:
+  //! Starts writing the trace. See workrave::utils::Trace.
   static void init(const std::string &name = "");
-  static std::string trace_string();
-  static std::ofstream &stream();
 };
 
 #  ifndef TRACE_EXTRA
 #    define TRACE_EXTRA ""
 #  endif
 
-#  define TRACE_ENTER(x)                                                                 \
-    g_log_mutex.lock();                                                                  \
-    const char *_trace_method_name = x;                                                  \
-    Debug::stream() << Debug::trace_string() << ">>> " << x << TRACE_EXTRA << std::endl; \
-    g_log_mutex.unlock()
-
-#  define TRACE_ENTER_MSG(x, y)                                                                      \
-    g_log_mutex.lock();                                                                              \
-    const char *_trace_method_name = x;                                                              \
-    Debug::stream() << Debug::trace_string() << ">>> " << x << TRACE_EXTRA << " " << y << std::endl; \
-    g_log_mutex.unlock()
-
-#  define TRACE_RETURN(y)                                                                       \
-    g_log_mutex.lock();                                                                         \
-    Debug::stream() << Debug::trace_string() << "<<< " << _trace_method_name << y << std::endl; \
-    g_log_mutex.unlock()
-
-#  define TRACE_EXIT()                                                                     \
-    g_log_mutex.lock();                                                                    \
-    Debug::stream() << Debug::trace_string() << "<<< " << _trace_method_name << std::endl; \
-    g_log_mutex.unlock()
-
-#  define TRACE_MSG(msg)                                                                                 \
-    g_log_mutex.lock();                                                                                  \
-    Debug::stream() << Debug::trace_string() << "    " << _trace_method_name << " " << msg << std::endl; \
-    g_log_mutex.unlock()
-
-#  define TRACE_GERROR(err)                                                                                                 \
-    g_log_mutex.lock();                                                                                                     \
-    if (err != NULL)                                                                                                        \
-      {                                                                                                                     \
-        Debug::stream() << Debug::trace_string() << "    " << _trace_method_name << " error:" << err->message << std::endl; \
-      }                                                                                                                     \
-    g_log_mutex.unlock()
-
-#  define TRACE_LOG(err)                                                    \
-    g_log_mutex.lock();                                                     \
-    Debug::stream() << Debug::trace_string() << "    " << err << std::endl; \
-    g_log_mutex.unlock()
+// The method name must be a string literal: only its address is recorded.
+#  define TRACE_ENTER(x)                               \
+    const char *_trace_method_name = "" x TRACE_EXTRA; \
+    workrave::utils::Trace::event(workrave::utils::Trace::KIND_ENTER, _trace_method_name)
+
+#  define TRACE_ENTER_MSG(x, y)                                                                     \
+    const char *_trace_method_name = "" x TRACE_EXTRA;                                              \
+    do                                                                                              \
+      {                                                                                             \
+        workrave::utils::Trace::begin(workrave::utils::Trace::KIND_ENTER, _trace_method_name) << y; \
+        workrave::utils::Trace::commit();                                                           \
+      }                                                                                             \
+    while (0)
+
+#  define TRACE_RETURN(y)                                                                            \
+    do                                                                                               \
+      {                                                                                              \
+        workrave::utils::Trace::begin(workrave::utils::Trace::KIND_RETURN, _trace_method_name) << y; \
+        workrave::utils::Trace::commit();                                                            \
+      }                                                                                              \
+    while (0)
+
+#  define TRACE_EXIT() workrave::utils::Trace::event(workrave::utils::Trace::KIND_EXIT, _trace_method_name)
+
+#  define TRACE_MSG(msg)                                                                                \
+    do                                                                                                  \
+      {                                                                                                 \
+        workrave::utils::Trace::begin(workrave::utils::Trace::KIND_MESSAGE, _trace_method_name) << msg; \
+        workrave::utils::Trace::commit();                                                               \
+      }                                                                                                 \
+    while (0)
+
+#  define TRACE_GERROR(err)                                                                         \
+    do                                                                                              \
+      {                                                                                             \
+        if (err != NULL)                                                                            \
+          {                                                                                         \
+            workrave::utils::Trace::begin(workrave::utils::Trace::KIND_MESSAGE, _trace_method_name) \
+              << "error:" << err->message;                                                          \
+            workrave::utils::Trace::commit();                                                       \
+          }                                                                                         \
+      }                                                                                             \
+    while (0)
+
+#  define TRACE_LOG(err)                                                            \
+    do                                                                              \
+      {                                                                             \
+        workrave::utils::Trace::begin(workrave::utils::Trace::KIND_LOG, "") << err; \
+        workrave::utils::Trace::commit();                                           \
+      }                                                                             \
+    while (0)
 
 #endif // TRACING
 
@@ -0,0 +1,129 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef WORKRAVE_UTILS_CALENDAR_HH
+#define WORKRAVE_UTILS_CALENDAR_HH
+
+#include <cstdint>
+#include <ctime>
+
+namespace workrave::utils
+{
+  //! Date in the proleptic Gregorian calendar.
+  struct CivilDate
+  {
+    int year{1970};
+
+    //! 1 - 12.
+    int month{1};
+
+    //! 1 - 31.
+    int day{1};
+  };
+
+  //! Calendar arithmetic and local time conversion.
+  /*!
+   *  Day numbers count days since 1970-01-01. Date arithmetic never looks at
+   *  the time zone. Local time conversions use a table of the UTC offset
+   *  transitions of the local time zone, built once per year from the C
+   *  library and cached, so they do not take the C library's time zone lock.
+   *  All functions may be called from any thread. Call reset() when the time
+   *  zone may have changed.
+   */
+  class Calendar
+  {
+  public:
+    static constexpr int64_t SECONDS_PER_DAY = 24 * 60 * 60;
+
+    static int32_t days_from_civil(int year, int month, int day)
+    {
+      year -= month <= 2 ? 1 : 0;
+      int era = (year >= 0 ? year : year - 399) / 400;
+      int yoe = year - era * 400;
+      int doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+      int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+      return era * 146097 + doe - 719468;
+    }
+
+    static int32_t days_from_civil(const CivilDate &date)
+    {
+      return days_from_civil(date.year, date.month, date.day);
+    }
+
+    static CivilDate civil_from_days(int32_t days)
+    {
+      int32_t z = days + 719468;
+      int era = (z >= 0 ? z : z - 146096) / 146097;
+      int doe = z - era * 146097;
+      int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+      int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+      int mp = (5 * doy + 2) / 153;
+
+      CivilDate ret;
+      ret.month = mp < 10 ? mp + 3 : mp - 9;
+      ret.year = yoe + era * 400 + (ret.month <= 2 ? 1 : 0);
+      ret.day = doy - (153 * mp + 2) / 5 + 1;
+      return ret;
+    }
+
+    //! Returns the day of the week, 0 is Sunday.
+    static int weekday(int32_t days)
+    {
+      // 1970-01-01 was a Thursday.
+      return (days % 7 + 11) % 7;
+    }
+
+    static bool is_leap_year(int year)
+    {
+      return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+    }
+
+    static int days_in_month(int year, int month)
+    {
+      static constexpr int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+      return month == 2 && is_leap_year(year) ? 29 : days[month - 1];
+    }
+
+    //! Returns the number of days since 1970-01-01 of the date of a struct tm.
+    static int32_t days_from_tm(const struct tm &tm)
+    {
+      return days_from_civil(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday);
+    }
+
+    //! Returns the offset of local time from UTC in seconds at time t.
+    static int32_t get_utc_offset(int64_t t);
+
+    //! Converts seconds since the epoch to local time, like localtime_r().
+    static struct tm to_local(int64_t t);
+
+    //! Converts local time to seconds since the epoch.
+    /*!
+     *  A time that does not exist because it falls in a daylight saving time
+     *  gap moves forward by the length of the gap. A time that exists twice
+     *  resolves to the first one.
+     */
+    static int64_t from_local(int32_t days, int hour, int minute, int second = 0);
+
+    //! Returns the first time after t at which the local time is hour:minute.
+    static int64_t get_next_local_time(int64_t t, int hour, int minute);
+
+    //! Discards the cached time zone information.
+    static void reset();
+  };
+} // namespace workrave::utils
+
+#endif // WORKRAVE_UTILS_CALENDAR_HH
@@ -18,33 +18,50 @@
 #ifndef DIANOSTICS_HH
 #define DIANOSTICS_HH
 
+#include <atomic>
 #include <string>
 #include <utility>
 #include <iostream>
 #include <functional>
 #include <sstream>
 #include <map>
+#include <mutex>
+#include <vector>
+
+#include "utils/Metrics.hh"
+#include "utils/MpscQueue.hh"
 
 class TracedFieldBase
 {
 public:
   TracedFieldBase() noexcept = default;
 
-  static bool debug;
+  static std::atomic<bool> debug;
 };
 
 class DiagnosticsSink
 {
 public:
   virtual ~DiagnosticsSink() = default;
-  virtual void diagnostics_log(const std::string &log) = 0;
+
+  //! Receives the log lines reported since the previous call, oldest first.
+  virtual void diagnostics_log(const std::vector<std::string> &lines) = 0;
 };
 
+//! Diagnostic log for the debug dialog.
+/*!
+ *  Any thread may log or report. Lines are queued without locking and
+ *  handed to the sink in batches by process(), which must be called from
+ *  the main loop. Lines logged while the queue is full are dropped and
+ *  counted in the "diagnostics.dropped" counter of workrave::utils::Metrics.
+ */
 class Diagnostics
 {
 public:
   using request_t = std::function<void()>;
 
+  static constexpr std::size_t QUEUE_SIZE = 1024;
+
   static Diagnostics &instance()
   {
     static auto *diag = new Diagnostics();
@@ -55,12 +72,14 @@ public:
   void disable();
   void register_topic(const std::string &name, request_t func);
   void unregister_topic(const std::string &name);
-  std::string trace_get_time();
+
+  //! Passes all queued lines to the sink.
+  void process();
 
   template<typename T>
   void report(const std::string &name, const T &value)
   {
-    if (enabled)
+    if (enabled.load(std::memory_order_relaxed))
       {
         std::stringstream ss;
         ss << value;
@@ -68,18 +87,34 @@ public:
       }
   }
 
-  void log(const std::string &txt)
+  void log(std::string txt)
   {
-    if (enabled)
+    if (enabled.load(std::memory_order_relaxed))
       {
-        sink->diagnostics_log(trace_get_time() + ": " + txt);
+        push(std::move(txt));
       }
   }
 
 private:
-  bool enabled{false};
+  struct Event
+  {
+    //! Real time in microseconds.
+    int64_t time{0};
+    std::string text;
+  };
+
+  Diagnostics();
+
+  void push(std::string &&txt);
+  static std::string trace_get_time(int64_t time);
+
+private:
+  std::atomic<bool> enabled{false};
+  std::mutex topics_mutex;
   std::map<std::string, request_t> topics;
   DiagnosticsSink *sink{nullptr};
+  workrave::utils::MpscQueue<Event, QUEUE_SIZE> queue;
+  workrave::utils::Counter &dropped;
 };
 
 template<typename ValueType>
@@ -0,0 +1,155 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef WORKRAVE_UTILS_METRICS_HH
+#define WORKRAVE_UTILS_METRICS_HH
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace workrave::utils
+{
+  //! Monotonically increasing count.
+  class Counter
+  {
+  public:
+    void add(int64_t n = 1)
+    {
+      value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    int64_t get() const
+    {
+      return value.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<int64_t> value{0};
+  };
+
+  //! Current value of a quantity.
+  class Gauge
+  {
+  public:
+    void set(int64_t v)
+    {
+      value.store(v, std::memory_order_relaxed);
+    }
+
+    void add(int64_t n)
+    {
+      value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    int64_t get() const
+    {
+      return value.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<int64_t> value{0};
+  };
+
+  //! Distribution of recorded values in power-of-two buckets.
+  /*!
+   *  Bucket 0 counts values <= 0, bucket i counts values in [2^(i-1), 2^i).
+   *  Percentiles are reported as the upper bound of their bucket.
+   */
+  class Histogram
+  {
+  public:
+    static constexpr int NUM_BUCKETS = 64;
+
+    void record(int64_t value);
+
+    uint64_t get_count() const;
+    int64_t get_sum() const;
+    int64_t get_min() const;
+    int64_t get_max() const;
+    int64_t get_percentile(double percentile) const;
+
+    static int get_bucket(int64_t value);
+
+  private:
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> buckets{};
+    std::atomic<uint64_t> count{0};
+    std::atomic<int64_t> sum{0};
+    std::atomic<int64_t> min{INT64_MAX};
+    std::atomic<int64_t> max{INT64_MIN};
+  };
+
+  //! Value of a metric at the time of Metrics::snapshot().
+  struct MetricSnapshot
+  {
+    std::string name;
+
+    //! "counter", "gauge" or "histogram".
+    std::string kind;
+
+    //! Value of a counter or gauge.
+    int64_t value{0};
+
+    //! Histograms only.
+    uint64_t count{0};
+    int64_t sum{0};
+    int64_t min{0};
+    int64_t max{0};
+    int64_t p50{0};
+    int64_t p90{0};
+    int64_t p99{0};
+  };
+
+  std::ostream &operator<<(std::ostream &stream, const MetricSnapshot &metric);
+
+  //! Registry of named metrics.
+  /*!
+   *  Looking up a metric takes a lock; keep the returned reference, which
+   *  stays valid for the lifetime of the process. Updating a metric is
+   *  lock-free and may be done from any thread.
+   */
+  class Metrics
+  {
+  public:
+    static Metrics &instance();
+
+    Counter &counter(const std::string &name);
+    Gauge &gauge(const std::string &name);
+    Histogram &histogram(const std::string &name);
+
+    //! Returns all metrics, sorted by name.
+    std::vector<MetricSnapshot> snapshot() const;
+
+  private:
+    template<typename T>
+    static T &lookup(std::map<std::string, std::unique_ptr<T>> &metrics, const std::string &name);
+
+  private:
+    mutable std::mutex mutex;
+    std::map<std::string, std::unique_ptr<Counter>> counters;
+    std::map<std::string, std::unique_ptr<Gauge>> gauges;
+    std::map<std::string, std::unique_ptr<Histogram>> histograms;
+  };
+} // namespace workrave::utils
+
+#endif // WORKRAVE_UTILS_METRICS_HH
@@ -0,0 +1,116 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef WORKRAVE_UTILS_MPSCQUEUE_HH
+#define WORKRAVE_UTILS_MPSCQUEUE_HH
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace workrave::utils
+{
+  //! Fixed-capacity queue with many producers and a single consumer.
+  /*!
+   *  Producers never take a lock: they claim a slot with a compare-and-swap
+   *  on the write position and mark it as filled afterwards. All storage is
+   *  allocated up front; push() fails when the queue is full.
+   */
+  template<typename T, std::size_t Capacity>
+  class MpscQueue
+  {
+    static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+  public:
+    static constexpr std::size_t capacity = Capacity;
+
+    MpscQueue()
+    {
+      for (std::size_t i = 0; i < Capacity; i++)
+        {
+          cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    //! Adds an entry. Safe to call from any thread. Returns false if the queue is full.
+    bool push(T &&value)
+    {
+      uint64_t pos = write_pos.load(std::memory_order_relaxed);
+      Cell *cell = nullptr;
+      for (;;)
+        {
+          cell = &cells[pos & (Capacity - 1)];
+          uint64_t seq = cell->sequence.load(std::memory_order_acquire);
+          auto diff = static_cast<int64_t>(seq - pos);
+          if (diff == 0)
+            {
+              if (write_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                  break;
+                }
+            }
+          else if (diff < 0)
+            {
+              return false;
+            }
+          else
+            {
+              pos = write_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+      cell->value = std::move(value);
+      cell->sequence.store(pos + 1, std::memory_order_release);
+      return true;
+    }
+
+    //! Removes the oldest entry. Must only be called from the consumer thread.
+    bool pop(T &value)
+    {
+      Cell &cell = cells[read_pos & (Capacity - 1)];
+      uint64_t seq = cell.sequence.load(std::memory_order_acquire);
+      if (seq != read_pos + 1)
+        {
+          return false;
+        }
+
+      value = std::move(cell.value);
+      cell.sequence.store(read_pos + Capacity, std::memory_order_release);
+      read_pos++;
+      return true;
+    }
+
+  private:
+    struct Cell
+    {
+      //! Equals the position when the cell is free, the position + 1 when it is filled.
+      std::atomic<uint64_t> sequence{0};
+      T value{};
+    };
+
+    std::array<Cell, Capacity> cells;
+    alignas(64) std::atomic<uint64_t> write_pos{0};
+    alignas(64) uint64_t read_pos{0};
+  };
+} // namespace workrave::utils
+
+#endif // WORKRAVE_UTILS_MPSCQUEUE_HH
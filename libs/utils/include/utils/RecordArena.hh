@@ -0,0 +1,89 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef WORKRAVE_UTILS_RECORDARENA_HH
+#define WORKRAVE_UTILS_RECORDARENA_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace workrave::utils
+{
+  //! Sorted set of small integer records stored in one arena.
+  /*!
+   *  Every record has a 32 bit key and a fixed number of 64 bit fields. The
+   *  index holds one fixed-size entry per record, sorted by key. The fields
+   *  of all records are stored in a single byte array as zigzag varints;
+   *  fields that are zero take no space at all. Replacing a record appends
+   *  the new encoding and leaves the old one behind until the arena is
+   *  compacted.
+   */
+  class RecordArena
+  {
+  public:
+    static constexpr int MAX_FIELDS = 64;
+
+    explicit RecordArena(int num_fields);
+
+    //! Adds a record, or replaces the record with the same key.
+    void put(int32_t key, const int64_t *fields);
+
+    void clear();
+
+    std::size_t size() const;
+    bool empty() const;
+    int get_num_fields() const;
+
+    //! Returns the index of the first record with a key not less than key.
+    std::size_t lower_bound(int32_t key) const;
+
+    int32_t get_key(std::size_t index) const;
+    int64_t get_field(std::size_t index, int field) const;
+    void get_fields(std::size_t index, int64_t *fields) const;
+
+    //! Returns the number of bytes allocated for the records.
+    std::size_t get_memory_usage() const;
+
+    //! Removes replaced records and releases unused capacity.
+    void shrink_to_fit();
+
+  private:
+    struct Entry
+    {
+      int32_t key;
+      uint32_t offset;
+
+      //! Bit i is set if field i is not zero.
+      uint64_t present;
+    };
+
+    std::size_t encode(const int64_t *fields, uint64_t &present);
+    std::size_t get_encoded_size(const Entry &entry) const;
+    void compact();
+
+  private:
+    int num_fields;
+    std::vector<Entry> index;
+    std::vector<uint8_t> data;
+
+    //! Bytes of data used by replaced records.
+    std::size_t garbage{0};
+  };
+} // namespace workrave::utils
+
+#endif // WORKRAVE_UTILS_RECORDARENA_HH
@@ -0,0 +1,133 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef WORKRAVE_UTILS_RINGBUFFER_HH
+#define WORKRAVE_UTILS_RINGBUFFER_HH
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace workrave::utils
+{
+  //! Fixed-capacity ring buffer that overwrites its oldest entries.
+  /*!
+   *  All storage is allocated up front. There is a single writer; readers
+   *  never block the writer. Every entry is identified by a sequence number
+   *  that increases by one per entry. The most recent Capacity - 1 entries
+   *  can be read; the remaining slot is the one the writer fills next. A
+   *  reader that falls behind loses the overwritten entries; read() reports
+   *  this instead of returning a torn copy.
+   */
+  template<typename T, std::size_t Capacity>
+  class RingBuffer
+  {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "Entries are copied while the writer may be running");
+
+  public:
+    static constexpr std::size_t capacity = Capacity;
+
+    //! Returns the slot for the next entry. It becomes visible to readers after publish().
+    T &next()
+    {
+      return entries[head.load(std::memory_order_relaxed) & (Capacity - 1)];
+    }
+
+    //! Makes the entry returned by next() visible to readers.
+    void publish()
+    {
+      head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    void push(const T &entry)
+    {
+      next() = entry;
+      publish();
+    }
+
+    //! Returns the sequence number of the next entry to be written.
+    uint64_t get_head() const
+    {
+      return head.load(std::memory_order_acquire);
+    }
+
+    //! Returns the sequence number of the oldest entry still available.
+    uint64_t get_tail() const
+    {
+      return tail_of(get_head());
+    }
+
+    bool empty() const
+    {
+      return get_head() == 0;
+    }
+
+    //! Copies the entry with sequence number seq. Returns false if it has been overwritten or not written yet.
+    bool read(uint64_t seq, T &entry) const
+    {
+      uint64_t h = get_head();
+      if (seq >= h || h - seq >= Capacity)
+        {
+          return false;
+        }
+
+      entry = entries[seq & (Capacity - 1)];
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      // The writer may have started overwriting the slot while it was copied.
+      return head.load(std::memory_order_relaxed) - seq < Capacity;
+    }
+
+    //! Calls func(seq, entry) for every available entry from seq onwards. Returns the sequence number to continue from.
+    template<typename Func>
+    uint64_t for_each(uint64_t seq, Func func) const
+    {
+      uint64_t h = get_head();
+      uint64_t tail = tail_of(h);
+
+      for (seq = seq < tail ? tail : seq; seq < h; seq++)
+        {
+          T entry;
+          if (read(seq, entry))
+            {
+              func(seq, entry);
+            }
+        }
+      return h;
+    }
+
+    void clear()
+    {
+      head.store(0, std::memory_order_release);
+    }
+
+  private:
+    static uint64_t tail_of(uint64_t h)
+    {
+      return h >= Capacity ? h - Capacity + 1 : 0;
+    }
+
+  private:
+    std::array<T, Capacity> entries{};
+    std::atomic<uint64_t> head{0};
+  };
+} // namespace workrave::utils
+
+#endif // WORKRAVE_UTILS_RINGBUFFER_HH
@@ -0,0 +1,330 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef WORKRAVE_UTILS_SIGNAL_HH
+#define WORKRAVE_UTILS_SIGNAL_HH
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <boost/container/small_vector.hpp>
+
+namespace workrave::utils
+{
+  namespace detail
+  {
+    class SignalBase
+    {
+    public:
+      virtual ~SignalBase() = default;
+      virtual void disconnect(uint64_t generation) = 0;
+      virtual bool connected(uint64_t generation) const = 0;
+    };
+  } // namespace detail
+
+  //! Handle to a slot connected to a Signal.
+  /*!
+   *  A connection stays safe to use after the slot was disconnected or the
+   *  signal was destroyed; it then simply does nothing.
+   */
+  class Connection
+  {
+  public:
+    Connection() = default;
+
+    Connection(std::weak_ptr<detail::SignalBase *> signal, uint64_t generation)
+      : signal(std::move(signal))
+      , generation(generation)
+    {
+    }
+
+    void disconnect() const
+    {
+      if (auto s = signal.lock())
+        {
+          (*s)->disconnect(generation);
+        }
+    }
+
+    bool connected() const
+    {
+      auto s = signal.lock();
+      return s && (*s)->connected(generation);
+    }
+
+  private:
+    std::weak_ptr<detail::SignalBase *> signal;
+    uint64_t generation{0};
+  };
+
+  template<typename Signature>
+  class Signal;
+
+  //! Single-threaded signal with the interface of boost::signals2::signal used in Workrave.
+  /*!
+   *  Emission walks the slots in place: there is no lock and no copy of
+   *  the slot list. Slots are called in the order in which they were
+   *  connected. Slots connected during an emission are not called until
+   *  the next one. Slots disconnected during an emission are skipped and
+   *  removed once the emission is done.
+   *
+   *  Every connect gets a new generation number, so a Connection can
+   *  never disconnect a slot other than its own.
+   *
+   *  The signal must only be used from one thread, and is neither
+   *  copyable nor movable.
+   */
+  template<typename R, typename... Args>
+  class Signal<R(Args...)> : private detail::SignalBase
+  {
+  public:
+    using result_type = std::conditional_t<std::is_void_v<R>, void, std::optional<R>>;
+
+    //! A function to connect, optionally tracking the lifetime of an object.
+    class slot_type
+    {
+    public:
+      template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, slot_type>>>
+      slot_type(F &&func)
+        : func(std::forward<F>(func))
+      {
+      }
+
+      //! The slot is disconnected automatically once the tracked object is gone.
+      slot_type &track_foreign(const std::weak_ptr<void> &tracked)
+      {
+        this->tracked = tracked;
+        tracking = true;
+        return *this;
+      }
+
+    private:
+      friend class Signal;
+
+      std::function<R(Args...)> func;
+      std::weak_ptr<void> tracked;
+      bool tracking{false};
+    };
+
+    Signal() = default;
+    Signal(const Signal &) = delete;
+    Signal &operator=(const Signal &) = delete;
+
+    ~Signal() override = default;
+
+    Connection connect(const slot_type &slot)
+    {
+      // Do not move the slots while one of them may be running.
+      Entry &entry = emit_depth == 0 ? slots.emplace_back() : pending.emplace_back();
+      entry.func = slot.func;
+      entry.tracked = slot.tracked;
+      entry.tracking = slot.tracking;
+      entry.generation = ++last_generation;
+
+      if (!self)
+        {
+          self = std::make_shared<detail::SignalBase *>(static_cast<detail::SignalBase *>(this));
+        }
+      return Connection(self, entry.generation);
+    }
+
+    template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, slot_type>>>
+    Connection connect(F &&func)
+    {
+      return connect(slot_type(std::forward<F>(func)));
+    }
+
+    result_type operator()(Args... args)
+    {
+      std::conditional_t<std::is_void_v<R>, bool, std::optional<R>> result{};
+
+      emit_depth++;
+      std::size_t count = slots.size();
+      for (std::size_t i = 0; i < count; i++)
+        {
+          Entry &entry = slots[i];
+          if (entry.generation == 0)
+            {
+              continue;
+            }
+
+          if (entry.tracking)
+            {
+              // Keep the tracked object alive while its slot runs.
+              std::shared_ptr<void> lock = entry.tracked.lock();
+              if (!lock)
+                {
+                  release(i);
+                  continue;
+                }
+              invoke(entry.func, result, args...);
+            }
+          else
+            {
+              invoke(entry.func, result, args...);
+            }
+        }
+      emit_depth--;
+
+      if (emit_depth == 0 && (released || !pending.empty()))
+        {
+          compact();
+        }
+
+      if constexpr (!std::is_void_v<R>)
+        {
+          return result;
+        }
+    }
+
+    bool empty() const
+    {
+      return num_slots() == 0;
+    }
+
+    std::size_t num_slots() const
+    {
+      std::size_t count = 0;
+      for (const auto *list: {&slots, &pending})
+        {
+          for (const Entry &entry: *list)
+            {
+              if (entry.generation != 0 && (!entry.tracking || !entry.tracked.expired()))
+                {
+                  count++;
+                }
+            }
+        }
+      return count;
+    }
+
+    void disconnect_all_slots()
+    {
+      for (std::size_t i = 0; i < slots.size(); i++)
+        {
+          release(i);
+        }
+      pending.clear();
+      if (emit_depth == 0)
+        {
+          compact();
+        }
+    }
+
+  private:
+    struct Entry
+    {
+      std::function<R(Args...)> func;
+      std::weak_ptr<void> tracked;
+
+      //! Generation of the connection, 0 once disconnected.
+      uint64_t generation{0};
+      bool tracking{false};
+    };
+
+    template<typename Result>
+    static void invoke(std::function<R(Args...)> &func, Result &result, Args &...args)
+    {
+      if constexpr (std::is_void_v<R>)
+        {
+          (void)result;
+          func(args...);
+        }
+      else
+        {
+          result = func(args...);
+        }
+    }
+
+    //! Marks a slot as disconnected. The function may be running, so it is destroyed later.
+    void release(std::size_t index)
+    {
+      slots[index].generation = 0;
+      released = true;
+    }
+
+    //! Removes all disconnected slots and adds the ones connected during emission.
+    void compact()
+    {
+      slots.erase(std::remove_if(slots.begin(), slots.end(), [](const Entry &entry) { return entry.generation == 0; }), slots.end());
+      for (Entry &entry: pending)
+        {
+          if (entry.generation != 0)
+            {
+              slots.push_back(std::move(entry));
+            }
+        }
+      pending.clear();
+      released = false;
+    }
+
+    const Entry *find(uint64_t generation) const
+    {
+      for (const auto *list: {&slots, &pending})
+        {
+          for (const Entry &entry: *list)
+            {
+              if (entry.generation == generation)
+                {
+                  return &entry;
+                }
+            }
+        }
+      return nullptr;
+    }
+
+    void disconnect(uint64_t generation) override
+    {
+      auto *entry = const_cast<Entry *>(generation != 0 ? find(generation) : nullptr);
+      if (entry != nullptr)
+        {
+          entry->generation = 0;
+          released = true;
+          if (emit_depth == 0)
+            {
+              compact();
+            }
+        }
+    }
+
+    bool connected(uint64_t generation) const override
+    {
+      return generation != 0 && find(generation) != nullptr;
+    }
+
+  private:
+    using Slots = boost::container::small_vector<Entry, 4>;
+
+    Slots slots;
+
+    //! Slots connected during an emission.
+    Slots pending;
+    uint64_t last_generation{0};
+    int emit_depth{0};
+    bool released{false};
+
+    //! Lets connections detect that the signal is gone.
+    std::shared_ptr<detail::SignalBase *> self;
+  };
+} // namespace workrave::utils
+
+#endif // WORKRAVE_UTILS_SIGNAL_HH
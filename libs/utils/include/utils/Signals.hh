@@ -25,6 +25,8 @@
 #include <boost/noncopyable.hpp>
 #include <boost/signals2.hpp>
 
+#include "utils/Signal.hh"
+
 namespace workrave::utils
 {
   class Trackable
@@ -64,20 +66,22 @@ namespace workrave::utils
     std::shared_ptr<void> const p_;
   };
 
+  // The helpers below work for both boost::signals2::signal and Signal.
+
   template<class S, typename C, typename F>
-  boost::signals2::connection connect(S &signal, const std::shared_ptr<C> &slot_owner, F func)
+  auto connect(S &signal, const std::shared_ptr<C> &slot_owner, F func)
   {
     return signal.connect(typename S::slot_type(std::move(func)).track_foreign(slot_owner));
   }
 
   template<class S, typename F>
-  boost::signals2::connection connect(S &signal, Trackable &slot_owner, F func)
+  auto connect(S &signal, Trackable &slot_owner, F func)
   {
     return signal.connect(typename S::slot_type(std::move(func)).track_foreign(slot_owner.tracker_object()));
   }
 
   template<class S, typename F>
-  boost::signals2::connection connect(S &signal, Trackable *slot_owner, F func)
+  auto connect(S &signal, Trackable *slot_owner, F func)
   {
     return signal.connect(typename S::slot_type(std::move(func)).track_foreign(slot_owner->tracker_object()));
   }
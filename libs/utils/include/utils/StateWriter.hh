@@ -0,0 +1,126 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef WORKRAVE_UTILS_STATEWRITER_HH
+#define WORKRAVE_UTILS_STATEWRITER_HH
+
+#include <string>
+#include <map>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <filesystem>
+#include <cstdint>
+
+namespace workrave::utils
+{
+  //! Persists snapshots of state files from a background thread.
+  /*!
+   *  Callers serialize a complete snapshot into memory and hand it over. Snapshots
+   *  that are byte-identical to the last one for the same file are dropped, and
+   *  snapshots queued before the writer gets to them are coalesced. Files are
+   *  replaced atomically (temporary file, fsync, rename), so a crash leaves either
+   *  the previous or the new contents on disk, never a mix.
+   *
+   *  Every file keeps its snapshot buffer, so once a file has been written, queuing
+   *  another snapshot of a similar size does not allocate on the caller's thread.
+   *
+   *  The shared instance is never destroyed, so that it can be used until the very
+   *  end. The application calls shutdown() when it exits; snapshots queued after
+   *  that are written by a new writer thread, which is not waited for.
+   */
+  class StateWriter
+  {
+  public:
+    static StateWriter &instance()
+    {
+      static auto *writer = new StateWriter();
+      return *writer;
+    }
+
+    StateWriter() = default;
+    ~StateWriter();
+
+    StateWriter(const StateWriter &) = delete;
+    StateWriter &operator=(const StateWriter &) = delete;
+
+    //! Queues a snapshot for the specified file.
+    //! Returns false if the snapshot is unchanged and will not be written.
+    bool write(const std::filesystem::path &path, const std::string &contents);
+
+    //! Blocks until all queued snapshots are on disk.
+    void flush();
+
+    //! Writes all queued snapshots and stops the writer thread.
+    void shutdown();
+
+    //! Returns the number of bytes written on the specified day (days since the epoch, UTC).
+    int64_t get_bytes_written(int64_t day) const;
+
+    //! Returns the number of bytes written today.
+    int64_t get_bytes_written_today() const;
+
+    //! Returns the number of files written.
+    int64_t get_write_count() const;
+
+    //! Returns the number of snapshots skipped because they were unchanged or superseded.
+    int64_t get_skip_count() const;
+
+    //! Replaces the contents of the specified file atomically.
+    static bool write_atomic(const std::filesystem::path &path, const std::string &contents);
+
+    //! Returns the name of the temporary file used while replacing the specified file.
+    static std::filesystem::path get_temp_path(const std::filesystem::path &path);
+
+  private:
+    void start();
+    void run();
+    void account(int64_t bytes);
+
+  private:
+    static constexpr int MAX_DAYS = 31;
+
+    mutable std::mutex mutex;
+    std::condition_variable cond;
+    std::condition_variable idle_cond;
+    std::shared_ptr<std::thread> writer_thread;
+    bool abort{false};
+    bool busy{false};
+
+    struct File
+    {
+      //! Last snapshot queued.
+      std::string contents;
+
+      //! Whether the snapshot still needs to be written.
+      bool dirty{false};
+
+      //! Whether writing the last snapshot failed.
+      bool failed{false};
+    };
+
+    //! All files ever written. Entries are never removed, so their buffers are reused.
+    std::map<std::filesystem::path, File> files;
+    int num_dirty{0};
+    std::map<int64_t, int64_t> bytes_per_day;
+    int64_t write_count{0};
+    int64_t skip_count{0};
+  };
+} // namespace workrave::utils
+
+#endif // WORKRAVE_UTILS_STATEWRITER_HH
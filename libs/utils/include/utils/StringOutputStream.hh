@@ -0,0 +1,83 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef WORKRAVE_UTILS_STRINGOUTPUTSTREAM_HH
+#define WORKRAVE_UTILS_STRINGOUTPUTSTREAM_HH
+
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+namespace workrave::utils
+{
+  //! Output stream that formats into a string that is kept between uses.
+  /*!
+   *  Unlike std::ostringstream, reset() keeps the capacity of the string and
+   *  str() returns a reference, so a stream that is reused for snapshots of
+   *  the same size stops allocating after the first one.
+   */
+  class StringOutputStream : public std::ostream
+  {
+  public:
+    StringOutputStream()
+      : std::ostream(&buffer)
+    {
+    }
+
+    StringOutputStream(const StringOutputStream &) = delete;
+    StringOutputStream &operator=(const StringOutputStream &) = delete;
+
+    //! Discards the contents, but keeps the memory.
+    void reset()
+    {
+      buffer.contents.clear();
+      clear();
+    }
+
+    const std::string &str() const
+    {
+      return buffer.contents;
+    }
+
+  private:
+    class Buffer : public std::streambuf
+    {
+    public:
+      std::string contents;
+
+    protected:
+      int_type overflow(int_type ch) override
+      {
+        if (!traits_type::eq_int_type(ch, traits_type::eof()))
+          {
+            contents.push_back(traits_type::to_char_type(ch));
+          }
+        return traits_type::not_eof(ch);
+      }
+
+      std::streamsize xsputn(const char_type *s, std::streamsize count) override
+      {
+        contents.append(s, static_cast<std::size_t>(count));
+        return count;
+      }
+    };
+
+    Buffer buffer;
+  };
+} // namespace workrave::utils
+
+#endif // WORKRAVE_UTILS_STRINGOUTPUTSTREAM_HH
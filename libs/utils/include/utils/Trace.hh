@@ -0,0 +1,391 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef WORKRAVE_UTILS_TRACE_HH
+#define WORKRAVE_UTILS_TRACE_HH
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "utils/RingBuffer.hh"
+
+namespace workrave::utils
+{
+  //! Binary trace log of the TRACE_* macros.
+  /*!
+   *  Every thread writes fixed-size records into its own ring buffer,
+   *  without locks or system calls. A record holds the address of a
+   *  static string, a monotonic timestamp and the arguments of the
+   *  message in binary form. Arguments are not formatted by the traced
+   *  thread: a background thread drains the buffers, formats the
+   *  messages and writes them to a binary file, which
+   *  libs/utils/bin/decode_trace.py turns into text. A thread that traces
+   *  faster than the writer drains loses its oldest records; the loss is
+   *  recorded in the file.
+   */
+  class Trace
+  {
+  public:
+    enum Kind : uint8_t
+    {
+      KIND_ENTER = 1,
+      KIND_EXIT,
+      KIND_RETURN,
+      KIND_MESSAGE,
+      KIND_LOG
+    };
+
+    //! Type of an argument in the data of a record.
+    enum Arg : uint8_t
+    {
+      //! u8.
+      ARG_BOOL = 1,
+      //! char.
+      ARG_CHAR,
+      //! i64.
+      ARG_INT,
+      //! u64.
+      ARG_UINT,
+      //! double.
+      ARG_DOUBLE,
+      //! const void *.
+      ARG_POINTER,
+      //! u8 length, text.
+      ARG_STRING
+    };
+
+    static constexpr std::size_t DATA_SIZE = 108;
+    static constexpr std::size_t BUFFER_SIZE = 4096;
+
+    struct Record
+    {
+      //! Nanoseconds on the steady clock.
+      int64_t time;
+
+      //! Static name of the traced method.
+      const char *name;
+
+      Kind kind;
+
+      //! Number of bytes used in data.
+      uint8_t length;
+
+      //! Arguments of the message, each an Arg followed by its value.
+      char data[DATA_SIZE];
+    };
+
+    //! Collects the arguments of a message into a record.
+    /*!
+     *  Numbers and pointers are stored as they are. Strings are copied,
+     *  including string literals: the writer may run after the caller's
+     *  character arrays went out of scope. Character arrays are copied up
+     *  to their first null character or their size, whichever comes
+     *  first. Other types are formatted with their operator<< right away.
+     *  Stream manipulators are ignored. Arguments that do not fit in the
+     *  record are dropped.
+     */
+    class Message
+    {
+    public:
+      Message()
+        : stream(&text)
+      {
+      }
+
+      Message(const Message &) = delete;
+      Message &operator=(const Message &) = delete;
+
+      template<typename T>
+      Message &operator<<(T &&value)
+      {
+        using V = std::remove_cv_t<std::remove_reference_t<T>>;
+        if constexpr (std::is_same_v<V, bool>)
+          {
+            put(ARG_BOOL, static_cast<uint8_t>(value));
+          }
+        else if constexpr (std::is_same_v<V, char> || std::is_same_v<V, signed char> || std::is_same_v<V, unsigned char>)
+          {
+            put(ARG_CHAR, static_cast<char>(value));
+          }
+        else if constexpr (std::is_integral_v<V> && std::is_signed_v<V>)
+          {
+            put(ARG_INT, static_cast<int64_t>(value));
+          }
+        else if constexpr (std::is_integral_v<V>)
+          {
+            put(ARG_UINT, static_cast<uint64_t>(value));
+          }
+        else if constexpr (std::is_floating_point_v<V>)
+          {
+            put(ARG_DOUBLE, static_cast<double>(value));
+          }
+        else if constexpr (std::is_array_v<std::remove_reference_t<T>>
+                           && std::is_same_v<std::remove_cv_t<std::remove_extent_t<std::remove_reference_t<T>>>, char>)
+          {
+            // Not necessarily null-terminated, e.g. a fixed-size magic.
+            put_string(std::string_view(value, strnlen(value, std::extent_v<std::remove_reference_t<T>>)));
+          }
+        else if constexpr (std::is_convertible_v<const V &, const char *>)
+          {
+            const char *str = value;
+            put_string(str != nullptr ? std::string_view(str) : std::string_view("(null)"));
+          }
+        else if constexpr (std::is_convertible_v<const V &, std::string_view>)
+          {
+            put_string(std::string_view(value));
+          }
+        else if constexpr (std::is_pointer_v<V> && !std::is_function_v<std::remove_pointer_t<V>>)
+          {
+            put(ARG_POINTER, static_cast<const void *>(value));
+          }
+        else
+          {
+            put_text(value);
+          }
+        return *this;
+      }
+
+      Message &operator<<(std::ostream &(*)(std::ostream &))
+      {
+        return *this;
+      }
+
+    private:
+      friend class Trace;
+
+      void reset(Record *record)
+      {
+        this->record = record;
+        record->length = 0;
+        end = DATA_SIZE;
+      }
+
+      template<typename T>
+      void put(Arg arg, T value)
+      {
+        std::size_t length = record->length;
+        if (length + 1 + sizeof(T) <= end)
+          {
+            record->data[length] = static_cast<char>(arg);
+            std::memcpy(record->data + length + 1, &value, sizeof(T));
+            record->length = static_cast<uint8_t>(length + 1 + sizeof(T));
+          }
+        else
+          {
+            end = 0;
+          }
+      }
+
+      void put_string(std::string_view str)
+      {
+        std::size_t length = record->length;
+        if (length + 2 <= end)
+          {
+            std::size_t size = std::min(str.size(), end - length - 2);
+            record->data[length] = static_cast<char>(ARG_STRING);
+            record->data[length + 1] = static_cast<char>(size);
+            std::memcpy(record->data + length + 2, str.data(), size);
+            record->length = static_cast<uint8_t>(length + 2 + size);
+            if (size < str.size())
+              {
+                end = 0;
+              }
+          }
+        else
+          {
+            end = 0;
+          }
+      }
+
+      template<typename T>
+      void put_text(const T &value)
+      {
+        std::size_t length = record->length;
+        if (length + 2 <= end)
+          {
+            text.reset(record->data + length + 2, record->data + end);
+            stream << value;
+            record->data[length] = static_cast<char>(ARG_STRING);
+            record->data[length + 1] = static_cast<char>(text.size());
+            record->length = static_cast<uint8_t>(length + 2 + text.size());
+            if (text.full())
+              {
+                end = 0;
+              }
+          }
+        else
+          {
+            end = 0;
+          }
+      }
+
+      //! Stream buffer that writes into the data of a record and drops what does not fit.
+      class TextBuffer : public std::streambuf
+      {
+      public:
+        void reset(char *begin, char *end)
+        {
+          setp(begin, end);
+          overflowed = false;
+        }
+
+        std::size_t size() const
+        {
+          return static_cast<std::size_t>(pptr() - pbase());
+        }
+
+        bool full() const
+        {
+          return overflowed;
+        }
+
+      protected:
+        int_type overflow(int_type ch) override
+        {
+          overflowed = true;
+          return traits_type::not_eof(ch);
+        }
+
+      private:
+        bool overflowed{false};
+      };
+
+      Record *record{nullptr};
+
+      //! Size of data available to arguments, 0 once an argument did not fit.
+      std::size_t end{DATA_SIZE};
+
+      TextBuffer text;
+      std::ostream stream;
+    };
+
+    //! Starts writing the trace to the specified file. Does nothing if the trace is already running.
+    static void start(const std::filesystem::path &path);
+
+    //! Starts writing the trace to a new file in the temporary directory, named after prefix.
+    static void start_default(const std::string &prefix = "");
+
+    //! Writes all pending records and stops the writer.
+    static void stop();
+
+    //! Writes all pending records.
+    static void flush();
+
+    //! Returns the file the trace is written to.
+    static std::filesystem::path get_path();
+
+    //! Formats the arguments in the data of a record.
+    static std::string format(const Record &record);
+
+    //! Traces an event without arguments.
+    static void event(Kind kind, const char *name)
+    {
+      ThreadBuffer *buffer = get_buffer();
+      Record &record = buffer->records.next();
+      record.time = now();
+      record.name = name;
+      record.kind = kind;
+      record.length = 0;
+      buffer->records.publish();
+    }
+
+    //! Starts an event with arguments. The arguments are written to the returned message and end with commit().
+    /*!
+     *  The event is timed here. The arguments may be computed by
+     *  functions that trace themselves, up to MAX_DEPTH events deep.
+     *  Deeper events are dropped and counted as lost.
+     */
+    static Message &begin(Kind kind, const char *name)
+    {
+      ThreadBuffer *buffer = get_buffer();
+      int depth = buffer->depth++;
+      if (depth >= MAX_DEPTH)
+        {
+          buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+          depth = MAX_DEPTH;
+        }
+      Pending &pending = buffer->pending[depth];
+      pending.record.time = now();
+      pending.record.name = name;
+      pending.record.kind = kind;
+      pending.message.reset(&pending.record);
+      return pending.message;
+    }
+
+    static void commit()
+    {
+      ThreadBuffer *buffer = current;
+      int depth = --buffer->depth;
+      if (depth < MAX_DEPTH)
+        {
+          buffer->records.push(buffer->pending[depth].record);
+        }
+    }
+
+    //! Number of events that can be started at the same time by one thread.
+    static constexpr int MAX_DEPTH = 4;
+
+  private:
+    //! Event whose arguments are being collected.
+    struct Pending
+    {
+      Record record{};
+      Message message;
+    };
+
+    struct ThreadBuffer
+    {
+      RingBuffer<Record, BUFFER_SIZE> records;
+
+      //! One per depth, and a last one that collects the arguments of dropped events.
+      Pending pending[MAX_DEPTH + 1];
+      int depth{0};
+
+      //! Events dropped because they were nested too deep.
+      std::atomic<uint64_t> dropped{0};
+    };
+
+    static int64_t now()
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static ThreadBuffer *get_buffer()
+    {
+      ThreadBuffer *buffer = current;
+      return buffer != nullptr ? buffer : register_thread();
+    }
+
+    static ThreadBuffer *register_thread();
+
+    struct Registry;
+
+    static inline thread_local ThreadBuffer *current = nullptr;
+  };
+} // namespace workrave::utils
+
+#endif // WORKRAVE_UTILS_TRACE_HH
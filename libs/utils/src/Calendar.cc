@@ -0,0 +1,307 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "utils/Calendar.hh"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace workrave::utils;
+
+namespace
+{
+  //! Years for which the transitions are cached. Other years ask the C library every time.
+  constexpr int FIRST_YEAR = 1970;
+  constexpr int LAST_YEAR = 2199;
+
+  //! Interval at which the C library is sampled to find transitions.
+  constexpr int64_t SAMPLE_INTERVAL = 6 * 60 * 60;
+
+  struct Offset
+  {
+    int32_t offset{0};
+    bool dst{false};
+
+    bool operator==(const Offset &other) const
+    {
+      return offset == other.offset && dst == other.dst;
+    }
+
+    bool operator!=(const Offset &other) const
+    {
+      return !(*this == other);
+    }
+  };
+
+  struct Transition
+  {
+    //! First second at which the offset applies.
+    int64_t time;
+    Offset offset;
+  };
+
+  //! Offsets of one year, UTC.
+  struct Year
+  {
+    Offset initial;
+    std::vector<Transition> transitions;
+  };
+
+  class Zone
+  {
+  public:
+    static Zone &get()
+    {
+      // Never destroyed: threads may convert times during static destruction.
+      static auto *zone = new Zone;
+      return *zone;
+    }
+
+    Offset lookup(int64_t t)
+    {
+      int year = Calendar::civil_from_days(floor_days(t)).year;
+      if (year < FIRST_YEAR || year > LAST_YEAR)
+        {
+          return query(t);
+        }
+
+      // Keeps the tables replaced by reset() alive until the lookup is done.
+      readers.fetch_add(1);
+      const Year *table = years[year - FIRST_YEAR].load();
+      if (table == nullptr)
+        {
+          table = build(year);
+        }
+
+      auto it = std::upper_bound(table->transitions.begin(), table->transitions.end(), t, [](int64_t t, const Transition &transition) {
+        return t < transition.time;
+      });
+      Offset ret = it == table->transitions.begin() ? table->initial : std::prev(it)->offset;
+      readers.fetch_sub(1, std::memory_order_release);
+      return ret;
+    }
+
+    void reset()
+    {
+      std::scoped_lock lock(mutex);
+#ifdef PLATFORM_OS_WINDOWS
+      _tzset();
+#else
+      tzset();
+#endif
+      for (auto &year: years)
+        {
+          year.store(nullptr);
+        }
+
+      // Other threads may still use the old tables.
+      std::move(tables.begin(), tables.end(), std::back_inserter(retired));
+      tables.clear();
+      reclaim(0);
+    }
+
+    static int32_t floor_days(int64_t t)
+    {
+      return static_cast<int32_t>(t >= 0 ? t / Calendar::SECONDS_PER_DAY : (t - Calendar::SECONDS_PER_DAY + 1) / Calendar::SECONDS_PER_DAY);
+    }
+
+  private:
+    const Year *build(int year)
+    {
+      std::scoped_lock lock(mutex);
+      const Year *existing = years[year - FIRST_YEAR].load(std::memory_order_acquire);
+      if (existing != nullptr)
+        {
+          return existing;
+        }
+
+      int64_t begin = Calendar::days_from_civil(year, 1, 1) * Calendar::SECONDS_PER_DAY;
+      int64_t end = Calendar::days_from_civil(year + 1, 1, 1) * Calendar::SECONDS_PER_DAY;
+
+      auto table = std::make_unique<Year>();
+      table->initial = query(begin);
+
+      Offset previous = table->initial;
+      for (int64_t t = begin; t < end;)
+        {
+          int64_t next = std::min(t + SAMPLE_INTERVAL, end);
+          Offset offset = query(next);
+          if (offset != previous)
+            {
+              // Find the first second of the new offset.
+              int64_t lo = t;
+              int64_t hi = next;
+              while (hi - lo > 1)
+                {
+                  int64_t mid = lo + (hi - lo) / 2;
+                  if (query(mid) == offset)
+                    {
+                      hi = mid;
+                    }
+                  else
+                    {
+                      lo = mid;
+                    }
+                }
+              if (hi < end)
+                {
+                  table->transitions.push_back(Transition{hi, offset});
+                }
+              previous = offset;
+            }
+          t = next;
+        }
+
+      const Year *ret = table.get();
+      tables.push_back(std::move(table));
+      years[year - FIRST_YEAR].store(ret, std::memory_order_release);
+      // The calling lookup uses no replaced table.
+      reclaim(1);
+      return ret;
+    }
+
+    //! Frees the replaced tables if no other lookup is in progress. Requires the mutex.
+    void reclaim(int own_lookups)
+    {
+      // A lookup that starts after this point only finds current tables.
+      if (!retired.empty() && readers.load() == own_lookups)
+        {
+          retired.clear();
+        }
+    }
+
+    //! Asks the C library.
+    static Offset query(int64_t t)
+    {
+      auto tt = static_cast<time_t>(t);
+      struct tm tm = {};
+#ifdef PLATFORM_OS_WINDOWS
+      if (localtime_s(&tm, &tt) != 0)
+        {
+          return Offset{};
+        }
+#else
+      if (localtime_r(&tt, &tm) == nullptr)
+        {
+          return Offset{};
+        }
+#endif
+      int64_t local = Calendar::days_from_tm(tm) * Calendar::SECONDS_PER_DAY + tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
+      return Offset{static_cast<int32_t>(local - t), tm.tm_isdst > 0};
+    }
+
+  private:
+    std::mutex mutex;
+    std::array<std::atomic<const Year *>, LAST_YEAR - FIRST_YEAR + 1> years{};
+    std::vector<std::unique_ptr<Year>> tables;
+
+    //! Tables replaced by reset() that a lookup may still use.
+    std::vector<std::unique_ptr<Year>> retired;
+
+    //! Number of lookups that may use a table.
+    std::atomic<int> readers{0};
+  };
+} // namespace
+
+int32_t
+Calendar::get_utc_offset(int64_t t)
+{
+  return Zone::get().lookup(t).offset;
+}
+
+struct tm
+Calendar::to_local(int64_t t)
+{
+  Offset offset = Zone::get().lookup(t);
+  int64_t local = t + offset.offset;
+  int32_t days = Zone::floor_days(local);
+  auto seconds = static_cast<int>(local - days * SECONDS_PER_DAY);
+  CivilDate date = civil_from_days(days);
+
+  struct tm ret = {};
+  ret.tm_year = date.year - 1900;
+  ret.tm_mon = date.month - 1;
+  ret.tm_mday = date.day;
+  ret.tm_hour = seconds / 3600;
+  ret.tm_min = seconds / 60 % 60;
+  ret.tm_sec = seconds % 60;
+  ret.tm_wday = weekday(days);
+  ret.tm_yday = days - days_from_civil(date.year, 1, 1);
+  ret.tm_isdst = offset.dst ? 1 : 0;
+  return ret;
+}
+
+int64_t
+Calendar::from_local(int32_t days, int hour, int minute, int second)
+{
+  int64_t local = days * SECONDS_PER_DAY + hour * 3600 + minute * 60 + second;
+
+  // Transitions are far more than a day apart, so the offsets a day before
+  // and after are the only candidates.
+  Zone &zone = Zone::get();
+  int32_t before = zone.lookup(local - SECONDS_PER_DAY).offset;
+  int32_t after = zone.lookup(local + SECONDS_PER_DAY).offset;
+
+  int64_t t = local - before;
+  if (zone.lookup(t).offset == before)
+    {
+      return t;
+    }
+  t = local - after;
+  if (zone.lookup(t).offset == after)
+    {
+      return t;
+    }
+
+  // In a gap: the offset from before the gap moves the time forward.
+  return local - before;
+}
+
+int64_t
+Calendar::get_next_local_time(int64_t t, int hour, int minute)
+{
+  struct tm now = to_local(t);
+  int32_t days = days_from_tm(now);
+
+  if (now.tm_hour > hour || (now.tm_hour == hour && now.tm_min >= minute))
+    {
+      days++;
+    }
+
+  int64_t ret = from_local(days, hour, minute);
+  if (ret <= t)
+    {
+      // The same local time, twice in a day.
+      ret = from_local(days + 1, hour, minute);
+    }
+  return ret;
+}
+
+void
+Calendar::reset()
+{
+  Zone::get().reset();
+}
@@ -21,9 +21,16 @@
 
 #include "Diagnostics.hh"
 
+#include <chrono>
+#include <cstdio>
 #include <time.h>
 
-bool TracedFieldBase::debug = false;
+std::atomic<bool> TracedFieldBase::debug{false};
+
+Diagnostics::Diagnostics()
+  : dropped(workrave::utils::Metrics::instance().counter("diagnostics.dropped"))
+{
+}
 
 void
 Diagnostics::enable(DiagnosticsSink *sink)
@@ -31,6 +38,8 @@ Diagnostics::enable(DiagnosticsSink *sink)
   this->sink = sink;
   enabled = true;
   TracedFieldBase::debug = true;
+
+  std::scoped_lock lock(topics_mutex);
   for (const auto &kv: topics)
     {
       kv.second();
@@ -43,28 +52,66 @@ Diagnostics::disable()
   enabled = false;
   sink = nullptr;
   TracedFieldBase::debug = false;
+
+  Event event;
+  while (queue.pop(event))
+    {
+    }
 }
 
 void
 Diagnostics::register_topic(const std::string &name, request_t func)
 {
+  std::scoped_lock lock(topics_mutex);
   topics[name] = func;
 }
 
 void
 Diagnostics::unregister_topic(const std::string &name)
 {
+  std::scoped_lock lock(topics_mutex);
   topics.erase(name);
 }
 
+void
+Diagnostics::process()
+{
+  std::vector<std::string> lines;
+  Event event;
+
+  // Do not keep up with producers forever: one queue worth of lines per call.
+  while (lines.size() < QUEUE_SIZE && queue.pop(event))
+    {
+      lines.push_back(trace_get_time(event.time) + ": " + event.text);
+    }
+
+  if (!lines.empty() && sink != nullptr)
+    {
+      sink->diagnostics_log(lines);
+    }
+}
+
+void
+Diagnostics::push(std::string &&txt)
+{
+  Event event;
+  event.time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+  event.text = std::move(txt);
+  if (!queue.push(std::move(event)))
+    {
+      dropped.add();
+    }
+}
+
 std::string
-Diagnostics::trace_get_time()
+Diagnostics::trace_get_time(int64_t time)
 {
   char logtime[128];
-  time_t ltime;
+  char millis[8];
 
-  time(&ltime);
+  auto ltime = static_cast<time_t>(time / 1000000);
   struct tm *tmlt = localtime(&ltime);
-  strftime(logtime, 128, "%d %b %Y %H:%M:%S ", tmlt);
-  return logtime;
+  strftime(logtime, 128, "%d %b %Y %H:%M:%S", tmlt);
+  snprintf(millis, sizeof(millis), ".%03d ", static_cast<int>(time % 1000000 / 1000));
+  return std::string(logtime) + millis;
 }
@@ -0,0 +1,211 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "utils/Metrics.hh"
+
+#include <algorithm>
+
+using namespace workrave::utils;
+
+void
+Histogram::record(int64_t value)
+{
+  buckets[get_bucket(value)].fetch_add(1, std::memory_order_relaxed);
+  count.fetch_add(1, std::memory_order_relaxed);
+  sum.fetch_add(value, std::memory_order_relaxed);
+
+  int64_t current = min.load(std::memory_order_relaxed);
+  while (value < current && !min.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+  current = max.load(std::memory_order_relaxed);
+  while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+uint64_t
+Histogram::get_count() const
+{
+  return count.load(std::memory_order_relaxed);
+}
+
+int64_t
+Histogram::get_sum() const
+{
+  return sum.load(std::memory_order_relaxed);
+}
+
+int64_t
+Histogram::get_min() const
+{
+  return get_count() > 0 ? min.load(std::memory_order_relaxed) : 0;
+}
+
+int64_t
+Histogram::get_max() const
+{
+  return get_count() > 0 ? max.load(std::memory_order_relaxed) : 0;
+}
+
+int64_t
+Histogram::get_percentile(double percentile) const
+{
+  uint64_t total = 0;
+  for (const auto &bucket: buckets)
+    {
+      total += bucket.load(std::memory_order_relaxed);
+    }
+  if (total == 0)
+    {
+      return 0;
+    }
+
+  auto rank = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(total));
+  uint64_t seen = 0;
+  for (int i = 0; i < NUM_BUCKETS; i++)
+    {
+      seen += buckets[i].load(std::memory_order_relaxed);
+      if (seen > rank)
+        {
+          int64_t upper = i == 0 ? 0 : i == NUM_BUCKETS - 1 ? INT64_MAX : (int64_t{1} << i) - 1;
+          return std::min(upper, get_max());
+        }
+    }
+  return get_max();
+}
+
+int
+Histogram::get_bucket(int64_t value)
+{
+  if (value <= 0)
+    {
+      return 0;
+    }
+
+  int bits = 0;
+  for (int shift = 32; shift > 0; shift /= 2)
+    {
+      if ((value >> shift) != 0)
+        {
+          value >>= shift;
+          bits += shift;
+        }
+    }
+  return bits + 1;
+}
+
+std::ostream &
+workrave::utils::operator<<(std::ostream &stream, const MetricSnapshot &metric)
+{
+  stream << metric.name << " (" << metric.kind << "): ";
+  if (metric.kind == "histogram")
+    {
+      stream << "count " << metric.count << ", sum " << metric.sum << ", min " << metric.min << ", max " << metric.max << ", p50 "
+             << metric.p50 << ", p90 " << metric.p90 << ", p99 " << metric.p99;
+    }
+  else
+    {
+      stream << metric.value;
+    }
+  return stream;
+}
+
+Metrics &
+Metrics::instance()
+{
+  static auto *metrics = new Metrics();
+  return *metrics;
+}
+
+template<typename T>
+T &
+Metrics::lookup(std::map<std::string, std::unique_ptr<T>> &metrics, const std::string &name)
+{
+  auto &metric = metrics[name];
+  if (!metric)
+    {
+      metric = std::make_unique<T>();
+    }
+  return *metric;
+}
+
+Counter &
+Metrics::counter(const std::string &name)
+{
+  std::scoped_lock lock(mutex);
+  return lookup(counters, name);
+}
+
+Gauge &
+Metrics::gauge(const std::string &name)
+{
+  std::scoped_lock lock(mutex);
+  return lookup(gauges, name);
+}
+
+Histogram &
+Metrics::histogram(const std::string &name)
+{
+  std::scoped_lock lock(mutex);
+  return lookup(histograms, name);
+}
+
+std::vector<MetricSnapshot>
+Metrics::snapshot() const
+{
+  std::vector<MetricSnapshot> ret;
+
+  std::scoped_lock lock(mutex);
+  for (const auto &[name, counter]: counters)
+    {
+      MetricSnapshot metric;
+      metric.name = name;
+      metric.kind = "counter";
+      metric.value = counter->get();
+      ret.push_back(metric);
+    }
+  for (const auto &[name, gauge]: gauges)
+    {
+      MetricSnapshot metric;
+      metric.name = name;
+      metric.kind = "gauge";
+      metric.value = gauge->get();
+      ret.push_back(metric);
+    }
+  for (const auto &[name, histogram]: histograms)
+    {
+      MetricSnapshot metric;
+      metric.name = name;
+      metric.kind = "histogram";
+      metric.count = histogram->get_count();
+      metric.sum = histogram->get_sum();
+      metric.min = histogram->get_min();
+      metric.max = histogram->get_max();
+      metric.p50 = histogram->get_percentile(50);
+      metric.p90 = histogram->get_percentile(90);
+      metric.p99 = histogram->get_percentile(99);
+      ret.push_back(metric);
+    }
+
+  std::stable_sort(ret.begin(), ret.end(), [](const MetricSnapshot &a, const MetricSnapshot &b) { return a.name < b.name; });
+  return ret;
+}
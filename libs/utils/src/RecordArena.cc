@@ -0,0 +1,253 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "utils/RecordArena.hh"
+
+#include <algorithm>
+#include <bitset>
+#include <cassert>
+
+using namespace workrave::utils;
+
+namespace
+{
+  uint64_t zigzag(int64_t value)
+  {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+  }
+
+  int64_t unzigzag(uint64_t value)
+  {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+  }
+
+  const uint8_t *skip_varint(const uint8_t *p)
+  {
+    while ((*p & 0x80) != 0)
+      {
+        p++;
+      }
+    return p + 1;
+  }
+
+  const uint8_t *read_varint(const uint8_t *p, uint64_t &value)
+  {
+    value = 0;
+    int shift = 0;
+    while ((*p & 0x80) != 0)
+      {
+        value |= static_cast<uint64_t>(*p++ & 0x7f) << shift;
+        shift += 7;
+      }
+    value |= static_cast<uint64_t>(*p++) << shift;
+    return p;
+  }
+
+  int count_bits(uint64_t bits)
+  {
+    return static_cast<int>(std::bitset<64>(bits).count());
+  }
+} // namespace
+
+RecordArena::RecordArena(int num_fields)
+  : num_fields(num_fields)
+{
+  assert(num_fields > 0 && num_fields <= MAX_FIELDS);
+}
+
+void
+RecordArena::put(int32_t key, const int64_t *fields)
+{
+  std::size_t pos = lower_bound(key);
+  bool replace = pos < index.size() && index[pos].key == key;
+
+  if (replace)
+    {
+      garbage += get_encoded_size(index[pos]);
+    }
+
+  Entry entry{};
+  entry.key = key;
+  entry.offset = static_cast<uint32_t>(encode(fields, entry.present));
+
+  if (replace)
+    {
+      index[pos] = entry;
+    }
+  else
+    {
+      index.insert(index.begin() + static_cast<std::ptrdiff_t>(pos), entry);
+    }
+
+  if (garbage > data.size() / 2)
+    {
+      compact();
+    }
+}
+
+void
+RecordArena::clear()
+{
+  index.clear();
+  data.clear();
+  garbage = 0;
+}
+
+std::size_t
+RecordArena::size() const
+{
+  return index.size();
+}
+
+bool
+RecordArena::empty() const
+{
+  return index.empty();
+}
+
+int
+RecordArena::get_num_fields() const
+{
+  return num_fields;
+}
+
+std::size_t
+RecordArena::lower_bound(int32_t key) const
+{
+  auto it = std::lower_bound(index.begin(), index.end(), key, [](const Entry &entry, int32_t k) { return entry.key < k; });
+  return static_cast<std::size_t>(it - index.begin());
+}
+
+int32_t
+RecordArena::get_key(std::size_t index) const
+{
+  return this->index[index].key;
+}
+
+int64_t
+RecordArena::get_field(std::size_t index, int field) const
+{
+  const Entry &entry = this->index[index];
+  uint64_t bit = uint64_t(1) << field;
+  if ((entry.present & bit) == 0)
+    {
+      return 0;
+    }
+
+  const uint8_t *p = data.data() + entry.offset;
+  for (int skip = count_bits(entry.present & (bit - 1)); skip > 0; skip--)
+    {
+      p = skip_varint(p);
+    }
+
+  uint64_t value = 0;
+  read_varint(p, value);
+  return unzigzag(value);
+}
+
+void
+RecordArena::get_fields(std::size_t index, int64_t *fields) const
+{
+  const Entry &entry = this->index[index];
+  const uint8_t *p = data.data() + entry.offset;
+
+  for (int i = 0; i < num_fields; i++)
+    {
+      fields[i] = 0;
+      if ((entry.present & (uint64_t(1) << i)) != 0)
+        {
+          uint64_t value = 0;
+          p = read_varint(p, value);
+          fields[i] = unzigzag(value);
+        }
+    }
+}
+
+std::size_t
+RecordArena::get_memory_usage() const
+{
+  return index.capacity() * sizeof(Entry) + data.capacity();
+}
+
+void
+RecordArena::shrink_to_fit()
+{
+  compact();
+  index.shrink_to_fit();
+  data.shrink_to_fit();
+}
+
+//! Appends the fields to the arena and returns their offset.
+std::size_t
+RecordArena::encode(const int64_t *fields, uint64_t &present)
+{
+  std::size_t offset = data.size();
+  present = 0;
+
+  for (int i = 0; i < num_fields; i++)
+    {
+      if (fields[i] == 0)
+        {
+          continue;
+        }
+
+      present |= uint64_t(1) << i;
+      uint64_t value = zigzag(fields[i]);
+      while (value >= 0x80)
+        {
+          data.push_back(static_cast<uint8_t>(value | 0x80));
+          value >>= 7;
+        }
+      data.push_back(static_cast<uint8_t>(value));
+    }
+  return offset;
+}
+
+std::size_t
+RecordArena::get_encoded_size(const Entry &entry) const
+{
+  const uint8_t *begin = data.data() + entry.offset;
+  const uint8_t *p = begin;
+  for (int n = count_bits(entry.present); n > 0; n--)
+    {
+      p = skip_varint(p);
+    }
+  return static_cast<std::size_t>(p - begin);
+}
+
+//! Rewrites the arena without the replaced records.
+void
+RecordArena::compact()
+{
+  std::vector<uint8_t> compacted;
+  compacted.reserve(data.size() - garbage);
+
+  for (Entry &entry: index)
+    {
+      std::size_t size = get_encoded_size(entry);
+      std::size_t offset = compacted.size();
+      compacted.insert(compacted.end(), data.begin() + entry.offset, data.begin() + static_cast<std::ptrdiff_t>(entry.offset + size));
+      entry.offset = static_cast<uint32_t>(offset);
+    }
+
+  data.swap(compacted);
+  garbage = 0;
+}
@@ -0,0 +1,304 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "debug.hh"
+#include "utils/StateWriter.hh"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifdef PLATFORM_OS_WINDOWS
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
+using namespace workrave::utils;
+
+namespace
+{
+  bool write_all(int fd, const char *data, size_t size)
+  {
+    while (size > 0)
+      {
+#ifdef PLATFORM_OS_WINDOWS
+        int ret = _write(fd, data, static_cast<unsigned int>(size));
+#else
+        ssize_t ret = ::write(fd, data, size);
+#endif
+        if (ret < 0)
+          {
+            if (errno == EINTR)
+              {
+                continue;
+              }
+            return false;
+          }
+        data += ret;
+        size -= ret;
+      }
+    return true;
+  }
+
+#ifndef PLATFORM_OS_WINDOWS
+  void sync_directory(const std::filesystem::path &path)
+  {
+    std::filesystem::path dir = path.parent_path();
+    if (dir.empty())
+      {
+        dir = ".";
+      }
+
+    int fd = ::open(dir.c_str(), O_RDONLY);
+    if (fd >= 0)
+      {
+        ::fsync(fd);
+        ::close(fd);
+      }
+  }
+#endif
+} // namespace
+
+StateWriter::~StateWriter()
+{
+  shutdown();
+}
+
+bool
+StateWriter::write(const std::filesystem::path &path, const std::string &contents)
+{
+  std::unique_lock<std::mutex> lock(mutex);
+
+  auto it = files.find(path);
+  if (it == files.end())
+    {
+      it = files.emplace(path, File()).first;
+    }
+  else if (!it->second.failed && it->second.contents == contents)
+    {
+      skip_count++;
+      return false;
+    }
+
+  File &file = it->second;
+  file.contents = contents;
+  file.failed = false;
+
+  if (file.dirty)
+    {
+      skip_count++;
+    }
+  else
+    {
+      file.dirty = true;
+      num_dirty++;
+    }
+
+  start();
+  cond.notify_all();
+  return true;
+}
+
+void
+StateWriter::flush()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  idle_cond.wait(lock, [this] { return (num_dirty == 0 && !busy) || !writer_thread; });
+}
+
+void
+StateWriter::shutdown()
+{
+  std::shared_ptr<std::thread> thread;
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    abort = true;
+    thread = writer_thread;
+    cond.notify_all();
+  }
+
+  // The writer drains the queue before it stops.
+  if (thread)
+    {
+      thread->join();
+    }
+
+  std::unique_lock<std::mutex> lock(mutex);
+  writer_thread.reset();
+  abort = false;
+}
+
+int64_t
+StateWriter::get_bytes_written(int64_t day) const
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  auto it = bytes_per_day.find(day);
+  return it != bytes_per_day.end() ? it->second : 0;
+}
+
+int64_t
+StateWriter::get_bytes_written_today() const
+{
+  auto now = std::chrono::system_clock::now().time_since_epoch();
+  return get_bytes_written(std::chrono::duration_cast<std::chrono::hours>(now).count() / 24);
+}
+
+int64_t
+StateWriter::get_write_count() const
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  return write_count;
+}
+
+int64_t
+StateWriter::get_skip_count() const
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  return skip_count;
+}
+
+std::filesystem::path
+StateWriter::get_temp_path(const std::filesystem::path &path)
+{
+  std::filesystem::path temp = path;
+  temp += ".tmp";
+  return temp;
+}
+
+bool
+StateWriter::write_atomic(const std::filesystem::path &path, const std::string &contents)
+{
+  TRACE_ENTER_MSG("StateWriter::write_atomic", path.u8string());
+  std::filesystem::path temp = get_temp_path(path);
+
+#ifdef PLATFORM_OS_WINDOWS
+  int fd = _wopen(temp.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+  int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+  if (fd < 0)
+    {
+      TRACE_RETURN("cannot create temporary file");
+      return false;
+    }
+
+  bool ok = write_all(fd, contents.data(), contents.size());
+
+#ifdef PLATFORM_OS_WINDOWS
+  ok = ok && (_commit(fd) == 0);
+  ok = (_close(fd) == 0) && ok;
+#else
+  ok = ok && (::fsync(fd) == 0);
+  ok = (::close(fd) == 0) && ok;
+#endif
+
+  if (ok)
+    {
+      std::error_code ec;
+      std::filesystem::rename(temp, path, ec);
+      ok = !ec;
+    }
+
+  if (!ok)
+    {
+      std::error_code ec;
+      std::filesystem::remove(temp, ec);
+      TRACE_RETURN("failed");
+      return false;
+    }
+
+#ifndef PLATFORM_OS_WINDOWS
+  sync_directory(path);
+#endif
+
+  TRACE_EXIT();
+  return true;
+}
+
+void
+StateWriter::start()
+{
+  if (!writer_thread)
+    {
+      writer_thread = std::make_shared<std::thread>([this] { run(); });
+    }
+}
+
+void
+StateWriter::account(int64_t bytes)
+{
+  auto now = std::chrono::system_clock::now().time_since_epoch();
+  int64_t day = std::chrono::duration_cast<std::chrono::hours>(now).count() / 24;
+
+  bytes_per_day[day] += bytes;
+  write_count++;
+
+  while (bytes_per_day.size() > MAX_DAYS)
+    {
+      bytes_per_day.erase(bytes_per_day.begin());
+    }
+}
+
+void
+StateWriter::run()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+
+  // Snapshot being written, so that the caller can queue the next one meanwhile.
+  std::string contents;
+
+  while (!abort || num_dirty > 0)
+    {
+      if (num_dirty == 0)
+        {
+          idle_cond.notify_all();
+          cond.wait(lock, [this] { return abort || num_dirty > 0; });
+          continue;
+        }
+
+      auto it = std::find_if(files.begin(), files.end(), [](const auto &entry) { return entry.second.dirty; });
+      File &file = it->second;
+      file.dirty = false;
+      num_dirty--;
+      contents = file.contents;
+      busy = true;
+      lock.unlock();
+
+      bool ok = write_atomic(it->first, contents);
+
+      lock.lock();
+      busy = false;
+      if (ok)
+        {
+          account(static_cast<int64_t>(contents.size()));
+        }
+      else if (!file.dirty)
+        {
+          // Force the next snapshot to be written, even if it is identical.
+          file.failed = true;
+        }
+    }
+
+  idle_cond.notify_all();
+}
@@ -0,0 +1,440 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "utils/Trace.hh"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace workrave::utils;
+
+// File format. All integers are little-endian.
+//
+// Header: "WRTRACE1", i64 steady clock (ns) at start, i64 real time (us) at start.
+// Followed by records, each starting with a u8 type:
+//   STRING: u32 id, u16 length, text
+//   THREAD: u16 thread, u16 length, text
+//   EVENT:  u8 kind, u16 thread, i64 time (ns), u32 string id, u8 length, text
+//   LOST:   u16 thread, u32 number of records
+
+namespace
+{
+  enum RecordType : uint8_t
+  {
+    RECORD_STRING = 1,
+    RECORD_THREAD,
+    RECORD_EVENT,
+    RECORD_LOST
+  };
+
+  constexpr auto DRAIN_INTERVAL = std::chrono::milliseconds(20);
+
+  class Output
+  {
+  public:
+    explicit Output(std::ofstream &out)
+      : out(out)
+    {
+    }
+
+    template<typename T>
+    void put(T value)
+    {
+      auto v = static_cast<uint64_t>(value);
+      char bytes[sizeof(T)];
+      for (std::size_t i = 0; i < sizeof(T); i++)
+        {
+          bytes[i] = static_cast<char>((v >> (8 * i)) & 0xff);
+        }
+      out.write(bytes, sizeof(T));
+    }
+
+    void put(const char *text, std::size_t length)
+    {
+      out.write(text, static_cast<std::streamsize>(length));
+    }
+
+  private:
+    std::ofstream &out;
+  };
+} // namespace
+
+struct Trace::Registry
+{
+  struct Thread
+  {
+    std::unique_ptr<ThreadBuffer> buffer{std::make_unique<ThreadBuffer>()};
+    uint16_t index{0};
+    std::string name;
+    uint64_t read_seq{0};
+    bool announced{false};
+    bool retired{false};
+  };
+
+  //! Marks the buffer of a thread as retired when the thread exits.
+  struct Holder
+  {
+    ~Holder()
+    {
+      current = nullptr;
+      exited = true;
+      if (thread)
+        {
+          Registry &r = Registry::get();
+          std::scoped_lock lock(r.mutex);
+          thread->retired = true;
+        }
+    }
+
+    std::shared_ptr<Thread> thread;
+  };
+
+  static Registry &get()
+  {
+    // Never destroyed: threads may trace during static destruction.
+    static auto *registry = new Registry;
+    return *registry;
+  }
+
+  void run()
+  {
+    std::unique_lock lock(mutex);
+    while (!stopping)
+      {
+        wakeup.wait_for(lock, DRAIN_INTERVAL);
+        lock.unlock();
+        drain();
+        lock.lock();
+      }
+  }
+
+  void drain()
+  {
+    std::scoped_lock drain_lock(drain_mutex);
+    if (!out.is_open())
+      {
+        return;
+      }
+
+    std::vector<std::shared_ptr<Thread>> snapshot;
+    std::vector<bool> retired;
+    {
+      std::scoped_lock lock(mutex);
+      snapshot = threads;
+      for (const auto &t: snapshot)
+        {
+          retired.push_back(t->retired);
+        }
+    }
+
+    Output output(out);
+    for (std::size_t i = 0; i < snapshot.size(); i++)
+      {
+        drain_thread(output, *snapshot[i]);
+      }
+    out.flush();
+
+    std::scoped_lock lock(mutex);
+    for (std::size_t i = 0; i < snapshot.size(); i++)
+      {
+        if (retired[i])
+          {
+            threads.erase(std::find(threads.begin(), threads.end(), snapshot[i]));
+          }
+      }
+  }
+
+  void drain_thread(Output &output, Thread &thread)
+  {
+    if (!thread.announced)
+      {
+        output.put(RECORD_THREAD);
+        output.put(thread.index);
+        output.put(static_cast<uint16_t>(thread.name.size()));
+        output.put(thread.name.data(), thread.name.size());
+        thread.announced = true;
+      }
+
+    uint64_t written = 0;
+    uint64_t start = thread.read_seq;
+    thread.read_seq = thread.buffer->records.for_each(start, [&](uint64_t, const Record &record) {
+      uint32_t id = get_string_id(output, record.name);
+      std::string text = format(record);
+      auto length = static_cast<uint8_t>(std::min<std::size_t>(text.size(), UINT8_MAX));
+      output.put(RECORD_EVENT);
+      output.put(record.kind);
+      output.put(thread.index);
+      output.put(record.time);
+      output.put(id);
+      output.put(length);
+      output.put(text.data(), length);
+      written++;
+    });
+
+    uint64_t lost = thread.read_seq - start - written + thread.buffer->dropped.exchange(0, std::memory_order_relaxed);
+    if (lost > 0)
+      {
+        output.put(RECORD_LOST);
+        output.put(thread.index);
+        output.put(static_cast<uint32_t>(lost));
+      }
+  }
+
+  uint32_t get_string_id(Output &output, const char *name)
+  {
+    auto [it, inserted] = strings.try_emplace(name, static_cast<uint32_t>(strings.size()));
+    if (inserted)
+      {
+        std::size_t length = std::char_traits<char>::length(name);
+        output.put(RECORD_STRING);
+        output.put(it->second);
+        output.put(static_cast<uint16_t>(length));
+        output.put(name, length);
+      }
+    return it->second;
+  }
+
+  //! Protects threads, stopping and the writer thread.
+  std::mutex mutex;
+  std::condition_variable wakeup;
+  std::vector<std::shared_ptr<Thread>> threads;
+  uint16_t next_index{0};
+  std::thread writer;
+  bool stopping{false};
+  bool exit_handler{false};
+
+  //! Protects the output. Held while draining; taken before mutex.
+  std::mutex drain_mutex;
+  std::ofstream out;
+  std::filesystem::path path;
+  std::map<const char *, uint32_t> strings;
+
+  static inline thread_local Holder holder;
+  static inline thread_local bool exited = false;
+};
+
+void
+Trace::start(const std::filesystem::path &path)
+{
+  Registry &r = Registry::get();
+  std::scoped_lock lock(r.drain_mutex, r.mutex);
+  if (r.writer.joinable())
+    {
+      return;
+    }
+
+  r.out.open(path, std::ios::binary | std::ios::trunc);
+  if (!r.out.is_open())
+    {
+      return;
+    }
+  r.path = path;
+  r.strings.clear();
+  for (auto &t: r.threads)
+    {
+      t->announced = false;
+    }
+
+  Output output(r.out);
+  output.put("WRTRACE1", 8);
+  output.put(now());
+  output.put(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+
+  r.stopping = false;
+  r.writer = std::thread([&r]() { r.run(); });
+
+  if (!r.exit_handler)
+    {
+      r.exit_handler = true;
+      std::atexit(&Trace::stop);
+    }
+}
+
+void
+Trace::start_default(const std::string &prefix)
+{
+  char stamp[64];
+  time_t t = time(nullptr);
+  strftime(stamp, sizeof(stamp), "%d%b%Y-%H%M%S", localtime(&t));
+
+  std::error_code ec;
+  std::filesystem::path dir = std::filesystem::temp_directory_path(ec);
+  start(dir / ("workrave-" + prefix + stamp + ".trace"));
+}
+
+void
+Trace::stop()
+{
+  Registry &r = Registry::get();
+  std::thread writer;
+  {
+    std::scoped_lock lock(r.mutex);
+    r.stopping = true;
+    writer = std::move(r.writer);
+  }
+  r.wakeup.notify_all();
+  if (writer.joinable())
+    {
+      writer.join();
+    }
+
+  r.drain();
+  std::scoped_lock drain_lock(r.drain_mutex);
+  r.out.close();
+}
+
+void
+Trace::flush()
+{
+  Registry::get().drain();
+}
+
+std::string
+Trace::format(const Record &record)
+{
+  std::ostringstream ss;
+  const char *data = record.data;
+  const char *end = record.data + std::min<std::size_t>(record.length, DATA_SIZE);
+  while (data < end)
+    {
+      auto arg = static_cast<Arg>(*data++);
+      auto get = [&](auto &value) {
+        if (static_cast<std::size_t>(end - data) < sizeof(value))
+          {
+            return false;
+          }
+        std::memcpy(&value, data, sizeof(value));
+        data += sizeof(value);
+        return true;
+      };
+
+      bool ok = false;
+      switch (arg)
+        {
+        case ARG_BOOL:
+          {
+            uint8_t value = 0;
+            ok = get(value);
+            ss << (value != 0);
+          }
+          break;
+        case ARG_CHAR:
+          {
+            char value = 0;
+            ok = get(value);
+            ss << value;
+          }
+          break;
+        case ARG_INT:
+          {
+            int64_t value = 0;
+            ok = get(value);
+            ss << value;
+          }
+          break;
+        case ARG_UINT:
+          {
+            uint64_t value = 0;
+            ok = get(value);
+            ss << value;
+          }
+          break;
+        case ARG_DOUBLE:
+          {
+            double value = 0;
+            ok = get(value);
+            ss << value;
+          }
+          break;
+        case ARG_POINTER:
+          {
+            const void *value = nullptr;
+            ok = get(value);
+            ss << value;
+          }
+          break;
+        case ARG_STRING:
+          {
+            uint8_t length = 0;
+            ok = get(length) && length <= end - data;
+            if (ok)
+              {
+                ss.write(data, length);
+                data += length;
+              }
+          }
+          break;
+        }
+
+      if (!ok)
+        {
+          break;
+        }
+    }
+  return ss.str();
+}
+
+std::filesystem::path
+Trace::get_path()
+{
+  Registry &r = Registry::get();
+  std::scoped_lock drain_lock(r.drain_mutex);
+  return r.path;
+}
+
+Trace::ThreadBuffer *
+Trace::register_thread()
+{
+  if (Registry::exited)
+    {
+      // Records traced by a thread that exits are dropped.
+      static thread_local auto *orphan = new ThreadBuffer;
+      current = orphan;
+      return orphan;
+    }
+
+  auto thread = std::make_shared<Registry::Thread>();
+  std::ostringstream ss;
+  ss << std::this_thread::get_id();
+  thread->name = ss.str();
+
+  Registry &r = Registry::get();
+  {
+    std::scoped_lock lock(r.mutex);
+    thread->index = r.next_index++;
+    r.threads.push_back(thread);
+  }
+
+  Registry::holder.thread = thread;
+  current = thread->buffer.get();
+  return current;
+}
@@ -21,127 +21,12 @@
 
 #ifdef TRACING
 
-#  include <sstream>
-#  include <chrono>
-
-#  include <thread>
-#  include <filesystem>
-
-#  ifdef PLATFORM_OS_WINDOWS
-#    define WIN32_LEAN_AND_MEAN
-#    include <windows.h> /* for GetFileAttributes */
-#  endif
-
 #  include "debug.hh"
-#  include "utils/TimeSource.hh"
-
-using namespace std;
-using namespace workrave::utils;
-
-std::recursive_mutex g_log_mutex;
-std::map<std::thread::id, std::ofstream *> g_log_streams;
-
-namespace
-{
-  std::string g_prefix;
-}
-
-std::string
-Debug::trace_string()
-{
-  char logtime[256];
-
-#  ifdef HAVE_TESTS
-  auto t = static_cast<time_t>(TimeSource::get_real_time_sec());
-  struct tm *tmlt = localtime(&t);
-  strftime(logtime, 256, "%d%b%Y %H:%M:%S", tmlt);
-
-  stringstream ss;
-  ss << logtime;
-
-  if (TimeSource::source)
-    {
-      auto tt = std::chrono::system_clock::now();
-      auto ms = std::chrono::duration_cast<std::chrono::microseconds>(tt.time_since_epoch()).count();
-
-      t = std::chrono::system_clock::to_time_t(tt);
-
-      tmlt = localtime(&t);
-
-      strftime(logtime, 256, "%H:%M:%S", tmlt);
-      ss << " " << logtime << "." << (ms % 1000000) / 1000;
-    }
-
-  ss << " " << std::this_thread::get_id() /* g_thread_self() */ << " ";
-  return ss.str();
-
-#  else
-
-  auto t = (time_t)TimeSource::get_real_time_sec();
-  struct tm *tmlt = localtime(&t);
-  strftime(logtime, 256, "%d%b%Y %H:%M:%S", tmlt);
-
-  stringstream ss;
-  ss << logtime << " " << std::this_thread::get_id() /* g_thread_self() */ << " ";
-  return ss.str();
-#  endif
-}
 
 void
 Debug::init(const std::string &name)
 {
-  g_prefix = name;
-}
-
-std::ofstream &
-Debug::stream()
-{
-  g_log_mutex.lock();
-  if (g_log_streams.find(std::this_thread::get_id()) == g_log_streams.end())
-    {
-      std::string debug_filename;
-
-#  if defined(WIN32) || defined(PLATFORM_OS_WINDOWS)
-      char path_buffer[MAX_PATH];
-
-      DWORD ret = GetTempPath(MAX_PATH, path_buffer);
-      if (ret > MAX_PATH || ret == 0)
-        {
-          debug_filename = "C:\\temp\\";
-        }
-      else
-        {
-          debug_filename = path_buffer;
-        }
-
-      std::filesystem::path dir(debug_filename);
-      std::filesystem::create_directory(dir);
-
-#  elif defined(PLATFORM_OS_MACOS)
-      debug_filename = "/tmp/";
-#  elif defined(PLATFORM_OS_UNIX)
-      debug_filename = "/tmp/";
-#  else
-#    error Unknown platform.
-#  endif
-
-      char logfile[128];
-      time_t ltime;
-
-      time(&ltime);
-      struct tm *tmlt = localtime(&ltime);
-      strftime(logfile, 128, "workrave-%d%b%Y-%H%M%S", tmlt);
-
-      stringstream ss;
-      ss << debug_filename << logfile << "-" << std::this_thread::get_id();
-
-      g_log_streams[std::this_thread::get_id()] = new std::ofstream();
-      g_log_streams[std::this_thread::get_id()]->open(ss.str().c_str(), std::ios::app);
-    }
-
-  std::ofstream *ret = g_log_streams[std::this_thread::get_id()];
-  g_log_mutex.unlock();
-  return *ret;
+  workrave::utils::Trace::start_default(name);
 }
 
 #endif
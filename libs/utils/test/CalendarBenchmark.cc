@@ -0,0 +1,132 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils/Calendar.hh"
+
+using namespace workrave::utils;
+
+namespace
+{
+  constexpr int64_t START = 1767225600; // 2026-01-01 00:00 UTC
+  constexpr int64_t STEP = 61;
+
+  struct tm libc_localtime(int64_t t)
+  {
+    auto tt = static_cast<time_t>(t);
+    struct tm ret = {};
+#ifdef PLATFORM_OS_WINDOWS
+    localtime_s(&ret, &tt);
+#else
+    localtime_r(&tt, &ret);
+#endif
+    return ret;
+  }
+
+  //! The former DayTimePred::get_next(), based on localtime_r() and mktime().
+  int64_t legacy_get_next(int64_t last_time, int hour, int minute)
+  {
+    auto t = static_cast<time_t>(last_time);
+    struct tm ret = libc_localtime(last_time);
+    ret.tm_hour = hour;
+    ret.tm_min = minute;
+    ret.tm_sec = 0;
+    ret.tm_isdst = -1;
+
+    time_t next = mktime(&ret);
+    if (next <= t)
+      {
+        ret.tm_mday++;
+        ret.tm_isdst = -1;
+        next = mktime(&ret);
+      }
+    return next;
+  }
+
+  template<typename Func>
+  void run(const std::string &name, int num_threads, int iterations, Func func)
+  {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    std::vector<int64_t> sums(num_threads);
+    for (int t = 0; t < num_threads; t++)
+      {
+        threads.emplace_back([&, t]() {
+          int64_t sum = 0;
+          for (int i = 0; i < iterations; i++)
+            {
+              sum += func(START + i * STEP);
+            }
+          sums[t] = sum;
+        });
+      }
+    for (auto &thread: threads)
+      {
+        thread.join();
+      }
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::cout << name << ", " << num_threads << " threads: " << ns / iterations << " ns/call (" << sums[0] % 10 << ")" << std::endl;
+  }
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+  int iterations = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+#ifdef PLATFORM_OS_WINDOWS
+  _putenv_s("TZ", "CET-1CEST,M3.5.0,M10.5.0/3");
+#else
+  setenv("TZ", "Europe/Amsterdam", 1);
+#endif
+  Calendar::reset();
+
+  for (int num_threads: {1, 4})
+    {
+      run("localtime_r", num_threads, iterations, [](int64_t t) { return static_cast<int64_t>(libc_localtime(t).tm_hour); });
+      run("to_local", num_threads, iterations, [](int64_t t) { return static_cast<int64_t>(Calendar::to_local(t).tm_hour); });
+
+      run("mktime", num_threads, iterations, [](int64_t t) {
+        struct tm tm = {};
+        tm.tm_year = 126;
+        tm.tm_mday = 1 + static_cast<int>(t % 365);
+        tm.tm_hour = 12;
+        tm.tm_isdst = -1;
+        return static_cast<int64_t>(mktime(&tm));
+      });
+      run("from_local", num_threads, iterations, [](int64_t t) {
+        return Calendar::from_local(Calendar::days_from_civil(2026, 1, 1) + static_cast<int32_t>(t % 365), 12, 0);
+      });
+
+      run("legacy get_next", num_threads, iterations, [](int64_t t) { return legacy_get_next(t, 2, 30); });
+      run("get_next_local_time", num_threads, iterations, [](int64_t t) { return Calendar::get_next_local_time(t, 2, 30); });
+    }
+  return 0;
+}
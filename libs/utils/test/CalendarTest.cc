@@ -0,0 +1,312 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <atomic>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_MODULE "workrave-utils-calendar"
+#ifdef PLATFORM_OS_WINDOWS_NATIVE
+#  include <boost/test/unit_test.hpp>
+#else
+#  include <boost/test/included/unit_test.hpp>
+#endif
+
+#include "utils/Calendar.hh"
+
+using namespace workrave::utils;
+
+namespace
+{
+  constexpr int64_t HOUR = 3600;
+  constexpr int64_t DAY = Calendar::SECONDS_PER_DAY;
+
+  void set_tz(const char *tz)
+  {
+#ifdef PLATFORM_OS_WINDOWS
+    _putenv_s("TZ", tz != nullptr ? tz : "");
+#else
+    if (tz != nullptr)
+      {
+        setenv("TZ", tz, 1);
+      }
+    else
+      {
+        unsetenv("TZ");
+      }
+#endif
+  }
+
+  struct tm libc_localtime(int64_t t)
+  {
+    auto tt = static_cast<time_t>(t);
+    struct tm ret = {};
+#ifdef PLATFORM_OS_WINDOWS
+    localtime_s(&ret, &tt);
+#else
+    localtime_r(&tt, &ret);
+#endif
+    return ret;
+  }
+
+  //! Switches the local time zone for the duration of a test.
+  class TimeZone
+  {
+  public:
+    explicit TimeZone(const std::string &tz)
+    {
+      const char *old = getenv("TZ");
+      if (old != nullptr)
+        {
+          previous = old;
+          had_previous = true;
+        }
+      set_tz(tz.c_str());
+      Calendar::reset();
+    }
+
+    ~TimeZone()
+    {
+      set_tz(had_previous ? previous.c_str() : nullptr);
+      Calendar::reset();
+    }
+
+    TimeZone(const TimeZone &) = delete;
+    TimeZone &operator=(const TimeZone &) = delete;
+
+  private:
+    std::string previous;
+    bool had_previous{false};
+  };
+
+  int64_t utc(int year, int month, int day, int hour, int minute)
+  {
+    return Calendar::days_from_civil(year, month, day) * DAY + hour * HOUR + minute * 60;
+  }
+
+  void check_local(int64_t t, int year, int month, int day, int hour, int minute)
+  {
+    struct tm tm = Calendar::to_local(t);
+    BOOST_CHECK_EQUAL(tm.tm_year + 1900, year);
+    BOOST_CHECK_EQUAL(tm.tm_mon + 1, month);
+    BOOST_CHECK_EQUAL(tm.tm_mday, day);
+    BOOST_CHECK_EQUAL(tm.tm_hour, hour);
+    BOOST_CHECK_EQUAL(tm.tm_min, minute);
+  }
+
+  //! Compares to_local() with the C library for every step seconds in [begin, end).
+  void check_against_libc(int64_t begin, int64_t end, int64_t step)
+  {
+    for (int64_t t = begin; t < end; t += step)
+      {
+        struct tm expected = libc_localtime(t);
+        struct tm actual = Calendar::to_local(t);
+
+        BOOST_REQUIRE_EQUAL(actual.tm_year, expected.tm_year);
+        BOOST_REQUIRE_EQUAL(actual.tm_mon, expected.tm_mon);
+        BOOST_REQUIRE_EQUAL(actual.tm_mday, expected.tm_mday);
+        BOOST_REQUIRE_EQUAL(actual.tm_hour, expected.tm_hour);
+        BOOST_REQUIRE_EQUAL(actual.tm_min, expected.tm_min);
+        BOOST_REQUIRE_EQUAL(actual.tm_sec, expected.tm_sec);
+        BOOST_REQUIRE_EQUAL(actual.tm_wday, expected.tm_wday);
+        BOOST_REQUIRE_EQUAL(actual.tm_yday, expected.tm_yday);
+        BOOST_REQUIRE_EQUAL(actual.tm_isdst > 0, expected.tm_isdst > 0);
+      }
+  }
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(calendar)
+
+BOOST_AUTO_TEST_CASE(test_days_from_civil)
+{
+  BOOST_CHECK_EQUAL(Calendar::days_from_civil(1970, 1, 1), 0);
+  BOOST_CHECK_EQUAL(Calendar::days_from_civil(1969, 12, 31), -1);
+  BOOST_CHECK_EQUAL(Calendar::days_from_civil(2000, 3, 1), 11017);
+  BOOST_CHECK_EQUAL(Calendar::days_from_civil(2026, 10, 19), 20745);
+
+  for (int32_t days = -800000; days < 800000; days += 13)
+    {
+      CivilDate date = Calendar::civil_from_days(days);
+      BOOST_REQUIRE_EQUAL(Calendar::days_from_civil(date), days);
+      BOOST_REQUIRE_GE(date.day, 1);
+      BOOST_REQUIRE_LE(date.day, Calendar::days_in_month(date.year, date.month));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_weekday)
+{
+  BOOST_CHECK_EQUAL(Calendar::weekday(0), 4);
+  BOOST_CHECK_EQUAL(Calendar::weekday(-1), 3);
+  BOOST_CHECK_EQUAL(Calendar::weekday(Calendar::days_from_civil(2026, 10, 19)), 1);
+  BOOST_CHECK_EQUAL(Calendar::weekday(Calendar::days_from_civil(1900, 1, 1)), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_days_in_month)
+{
+  BOOST_CHECK_EQUAL(Calendar::days_in_month(2024, 2), 29);
+  BOOST_CHECK_EQUAL(Calendar::days_in_month(2026, 2), 28);
+  BOOST_CHECK_EQUAL(Calendar::days_in_month(1900, 2), 28);
+  BOOST_CHECK_EQUAL(Calendar::days_in_month(2000, 2), 29);
+  BOOST_CHECK_EQUAL(Calendar::days_in_month(2026, 4), 30);
+  BOOST_CHECK_EQUAL(Calendar::days_in_month(2026, 12), 31);
+}
+
+BOOST_AUTO_TEST_CASE(test_utc)
+{
+  TimeZone tz("UTC");
+
+  BOOST_CHECK_EQUAL(Calendar::get_utc_offset(utc(2026, 7, 1, 12, 0)), 0);
+  check_local(utc(2026, 3, 29, 2, 30), 2026, 3, 29, 2, 30);
+  BOOST_CHECK_EQUAL(Calendar::from_local(Calendar::days_from_civil(2026, 3, 29), 2, 30), utc(2026, 3, 29, 2, 30));
+  BOOST_CHECK_EQUAL(Calendar::get_next_local_time(utc(2026, 3, 29, 2, 30), 2, 30), utc(2026, 3, 30, 2, 30));
+  BOOST_CHECK_EQUAL(Calendar::get_next_local_time(utc(2026, 3, 29, 2, 29), 2, 30), utc(2026, 3, 29, 2, 30));
+}
+
+BOOST_AUTO_TEST_CASE(test_spring_forward)
+{
+  TimeZone tz("Europe/Amsterdam");
+
+  // 2026-03-29 02:00 CET becomes 03:00 CEST, at 01:00 UTC.
+  BOOST_CHECK_EQUAL(Calendar::get_utc_offset(utc(2026, 3, 29, 0, 59)), HOUR);
+  BOOST_CHECK_EQUAL(Calendar::get_utc_offset(utc(2026, 3, 29, 1, 0)), 2 * HOUR);
+  check_local(utc(2026, 3, 29, 0, 59), 2026, 3, 29, 1, 59);
+  check_local(utc(2026, 3, 29, 1, 0), 2026, 3, 29, 3, 0);
+
+  // 02:30 does not exist and moves forward to 03:30 CEST.
+  int32_t day = Calendar::days_from_civil(2026, 3, 29);
+  BOOST_CHECK_EQUAL(Calendar::from_local(day, 2, 30), utc(2026, 3, 29, 1, 30));
+  BOOST_CHECK_EQUAL(Calendar::from_local(day, 1, 30), utc(2026, 3, 29, 0, 30));
+  BOOST_CHECK_EQUAL(Calendar::from_local(day, 3, 30), utc(2026, 3, 29, 1, 30));
+
+  // The day before the transition is 24 hours, the day itself 23.
+  BOOST_CHECK_EQUAL(Calendar::get_next_local_time(utc(2026, 3, 27, 23, 0), 0, 0), utc(2026, 3, 28, 23, 0));
+  BOOST_CHECK_EQUAL(Calendar::get_next_local_time(utc(2026, 3, 28, 23, 0), 0, 0), utc(2026, 3, 29, 22, 0));
+
+  // A daily reset in the gap still happens once that day.
+  BOOST_CHECK_EQUAL(Calendar::get_next_local_time(utc(2026, 3, 28, 12, 0), 2, 30), utc(2026, 3, 29, 1, 30));
+  BOOST_CHECK_EQUAL(Calendar::get_next_local_time(utc(2026, 3, 29, 1, 30), 2, 30), utc(2026, 3, 30, 0, 30));
+}
+
+BOOST_AUTO_TEST_CASE(test_fall_back)
+{
+  TimeZone tz("Europe/Amsterdam");
+
+  // 2026-10-25 03:00 CEST becomes 02:00 CET, at 01:00 UTC.
+  check_local(utc(2026, 10, 25, 0, 30), 2026, 10, 25, 2, 30);
+  check_local(utc(2026, 10, 25, 1, 30), 2026, 10, 25, 2, 30);
+  BOOST_CHECK_EQUAL(Calendar::to_local(utc(2026, 10, 25, 0, 30)).tm_isdst, 1);
+  BOOST_CHECK_EQUAL(Calendar::to_local(utc(2026, 10, 25, 1, 30)).tm_isdst, 0);
+
+  // 02:30 exists twice and resolves to the first one.
+  int32_t day = Calendar::days_from_civil(2026, 10, 25);
+  BOOST_CHECK_EQUAL(Calendar::from_local(day, 2, 30), utc(2026, 10, 25, 0, 30));
+  BOOST_CHECK_EQUAL(Calendar::from_local(day, 3, 30), utc(2026, 10, 25, 2, 30));
+
+  // The day of the transition is 25 hours.
+  BOOST_CHECK_EQUAL(Calendar::get_next_local_time(utc(2026, 10, 24, 22, 0), 0, 0), utc(2026, 10, 25, 23, 0));
+
+  // The reset happens once, at the first 02:30.
+  int64_t first = Calendar::get_next_local_time(utc(2026, 10, 24, 12, 0), 2, 30);
+  BOOST_CHECK_EQUAL(first, utc(2026, 10, 25, 0, 30));
+  BOOST_CHECK_EQUAL(Calendar::get_next_local_time(first, 2, 30), utc(2026, 10, 26, 1, 30));
+  BOOST_CHECK_EQUAL(Calendar::get_next_local_time(utc(2026, 10, 25, 1, 10), 2, 30), utc(2026, 10, 26, 1, 30));
+}
+
+BOOST_AUTO_TEST_CASE(test_southern_hemisphere)
+{
+  TimeZone tz("Australia/Sydney");
+
+  // 2026-04-05 03:00 AEDT becomes 02:00 AEST; 2026-10-04 02:00 AEST becomes 03:00 AEDT.
+  BOOST_CHECK_EQUAL(Calendar::get_utc_offset(utc(2026, 1, 1, 0, 0)), 11 * HOUR);
+  BOOST_CHECK_EQUAL(Calendar::get_utc_offset(utc(2026, 7, 1, 0, 0)), 10 * HOUR);
+  check_local(utc(2025, 12, 31, 13, 0), 2026, 1, 1, 0, 0);
+
+  int32_t day = Calendar::days_from_civil(2026, 10, 4);
+  BOOST_CHECK_EQUAL(Calendar::from_local(day, 2, 30), utc(2026, 10, 3, 16, 30));
+  check_local(utc(2026, 10, 3, 16, 30), 2026, 10, 4, 3, 30);
+}
+
+BOOST_AUTO_TEST_CASE(test_against_libc)
+{
+  for (const char *zone: {"UTC", "Europe/Amsterdam", "America/New_York", "Australia/Sydney", "Asia/Kolkata"})
+    {
+      TimeZone tz(zone);
+      check_against_libc(utc(2025, 12, 1, 0, 0), utc(2027, 2, 1, 0, 0), 17 * 60 + 13);
+      check_against_libc(utc(1969, 12, 1, 0, 0), utc(1970, 2, 1, 0, 0), 3 * HOUR + 7);
+      check_against_libc(utc(2200, 1, 1, 0, 0), utc(2200, 2, 1, 0, 0), 3 * HOUR + 7);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_from_local_round_trip)
+{
+  TimeZone tz("America/New_York");
+
+  for (int64_t t = utc(2026, 1, 1, 0, 0); t < utc(2027, 1, 1, 0, 0); t += 37 * 60)
+    {
+      struct tm tm = Calendar::to_local(t);
+      int64_t back = Calendar::from_local(Calendar::days_from_tm(tm), tm.tm_hour, tm.tm_min, tm.tm_sec);
+
+      // Times in the repeated hour map to the first one.
+      BOOST_REQUIRE(back == t || back == t - HOUR);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_reset_while_converting)
+{
+  TimeZone tz("Europe/Amsterdam");
+
+  // Replaced tables are freed while other threads convert times.
+  std::atomic<bool> done{false};
+  std::atomic<int> errors{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++)
+    {
+      threads.emplace_back([&done, &errors, i]() {
+        int64_t t = utc(2026, 1, 1, 0, 0) + i * 7 * DAY;
+        while (!done.load())
+          {
+            if (Calendar::get_utc_offset(t) != (t < utc(2026, 3, 29, 1, 0) ? HOUR : 2 * HOUR))
+              {
+                errors++;
+              }
+            t = t < utc(2026, 6, 1, 0, 0) ? t + 13 * HOUR : utc(2026, 1, 1, 0, 0);
+          }
+      });
+    }
+
+  for (int i = 0; i < 500; i++)
+    {
+      Calendar::reset();
+      std::this_thread::yield();
+    }
+  done.store(true);
+
+  for (auto &thread: threads)
+    {
+      thread.join();
+    }
+  BOOST_CHECK_EQUAL(errors.load(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,152 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils/Diagnostics.hh"
+#include "utils/Metrics.hh"
+
+using namespace workrave::utils;
+
+namespace
+{
+  class Sink : public DiagnosticsSink
+  {
+  public:
+    //! Appends to a text buffer, like the debug dialog.
+    void diagnostics_log(const std::vector<std::string> &lines) override
+    {
+      for (const auto &line: lines)
+        {
+          text += line + "\n";
+        }
+      if (text.size() > 1024 * 1024)
+        {
+          text.clear();
+        }
+      count += lines.size();
+      batches++;
+    }
+
+    std::string text;
+    std::size_t count{0};
+    std::size_t batches{0};
+  };
+
+  //! The former Diagnostics::log(): the sink is called on the reporting thread, here behind a lock.
+  //! It also formatted the time stamp on the reporting thread.
+  class LegacyDiagnostics
+  {
+  public:
+    void log(const std::string &txt)
+    {
+      char logtime[128];
+      time_t ltime = time(nullptr);
+      strftime(logtime, 128, "%d %b %Y %H:%M:%S ", localtime(&ltime));
+
+      std::scoped_lock lock(mutex);
+      sink.diagnostics_log({logtime + std::string(": ") + txt});
+    }
+
+    std::mutex mutex;
+    Sink sink;
+  };
+
+  template<typename Func>
+  void run(const std::string &name, int num_threads, int iterations, Func func)
+  {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++)
+      {
+        threads.emplace_back([&]() {
+          for (int i = 0; i < iterations; i++)
+            {
+              func(i);
+            }
+        });
+      }
+    for (auto &thread: threads)
+      {
+        thread.join();
+      }
+    auto end = std::chrono::steady_clock::now();
+
+    double s = std::chrono::duration<double>(end - start).count();
+    std::cout << name << ", " << num_threads << " threads: " << static_cast<int64_t>(iterations * num_threads / s) << " reports/s"
+              << std::endl;
+  }
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+  int iterations = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+  Counter &counter = Metrics::instance().counter("benchmark.counter");
+  Histogram &histogram = Metrics::instance().histogram("benchmark.histogram");
+
+  for (int num_threads: {1, 8})
+    {
+      run("counter", num_threads, iterations, [&counter](int) { counter.add(); });
+      run("histogram", num_threads, iterations, [&histogram](int i) { histogram.record(i); });
+    }
+
+  Sink sink;
+  Diagnostics::instance().enable(&sink);
+
+  // The main loop: drains the queue while the threads report.
+  std::atomic<bool> done{false};
+  std::thread main_loop([&done]() {
+    while (!done)
+      {
+        Diagnostics::instance().process();
+        std::this_thread::yield();
+      }
+    Diagnostics::instance().process();
+  });
+
+  for (int num_threads: {1, 8})
+    {
+      run("log", num_threads, iterations / 10, [](int) { Diagnostics::instance().log("benchmark"); });
+    }
+  done = true;
+  main_loop.join();
+  Diagnostics::instance().disable();
+
+  std::cout << "log: " << sink.count << " lines in " << sink.batches << " batches, "
+            << Metrics::instance().counter("diagnostics.dropped").get() << " dropped" << std::endl;
+
+  LegacyDiagnostics legacy;
+  for (int num_threads: {1, 8})
+    {
+      run("legacy log", num_threads, iterations / 10, [&legacy](int) { legacy.log("benchmark"); });
+    }
+  return 0;
+}
@@ -0,0 +1,256 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_MODULE "workrave-utils-diagnostics"
+#ifdef PLATFORM_OS_WINDOWS_NATIVE
+#  include <boost/test/unit_test.hpp>
+#else
+#  include <boost/test/included/unit_test.hpp>
+#endif
+
+#include "utils/Diagnostics.hh"
+#include "utils/Metrics.hh"
+
+using namespace workrave::utils;
+
+namespace
+{
+  class Sink : public DiagnosticsSink
+  {
+  public:
+    void diagnostics_log(const std::vector<std::string> &lines) override
+    {
+      batches.push_back(lines);
+    }
+
+    //! Returns the logged text without the time stamps.
+    std::vector<std::string> get_text() const
+    {
+      std::vector<std::string> ret;
+      for (const auto &batch: batches)
+        {
+          for (const auto &line: batch)
+            {
+              ret.push_back(line.substr(line.find(": ") + 2));
+            }
+        }
+      return ret;
+    }
+
+    std::vector<std::vector<std::string>> batches;
+  };
+} // namespace
+
+struct Fixture
+{
+  Fixture()
+  {
+    Diagnostics::instance().enable(&sink);
+  }
+
+  ~Fixture()
+  {
+    Diagnostics::instance().disable();
+  }
+
+  Sink sink;
+};
+
+BOOST_FIXTURE_TEST_SUITE(diagnostics, Fixture)
+
+BOOST_AUTO_TEST_CASE(test_metrics_counter_gauge)
+{
+  Counter &counter = Metrics::instance().counter("test.counter");
+  counter.add();
+  counter.add(41);
+  BOOST_CHECK_EQUAL(counter.get(), 42);
+  BOOST_CHECK_EQUAL(&Metrics::instance().counter("test.counter"), &counter);
+
+  Gauge &gauge = Metrics::instance().gauge("test.gauge");
+  gauge.set(10);
+  gauge.add(-3);
+  BOOST_CHECK_EQUAL(gauge.get(), 7);
+}
+
+BOOST_AUTO_TEST_CASE(test_metrics_histogram)
+{
+  BOOST_CHECK_EQUAL(Histogram::get_bucket(-5), 0);
+  BOOST_CHECK_EQUAL(Histogram::get_bucket(0), 0);
+  BOOST_CHECK_EQUAL(Histogram::get_bucket(1), 1);
+  BOOST_CHECK_EQUAL(Histogram::get_bucket(2), 2);
+  BOOST_CHECK_EQUAL(Histogram::get_bucket(3), 2);
+  BOOST_CHECK_EQUAL(Histogram::get_bucket(1024), 11);
+  BOOST_CHECK_EQUAL(Histogram::get_bucket(INT64_MAX), 63);
+
+  Histogram &histogram = Metrics::instance().histogram("test.histogram");
+  BOOST_CHECK_EQUAL(histogram.get_percentile(50), 0);
+
+  for (int i = 1; i <= 100; i++)
+    {
+      histogram.record(i);
+    }
+
+  BOOST_CHECK_EQUAL(histogram.get_count(), 100U);
+  BOOST_CHECK_EQUAL(histogram.get_sum(), 5050);
+  BOOST_CHECK_EQUAL(histogram.get_min(), 1);
+  BOOST_CHECK_EQUAL(histogram.get_max(), 100);
+
+  // 50 falls in [32, 64), 99 in [64, 128) which is capped by the maximum.
+  BOOST_CHECK_EQUAL(histogram.get_percentile(50), 63);
+  BOOST_CHECK_EQUAL(histogram.get_percentile(99), 100);
+}
+
+BOOST_AUTO_TEST_CASE(test_metrics_snapshot)
+{
+  Metrics::instance().gauge("test.snapshot.b").set(2);
+  Metrics::instance().counter("test.snapshot.a").add(1);
+  Metrics::instance().histogram("test.snapshot.c").record(5);
+
+  std::vector<MetricSnapshot> metrics;
+  for (const auto &metric: Metrics::instance().snapshot())
+    {
+      if (metric.name.rfind("test.snapshot.", 0) == 0)
+        {
+          metrics.push_back(metric);
+        }
+    }
+
+  BOOST_REQUIRE_EQUAL(metrics.size(), 3U);
+  BOOST_CHECK_EQUAL(metrics[0].name, "test.snapshot.a");
+  BOOST_CHECK_EQUAL(metrics[0].kind, "counter");
+  BOOST_CHECK_EQUAL(metrics[0].value, 1);
+  BOOST_CHECK_EQUAL(metrics[1].kind, "gauge");
+  BOOST_CHECK_EQUAL(metrics[1].value, 2);
+  BOOST_CHECK_EQUAL(metrics[2].kind, "histogram");
+  BOOST_CHECK_EQUAL(metrics[2].count, 1U);
+  BOOST_CHECK_EQUAL(metrics[2].max, 5);
+
+  std::stringstream ss;
+  ss << metrics[0];
+  BOOST_CHECK_EQUAL(ss.str(), "test.snapshot.a (counter): 1");
+}
+
+BOOST_AUTO_TEST_CASE(test_diagnostics_batch)
+{
+  Diagnostics::instance().log("one");
+  Diagnostics::instance().report("two", 2);
+  BOOST_CHECK(sink.batches.empty());
+
+  Diagnostics::instance().process();
+  BOOST_REQUIRE_EQUAL(sink.batches.size(), 1U);
+
+  auto text = sink.get_text();
+  BOOST_REQUIRE_EQUAL(text.size(), 2U);
+  BOOST_CHECK_EQUAL(text[0], "one");
+  BOOST_CHECK_EQUAL(text[1], "two -> 2");
+
+  Diagnostics::instance().process();
+  BOOST_CHECK_EQUAL(sink.batches.size(), 1U);
+}
+
+BOOST_AUTO_TEST_CASE(test_diagnostics_disabled)
+{
+  Diagnostics::instance().disable();
+  Diagnostics::instance().log("ignored");
+  Diagnostics::instance().enable(&sink);
+  Diagnostics::instance().process();
+  BOOST_CHECK(sink.batches.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_diagnostics_traced_field)
+{
+  TracedField<int> field{"test.field", 1};
+  Diagnostics::instance().process();
+
+  field = 2;
+  field = 2;
+  field++;
+  Diagnostics::instance().process();
+
+  auto text = sink.get_text();
+  BOOST_REQUIRE_EQUAL(text.size(), 3U);
+  BOOST_CHECK_EQUAL(text[0], "test.field -> 1");
+  BOOST_CHECK_EQUAL(text[1], "test.field -> 2");
+  BOOST_CHECK_EQUAL(text[2], "test.field -> 3");
+}
+
+BOOST_AUTO_TEST_CASE(test_diagnostics_threads)
+{
+  constexpr int num_threads = 8;
+  constexpr int num_lines = static_cast<int>(Diagnostics::QUEUE_SIZE / num_threads);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++)
+    {
+      threads.emplace_back([t]() {
+        for (int i = 0; i < num_lines; i++)
+          {
+            Diagnostics::instance().log(std::to_string(t) + " " + std::to_string(i));
+          }
+      });
+    }
+  for (auto &thread: threads)
+    {
+      thread.join();
+    }
+
+  Diagnostics::instance().process();
+  auto text = sink.get_text();
+  BOOST_REQUIRE_EQUAL(text.size(), static_cast<std::size_t>(num_threads * num_lines));
+
+  std::map<int, int> next;
+  for (const auto &line: text)
+    {
+      int t = 0;
+      int i = 0;
+      std::istringstream(line) >> t >> i;
+      BOOST_CHECK_EQUAL(next[t], i);
+      next[t] = i + 1;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_diagnostics_overflow)
+{
+  Counter &dropped = Metrics::instance().counter("diagnostics.dropped");
+  int64_t before = dropped.get();
+
+  for (std::size_t i = 0; i < Diagnostics::QUEUE_SIZE + 10; i++)
+    {
+      Diagnostics::instance().log("line");
+    }
+  BOOST_CHECK_EQUAL(dropped.get() - before, 10);
+
+  Diagnostics::instance().process();
+  BOOST_CHECK_EQUAL(sink.get_text().size(), Diagnostics::QUEUE_SIZE);
+
+  // The queue is usable again.
+  Diagnostics::instance().log("after");
+  Diagnostics::instance().process();
+  BOOST_CHECK_EQUAL(sink.get_text().back(), "after");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
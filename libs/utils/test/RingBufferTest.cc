@@ -0,0 +1,170 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_MODULE "workrave-utils-ringbuffer"
+#ifdef PLATFORM_OS_WINDOWS_NATIVE
+#  include <boost/test/unit_test.hpp>
+#else
+#  include <boost/test/included/unit_test.hpp>
+#endif
+
+#include "utils/RingBuffer.hh"
+
+using namespace workrave::utils;
+
+namespace
+{
+  struct Entry
+  {
+    uint64_t seq;
+    uint64_t check;
+  };
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(ringbuffer)
+
+BOOST_AUTO_TEST_CASE(test_ringbuffer_empty)
+{
+  RingBuffer<int, 8> buffer;
+  BOOST_CHECK(buffer.empty());
+  BOOST_CHECK_EQUAL(buffer.get_head(), 0);
+  BOOST_CHECK_EQUAL(buffer.get_tail(), 0);
+
+  int value = 0;
+  BOOST_CHECK(!buffer.read(0, value));
+
+  int count = 0;
+  BOOST_CHECK_EQUAL(buffer.for_each(0, [&count](uint64_t, int) { count++; }), 0);
+  BOOST_CHECK_EQUAL(count, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_ringbuffer_push_read)
+{
+  RingBuffer<int, 8> buffer;
+  for (int i = 0; i < 5; i++)
+    {
+      buffer.push(i * 10);
+    }
+
+  BOOST_CHECK_EQUAL(buffer.get_head(), 5);
+  BOOST_CHECK_EQUAL(buffer.get_tail(), 0);
+
+  for (int i = 0; i < 5; i++)
+    {
+      int value = -1;
+      BOOST_REQUIRE(buffer.read(i, value));
+      BOOST_CHECK_EQUAL(value, i * 10);
+    }
+
+  int value = -1;
+  BOOST_CHECK(!buffer.read(5, value));
+}
+
+BOOST_AUTO_TEST_CASE(test_ringbuffer_overwrite)
+{
+  RingBuffer<int, 8> buffer;
+  for (int i = 0; i < 20; i++)
+    {
+      buffer.push(i);
+    }
+
+  BOOST_CHECK_EQUAL(buffer.get_head(), 20);
+  BOOST_CHECK_EQUAL(buffer.get_tail(), 13);
+
+  int value = -1;
+  BOOST_CHECK(!buffer.read(12, value));
+  BOOST_CHECK(buffer.read(13, value));
+  BOOST_CHECK_EQUAL(value, 13);
+
+  std::vector<int> values;
+  uint64_t next = buffer.for_each(0, [&values](uint64_t seq, int v) {
+    BOOST_CHECK_EQUAL(static_cast<int>(seq), v);
+    values.push_back(v);
+  });
+  BOOST_CHECK_EQUAL(next, 20);
+  BOOST_REQUIRE_EQUAL(values.size(), 7);
+  BOOST_CHECK_EQUAL(values.front(), 13);
+  BOOST_CHECK_EQUAL(values.back(), 19);
+}
+
+BOOST_AUTO_TEST_CASE(test_ringbuffer_resume)
+{
+  RingBuffer<int, 8> buffer;
+  uint64_t seq = 0;
+  int count = 0;
+
+  buffer.push(1);
+  buffer.push(2);
+  seq = buffer.for_each(seq, [&count](uint64_t, int) { count++; });
+  BOOST_CHECK_EQUAL(count, 2);
+
+  buffer.push(3);
+  seq = buffer.for_each(seq, [&count](uint64_t, int v) {
+    BOOST_CHECK_EQUAL(v, 3);
+    count++;
+  });
+  BOOST_CHECK_EQUAL(count, 3);
+  BOOST_CHECK_EQUAL(seq, 3);
+
+  buffer.clear();
+  BOOST_CHECK(buffer.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_ringbuffer_concurrent_reader)
+{
+  RingBuffer<Entry, 64> buffer;
+  std::atomic<bool> done{false};
+  const uint64_t count = 200000;
+
+  std::thread writer([&]() {
+    for (uint64_t i = 0; i < count; i++)
+      {
+        Entry &e = buffer.next();
+        e.seq = i;
+        e.check = i * 31 + 7;
+        buffer.publish();
+      }
+    done = true;
+  });
+
+  uint64_t seq = 0;
+  uint64_t received = 0;
+  bool consistent = true;
+  while (!done || seq < buffer.get_head())
+    {
+      seq = buffer.for_each(seq, [&](uint64_t s, const Entry &e) {
+        consistent = consistent && e.seq == s && e.check == s * 31 + 7;
+        received++;
+      });
+    }
+  writer.join();
+
+  BOOST_CHECK(consistent);
+  BOOST_CHECK(received > 0);
+  BOOST_CHECK(received <= count);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,82 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "utils/Signals.hh"
+
+using namespace workrave::utils;
+
+namespace
+{
+  int64_t counter = 0;
+
+  template<typename S>
+  void run(const std::string &name, int slots, bool tracked, int iterations)
+  {
+    S signal;
+    Trackable trackable;
+
+    for (int i = 0; i < slots; i++)
+      {
+        if (tracked)
+          {
+            connect(signal, trackable, [](int v) { counter += v; });
+          }
+        else
+          {
+            signal.connect([](int v) { counter += v; });
+          }
+      }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+      {
+        signal(1);
+      }
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+    std::cout << name << (tracked ? " tracked" : "") << ", " << slots << " slots: " << ns << " ns/emit, " << ns / slots << " ns/slot"
+              << std::endl;
+  }
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+  int iterations = argc > 1 ? std::atoi(argv[1]) : 200000;
+
+  for (bool tracked: {false, true})
+    {
+      for (int slots: {1, 8, 64})
+        {
+          run<boost::signals2::signal<void(int)>>("signals2", slots, tracked, iterations);
+          run<Signal<void(int)>>("Signal", slots, tracked, iterations);
+        }
+    }
+
+  std::cout << "(" << counter << ")" << std::endl;
+  return 0;
+}
@@ -0,0 +1,194 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_MODULE "workrave-utils-signal"
+#ifdef PLATFORM_OS_WINDOWS_NATIVE
+#  include <boost/test/unit_test.hpp>
+#else
+#  include <boost/test/included/unit_test.hpp>
+#endif
+
+#include "utils/Signals.hh"
+
+using namespace workrave::utils;
+
+BOOST_AUTO_TEST_SUITE(signals)
+
+BOOST_AUTO_TEST_CASE(test_signal_emit)
+{
+  Signal<void(int)> signal;
+  BOOST_CHECK(signal.empty());
+
+  std::vector<int> calls;
+  signal.connect([&calls](int v) { calls.push_back(v); });
+  signal.connect([&calls](int v) { calls.push_back(v * 10); });
+
+  BOOST_CHECK_EQUAL(signal.num_slots(), 2);
+  signal(3);
+
+  BOOST_REQUIRE_EQUAL(calls.size(), 2);
+  BOOST_CHECK_EQUAL(calls[0], 3);
+  BOOST_CHECK_EQUAL(calls[1], 30);
+}
+
+BOOST_AUTO_TEST_CASE(test_signal_result)
+{
+  Signal<int(int)> signal;
+  BOOST_CHECK(!signal(1).has_value());
+
+  signal.connect([](int v) { return v + 1; });
+  signal.connect([](int v) { return v + 2; });
+  BOOST_CHECK_EQUAL(*signal(1), 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_signal_disconnect)
+{
+  Signal<void()> signal;
+  int a = 0;
+  int b = 0;
+
+  Connection ca = signal.connect([&a]() { a++; });
+  Connection cb = signal.connect([&b]() { b++; });
+  BOOST_CHECK(ca.connected());
+
+  ca.disconnect();
+  BOOST_CHECK(!ca.connected());
+  BOOST_CHECK(cb.connected());
+
+  signal();
+  BOOST_CHECK_EQUAL(a, 0);
+  BOOST_CHECK_EQUAL(b, 1);
+
+  // A stale connection must not affect later slots.
+  Connection cc = signal.connect([&a]() { a++; });
+  ca.disconnect();
+  signal();
+  BOOST_CHECK_EQUAL(a, 1);
+  BOOST_CHECK(cc.connected());
+
+  signal.disconnect_all_slots();
+  BOOST_CHECK(signal.empty());
+  BOOST_CHECK(!cb.connected());
+}
+
+BOOST_AUTO_TEST_CASE(test_signal_disconnect_after_destroy)
+{
+  Connection c;
+  {
+    Signal<void()> signal;
+    c = signal.connect([]() {});
+    BOOST_CHECK(c.connected());
+  }
+  BOOST_CHECK(!c.connected());
+  c.disconnect();
+}
+
+BOOST_AUTO_TEST_CASE(test_signal_modify_during_emit)
+{
+  Signal<void()> signal;
+  std::vector<std::string> calls;
+  Connection self;
+  Connection other;
+
+  self = signal.connect([&]() {
+    calls.emplace_back("self");
+    self.disconnect();
+    other.disconnect();
+    signal.connect([&]() { calls.emplace_back("late"); });
+  });
+  other = signal.connect([&]() { calls.emplace_back("other"); });
+  signal.connect([&]() { calls.emplace_back("last"); });
+
+  signal();
+  BOOST_REQUIRE_EQUAL(calls.size(), 2);
+  BOOST_CHECK_EQUAL(calls[0], "self");
+  BOOST_CHECK_EQUAL(calls[1], "last");
+
+  calls.clear();
+  signal();
+  BOOST_REQUIRE_EQUAL(calls.size(), 2);
+  BOOST_CHECK_EQUAL(calls[0], "last");
+  BOOST_CHECK_EQUAL(calls[1], "late");
+}
+
+BOOST_AUTO_TEST_CASE(test_signal_many_slots)
+{
+  Signal<void(int &)> signal;
+  std::vector<Connection> connections;
+
+  for (int i = 0; i < 100; i++)
+    {
+      connections.push_back(signal.connect([](int &v) { v++; }));
+    }
+
+  for (int i = 0; i < 100; i += 2)
+    {
+      connections[i].disconnect();
+    }
+
+  int count = 0;
+  signal(count);
+  BOOST_CHECK_EQUAL(count, 50);
+}
+
+BOOST_AUTO_TEST_CASE(test_signal_tracking)
+{
+  Signal<void()> signal;
+  int calls = 0;
+
+  auto owner = std::make_shared<int>(0);
+  auto trackable = std::make_unique<Trackable>();
+
+  connect(signal, owner, [&calls]() { calls++; });
+  connect(signal, *trackable, [&calls]() { calls++; });
+  connect(signal, trackable.get(), [&calls]() { calls++; });
+
+  signal();
+  BOOST_CHECK_EQUAL(calls, 3);
+
+  owner.reset();
+  BOOST_CHECK_EQUAL(signal.num_slots(), 2);
+  signal();
+  BOOST_CHECK_EQUAL(calls, 5);
+
+  trackable.reset();
+  BOOST_CHECK(signal.empty());
+  signal();
+  BOOST_CHECK_EQUAL(calls, 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_signal_boost_compat)
+{
+  // The connect() helpers still accept boost signals.
+  boost::signals2::signal<void()> signal;
+  Trackable trackable;
+  int calls = 0;
+
+  connect(signal, trackable, [&calls]() { calls++; });
+  signal();
+  BOOST_CHECK_EQUAL(calls, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,223 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <chrono>
+
+#define BOOST_TEST_MODULE "workrave-utils-statewriter"
+#ifdef PLATFORM_OS_WINDOWS_NATIVE
+#  include <boost/test/unit_test.hpp>
+#else
+#  include <boost/test/included/unit_test.hpp>
+#endif
+
+#ifndef PLATFORM_OS_WINDOWS
+#  include <csignal>
+#  include <sys/types.h>
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+#include "debug.hh"
+
+#include "utils/StateWriter.hh"
+
+using namespace workrave::utils;
+
+struct Fixture
+{
+  Fixture()
+  {
+#ifdef TRACING
+    Debug::init(boost::unit_test::framework::current_test_case().p_name.get() + "-");
+#endif
+    dir = std::filesystem::temp_directory_path() / ("workrave-statewriter-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::create_directories(dir);
+  }
+
+  ~Fixture()
+  {
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+  }
+
+  static std::string read_file(const std::filesystem::path &path)
+  {
+    std::ifstream file(path.u8string(), std::ios::binary);
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+  }
+
+  static std::string make_snapshot(int generation, size_t size)
+  {
+    std::string header = "WorkRaveState " + std::to_string(generation) + "\n";
+    std::string body(size, static_cast<char>('a' + generation % 26));
+    return header + body + "\nEND\n";
+  }
+
+protected:
+  std::filesystem::path dir;
+};
+
+BOOST_FIXTURE_TEST_SUITE(s, Fixture)
+
+BOOST_AUTO_TEST_CASE(test_write_atomic)
+{
+  std::filesystem::path path = dir / "state";
+
+  BOOST_CHECK(StateWriter::write_atomic(path, "first"));
+  BOOST_CHECK_EQUAL(read_file(path), "first");
+
+  BOOST_CHECK(StateWriter::write_atomic(path, "second"));
+  BOOST_CHECK_EQUAL(read_file(path), "second");
+  BOOST_CHECK(!std::filesystem::exists(StateWriter::get_temp_path(path)));
+}
+
+BOOST_AUTO_TEST_CASE(test_write_background)
+{
+  StateWriter writer;
+  std::filesystem::path path = dir / "todaystats";
+
+  BOOST_CHECK(writer.write(path, "stats 1"));
+  writer.flush();
+  BOOST_CHECK_EQUAL(read_file(path), "stats 1");
+  BOOST_CHECK_EQUAL(writer.get_write_count(), 1);
+  BOOST_CHECK_EQUAL(writer.get_bytes_written_today(), 7);
+}
+
+BOOST_AUTO_TEST_CASE(test_write_unchanged_skipped)
+{
+  StateWriter writer;
+  std::filesystem::path path = dir / "state";
+
+  BOOST_CHECK(writer.write(path, "same"));
+  writer.flush();
+  BOOST_CHECK(!writer.write(path, "same"));
+  BOOST_CHECK(!writer.write(path, "same"));
+  writer.flush();
+
+  BOOST_CHECK_EQUAL(writer.get_write_count(), 1);
+  BOOST_CHECK_EQUAL(writer.get_skip_count(), 2);
+  BOOST_CHECK_EQUAL(writer.get_bytes_written_today(), 4);
+
+  BOOST_CHECK(writer.write(path, "different"));
+  writer.flush();
+  BOOST_CHECK_EQUAL(read_file(path), "different");
+  BOOST_CHECK_EQUAL(writer.get_write_count(), 2);
+  BOOST_CHECK_EQUAL(writer.get_bytes_written_today(), 13);
+}
+
+BOOST_AUTO_TEST_CASE(test_write_coalesced)
+{
+  StateWriter writer;
+
+  for (int i = 0; i < 1000; i++)
+    {
+      writer.write(dir / "state", make_snapshot(i, 64));
+      writer.write(dir / "idlelog.idx", std::to_string(i));
+    }
+  writer.flush();
+
+  BOOST_CHECK_EQUAL(read_file(dir / "state"), make_snapshot(999, 64));
+  BOOST_CHECK_EQUAL(read_file(dir / "idlelog.idx"), "999");
+  BOOST_CHECK_LE(writer.get_write_count(), 2000);
+  BOOST_CHECK_EQUAL(writer.get_write_count() + writer.get_skip_count(), 2000);
+}
+
+BOOST_AUTO_TEST_CASE(test_destructor_flushes)
+{
+  std::filesystem::path path = dir / "state";
+  {
+    StateWriter writer;
+    writer.write(path, "pending");
+  }
+  BOOST_CHECK_EQUAL(read_file(path), "pending");
+}
+
+BOOST_AUTO_TEST_CASE(test_shutdown)
+{
+  StateWriter writer;
+  std::filesystem::path path = dir / "state";
+
+  writer.write(path, "pending");
+  writer.shutdown();
+  BOOST_CHECK_EQUAL(read_file(path), "pending");
+
+  // A writer that was shut down starts again on the next write.
+  BOOST_CHECK(writer.write(path, "again"));
+  writer.shutdown();
+  BOOST_CHECK_EQUAL(read_file(path), "again");
+  BOOST_CHECK_EQUAL(writer.get_write_count(), 2);
+}
+
+#ifndef PLATFORM_OS_WINDOWS
+BOOST_AUTO_TEST_CASE(test_kill_during_write)
+{
+  std::filesystem::path path = dir / "state";
+  const size_t size = 4 * 1024 * 1024;
+
+  BOOST_REQUIRE(StateWriter::write_atomic(path, make_snapshot(0, size)));
+
+  for (int round = 0; round < 10; round++)
+    {
+      pid_t pid = fork();
+      BOOST_REQUIRE(pid >= 0);
+
+      if (pid == 0)
+        {
+          StateWriter writer;
+          for (int i = 1;; i++)
+            {
+              writer.write(path, make_snapshot(i, size));
+            }
+          _exit(0);
+        }
+
+      usleep(20000 + round * 15000);
+      kill(pid, SIGKILL);
+
+      int status = 0;
+      waitpid(pid, &status, 0);
+      BOOST_CHECK(WIFSIGNALED(status));
+
+      // Whatever was interrupted, the state file must be one complete snapshot.
+      std::string contents = read_file(path);
+      BOOST_REQUIRE_GT(contents.size(), 0);
+
+      std::istringstream ss(contents);
+      std::string tag;
+      int generation = -1;
+      ss >> tag >> generation;
+      BOOST_CHECK_EQUAL(tag, "WorkRaveState");
+      BOOST_CHECK_EQUAL(contents, make_snapshot(generation, size));
+
+      // A stale temporary file must not prevent the next write.
+      BOOST_CHECK(StateWriter::write_atomic(path, make_snapshot(0, size)));
+      BOOST_CHECK(!std::filesystem::exists(StateWriter::get_temp_path(path)));
+    }
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,151 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils/Trace.hh"
+
+using namespace workrave::utils;
+
+namespace
+{
+  //! The former TRACE_MSG: a global lock, a formatted time stamp and an ofstream per trace point.
+  class LegacyTrace
+  {
+  public:
+    explicit LegacyTrace(const std::filesystem::path &path)
+      : out(path)
+    {
+    }
+
+    void message(const char *name, int value)
+    {
+      std::scoped_lock lock(mutex);
+      out << time_string() << "    " << name << " " << value << std::endl;
+    }
+
+  private:
+    static std::string time_string()
+    {
+      char logtime[256];
+      time_t t = time(nullptr);
+      strftime(logtime, 256, "%d%b%Y %H:%M:%S", localtime(&t));
+      std::stringstream ss;
+      ss << logtime << " " << std::this_thread::get_id() << " ";
+      return ss.str();
+    }
+
+    std::recursive_mutex mutex;
+    std::ofstream out;
+  };
+
+  //! Times func on each thread. With batch > 0, the trace is flushed after every batch calls, outside the measured time.
+  /*!
+   *  Flushing between batches keeps the writer thread, which formats the
+   *  messages, from running during the measurement, so that only the
+   *  cost for the traced thread is measured, also on a single core.
+   */
+  template<typename Func>
+  void run(const std::string &name, int num_threads, int iterations, int batch, Func func)
+  {
+    std::mutex mutex;
+    std::chrono::nanoseconds total{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++)
+      {
+        threads.emplace_back([&]() {
+          std::chrono::nanoseconds elapsed{0};
+          auto start = std::chrono::steady_clock::now();
+          for (int i = 0; i < iterations; i++)
+            {
+              func(i);
+              if (batch > 0 && i % batch == batch - 1)
+                {
+                  elapsed += std::chrono::steady_clock::now() - start;
+                  Trace::flush();
+                  start = std::chrono::steady_clock::now();
+                }
+            }
+          elapsed += std::chrono::steady_clock::now() - start;
+
+          std::scoped_lock lock(mutex);
+          total += elapsed;
+        });
+      }
+    for (auto &thread: threads)
+      {
+        thread.join();
+      }
+
+    double ns = std::chrono::duration<double, std::nano>(total).count() / iterations / num_threads;
+    std::cout << name << ", " << num_threads << " threads: " << ns << " ns/trace" << std::endl;
+  }
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+  int iterations = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+  auto dir = std::filesystem::temp_directory_path()
+             / ("workrave-trace-benchmark-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+  std::filesystem::create_directories(dir);
+
+  Trace::start(dir / "trace");
+  LegacyTrace legacy(dir / "legacy");
+
+  int batch = static_cast<int>(Trace::BUFFER_SIZE / 2);
+  for (int num_threads: {1, 4})
+    {
+      // Every trace point reads the clock once; this is the part of the cost that cannot be avoided.
+      run("clock", num_threads, iterations, batch, [](int) {
+        volatile auto now = std::chrono::steady_clock::now();
+        (void)now;
+      });
+      run("event", num_threads, iterations, batch, [](int) { Trace::event(Trace::KIND_ENTER, "benchmark"); });
+      run("message", num_threads, iterations, batch, [](int i) {
+        Trace::begin(Trace::KIND_MESSAGE, "benchmark") << "value " << i;
+        Trace::commit();
+      });
+      run("message with string", num_threads, iterations, batch, [](int i) {
+        Trace::begin(Trace::KIND_MESSAGE, "benchmark") << "key " << std::string("timers/micro_pause/limit") << " value " << i;
+        Trace::commit();
+      });
+      run("legacy message", num_threads, iterations / 10, 0, [&legacy](int i) { legacy.message("benchmark", i); });
+    }
+
+  Trace::stop();
+  std::cout << "trace file: " << std::filesystem::file_size(dir / "trace") << " bytes" << std::endl;
+
+  std::error_code ec;
+  std::filesystem::remove_all(dir, ec);
+  return 0;
+}
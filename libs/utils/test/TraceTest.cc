@@ -0,0 +1,406 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_MODULE "workrave-utils-trace"
+#ifdef PLATFORM_OS_WINDOWS_NATIVE
+#  include <boost/test/unit_test.hpp>
+#else
+#  include <boost/test/included/unit_test.hpp>
+#endif
+
+// Test the TRACE_* macros regardless of the build configuration.
+#ifndef TRACING
+#  define TRACING
+#endif
+#include "debug.hh"
+
+#include "utils/Trace.hh"
+
+using namespace workrave::utils;
+
+namespace
+{
+  struct Event
+  {
+    int thread;
+    int kind;
+    int64_t time;
+    std::string name;
+    std::string text;
+  };
+
+  //! Decoded trace file. Mirrors libs/utils/bin/decode_trace.py.
+  struct TraceFile
+  {
+    explicit TraceFile(const std::filesystem::path &path)
+    {
+      std::ifstream file(path, std::ios::binary);
+      std::stringstream ss;
+      ss << file.rdbuf();
+      data = ss.str();
+
+      BOOST_REQUIRE_GE(data.size(), 24U);
+      BOOST_REQUIRE_EQUAL(data.substr(0, 8), "WRTRACE1");
+      pos = 24;
+
+      std::map<uint32_t, std::string> strings;
+      while (pos < data.size())
+        {
+          switch (get<uint8_t>())
+            {
+            case 1:
+              {
+                auto id = get<uint32_t>();
+                strings[id] = get_text(get<uint16_t>());
+              }
+              break;
+            case 2:
+              {
+                auto thread = get<uint16_t>();
+                threads[thread] = get_text(get<uint16_t>());
+              }
+              break;
+            case 3:
+              {
+                Event event;
+                event.kind = get<uint8_t>();
+                event.thread = get<uint16_t>();
+                event.time = get<int64_t>();
+                event.name = strings.at(get<uint32_t>());
+                event.text = get_text(get<uint8_t>());
+                events.push_back(event);
+              }
+              break;
+            case 4:
+              {
+                auto thread = get<uint16_t>();
+                lost[thread] += get<uint32_t>();
+              }
+              break;
+            default:
+              BOOST_FAIL("unknown record type");
+            }
+        }
+    }
+
+    template<typename T>
+    T get()
+    {
+      BOOST_REQUIRE_LE(pos + sizeof(T), data.size());
+      uint64_t value = 0;
+      for (std::size_t i = 0; i < sizeof(T); i++)
+        {
+          value |= static_cast<uint64_t>(static_cast<uint8_t>(data[pos + i])) << (8 * i);
+        }
+      pos += sizeof(T);
+      return static_cast<T>(value);
+    }
+
+    std::string get_text(std::size_t length)
+    {
+      BOOST_REQUIRE_LE(pos + length, data.size());
+      std::string text = data.substr(pos, length);
+      pos += length;
+      return text;
+    }
+
+    std::vector<Event> find(const std::string &name) const
+    {
+      std::vector<Event> ret;
+      for (const auto &event: events)
+        {
+          if (event.name == name)
+            {
+              ret.push_back(event);
+            }
+        }
+      return ret;
+    }
+
+    std::string data;
+    std::size_t pos{0};
+    std::map<int, std::string> threads;
+    std::map<int, uint64_t> lost;
+    std::vector<Event> events;
+  };
+
+  std::string traced_value()
+  {
+    TRACE_ENTER("traced_value");
+    TRACE_RETURN(42);
+    return "value";
+  }
+
+  std::string deep_value(int depth)
+  {
+    if (depth > 0)
+      {
+        Trace::begin(Trace::KIND_MESSAGE, "test_trace_depth") << depth << " " << deep_value(depth - 1);
+        Trace::commit();
+      }
+    return std::to_string(depth);
+  }
+
+  struct Point
+  {
+    int x;
+    int y;
+  };
+
+  std::ostream &operator<<(std::ostream &stream, const Point &p)
+  {
+    stream << "(" << p.x << "," << p.y << ")";
+    return stream;
+  }
+} // namespace
+
+struct Fixture
+{
+  Fixture()
+  {
+    if (Trace::get_path().empty())
+      {
+        path = std::filesystem::temp_directory_path()
+               / ("workrave-trace-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".trace");
+        Trace::start(path);
+      }
+  }
+
+  ~Fixture()
+  {
+    if (!path.empty())
+      {
+        Trace::stop();
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+      }
+  }
+
+  std::filesystem::path path;
+};
+
+BOOST_GLOBAL_FIXTURE(Fixture);
+
+BOOST_AUTO_TEST_SUITE(trace)
+
+BOOST_AUTO_TEST_CASE(test_trace_macros)
+{
+  {
+    TRACE_ENTER_MSG("test_trace_macros", 1 << " " << 2.5);
+    TRACE_MSG("message " << std::string("text"));
+    TRACE_MSG("nested " << traced_value());
+    TRACE_EXIT();
+  }
+
+  Trace::flush();
+  TraceFile file(Trace::get_path());
+
+  auto events = file.find("test_trace_macros");
+  BOOST_REQUIRE_EQUAL(events.size(), 4U);
+  BOOST_CHECK_EQUAL(events[0].kind, Trace::KIND_ENTER);
+  BOOST_CHECK_EQUAL(events[0].text, "1 2.5");
+  BOOST_CHECK_EQUAL(events[1].kind, Trace::KIND_MESSAGE);
+  BOOST_CHECK_EQUAL(events[1].text, "message text");
+  BOOST_CHECK_EQUAL(events[2].text, "nested value");
+  BOOST_CHECK_EQUAL(events[3].kind, Trace::KIND_EXIT);
+  BOOST_CHECK_EQUAL(events[3].text, "");
+
+  auto nested = file.find("traced_value");
+  BOOST_REQUIRE_EQUAL(nested.size(), 2U);
+  BOOST_CHECK_EQUAL(nested[0].kind, Trace::KIND_ENTER);
+  BOOST_CHECK_EQUAL(nested[1].kind, Trace::KIND_RETURN);
+  BOOST_CHECK_EQUAL(nested[1].text, "42");
+
+  // The message is timed when it starts, before the nested method is traced.
+  BOOST_CHECK_LE(events[1].time, events[2].time);
+  BOOST_CHECK_LE(events[2].time, nested[0].time);
+  for (const auto &event: events)
+    {
+      BOOST_CHECK_EQUAL(event.thread, nested[0].thread);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_trace_truncate)
+{
+  std::string text(Trace::DATA_SIZE * 2, 'x');
+  Trace::begin(Trace::KIND_MESSAGE, "test_trace_truncate") << text << " dropped";
+  Trace::commit();
+
+  Trace::flush();
+  TraceFile file(Trace::get_path());
+
+  auto events = file.find("test_trace_truncate");
+  BOOST_REQUIRE_EQUAL(events.size(), 1U);
+
+  // The string is cut off after its type and length, and the arguments after it are dropped.
+  BOOST_CHECK_EQUAL(events[0].text, text.substr(0, Trace::DATA_SIZE - 2));
+}
+
+BOOST_AUTO_TEST_CASE(test_trace_arguments)
+{
+  char buffer[16] = "buffer";
+  const char *null_text = nullptr;
+  std::string text = "string";
+  int value = 0;
+
+  Trace::begin(Trace::KIND_MESSAGE, "test_trace_arguments")
+    << true << " " << 'c' << " " << static_cast<uint8_t>('u') << " " << -12 << " " << 34U << " " << INT64_MIN << " " << 0.25;
+  Trace::commit();
+  Trace::begin(Trace::KIND_MESSAGE, "test_trace_arguments")
+    << buffer << " " << null_text << " " << text << " " << std::string_view("view") << " " << Point{1, 2} << std::endl;
+  Trace::commit();
+
+  // Changes after the call are not seen by the writer.
+  buffer[0] = 'B';
+  text[0] = 'S';
+
+  Trace::begin(Trace::KIND_MESSAGE, "test_trace_arguments") << &value;
+  Trace::commit();
+
+  // Character arrays are copied, and are not read beyond their size.
+  struct
+  {
+    const char magic[4] = {'W', 'R', 'I', 'L'};
+    const char next[4] = {'X', 'X', 'X', '\0'};
+  } unterminated;
+  {
+    const char scoped[] = "scoped";
+    Trace::begin(Trace::KIND_MESSAGE, "test_trace_arguments") << unterminated.magic << " " << scoped;
+    Trace::commit();
+  }
+
+  Trace::flush();
+  TraceFile file(Trace::get_path());
+
+  auto events = file.find("test_trace_arguments");
+  BOOST_REQUIRE_EQUAL(events.size(), 4U);
+  BOOST_CHECK_EQUAL(events[0].text, "1 c u -12 34 -9223372036854775808 0.25");
+  BOOST_CHECK_EQUAL(events[1].text, "buffer (null) string view (1,2)");
+
+  std::ostringstream ss;
+  ss << static_cast<const void *>(&value);
+  BOOST_CHECK_EQUAL(events[2].text, ss.str());
+  BOOST_CHECK_EQUAL(events[3].text, "WRIL scoped");
+}
+
+BOOST_AUTO_TEST_CASE(test_trace_depth)
+{
+  constexpr int depth = Trace::MAX_DEPTH + 2;
+  deep_value(depth);
+
+  Trace::flush();
+  TraceFile file(Trace::get_path());
+
+  // Events nested deeper than MAX_DEPTH are dropped and counted as lost;
+  // the events around them keep their own arguments.
+  auto events = file.find("test_trace_depth");
+  BOOST_REQUIRE_EQUAL(events.size(), static_cast<std::size_t>(Trace::MAX_DEPTH));
+  for (int i = 0; i < Trace::MAX_DEPTH; i++)
+    {
+      int d = depth - Trace::MAX_DEPTH + 1 + i;
+      BOOST_CHECK_EQUAL(events[i].text, std::to_string(d) + " " + std::to_string(d - 1));
+    }
+  BOOST_CHECK_EQUAL(file.lost[events[0].thread], 2U);
+}
+
+BOOST_AUTO_TEST_CASE(test_trace_threads)
+{
+  constexpr int num_threads = 4;
+  constexpr int num_events = 1000;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++)
+    {
+      threads.emplace_back([t]() {
+        for (int i = 0; i < num_events; i++)
+          {
+            Trace::begin(Trace::KIND_MESSAGE, "test_trace_threads") << t << " " << i;
+            Trace::commit();
+          }
+      });
+    }
+  for (auto &thread: threads)
+    {
+      thread.join();
+    }
+
+  Trace::flush();
+  TraceFile file(Trace::get_path());
+
+  auto events = file.find("test_trace_threads");
+  BOOST_REQUIRE_EQUAL(events.size(), static_cast<std::size_t>(num_threads * num_events));
+
+  std::map<int, int> next;
+  std::map<int, int> thread_of;
+  for (const auto &event: events)
+    {
+      int t = 0;
+      int i = 0;
+      std::istringstream(event.text) >> t >> i;
+
+      // Every thread has its own id, and its events are in order.
+      auto it = thread_of.try_emplace(t, event.thread).first;
+      BOOST_CHECK_EQUAL(it->second, event.thread);
+      BOOST_CHECK_EQUAL(next[t], i);
+      next[t] = i + 1;
+      BOOST_CHECK(file.threads.count(event.thread) == 1);
+      BOOST_CHECK(file.lost.count(event.thread) == 0);
+    }
+  BOOST_CHECK_EQUAL(thread_of.size(), static_cast<std::size_t>(num_threads));
+}
+
+BOOST_AUTO_TEST_CASE(test_trace_lost)
+{
+  constexpr int num_events = static_cast<int>(Trace::BUFFER_SIZE * 3);
+
+  std::thread thread([]() {
+    for (int i = 0; i < num_events; i++)
+      {
+        Trace::event(Trace::KIND_ENTER, "test_trace_lost");
+      }
+  });
+  thread.join();
+
+  Trace::flush();
+  TraceFile file(Trace::get_path());
+
+  auto events = file.find("test_trace_lost");
+  BOOST_REQUIRE(!events.empty());
+  int id = events[0].thread;
+
+  // The writer may have drained part of the buffer while the thread ran,
+  // but every event is either written or counted as lost.
+  BOOST_CHECK_EQUAL(events.size() + file.lost[id], static_cast<std::size_t>(num_events));
+  BOOST_CHECK_GE(events.size(), Trace::BUFFER_SIZE - 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -37,6 +37,7 @@
 #include "utils/Exception.hh"
 #include "utils/Platform.hh"
 #include "utils/Paths.hh"
+#include "utils/StateWriter.hh"
 
 #ifdef HAVE_DBUS
 #  include "GenericDBusApplet.hh"
@@ -64,6 +65,9 @@ Application::~Application()
 
   core.reset();
 
+  // Queued state would be lost when the process exits.
+  StateWriter::instance().shutdown();
+
   TRACE_EXIT();
 }
 
@@ -519,7 +523,7 @@ Application::set_prelude_progress_text(PreludeProgressText text)
 void
 Application::on_timer()
 {
-  std::string tip = get_timers_tooltip();
+  const std::string &tip = update_timers_tooltip();
 
   core->heartbeat();
 
@@ -581,29 +585,31 @@ Application::on_operation_mode_warning_timer()
     }
 }
 
-std::string
-Application::get_timers_tooltip()
+//! Rebuilds the tooltip in place, so that its memory is reused every second.
+const std::string &
+Application::update_timers_tooltip()
 {
   // FIXME: duplicate
   const char *labels[] = {_("Micro-break"), _("Rest break"), _("Daily limit")};
-  std::string tip = "";
+  std::string &tip = timers_tooltip;
+  tip.clear();
 
   OperationMode mode = core->get_operation_mode();
   switch (mode)
     {
     case OperationMode::Suspended:
-      tip = std::string(_("Mode: ")) + _("Suspended");
+      tip.append(_("Mode: ")).append(_("Suspended"));
       break;
 
     case OperationMode::Quiet:
-      tip = std::string(_("Mode: ")) + _("Quiet");
+      tip.append(_("Mode: ")).append(_("Quiet"));
       break;
 
     case OperationMode::Normal:
     default:
 #if !defined(PLATFORM_OS_WINDOWS)
       // Win32 tip is limited in length
-      tip = "Workrave";
+      tip.append("Workrave");
 #endif
       break;
     }
@@ -636,7 +642,8 @@ Application::get_timers_tooltip()
             }
 
           tip += labels[count];
-          tip += ": " + text;
+          tip += ": ";
+          tip += text;
         }
     }
 
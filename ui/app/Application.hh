@@ -77,7 +77,7 @@ public:
 #endif
 
 private:
-  auto get_timers_tooltip() -> std::string;
+  auto update_timers_tooltip() -> const std::string &;
   void on_timer();
   void init_nls();
   void init_core();
@@ -113,6 +113,7 @@ private:
   bool closewarn_shown{false};
   bool is_idle{false};
   bool taking{false};
+  std::string timers_tooltip;
 };
 
 inline auto
@@ -50,6 +50,7 @@ const string GUIConfig::CFG_KEY_MAIN_WINDOW_HEAD = "gui/main_window/head";
 
 const string GUIConfig::CFG_KEY_APPLET_FALLBACK_ENABLED = "gui/applet/fallback_enabled";
 const string GUIConfig::CFG_KEY_APPLET_ICON_ENABLED = "gui/applet/icon_enabled";
+const string GUIConfig::CFG_KEY_APPLET_LEGACY_TIMERS = "gui/applet/legacy_timers";
 
 const string GUIConfig::CFG_KEY_TIMERBOX = "gui/";
 const string GUIConfig::CFG_KEY_TIMERBOX_CYCLE_TIME = "/cycle_time";
@@ -261,3 +262,9 @@ GUIConfig::applet_icon_enabled() -> Setting<bool> &
 {
   return SettingCache::get<bool>(config, CFG_KEY_APPLET_ICON_ENABLED, true);
 }
+
+auto
+GUIConfig::applet_legacy_timers() -> Setting<bool> &
+{
+  return SettingCache::get<bool>(config, CFG_KEY_APPLET_LEGACY_TIMERS, false);
+}
@@ -29,6 +29,7 @@
 #include "ui/Text.hh"
 #include "config/IConfigurator.hh"
 
+#include "utils/TimeSource.hh"
 #include "dbus/IDBus.hh"
 #include "dbus/DBusException.hh"
 #include "DBusGUI.hh"
@@ -43,6 +44,9 @@ GenericDBusApplet::GenericDBusApplet(std::shared_ptr<IApplication> app)
   , menu_model(app->get_menu_model())
   , menu_helper(menu_model)
   , apphold(toolkit)
+  , menu_changes([this](auto func) { toolkit->create_oneshot_timer(0, func); },
+                 [this](const auto &node) { return create_menu_item(node); },
+                 [this](uint32_t version, const MenuItem &item) { send_menu_item_changed(version, item); })
 {
   control = std::make_shared<TimerBoxControl>(app, "applet", this);
 
@@ -86,6 +90,15 @@ GenericDBusApplet::set_time_bar(BreakId id,
   data[id].bar_secondary_color = (int)secondary_color;
   data[id].bar_secondary_val = secondary_val;
   data[id].bar_secondary_max = secondary_max;
+
+  TimerState &sample = timer_samples[id];
+  sample.value = value;
+  sample.primary_color = static_cast<uint32_t>(primary_color);
+  sample.primary_val = primary_val;
+  sample.primary_max = primary_max;
+  sample.secondary_color = static_cast<uint32_t>(secondary_color);
+  sample.secondary_val = secondary_val;
+  sample.secondary_max = secondary_max;
   TRACE_EXIT();
 }
 
@@ -94,13 +107,50 @@ GenericDBusApplet::update_view()
 {
   TRACE_ENTER("GenericDBusApplet::update_view");
 
-  org_workrave_AppletInterface *iface = org_workrave_AppletInterface::instance(dbus);
-  assert(iface != nullptr);
-  iface->TimersUpdated(WORKRAVE_APPLET_SERVICE_OBJ, data[BREAK_ID_MICRO_BREAK], data[BREAK_ID_REST_BREAK], data[BREAK_ID_DAILY_LIMIT]);
+  // Applets that embed themselves without requesting timer states rely on TimersUpdated.
+  bool legacy = GUIConfig::applet_legacy_timers()() || (embedded && !timer_state_clients);
+  if (legacy)
+    {
+      org_workrave_AppletInterface *iface = org_workrave_AppletInterface::instance(dbus);
+      assert(iface != nullptr);
+      iface->TimersUpdated(WORKRAVE_APPLET_SERVICE_OBJ, data[BREAK_ID_MICRO_BREAK], data[BREAK_ID_REST_BREAK], data[BREAK_ID_DAILY_LIMIT]);
+    }
+
+  send_timer_states();
 
   TRACE_EXIT();
 }
 
+void
+GenericDBusApplet::send_timer_states()
+{
+  int64_t now = workrave::utils::TimeSource::get_real_time_sec_sync() * workrave::utils::TimeSource::TIME_USEC_PER_SEC;
+
+  for (auto &sample: timer_samples)
+    {
+      sample.slot = -1;
+      sample.reference = now;
+    }
+  for (int slot = 0; slot < BREAK_ID_SIZEOF; slot++)
+    {
+      if (data[slot].slot >= 0 && data[slot].slot < BREAK_ID_SIZEOF)
+        {
+          timer_samples[data[slot].slot].slot = slot;
+        }
+    }
+
+  org_workrave_AppletInterface *iface = org_workrave_AppletInterface::instance(dbus);
+  for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+    {
+      // Keep tracking without clients, so that get_timer_states is up to date.
+      if (timer_states[i].update(timer_samples[i]) && timer_state_clients)
+        {
+          TimerState state = timer_states[i].get_state();
+          iface->TimerStateChanged(WORKRAVE_APPLET_SERVICE_OBJ, i, state);
+        }
+    }
+}
+
 void
 GenericDBusApplet::init()
 {
@@ -113,7 +163,7 @@ GenericDBusApplet::init()
 
           workrave::utils::connect(menu_model->signal_update(), this, [this]() { send_menu_updated_event(); });
 
-          workrave::utils::connect(menu_helper.signal_update(), this, [this](auto node) { update_menu_item(node); });
+          workrave::utils::connect(menu_helper.signal_update(), this, [this](auto node) { menu_changes.changed(node); });
 
           menu_helper.setup_event();
           send_menu_updated_event();
@@ -131,6 +181,8 @@ GenericDBusApplet::applet_embed(bool enable, const std::string &sender)
 {
   TRACE_ENTER_MSG("GenericDBusApplet::applet_embed", enable << " " << sender);
   embedded = enable;
+  embedded_sender = enable ? sender : "";
+  timer_state_clients = false;
 
   for (const auto &bus_name: active_bus_names)
     {
@@ -156,9 +208,39 @@ GenericDBusApplet::applet_embed(bool enable, const std::string &sender)
 void
 GenericDBusApplet::get_menu(std::list<MenuItem> &out)
 {
+  // Only applets that predate menu versions use GetMenu. They need the unversioned signals.
+  legacy_menu_clients = true;
+
+  menu_changes.flush();
+
+  std::list<MenuItem> items;
+  init_menu_list(items, menu_model->get_root());
+  out = std::move(items);
+}
+
+void
+GenericDBusApplet::get_menu_snapshot(uint32_t &version, std::list<MenuItem> &out)
+{
+  // The snapshot must not include changes that were not sent yet.
+  menu_changes.flush();
+
   std::list<MenuItem> items;
   init_menu_list(items, menu_model->get_root());
-  out = items;
+  version = menu_changes.get_version();
+  out = std::move(items);
+}
+
+void
+GenericDBusApplet::get_timer_states(const std::string &sender, TimerState &micro, TimerState &rest, TimerState &daily)
+{
+  if (sender == embedded_sender)
+    {
+      timer_state_clients = true;
+    }
+
+  micro = timer_states[BREAK_ID_MICRO_BREAK].get_state();
+  rest = timer_states[BREAK_ID_REST_BREAK].get_state();
+  daily = timer_states[BREAK_ID_DAILY_LIMIT].get_state();
 }
 
 void
@@ -217,6 +299,7 @@ GenericDBusApplet::bus_name_presence(const std::string &name, bool present)
           TRACE_MSG("Disabling");
           visible = false;
           embedded = false;
+          timer_state_clients = false;
           apphold.release();
         }
     }
@@ -241,9 +324,14 @@ GenericDBusApplet::send_menu_updated_event()
 {
   std::list<MenuItem> items;
   init_menu_list(items, menu_model->get_root());
+  uint32_t version = menu_changes.snapshot(items);
 
   org_workrave_AppletInterface *iface = org_workrave_AppletInterface::instance(dbus);
-  iface->MenuUpdated(WORKRAVE_APPLET_SERVICE_OBJ, items);
+  iface->MenuSnapshot(WORKRAVE_APPLET_SERVICE_OBJ, version, items);
+  if (legacy_menu_clients)
+    {
+      iface->MenuUpdated(WORKRAVE_APPLET_SERVICE_OBJ, items);
+    }
 }
 
 void
@@ -316,7 +404,18 @@ GenericDBusApplet::init_menu_list(std::list<MenuItem> &items, menus::Node::Ptr n
 }
 
 void
-GenericDBusApplet::update_menu_item(menus::Node::Ptr node)
+GenericDBusApplet::send_menu_item_changed(uint32_t version, const MenuItem &item)
+{
+  org_workrave_AppletInterface *iface = org_workrave_AppletInterface::instance(dbus);
+  iface->MenuItemChanged(WORKRAVE_APPLET_SERVICE_OBJ, version, item.command, item.text, item.flags);
+  if (legacy_menu_clients)
+    {
+      iface->MenuItemUpdated(WORKRAVE_APPLET_SERVICE_OBJ, item);
+    }
+}
+
+GenericDBusApplet::MenuItem
+GenericDBusApplet::create_menu_item(menus::Node::Ptr node)
 {
   uint32_t command = menu_helper.allocate_command(node->get_id());
   uint8_t flags = MENU_ITEM_FLAG_NONE;
@@ -362,7 +461,5 @@ GenericDBusApplet::update_menu_item(menus::Node::Ptr node)
       type = MenuItemType::Separator;
     }
 
-  MenuItem item(node->get_text(), node->get_id(), command, type, flags);
-  org_workrave_AppletInterface *iface = org_workrave_AppletInterface::instance(dbus);
-  iface->MenuItemUpdated(WORKRAVE_APPLET_SERVICE_OBJ, item);
+  return MenuItem(node->get_text(), node->get_id(), command, type, flags);
 }
@@ -18,14 +18,17 @@
 #ifndef GENERICDBUSAPPLET_HH
 #define GENERICDBUSAPPLET_HH
 
+#include <memory>
 #include <string>
 #include <set>
 
 #include "commonui/MenuDefs.hh"
 #include "ui/MenuModel.hh"
 #include "ui/MenuHelper.hh"
+#include "ui/MenuChangeTracker.hh"
 #include "ui/TimerBoxViewBase.hh"
 #include "ui/TimerBoxControl.hh"
+#include "ui/TimerStateTracker.hh"
 #include "utils/Signals.hh"
 #include "dbus/IDBus.hh"
 #include "dbus/IDBusWatch.hh"
@@ -53,6 +56,8 @@ public:
     uint32_t bar_primary_max;
   };
 
+  using TimerState = ::TimerState;
+
   struct MenuItem
   {
     MenuItem() = default;
@@ -86,6 +91,8 @@ public:
 
   // DBus
   virtual void get_menu(std::list<MenuItem> &out);
+  virtual void get_menu_snapshot(uint32_t &version, std::list<MenuItem> &out);
+  virtual void get_timer_states(const std::string &sender, TimerState &micro, TimerState &rest, TimerState &daily);
   virtual void get_tray_icon_enabled(bool &enabled) const;
   virtual void applet_menu_action(const std::string &action);
   virtual void applet_command(int command);
@@ -112,8 +119,10 @@ private:
 
   void send_menu_updated_event();
   void init_menu_list(std::list<MenuItem> &items, menus::Node::Ptr node);
-  void update_menu_item(menus::Node::Ptr node);
+  void send_menu_item_changed(uint32_t version, const MenuItem &item);
+  MenuItem create_menu_item(menus::Node::Ptr node);
   void send_tray_icon_enabled();
+  void send_timer_states();
 
 private:
   std::shared_ptr<IApplication> app;
@@ -124,9 +133,23 @@ private:
   bool visible{false};
   bool embedded{false};
   TimerData data[workrave::BREAK_ID_SIZEOF];
+  TimerState timer_samples[workrave::BREAK_ID_SIZEOF];
+  TimerStateTracker timer_states[workrave::BREAK_ID_SIZEOF];
   std::set<std::string> active_bus_names;
   workrave::dbus::IDBus::Ptr dbus;
   std::shared_ptr<TimerBoxControl> control;
+
+  //! Changes of the menu as seen by applets.
+  MenuChangeTracker<menus::Node::Ptr, MenuItem> menu_changes;
+
+  //! Whether an applet that does not know menu versions asked for the menu.
+  bool legacy_menu_clients{false};
+
+  //! Bus name of the embedded applet.
+  std::string embedded_sender;
+
+  //! Whether the embedded applet requested timer states instead of TimersUpdated.
+  bool timer_state_clients{false};
 };
 
 #endif // GENERICDBUSAPPLET_HH
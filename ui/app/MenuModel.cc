@@ -91,6 +91,7 @@ menus::Node::set_text(std::string text)
   if (this->text != text)
     {
       this->text = text;
+      changed_signal();
     }
 }
 
@@ -146,7 +147,7 @@ menus::SubMenuNode::remove(menus::Node::Ptr submenu)
 }
 
 auto
-menus::SubMenuNode::get_children() const -> std::list<menus::Node::Ptr>
+menus::SubMenuNode::get_children() const -> const std::list<menus::Node::Ptr> &
 {
   return children;
 }
@@ -316,7 +317,7 @@ menus::RadioGroupNode::remove(menus::RadioNode::Ptr submenu)
 }
 
 auto
-menus::RadioGroupNode::get_children() const -> std::list<menus::RadioNode::Ptr>
+menus::RadioGroupNode::get_children() const -> const std::list<menus::RadioNode::Ptr> &
 {
   return children;
 }
@@ -0,0 +1,470 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "ui/TimeBarRenderer.hh"
+
+#include <algorithm>
+
+bool
+TimeBarRenderer::Rect::is_empty() const
+{
+  return width <= 0 || height <= 0;
+}
+
+TimeBarRenderer::Rect
+TimeBarRenderer::Rect::united(const Rect &other) const
+{
+  if (is_empty())
+    {
+      return other;
+    }
+  if (other.is_empty())
+    {
+      return *this;
+    }
+
+  int x1 = std::min(x, other.x);
+  int y1 = std::min(y, other.y);
+  int x2 = std::max(x + width, other.x + other.width);
+  int y2 = std::max(y + height, other.y + other.height);
+  return Rect{x1, y1, x2 - x1, y2 - y1};
+}
+
+TimeBarRenderer::Rect
+TimeBarRenderer::Rect::intersected(const Rect &other) const
+{
+  int x1 = std::max(x, other.x);
+  int y1 = std::max(y, other.y);
+  int x2 = std::min(x + width, other.x + other.width);
+  int y2 = std::min(y + height, other.y + other.height);
+  if (x2 <= x1 || y2 <= y1)
+    {
+      return Rect{};
+    }
+  return Rect{x1, y1, x2 - x1, y2 - y1};
+}
+
+bool
+TimeBarRenderer::Rect::contains(const Rect &other) const
+{
+  if (other.is_empty())
+    {
+      return true;
+    }
+  return x <= other.x && y <= other.y && x + width >= other.x + other.width && y + height >= other.y + other.height;
+}
+
+bool
+TimeBarRenderer::Rect::operator==(const Rect &other) const
+{
+  return x == other.x && y == other.y && width == other.width && height == other.height;
+}
+
+bool
+TimeBarRenderer::Rect::operator!=(const Rect &other) const
+{
+  return !(*this == other);
+}
+
+void
+TimeBarRenderer::set_size(int width, int height)
+{
+  if (width != this->width || height != this->height)
+    {
+      this->width = width;
+      this->height = height;
+      full_damage = true;
+    }
+}
+
+void
+TimeBarRenderer::set_border_size(int size)
+{
+  if (size != border_size)
+    {
+      border_size = size;
+      full_damage = true;
+    }
+}
+
+void
+TimeBarRenderer::set_rotation(int rotation)
+{
+  if (rotation != this->rotation)
+    {
+      this->rotation = rotation;
+      full_damage = true;
+    }
+}
+
+void
+TimeBarRenderer::set_text_alignment(int align)
+{
+  if (align != text_align)
+    {
+      text_align = align;
+      full_damage = true;
+    }
+}
+
+void
+TimeBarRenderer::set_progress(int value, int max_value)
+{
+  bar_value = std::min(value, max_value);
+  bar_max_value = max_value;
+}
+
+void
+TimeBarRenderer::set_secondary_progress(int value, int max_value)
+{
+  secondary_bar_value = std::min(value, max_value);
+  secondary_bar_max_value = max_value;
+}
+
+void
+TimeBarRenderer::set_bar_color(TimerColorId color)
+{
+  bar_color = color;
+}
+
+void
+TimeBarRenderer::set_secondary_bar_color(TimerColorId color)
+{
+  secondary_bar_color = color;
+}
+
+void
+TimeBarRenderer::set_text(const std::string &text, int text_width, int text_height)
+{
+  this->text = text;
+  this->text_width = text_width;
+  this->text_height = text_height;
+}
+
+void
+TimeBarRenderer::invalidate()
+{
+  full_damage = true;
+}
+
+int
+TimeBarRenderer::get_width() const
+{
+  return width;
+}
+
+int
+TimeBarRenderer::get_height() const
+{
+  return height;
+}
+
+TimeBarRenderer::Rect
+TimeBarRenderer::get_damage() const
+{
+  Rect all{0, 0, width, height};
+  if (full_damage)
+    {
+      return all;
+    }
+
+  const Layout layout = compute_layout();
+  Rect damage = pending_damage;
+
+  // Compare the colors of both layouts between all segment boundaries.
+  std::array<int, 10> bounds{};
+  size_t num_bounds = 0;
+  bounds[num_bounds++] = border_size;
+  for (const Layout *l: {&painted, &layout})
+    {
+      for (int i = 0; i < l->num_segments; i++)
+        {
+          bounds[num_bounds++] = l->segments[i].x;
+          bounds[num_bounds++] = l->segments[i].x + l->segments[i].width;
+        }
+    }
+  std::sort(bounds.begin(), bounds.begin() + num_bounds);
+
+  for (size_t i = 0; i + 1 < num_bounds; i++)
+    {
+      int x = bounds[i];
+      int next = bounds[i + 1];
+      if (next == x)
+        {
+          continue;
+        }
+
+      bool painted_filled = false;
+      bool filled = false;
+      TimerColorId painted_color = color_at(painted, x, painted_filled);
+      TimerColorId color = color_at(layout, x, filled);
+      if (painted_filled != filled || (filled && painted_color != color))
+        {
+          damage = damage.united(to_physical(x, next - x));
+        }
+    }
+
+  if (text != painted_text || text_width != painted_text_width || text_height != painted_text_height
+      || layout.text_x != painted.text_x || layout.text_y != painted.text_y)
+    {
+      damage = damage.united(get_text_rect(painted, painted_text_width, painted_text_height));
+      damage = damage.united(get_text_rect(layout, text_width, text_height));
+    }
+
+  return damage.intersected(all);
+}
+
+void
+TimeBarRenderer::paint(IPainter &painter, const Rect &clip)
+{
+  Rect all{0, 0, width, height};
+  Rect area = clip.intersected(all);
+  if (area.is_empty())
+    {
+      return;
+    }
+
+  Rect damage = get_damage();
+  Layout layout = compute_layout();
+
+  painter.draw_frame(area);
+
+  for (int i = 0; i < layout.num_segments; i++)
+    {
+      const Segment &segment = layout.segments[i];
+      Rect rect = to_physical(segment.x, segment.width).intersected(area);
+      if (!rect.is_empty())
+        {
+          painter.fill_rect(rect, segment.color);
+        }
+    }
+
+  // The text is split where the bars end.
+  Rect on_bar;
+  Rect off_bar;
+  if (!is_vertical())
+    {
+      on_bar = Rect{0, 0, layout.bar_end, height};
+      off_bar = Rect{layout.bar_end, 0, width - layout.bar_end, height};
+    }
+  else
+    {
+      int lw = get_logical_width();
+      on_bar = Rect{0, lw - layout.bar_end, width, layout.bar_end};
+      off_bar = Rect{0, 0, width, lw - layout.bar_end};
+    }
+
+  on_bar = on_bar.intersected(area);
+  off_bar = off_bar.intersected(area);
+  if (!on_bar.is_empty())
+    {
+      painter.draw_text(layout.text_x, layout.text_y, on_bar, true);
+    }
+  if (!off_bar.is_empty())
+    {
+      painter.draw_text(layout.text_x, layout.text_y, off_bar, false);
+    }
+
+  // Everything inside the clip is now up to date. Whatever damage lies
+  // outside it stays pending until an expose covers it.
+  pending_damage = area.contains(damage) ? Rect{} : damage;
+
+  painted = layout;
+  painted_text = text;
+  painted_text_width = text_width;
+  painted_text_height = text_height;
+  full_damage = false;
+}
+
+TimeBarRenderer::Layout
+TimeBarRenderer::compute_layout() const
+{
+  Layout layout;
+
+  int lw = get_logical_width();
+  int span = std::max(lw - 2 * border_size - 1, 0);
+
+  int bar_width = 0;
+  if (bar_max_value > 0)
+    {
+      bar_width = std::max(bar_value, 0) * span / bar_max_value;
+    }
+
+  int sbar_width = 0;
+  if (secondary_bar_max_value > 0)
+    {
+      sbar_width = std::max(secondary_bar_value, 0) * span / secondary_bar_max_value;
+    }
+
+  auto add_segment = [&layout](int x, int width, TimerColorId color) {
+    if (width > 0)
+      {
+        layout.segments[layout.num_segments++] = Segment{x, width, color};
+      }
+  };
+
+  if (sbar_width > 0)
+    {
+      // Overlap
+      TimerColorId overlap_color;
+      switch (bar_color)
+        {
+        case TimerColorId::Active:
+          overlap_color = TimerColorId::InactiveOverActive;
+          break;
+        case TimerColorId::Overdue:
+          overlap_color = TimerColorId::InactiveOverOverdue;
+          break;
+        default:
+          overlap_color = TimerColorId::InactiveOverActive;
+        }
+
+      if (sbar_width >= bar_width)
+        {
+          add_segment(border_size, bar_width, overlap_color);
+          add_segment(border_size + bar_width, sbar_width - bar_width, secondary_bar_color);
+        }
+      else
+        {
+          add_segment(border_size, sbar_width, overlap_color);
+          add_segment(border_size + sbar_width, bar_width - sbar_width, bar_color);
+        }
+    }
+  else
+    {
+      // No overlap
+      add_segment(border_size, bar_width, bar_color);
+    }
+
+  layout.bar_end = std::max(bar_width, sbar_width) + border_size;
+
+  if (!is_vertical())
+    {
+      if (width - text_width - MARGINX > 0)
+        {
+          if (text_align > 0)
+            {
+              layout.text_x = width - text_width - MARGINX;
+            }
+          else if (text_align < 0)
+            {
+              layout.text_x = MARGINX;
+            }
+          else
+            {
+              layout.text_x = (width - text_width) / 2;
+            }
+        }
+      else
+        {
+          layout.text_x = MARGINX;
+        }
+      layout.text_y = (height - text_height) / 2;
+    }
+  else
+    {
+      if (height - text_width - MARGINY > 0)
+        {
+          int align = rotation == 270 ? -text_align : text_align;
+          if (align > 0)
+            {
+              layout.text_y = height - text_width - MARGINY;
+            }
+          else if (align < 0)
+            {
+              layout.text_y = MARGINY;
+            }
+          else
+            {
+              layout.text_y = (height - text_width) / 2;
+            }
+        }
+      else
+        {
+          layout.text_y = MARGINY;
+        }
+      layout.text_x = (width - text_height) / 2;
+    }
+
+  return layout;
+}
+
+TimerColorId
+TimeBarRenderer::color_at(const Layout &layout, int x, bool &filled) const
+{
+  for (int i = 0; i < layout.num_segments; i++)
+    {
+      const Segment &segment = layout.segments[i];
+      if (x >= segment.x && x < segment.x + segment.width)
+        {
+          filled = true;
+          return segment.color;
+        }
+    }
+  filled = false;
+  return TimerColorId::Bg;
+}
+
+//! Returns the area covered by the text, with a pixel extra for antialiasing.
+TimeBarRenderer::Rect
+TimeBarRenderer::get_text_rect(const Layout &layout, int text_width, int text_height) const
+{
+  if (text_width == 0 || text_height == 0)
+    {
+      return Rect{};
+    }
+
+  if (!is_vertical())
+    {
+      return Rect{layout.text_x - 1, layout.text_y - 1, text_width + 2, text_height + 2};
+    }
+  return Rect{layout.text_x - 1, layout.text_y - 1, text_height + 2, text_width + 2};
+}
+
+//! Converts a span along the bar into the rectangle it covers.
+TimeBarRenderer::Rect
+TimeBarRenderer::to_physical(int x, int width) const
+{
+  int bar_height = get_logical_height() - 2 * border_size - 1;
+  if (!is_vertical())
+    {
+      return Rect{x, border_size, width, bar_height};
+    }
+  return Rect{border_size, get_logical_width() - x - width, bar_height, width};
+}
+
+bool
+TimeBarRenderer::is_vertical() const
+{
+  return rotation == 90 || rotation == 270;
+}
+
+int
+TimeBarRenderer::get_logical_width() const
+{
+  return is_vertical() ? height : width;
+}
+
+int
+TimeBarRenderer::get_logical_height() const
+{
+  return is_vertical() ? width : height;
+}
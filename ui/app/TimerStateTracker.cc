@@ -0,0 +1,85 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "ui/TimerStateTracker.hh"
+
+bool
+TimerStateTracker::update(const TimerState &sample)
+{
+  bool changed = !published || !is_equal(interpolate(state, sample.reference), sample);
+
+  if (changed)
+    {
+      int64_t seconds = published ? (sample.reference - last_sample.reference) / USEC_PER_SEC : 0;
+
+      state = sample;
+      state.value_rate = get_rate(last_sample.value, sample.value, seconds);
+      state.primary_rate = get_rate(last_sample.primary_val, sample.primary_val, seconds);
+      state.secondary_rate = get_rate(last_sample.secondary_val, sample.secondary_val, seconds);
+      published = true;
+    }
+
+  last_sample = sample;
+  return changed;
+}
+
+const TimerState &
+TimerStateTracker::get_state() const
+{
+  return state;
+}
+
+TimerState
+TimerStateTracker::interpolate(const TimerState &state, int64_t now)
+{
+  TimerState ret = state;
+  if (now > state.reference)
+    {
+      auto seconds = static_cast<int32_t>((now - state.reference) / USEC_PER_SEC);
+      ret.value += state.value_rate * seconds;
+      ret.primary_val += state.primary_rate * seconds;
+      ret.secondary_val += state.secondary_rate * seconds;
+    }
+  return ret;
+}
+
+bool
+TimerStateTracker::is_equal(const TimerState &a, const TimerState &b)
+{
+  return a.slot == b.slot && a.value == b.value && a.primary_color == b.primary_color && a.primary_val == b.primary_val
+         && a.primary_max == b.primary_max && a.secondary_color == b.secondary_color && a.secondary_val == b.secondary_val
+         && a.secondary_max == b.secondary_max;
+}
+
+int32_t
+TimerStateTracker::get_rate(int32_t from, int32_t to, int64_t seconds)
+{
+  // Timers run at one second per second. Anything else, e.g. a reset, is a jump.
+  if (seconds > 0 && to - from == seconds)
+    {
+      return 1;
+    }
+  if (seconds > 0 && from - to == seconds)
+    {
+      return -1;
+    }
+  return 0;
+}
@@ -64,6 +64,7 @@ public:
 
   static workrave::config::Setting<bool> &applet_fallback_enabled();
   static workrave::config::Setting<bool> &applet_icon_enabled();
+  static workrave::config::Setting<bool> &applet_legacy_timers();
 
   static workrave::config::Setting<int> &timerbox_cycle_time(const std::string &box);
   static workrave::config::Setting<int> &timerbox_slot(const std::string &box, workrave::BreakId break_id);
@@ -98,6 +99,7 @@ private:
 
   static const std::string CFG_KEY_APPLET_FALLBACK_ENABLED;
   static const std::string CFG_KEY_APPLET_ICON_ENABLED;
+  static const std::string CFG_KEY_APPLET_LEGACY_TIMERS;
 
   static const std::string CFG_KEY_TIMERBOX;
   static const std::string CFG_KEY_TIMERBOX_CYCLE_TIME;
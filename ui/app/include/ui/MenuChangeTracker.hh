@@ -0,0 +1,150 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef WORKRAVE_UI_MENUCHANGETRACKER_HH
+#define WORKRAVE_UI_MENUCHANGETRACKER_HH
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+//! Collects the changes of menu items and numbers the menu as sent to applets.
+/*!
+ *  Every snapshot and every changed item increments the version, so an
+ *  applet that sees a version other than the next one knows it missed a
+ *  change and fetches a new snapshot. Changes are collected until control
+ *  returns to the main loop, and only items whose text or flags differ from
+ *  what applets last received are sent.
+ *
+ *  Node identifies a menu item; Item has command, text and flags members.
+ */
+template<typename Node, typename Item>
+class MenuChangeTracker
+{
+public:
+  //! Runs a function once control returns to the main loop.
+  using Scheduler = std::function<void(std::function<void()>)>;
+
+  //! Returns the current state of the item of a node.
+  using Resolver = std::function<Item(const Node &)>;
+
+  //! Sends a changed item to applets.
+  using Sender = std::function<void(uint32_t version, const Item &item)>;
+
+  MenuChangeTracker(Scheduler scheduler, Resolver resolver, Sender sender)
+    : scheduler(std::move(scheduler))
+    , resolver(std::move(resolver))
+    , sender(std::move(sender))
+  {
+  }
+
+  // A scheduled flush refers to the tracker.
+  MenuChangeTracker(const MenuChangeTracker &) = delete;
+  MenuChangeTracker &operator=(const MenuChangeTracker &) = delete;
+
+  //! Records that the item of a node changed.
+  void changed(const Node &node)
+  {
+    // A single action often changes several nodes, e.g. all radio items of
+    // the mode menu. Collect them and send the changes once control
+    // returns to the main loop.
+    if (!flush_timer)
+      {
+        flush_timer = std::make_shared<bool>(true);
+        scheduler([this, timer = std::weak_ptr<bool>(flush_timer)]() {
+          if (!timer.expired())
+            {
+              flush();
+            }
+        });
+      }
+    if (std::find(changed_nodes.begin(), changed_nodes.end(), node) == changed_nodes.end())
+      {
+        changed_nodes.push_back(node);
+      }
+  }
+
+  //! Sends the collected changes now.
+  void flush()
+  {
+    // The scheduler cannot cancel; make a pending flush a no-op instead.
+    flush_timer.reset();
+
+    std::vector<Node> nodes;
+    std::swap(nodes, changed_nodes);
+
+    for (const auto &node: nodes)
+      {
+        Item item = resolver(node);
+
+        // Only send what applets can see: text and flags.
+        auto i = sent_items.find(item.command);
+        if (i != sent_items.end() && i->second.first == item.text && i->second.second == item.flags)
+          {
+            continue;
+          }
+        sent_items[item.command] = std::make_pair(item.text, item.flags);
+
+        version++;
+        sender(version, item);
+      }
+  }
+
+  //! Records that a snapshot of the whole menu is sent. Returns its version.
+  template<typename Items>
+  uint32_t snapshot(const Items &items)
+  {
+    // The snapshot supersedes all collected changes.
+    flush_timer.reset();
+    changed_nodes.clear();
+    sent_items.clear();
+    for (const auto &item: items)
+      {
+        sent_items[item.command] = std::make_pair(item.text, item.flags);
+      }
+    return ++version;
+  }
+
+  //! Returns the version of the menu as last sent to applets.
+  uint32_t get_version() const
+  {
+    return version;
+  }
+
+private:
+  Scheduler scheduler;
+  Resolver resolver;
+  Sender sender;
+
+  uint32_t version{0};
+
+  //! Nodes that changed since the last flush.
+  std::vector<Node> changed_nodes;
+
+  //! Handle of the pending flush. Resetting it cancels the flush.
+  std::shared_ptr<bool> flush_timer;
+
+  //! Text and flags of each item as last sent to applets, by command.
+  std::map<uint32_t, std::pair<std::string, uint8_t>> sent_items;
+};
+
+#endif // WORKRAVE_UI_MENUCHANGETRACKER_HH
@@ -69,7 +69,7 @@ namespace menus
     void add(menus::Node::Ptr submenu, menus::Node::Ptr before = menus::Node::Ptr());
     void remove(menus::Node::Ptr submenu);
 
-    [[nodiscard]] auto get_children() const -> std::list<Node::Ptr>;
+    [[nodiscard]] auto get_children() const -> const std::list<Node::Ptr> &;
 
   private:
     std::list<Node::Ptr> children;
@@ -142,7 +142,7 @@ namespace menus
 
     void add(menus::RadioNode::Ptr submenu, menus::RadioNode::Ptr before = menus::RadioNode::Ptr());
     void remove(menus::RadioNode::Ptr submenu);
-    [[nodiscard]] auto get_children() const -> std::list<RadioNode::Ptr>;
+    [[nodiscard]] auto get_children() const -> const std::list<RadioNode::Ptr> &;
 
     void select(std::string id);
     void select(int value);
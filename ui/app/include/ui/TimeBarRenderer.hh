@@ -0,0 +1,165 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef WORKRAVE_UI_TIMEBARRENDERER_HH
+#define WORKRAVE_UI_TIMEBARRENDERER_HH
+
+#include <array>
+#include <string>
+
+#include "ui/UiTypes.hh"
+
+//! Toolkit independent layout and invalidation of a time bar.
+/*!
+ *  The renderer keeps the state that was last painted. When the state
+ *  changes, get_damage() returns the smallest rectangle that covers all
+ *  pixels that look different, e.g. the one pixel column by which a bar
+ *  grew, or the digits of the text. Toolkits invalidate only that area,
+ *  and paint() only draws what intersects the clip rectangle.
+ *
+ *  Toolkits draw through an IPainter. They are expected to cache the
+ *  background and frame, and the text layout, because neither changes
+ *  every second.
+ *
+ *  Coordinates are in pixels, relative to the top-left of the bar. For
+ *  a rotation of 90 or 270 degrees the bar grows downwards.
+ */
+class TimeBarRenderer
+{
+public:
+  struct Rect
+  {
+    int x{0};
+    int y{0};
+    int width{0};
+    int height{0};
+
+    bool is_empty() const;
+    Rect united(const Rect &other) const;
+    Rect intersected(const Rect &other) const;
+    bool contains(const Rect &other) const;
+    bool operator==(const Rect &other) const;
+    bool operator!=(const Rect &other) const;
+  };
+
+  class IPainter
+  {
+  public:
+    virtual ~IPainter() = default;
+
+    //! Draws the background and the frame of the bar within the clip rectangle.
+    virtual void draw_frame(const Rect &clip) = 0;
+
+    //! Fills a rectangle with a bar color.
+    virtual void fill_rect(const Rect &rect, TimerColorId color) = 0;
+
+    //! Draws the text with its top-left corner at x,y, clipped to the rectangle.
+    /*! Text on top of a bar may need a different color than text on the background. */
+    virtual void draw_text(int x, int y, const Rect &clip, bool on_bar) = 0;
+  };
+
+  static constexpr int MARGINX = 4;
+  static constexpr int MARGINY = 2;
+
+  void set_size(int width, int height);
+  void set_border_size(int size);
+  void set_rotation(int rotation);
+  void set_text_alignment(int align);
+
+  void set_progress(int value, int max_value);
+  void set_secondary_progress(int value, int max_value);
+  void set_bar_color(TimerColorId color);
+  void set_secondary_bar_color(TimerColorId color);
+
+  //! Sets the text and its size as measured by the toolkit, unrotated.
+  void set_text(const std::string &text, int text_width, int text_height);
+
+  //! Invalidates the whole bar, e.g. after a theme change.
+  void invalidate();
+
+  //! Returns the area that changed since the last paint.
+  Rect get_damage() const;
+
+  //! Paints everything that intersects the clip rectangle.
+  /*! Damage outside the clip is reported again by get_damage(). */
+  void paint(IPainter &painter, const Rect &clip);
+
+  int get_width() const;
+  int get_height() const;
+
+private:
+  struct Segment
+  {
+    int x{0};
+    int width{0};
+    TimerColorId color{TimerColorId::Bg};
+  };
+
+  //! Positions of the bars and the text, in logical coordinates (x along the bar).
+  struct Layout
+  {
+    std::array<Segment, 2> segments{};
+    int num_segments{0};
+
+    //! End of the bars, where the text changes color.
+    int bar_end{0};
+
+    //! Physical position of the text.
+    int text_x{0};
+    int text_y{0};
+  };
+
+  Layout compute_layout() const;
+  TimerColorId color_at(const Layout &layout, int x, bool &filled) const;
+  Rect get_text_rect(const Layout &layout, int text_width, int text_height) const;
+  Rect to_physical(int x, int width) const;
+  bool is_vertical() const;
+  int get_logical_width() const;
+  int get_logical_height() const;
+
+private:
+  int width{0};
+  int height{0};
+  int border_size{1};
+  int rotation{0};
+  int text_align{0};
+
+  int bar_value{0};
+  int bar_max_value{0};
+  int secondary_bar_value{0};
+  int secondary_bar_max_value{0};
+  TimerColorId bar_color{TimerColorId::Inactive};
+  TimerColorId secondary_bar_color{TimerColorId::Inactive};
+
+  std::string text;
+  int text_width{0};
+  int text_height{0};
+
+  //! Whether the next paint must draw everything.
+  bool full_damage{true};
+
+  //! Damage that was outside the clip of an earlier paint.
+  Rect pending_damage;
+
+  //! State of the last paint.
+  Layout painted;
+  std::string painted_text;
+  int painted_text_width{0};
+  int painted_text_height{0};
+};
+
+#endif // WORKRAVE_UI_TIMEBARRENDERER_HH
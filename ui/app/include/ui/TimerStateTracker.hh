@@ -0,0 +1,79 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef WORKRAVE_UI_TIMERSTATETRACKER_HH
+#define WORKRAVE_UI_TIMERSTATETRACKER_HH
+
+#include <cstdint>
+
+//! State of a timer as published to applets.
+/*!
+ *  The value, primary and secondary values change by their rate every
+ *  second after the reference time, until a new state is published.
+ *  The reference time is in microseconds of wall-clock time and always
+ *  falls on a whole second, the tick of the core.
+ */
+struct TimerState
+{
+  //! Position of the timer in the timer box, or -1 if not shown.
+  int32_t slot{-1};
+  int32_t value{0};
+  int32_t value_rate{0};
+  uint32_t primary_color{0};
+  int32_t primary_val{0};
+  int32_t primary_rate{0};
+  int32_t primary_max{0};
+  uint32_t secondary_color{0};
+  int32_t secondary_val{0};
+  int32_t secondary_rate{0};
+  int32_t secondary_max{0};
+  int64_t reference{0};
+};
+
+//! Decides when the state of a timer must be published to applets.
+/*!
+ *  The tracker is fed the state of the timer on every tick of the core.
+ *  As long as the state matches what applets compute from the last
+ *  published state, nothing is published. Otherwise, e.g. when the timer
+ *  stops or starts running, is reset, or becomes overdue, a new state is
+ *  published with rates derived from the last two ticks.
+ */
+class TimerStateTracker
+{
+public:
+  static constexpr int64_t USEC_PER_SEC = 1000000;
+
+  //! Feeds the state of the timer at a tick. Rates are ignored. Returns whether the state must be published.
+  bool update(const TimerState &sample);
+
+  //! Returns the last published state.
+  const TimerState &get_state() const;
+
+  //! Returns the state at the specified time, as computed by applets.
+  static TimerState interpolate(const TimerState &state, int64_t now);
+
+private:
+  static bool is_equal(const TimerState &a, const TimerState &b);
+  static int32_t get_rate(int32_t from, int32_t to, int64_t seconds);
+
+private:
+  TimerState state;
+  TimerState last_sample;
+  bool published{false};
+};
+
+#endif // WORKRAVE_UI_TIMERSTATETRACKER_HH
@@ -0,0 +1,296 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#define BOOST_TEST_MODULE workrave_menu_changes
+#include <boost/test/unit_test.hpp>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ui/MenuChangeTracker.hh"
+
+namespace
+{
+  struct Item
+  {
+    uint32_t command{0};
+    std::string text;
+    uint8_t flags{0};
+  };
+
+  struct Signal
+  {
+    uint32_t version;
+    Item item;
+  };
+
+  using Tracker = MenuChangeTracker<int, Item>;
+
+  //! Mirrors the menu handling of the applets: apply the next version, fetch a snapshot after a gap.
+  class Applet
+  {
+  public:
+    explicit Applet(std::function<std::pair<uint32_t, std::vector<Item>>()> get_menu_snapshot)
+      : get_menu_snapshot(std::move(get_menu_snapshot))
+    {
+      fetch();
+    }
+
+    void on_menu_item_changed(const Signal &signal)
+    {
+      if (signal.version <= version)
+        {
+          // Already part of the menu snapshot.
+          return;
+        }
+      if (signal.version != version + 1)
+        {
+          fetch();
+          return;
+        }
+      version = signal.version;
+      items[signal.item.command] = std::make_pair(signal.item.text, signal.item.flags);
+    }
+
+  private:
+    void fetch()
+    {
+      auto [v, snapshot] = get_menu_snapshot();
+      version = v;
+      items.clear();
+      for (const auto &item: snapshot)
+        {
+          items[item.command] = std::make_pair(item.text, item.flags);
+        }
+      snapshots++;
+    }
+
+  public:
+    uint32_t version{0};
+    std::map<uint32_t, std::pair<std::string, uint8_t>> items;
+    int snapshots{0};
+
+  private:
+    std::function<std::pair<uint32_t, std::vector<Item>>()> get_menu_snapshot;
+  };
+
+  //! A menu of three radio items, node n has command n, with the main loop and bus of GenericDBusApplet.
+  class Fixture
+  {
+  public:
+    Fixture()
+    {
+      for (uint32_t i = 1; i <= 3; i++)
+        {
+          menu[i] = Item{i, "Mode " + std::to_string(i), static_cast<uint8_t>(i == 1 ? 3 : 1)};
+        }
+      tracker = std::make_unique<Tracker>([this](std::function<void()> func) { main_loop.push_back(std::move(func)); },
+                                          [this](int node) { return menu.at(node); },
+                                          [this](uint32_t version, const Item &item) {
+                                            signals.push_back(Signal{version, item});
+                                          });
+    }
+
+    //! Sends a snapshot, as the MenuSnapshot signal does.
+    uint32_t snapshot()
+    {
+      return tracker->snapshot(get_items());
+    }
+
+    //! Answers GetMenuSnapshot.
+    std::pair<uint32_t, std::vector<Item>> get_menu_snapshot()
+    {
+      tracker->flush();
+      return std::make_pair(tracker->get_version(), get_items());
+    }
+
+    //! Switches the active radio item, as a mode change does.
+    void select(int node)
+    {
+      for (auto &[n, item]: menu)
+        {
+          uint8_t flags = n == node ? 3 : 1;
+          if (item.flags != flags)
+            {
+              item.flags = flags;
+              tracker->changed(n);
+            }
+        }
+    }
+
+    //! Returns to the main loop.
+    void run()
+    {
+      std::vector<std::function<void()>> pending;
+      std::swap(pending, main_loop);
+      for (auto &func: pending)
+        {
+          func();
+        }
+    }
+
+  private:
+    std::vector<Item> get_items() const
+    {
+      std::vector<Item> items;
+      for (const auto &[n, item]: menu)
+        {
+          items.push_back(item);
+        }
+      return items;
+    }
+
+  public:
+    std::map<int, Item> menu;
+    std::vector<std::function<void()>> main_loop;
+    std::vector<Signal> signals;
+    std::unique_ptr<Tracker> tracker;
+  };
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(menu_changes)
+
+BOOST_FIXTURE_TEST_CASE(test_changes_are_coalesced, Fixture)
+{
+  BOOST_CHECK_EQUAL(snapshot(), 1U);
+
+  // Several changes of the same items before control returns to the main loop.
+  select(2);
+  select(3);
+  menu[1].text = "Normal";
+  tracker->changed(1);
+
+  BOOST_CHECK_EQUAL(main_loop.size(), 1U);
+  BOOST_CHECK(signals.empty());
+
+  run();
+
+  // One signal per item that differs from the snapshot, in consecutive versions.
+  BOOST_REQUIRE_EQUAL(signals.size(), 2U);
+  std::map<uint32_t, Item> sent;
+  for (std::size_t i = 0; i < signals.size(); i++)
+    {
+      BOOST_CHECK_EQUAL(signals[i].version, 2 + i);
+      sent[signals[i].item.command] = signals[i].item;
+    }
+  BOOST_CHECK_EQUAL(sent.count(2), 0U);
+  BOOST_CHECK_EQUAL(sent[1].text, "Normal");
+  BOOST_CHECK_EQUAL(sent[1].flags, 1);
+  BOOST_CHECK_EQUAL(sent[3].flags, 3);
+  BOOST_CHECK_EQUAL(tracker->get_version(), 3U);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_unchanged_items_are_not_sent, Fixture)
+{
+  snapshot();
+
+  select(2);
+  select(1);
+  run();
+
+  BOOST_CHECK(signals.empty());
+  BOOST_CHECK_EQUAL(tracker->get_version(), 1U);
+
+  select(2);
+  run();
+  select(2);
+  tracker->changed(3);
+  run();
+
+  BOOST_REQUIRE_EQUAL(signals.size(), 2U);
+  BOOST_CHECK_EQUAL(signals[0].version, 2U);
+  BOOST_CHECK_EQUAL(signals[1].version, 3U);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_flush_cancels_timer, Fixture)
+{
+  snapshot();
+
+  // GetMenuSnapshot sends the changes before the main loop does.
+  select(2);
+  get_menu_snapshot();
+  BOOST_CHECK_EQUAL(signals.size(), 2U);
+
+  run();
+  BOOST_CHECK_EQUAL(signals.size(), 2U);
+
+  // A later change schedules a new flush.
+  select(3);
+  BOOST_CHECK_EQUAL(main_loop.size(), 1U);
+  run();
+  BOOST_CHECK_EQUAL(signals.size(), 4U);
+
+  // A snapshot supersedes the collected changes.
+  select(1);
+  BOOST_CHECK_EQUAL(snapshot(), 6U);
+  run();
+  BOOST_CHECK_EQUAL(signals.size(), 4U);
+
+  // The main loop may run the flush after the tracker is gone.
+  select(2);
+  tracker.reset();
+  run();
+  BOOST_CHECK_EQUAL(signals.size(), 4U);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_version_gap_fetches_snapshot, Fixture)
+{
+  snapshot();
+  Applet applet([this]() { return get_menu_snapshot(); });
+  BOOST_CHECK_EQUAL(applet.version, 1U);
+
+  select(2);
+  run();
+  for (const auto &signal: signals)
+    {
+      applet.on_menu_item_changed(signal);
+    }
+  BOOST_CHECK_EQUAL(applet.snapshots, 1);
+  BOOST_CHECK_EQUAL(applet.version, 3U);
+  BOOST_CHECK_EQUAL(applet.items[2].second, 3);
+
+  // The applet misses the first of two changes.
+  signals.clear();
+  select(3);
+  run();
+  BOOST_REQUIRE_EQUAL(signals.size(), 2U);
+  applet.on_menu_item_changed(signals[1]);
+
+  BOOST_CHECK_EQUAL(applet.snapshots, 2);
+  BOOST_CHECK_EQUAL(applet.version, 5U);
+
+  // The missed change arrives late; it is part of the snapshot.
+  applet.on_menu_item_changed(signals[0]);
+  BOOST_CHECK_EQUAL(applet.snapshots, 2);
+  BOOST_CHECK_EQUAL(applet.version, 5U);
+
+  for (const auto &[n, item]: menu)
+    {
+      BOOST_CHECK_EQUAL(applet.items[item.command].first, item.text);
+      BOOST_CHECK_EQUAL(applet.items[item.command].second, item.flags);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,252 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ui/TimeBarRenderer.hh"
+
+using namespace std;
+
+namespace
+{
+  const int GLYPH_WIDTH = 7;
+  const int GLYPH_HEIGHT = 13;
+
+  //! Paints into an in-memory ARGB32 image, text is drawn as one box per glyph.
+  class ImagePainter : public TimeBarRenderer::IPainter
+  {
+  public:
+    ImagePainter(int width, int height, bool vertical)
+      : width(width)
+      , height(height)
+      , vertical(vertical)
+      , pixels(static_cast<size_t>(width) * height, 0)
+    {
+    }
+
+    void set_text(const string &text)
+    {
+      this->text = text;
+    }
+
+    void draw_frame(const TimeBarRenderer::Rect &clip) override
+    {
+      for (int y = clip.y; y < clip.y + clip.height; y++)
+        {
+          for (int x = clip.x; x < clip.x + clip.width; x++)
+            {
+              bool edge = x == 0 || y == 0 || x == width - 1 || y == height - 1;
+              put(x, y, edge ? 0xff777777 : 0xffeeeeee);
+            }
+        }
+    }
+
+    void fill_rect(const TimeBarRenderer::Rect &rect, TimerColorId color) override
+    {
+      static const uint32_t colors[] = {0xffadd8e6, 0xff90ee90, 0xffffa500, 0xffff0000, 0xffe00000, 0xff00d4b2, 0xff90ee90, 0xff777777};
+      for (int y = rect.y; y < rect.y + rect.height; y++)
+        {
+          for (int x = rect.x; x < rect.x + rect.width; x++)
+            {
+              put(x, y, colors[static_cast<int>(color)]);
+            }
+        }
+    }
+
+    void draw_text(int text_x, int text_y, const TimeBarRenderer::Rect &clip, bool on_bar) override
+    {
+      uint32_t color = on_bar ? 0xff000000 : 0xff202020;
+      for (size_t i = 0; i < text.size(); i++)
+        {
+          int offset = static_cast<int>(i) * GLYPH_WIDTH + 1;
+          TimeBarRenderer::Rect glyph = vertical ? TimeBarRenderer::Rect{text_x + 1, text_y + offset, GLYPH_HEIGHT - 2, GLYPH_WIDTH - 2}
+                                                 : TimeBarRenderer::Rect{text_x + offset, text_y + 1, GLYPH_WIDTH - 2, GLYPH_HEIGHT - 2};
+          glyph = glyph.intersected(clip);
+          for (int y = glyph.y; y < glyph.y + glyph.height; y++)
+            {
+              for (int x = glyph.x; x < glyph.x + glyph.width; x++)
+                {
+                  // Different glyphs must give different pixels.
+                  if (((x - text_x) + (y - text_y) * text[i]) % 3 != 0)
+                    {
+                      put(x, y, color);
+                    }
+                }
+            }
+        }
+    }
+
+    const vector<uint32_t> &get_pixels() const
+    {
+      return pixels;
+    }
+
+    int64_t get_pixels_touched() const
+    {
+      return pixels_touched;
+    }
+
+  private:
+    void put(int x, int y, uint32_t color)
+    {
+      if (x >= 0 && y >= 0 && x < width && y < height)
+        {
+          pixels[static_cast<size_t>(y) * width + x] = color;
+          pixels_touched++;
+        }
+    }
+
+  private:
+    int width;
+    int height;
+    bool vertical;
+    vector<uint32_t> pixels;
+    string text;
+    int64_t pixels_touched{0};
+  };
+
+  string time_to_string(int t)
+  {
+    char buf[32];
+    if (t < 0)
+      {
+        snprintf(buf, sizeof(buf), "-%d:%02d", -t / 60, -t % 60);
+      }
+    else
+      {
+        snprintf(buf, sizeof(buf), "%d:%02d", t / 60, t % 60);
+      }
+    return buf;
+  }
+
+  //! State of a rest break timer at second i: active, idle, overdue and natural breaks.
+  void apply_state(TimeBarRenderer &renderer, ImagePainter &painter, int i)
+  {
+    const int limit = 2700;
+    int elapsed = i % 3300;
+    int idle = (i / 60) % 7 == 3 ? (i % 60) * 5 : 0;
+
+    TimerColorId color = elapsed > limit ? TimerColorId::Overdue : (idle > 0 ? TimerColorId::Inactive : TimerColorId::Active);
+    renderer.set_bar_color(color);
+    renderer.set_progress(elapsed, limit);
+    renderer.set_secondary_bar_color(TimerColorId::Inactive);
+    renderer.set_secondary_progress(idle, 600);
+
+    string text = time_to_string(limit - elapsed);
+    renderer.set_text(text, static_cast<int>(text.size()) * GLYPH_WIDTH, GLYPH_HEIGHT);
+    painter.set_text(text);
+  }
+
+  struct Result
+  {
+    double usec{0};
+    int64_t pixels{0};
+    int64_t paints{0};
+    int mismatches{0};
+  };
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+  const int states = argc > 1 ? stoi(argv[1]) : 10000;
+
+  for (int rotation: {0, 90})
+    {
+      const int bar_width = rotation == 0 ? 120 : 24;
+      const int bar_height = rotation == 0 ? 24 : 120;
+
+      TimeBarRenderer full;
+      TimeBarRenderer damaged;
+      ImagePainter full_painter(bar_width, bar_height, rotation != 0);
+      ImagePainter damaged_painter(bar_width, bar_height, rotation != 0);
+
+      for (TimeBarRenderer *r: {&full, &damaged})
+        {
+          r->set_size(bar_width, bar_height);
+          r->set_rotation(rotation);
+          r->set_text_alignment(1);
+        }
+
+      Result full_result;
+      Result damaged_result;
+
+      for (int i = 0; i < states; i++)
+        {
+          apply_state(full, full_painter, i);
+          apply_state(damaged, damaged_painter, i);
+
+          auto start = chrono::steady_clock::now();
+          full.invalidate();
+          full.paint(full_painter, TimeBarRenderer::Rect{0, 0, bar_width, bar_height});
+          auto middle = chrono::steady_clock::now();
+
+          TimeBarRenderer::Rect damage = damaged.get_damage();
+          if (!damage.is_empty() && i % 5 == 0)
+            {
+              // Expose only the first half; the rest must still be reported as damage.
+              TimeBarRenderer::Rect half = damage;
+              half.width = std::max(half.width / 2, 1);
+              damaged.paint(damaged_painter, half);
+              damaged_result.paints++;
+              damage = damaged.get_damage();
+            }
+          if (!damage.is_empty())
+            {
+              damaged.paint(damaged_painter, damage);
+              damaged_result.paints++;
+            }
+          auto end = chrono::steady_clock::now();
+
+          full_result.paints++;
+          full_result.usec += chrono::duration<double, micro>(middle - start).count();
+          damaged_result.usec += chrono::duration<double, micro>(end - middle).count();
+
+          if (full_painter.get_pixels() != damaged_painter.get_pixels())
+            {
+              damaged_result.mismatches++;
+            }
+        }
+
+      full_result.pixels = full_painter.get_pixels_touched();
+      damaged_result.pixels = damaged_painter.get_pixels_touched();
+
+      cout << "rotation " << rotation << ", " << bar_width << "x" << bar_height << ", " << states << " states" << endl;
+      cout << "  full redraw:  " << full_result.paints << " paints, " << full_result.pixels << " pixels, " << full_result.usec / 1000.0
+           << " ms" << endl;
+      cout << "  damage only:  " << damaged_result.paints << " paints, " << damaged_result.pixels << " pixels, "
+           << damaged_result.usec / 1000.0 << " ms" << endl;
+      cout << "  pixel reduction: " << (damaged_result.pixels > 0 ? static_cast<double>(full_result.pixels) / damaged_result.pixels : 0.0)
+           << "x, mismatching frames: " << damaged_result.mismatches << endl;
+
+      if (damaged_result.mismatches > 0)
+        {
+          return 1;
+        }
+    }
+  return 0;
+}
@@ -0,0 +1,238 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#define BOOST_TEST_MODULE workrave_timer_state
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <vector>
+
+#include "ui/TimerStateTracker.hh"
+
+namespace
+{
+  constexpr int64_t SEC = TimerStateTracker::USEC_PER_SEC;
+  constexpr int64_t START = 1700000000 * SEC;
+
+  //! A break timer driven by random activity, reported the way TimerBoxControl does every second.
+  class TimerSimulation
+  {
+  public:
+    TimerSimulation(int limit, int auto_reset, uint32_t seed)
+      : limit(limit)
+      , auto_reset(auto_reset)
+      , random(seed)
+    {
+    }
+
+    void set_idle(bool idle)
+    {
+      this->idle = idle;
+    }
+
+    TimerState tick(int64_t now)
+    {
+      if (idle)
+        {
+          active = false;
+        }
+      else if (--remaining <= 0)
+        {
+          // Alternate between activity and pauses of random length.
+          active = !active;
+          std::uniform_int_distribution<int> dist(1, active ? 400 : 200);
+          remaining = dist(random);
+        }
+
+      if (active)
+        {
+          active_time++;
+          idle_time = 0;
+        }
+      else if (idle_time < auto_reset)
+        {
+          idle_time++;
+          if (idle_time == auto_reset)
+            {
+              active_time = 0;
+            }
+        }
+
+      TimerState sample;
+      sample.slot = 0;
+      sample.value = limit - active_time;
+      sample.primary_color = active_time > limit ? 2 : 0;
+      sample.primary_val = active_time;
+      sample.primary_max = limit;
+      sample.secondary_color = 1;
+      sample.secondary_val = idle_time;
+      sample.secondary_max = auto_reset;
+      sample.reference = now;
+      return sample;
+    }
+
+  private:
+    int limit;
+    int auto_reset;
+    std::mt19937 random;
+    bool idle{false};
+    bool active{false};
+    int remaining{0};
+    int active_time{0};
+    int idle_time{0};
+  };
+
+  bool same_values(const TimerState &a, const TimerState &b)
+  {
+    return a.slot == b.slot && a.value == b.value && a.primary_color == b.primary_color && a.primary_val == b.primary_val
+           && a.primary_max == b.primary_max && a.secondary_color == b.secondary_color && a.secondary_val == b.secondary_val
+           && a.secondary_max == b.secondary_max;
+  }
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(timer_state)
+
+BOOST_AUTO_TEST_CASE(test_first_update_is_published)
+{
+  TimerStateTracker tracker;
+  TimerState sample;
+  sample.reference = START;
+  BOOST_CHECK(tracker.update(sample));
+  BOOST_CHECK(!tracker.update(sample));
+}
+
+BOOST_AUTO_TEST_CASE(test_rates)
+{
+  TimerStateTracker tracker;
+  TimerState sample;
+  sample.value = 100;
+  sample.reference = START;
+  tracker.update(sample);
+
+  // Starts running.
+  sample.value = 99;
+  sample.primary_val = 1;
+  sample.reference += SEC;
+  BOOST_CHECK(tracker.update(sample));
+  BOOST_CHECK_EQUAL(tracker.get_state().value_rate, -1);
+  BOOST_CHECK_EQUAL(tracker.get_state().primary_rate, 1);
+  BOOST_CHECK_EQUAL(tracker.get_state().secondary_rate, 0);
+
+  for (int i = 0; i < 10; i++)
+    {
+      sample.value--;
+      sample.primary_val++;
+      sample.reference += SEC;
+      BOOST_CHECK(!tracker.update(sample));
+    }
+
+  // Reset.
+  sample.value = 100;
+  sample.primary_val = 0;
+  sample.reference += SEC;
+  BOOST_CHECK(tracker.update(sample));
+  BOOST_CHECK_EQUAL(tracker.get_state().value_rate, 0);
+  BOOST_CHECK_EQUAL(tracker.get_state().primary_rate, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_interpolation)
+{
+  TimerState state;
+  state.value = 50;
+  state.value_rate = -1;
+  state.primary_val = 10;
+  state.primary_rate = 1;
+  state.reference = START;
+
+  BOOST_CHECK_EQUAL(TimerStateTracker::interpolate(state, START - SEC).value, 50);
+  BOOST_CHECK_EQUAL(TimerStateTracker::interpolate(state, START + SEC - 1).value, 50);
+  BOOST_CHECK_EQUAL(TimerStateTracker::interpolate(state, START + SEC).value, 49);
+  BOOST_CHECK_EQUAL(TimerStateTracker::interpolate(state, START + 60 * SEC).value, -10);
+  BOOST_CHECK_EQUAL(TimerStateTracker::interpolate(state, START + 60 * SEC).primary_val, 70);
+}
+
+BOOST_AUTO_TEST_CASE(test_interpolation_matches_stream)
+{
+  const int duration = 8 * 3600;
+
+  for (uint32_t seed: {1, 2, 3})
+    {
+      TimerSimulation sim(300, 30, seed);
+      TimerStateTracker tracker;
+
+      // What an applet knows: the last state it received.
+      TimerState received;
+      int published = 0;
+      int mismatches = 0;
+      int mid_mismatches = 0;
+
+      for (int i = 0; i < duration; i++)
+        {
+          int64_t now = START + i * SEC;
+          TimerState sample = sim.tick(now);
+
+          // Between two ticks, the applet still shows the previous one.
+          if (i > 0 && !same_values(TimerStateTracker::interpolate(received, now - SEC / 2), TimerStateTracker::interpolate(received, now - SEC)))
+            {
+              mid_mismatches++;
+            }
+
+          if (tracker.update(sample))
+            {
+              received = tracker.get_state();
+              published++;
+            }
+
+          // The applet draws a frame just after the tick, and must show what TimersUpdated would have sent.
+          if (!same_values(TimerStateTracker::interpolate(received, now + SEC / 100), sample))
+            {
+              mismatches++;
+            }
+        }
+
+      BOOST_TEST_MESSAGE("seed " << seed << ": " << published << " states instead of " << duration << " TimersUpdated signals");
+
+      BOOST_CHECK_EQUAL(mismatches, 0);
+      BOOST_CHECK_EQUAL(mid_mismatches, 0);
+      BOOST_CHECK_LT(published * 10, duration);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_idle)
+{
+  TimerSimulation sim(300, 30, 1);
+  TimerStateTracker tracker;
+
+  int published = 0;
+  for (int i = 0; i < 3600; i++)
+    {
+      sim.set_idle(i >= 600);
+      if (tracker.update(sim.tick(START + i * SEC)) && i >= 600 + 30 + 1)
+        {
+          published++;
+        }
+    }
+
+  // Once the timer is reset, an idle desktop does not publish anything.
+  BOOST_CHECK_EQUAL(published, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
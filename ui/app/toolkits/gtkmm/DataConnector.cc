@@ -77,6 +77,10 @@ DataConnector::connect(const string &setting, DataConnection *connection, dc::Fl
 
       connection->set(config, flags, setting);
       connection->init();
+      if (!active)
+        {
+          connection->detach();
+        }
 
       connections.push_back(mw);
     }
@@ -95,11 +99,38 @@ DataConnector::connect(const string &setting, DataConnection *connection, sigc::
       connection->set(config, flags, setting);
       connection->intercept.connect(slot);
       connection->init();
+      if (!active)
+        {
+          connection->detach();
+        }
 
       connections.push_back(mw);
     }
 }
 
+//! Stops or resumes monitoring the configuration for all connected widgets.
+void
+DataConnector::set_active(bool active)
+{
+  if (active == this->active)
+    {
+      return;
+    }
+
+  this->active = active;
+  for (auto &connection: connections)
+    {
+      if (active)
+        {
+          connection.connection->attach();
+        }
+      else
+        {
+          connection.connection->detach();
+        }
+    }
+}
+
 //! Construct a new data connection
 DataConnection::DataConnection()
 {
@@ -108,7 +139,7 @@ DataConnection::DataConnection()
 //! Destruct data connection.
 DataConnection::~DataConnection()
 {
-  config->remove_listener(key, this);
+  detach();
 }
 
 //! Set connection flags and configuration key.
@@ -122,6 +153,30 @@ DataConnection::set(workrave::config::IConfigurator::Ptr config, dc::Flags flags
   if ((flags & dc::NO_CONFIG) == 0)
     {
       config->add_listener(key, this);
+      attached = true;
+    }
+}
+
+//! Resumes monitoring the configuration item, and catches up on changes made while detached.
+void
+DataConnection::attach()
+{
+  if (!attached && (flags & dc::NO_CONFIG) == 0)
+    {
+      config->add_listener(key, this);
+      attached = true;
+      config_changed_notify(key);
+    }
+}
+
+//! Stops monitoring the configuration item.
+void
+DataConnection::detach()
+{
+  if (attached)
+    {
+      config->remove_listener(key, this);
+      attached = false;
     }
 }
 
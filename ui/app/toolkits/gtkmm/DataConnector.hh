@@ -81,6 +81,9 @@ public:
     connect(setting.key(), connection, slot, flags);
   }
 
+  //! Stops or resumes monitoring the configuration for all connected widgets.
+  void set_active(bool active);
+
 private:
   struct MonitoredWidget
   {
@@ -100,6 +103,9 @@ private:
 
   //!
   workrave::config::IConfigurator::Ptr config;
+
+  //!
+  bool active{true};
 };
 
 class DataConnection : public workrave::config::IConfiguratorListener
@@ -111,12 +117,16 @@ public:
   void set(workrave::config::IConfigurator::Ptr config, dc::Flags flags, const std::string &key);
   virtual void init() = 0;
 
+  void attach();
+  void detach();
+
   sigc::signal<bool, const std::string &, bool> intercept;
 
 protected:
   workrave::config::IConfigurator::Ptr config;
   std::string key;
   dc::Flags flags;
+  bool attached{false};
 };
 
 #define DECLARE_DATA_TYPE(WidgetType, WrapperType, WidgetDataType /*, ConfigDataType */) \
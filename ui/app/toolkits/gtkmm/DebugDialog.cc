@@ -21,9 +21,12 @@
 #  include "config.h"
 #endif
 
+#include <sstream>
+
 #include <gtkmm/textview.h>
 #include <gtkmm/textbuffer.h>
 #include <gtkmm/adjustment.h>
+#include <gtkmm/notebook.h>
 #include <gtkmm/stock.h>
 
 #include "commonui/nls.h"
@@ -49,10 +52,20 @@ DebugDialog::DebugDialog()
   scrolled_window.set_policy(Gtk::POLICY_AUTOMATIC, Gtk::POLICY_AUTOMATIC);
   scrolled_window.add(*text_view);
 
-  Gtk::HBox *box = Gtk::manage(new Gtk::HBox(false, 6));
-  box->pack_start(scrolled_window, true, true, 0);
+  metrics_buffer = Gtk::TextBuffer::create();
+  auto *metrics_view = Gtk::manage(new Gtk::TextView(metrics_buffer));
+  metrics_view->set_cursor_visible(false);
+  metrics_view->set_editable(false);
+
+  metrics_window.set_policy(Gtk::POLICY_AUTOMATIC, Gtk::POLICY_AUTOMATIC);
+  metrics_window.add(*metrics_view);
 
-  get_vbox()->pack_start(*box, true, true, 0);
+  Gtk::Notebook *notebook = Gtk::manage(new Gtk::Notebook());
+  notebook->set_tab_pos(Gtk::POS_TOP);
+  notebook->append_page(scrolled_window, "Log");
+  notebook->append_page(metrics_window, "Metrics");
+
+  get_vbox()->pack_start(*notebook, true, true, 0);
 
   add_button("Close", Gtk::RESPONSE_CLOSE);
 
@@ -69,10 +82,15 @@ DebugDialog::~DebugDialog()
 }
 
 void
-DebugDialog::diagnostics_log(const std::string &log)
+DebugDialog::diagnostics_log(const std::vector<std::string> &lines)
 {
-  Gtk::TextIter iter = text_buffer->end();
-  iter = text_buffer->insert(iter, log + "\n");
+  std::string text;
+  for (const auto &line: lines)
+    {
+      text += line + "\n";
+    }
+
+  text_buffer->insert(text_buffer->end(), text);
   Glib::RefPtr<Gtk::Adjustment> a = scrolled_window.get_vadjustment();
   a->set_value(a->get_upper());
 }
@@ -81,6 +99,32 @@ void
 DebugDialog::init()
 {
   Diagnostics::instance().enable(this);
+
+  // Periodic timer.
+  Glib::signal_timeout().connect(sigc::mem_fun(*this, &DebugDialog::on_timer), 250);
+}
+
+bool
+DebugDialog::on_timer()
+{
+  Diagnostics::instance().process();
+
+  if (++timer_count % 4 == 0)
+    {
+      update_metrics();
+    }
+  return true;
+}
+
+void
+DebugDialog::update_metrics()
+{
+  std::stringstream ss;
+  for (const auto &metric: workrave::utils::Metrics::instance().snapshot())
+    {
+      ss << metric << "\n";
+    }
+  metrics_buffer->set_text(ss.str());
 }
 
 int
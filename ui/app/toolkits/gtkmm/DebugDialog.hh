@@ -19,6 +19,7 @@
 #define DEBUGDIALOG_HH
 
 #include <string>
+#include <vector>
 
 #include <gtkmm/scrolledwindow.h>
 #include <gtkmm/dialog.h>
@@ -41,15 +42,20 @@ public:
 
   int run();
 
-  void diagnostics_log(const std::string &log) override;
+  void diagnostics_log(const std::vector<std::string> &lines) override;
 
 private:
   void init();
+  bool on_timer();
+  void update_metrics();
   void on_response(int response) override;
 
   Gtk::TextView *text_view{nullptr};
   Gtk::ScrolledWindow scrolled_window;
   Glib::RefPtr<Gtk::TextBuffer> text_buffer;
+  Gtk::ScrolledWindow metrics_window;
+  Glib::RefPtr<Gtk::TextBuffer> metrics_buffer;
+  int timer_count{0};
 };
 
 #endif // DEBUGWINDOW_HH
@@ -84,10 +84,13 @@ NetworkLogDialog::~NetworkLogDialog()
 }
 
 void
-NetworkLogDialog::distribution_log(std::string msg)
+NetworkLogDialog::distribution_log(const std::list<std::string> &messages)
 {
   Gtk::TextIter iter = text_buffer->end();
-  iter = text_buffer->insert(iter, msg);
+  for (const auto &msg: messages)
+    {
+      iter = text_buffer->insert(iter, msg);
+    }
   Glib::RefPtr<Gtk::Adjustment> a = scrolled_window.get_vadjustment();
   a->set_value(a->get_upper());
 }
@@ -50,7 +50,7 @@ public:
 
 private:
   void init();
-  void distribution_log(std::string msg) override;
+  void distribution_log(const std::list<std::string> &messages) override;
   void on_response(int response) override;
 
   std::shared_ptr<IApplication> app;
@@ -46,6 +46,7 @@
 #include "TimeEntry.hh"
 #include "TimerBoxPreferencePage.hh"
 #include "TimerPreferencesPanel.hh"
+#include "LazyPage.hh"
 #include "utils/AssetPath.hh"
 //#include "Application.hh"
 #include "ui/GUIConfig.hh"
@@ -80,31 +81,30 @@ PreferencesDialog::PreferencesDialog(std::shared_ptr<IApplication> app)
 {
   TRACE_ENTER("PreferencesDialog::PreferencesDialog");
 
-  connector = new DataConnector(app);
   inhibit_events = 0;
 
-  // Pages
+  // Pages are created when they are first shown.
   Gtk::Widget *timer_page = Gtk::manage(create_timer_page());
   Gtk::Notebook *gui_page = Gtk::manage(new Gtk::Notebook());
 
 #if !defined(PLATFORM_OS_MACOS)
-  Gtk::Widget *gui_general_page = Gtk::manage(create_gui_page());
+  Gtk::Widget *gui_general_page = create_lazy_page([this](DataConnector &connector) { return create_gui_page(connector); });
   gui_page->append_page(*gui_general_page, _("General"));
 #endif
 
-  Gtk::Widget *gui_sounds_page = Gtk::manage(create_sounds_page());
+  Gtk::Widget *gui_sounds_page = create_lazy_page([this](DataConnector &connector) { return create_sounds_page(connector); });
   gui_page->append_page(*gui_sounds_page, _("Sounds"));
 
-  Gtk::Widget *gui_mainwindow_page = Gtk::manage(create_mainwindow_page());
+  Gtk::Widget *gui_mainwindow_page = Gtk::manage(new LazyPage([this]() { return create_mainwindow_page(); }));
   gui_page->append_page(*gui_mainwindow_page, _("Status Window"));
 
 #if !defined(PLATFORM_OS_MACOS)
-  Gtk::Widget *gui_applet_page = Gtk::manage(create_applet_page());
+  Gtk::Widget *gui_applet_page = Gtk::manage(new LazyPage([this]() { return create_applet_page(); }));
   gui_page->append_page(*gui_applet_page, _("Applet"));
 #endif
 
 #ifdef HAVE_DISTRIBUTION
-  Gtk::Widget *network_page = Gtk::manage(create_network_page());
+  Gtk::Widget *network_page = Gtk::manage(new LazyPage([this]() { return create_network_page(); }));
 #endif
 
   // Notebook
@@ -133,22 +133,31 @@ PreferencesDialog::~PreferencesDialog()
   TRACE_ENTER("PreferencesDialog::~PreferencesDialog");
 
 #if defined(HAVE_LANGUAGE_SELECTION)
-  const Gtk::TreeModel::iterator &iter = languages_combo.get_active();
-  const Gtk::TreeModel::Row row = *iter;
-  const Glib::ustring code = row[languages_columns.code];
+  // The language can only have been changed if the page was shown.
+  if (languages_model)
+    {
+      const Gtk::TreeModel::iterator &iter = languages_combo.get_active();
+      const Gtk::TreeModel::Row row = *iter;
+      const Glib::ustring code = row[languages_columns.code];
 
-  GUIConfig::locale().set(code);
+      GUIConfig::locale().set(code);
+    }
 #endif
 
   auto core = app->get_core();
   core->remove_operation_mode_override("preferences");
 
-  delete connector;
+  // The lazy pages outlive the connectors; they may still be hidden while the dialog is destroyed.
+  for (sigc::connection &connection: connector_connections)
+    {
+      connection.disconnect();
+    }
+  connectors.clear();
   TRACE_EXIT();
 }
 
 Gtk::Widget *
-PreferencesDialog::create_gui_page()
+PreferencesDialog::create_gui_page(DataConnector &connector)
 {
   // Block types
   block_button = Gtk::manage(new Gtk::ComboBoxText());
@@ -276,7 +285,7 @@ PreferencesDialog::create_gui_page()
       autostart_cb->signal_toggled().connect(sigc::mem_fun(*this, &PreferencesDialog::on_autostart_toggled));
       panel->add_widget(*autostart_cb);
 
-      connector->connect(GUIConfig::autostart_enabled(), dc::wrap(autostart_cb));
+      connector.connect(GUIConfig::autostart_enabled(), dc::wrap(autostart_cb));
 
 #if defined(PLATFORM_OS_WINDOWS)
       char value[MAX_PATH];
@@ -288,7 +297,7 @@ PreferencesDialog::create_gui_page()
   Gtk::Label *trayicon_lab = Gtk::manage(GtkUtil::create_label(_("Show system tray icon"), false));
   trayicon_cb = Gtk::manage(new Gtk::CheckButton());
   trayicon_cb->add(*trayicon_lab);
-  connector->connect(GUIConfig::trayicon_enabled(), dc::wrap(trayicon_cb));
+  connector.connect(GUIConfig::trayicon_enabled(), dc::wrap(trayicon_cb));
 
   panel->add_widget(*trayicon_cb, false, false);
 
@@ -303,7 +312,7 @@ PreferencesDialog::create_gui_page()
 }
 
 Gtk::Widget *
-PreferencesDialog::create_sounds_page()
+PreferencesDialog::create_sounds_page(DataConnector &connector)
 {
   Gtk::VBox *panel = Gtk::manage(new Gtk::VBox(false, 6));
 
@@ -332,7 +341,7 @@ PreferencesDialog::create_sounds_page()
       // Volume
       sound_volume_scale = Gtk::manage(new Gtk::HScale(0.0, 100.0, 0.0));
       sound_volume_scale->set_increments(1.0, 5.0);
-      connector->connect(sound_theme->sound_volume(), dc::wrap(sound_volume_scale->get_adjustment()));
+      connector.connect(sound_theme->sound_volume(), dc::wrap(sound_volume_scale->get_adjustment()));
 
       hig->add_label(_("Volume:"), *sound_volume_scale, true, true);
     }
@@ -344,7 +353,7 @@ PreferencesDialog::create_sounds_page()
       // Volume
       mute_cb = Gtk::manage(new Gtk::CheckButton(_("Mute sounds during rest break and daily limit")));
 
-      connector->connect(sound_theme->sound_mute(), dc::wrap(mute_cb));
+      connector.connect(sound_theme->sound_mute(), dc::wrap(mute_cb));
 
       hig->add_widget(*mute_cb, true, true);
     }
@@ -460,13 +469,15 @@ PreferencesDialog::create_timer_page()
     {
       // Label
       Gtk::Widget *box = Gtk::manage(GtkUtil::create_label_for_break((BreakId)i));
-      TimerPreferencesPanel *tp = Gtk::manage(new TimerPreferencesPanel(app, BreakId(i), hsize_group, vsize_group));
+      LazyPage *tp = Gtk::manage(new LazyPage([this, i, hsize_group, vsize_group]() {
+        return new TimerPreferencesPanel(app, BreakId(i), hsize_group, vsize_group);
+      }));
       box->show_all();
       tnotebook->append_page(*tp, *box);
     }
 
   Gtk::Widget *box = Gtk::manage(GtkUtil::create_label("Monitoring", false));
-  Gtk::Widget *monitoring_page = create_monitoring_page();
+  Gtk::Widget *monitoring_page = create_lazy_page([this](DataConnector &connector) { return create_monitoring_page(connector); });
 
   tnotebook->append_page(*monitoring_page, *box);
 
@@ -474,7 +485,7 @@ PreferencesDialog::create_timer_page()
 }
 
 Gtk::Widget *
-PreferencesDialog::create_monitoring_page()
+PreferencesDialog::create_monitoring_page(DataConnector &connector)
 {
   Gtk::VBox *panel = Gtk::manage(new Gtk::VBox(false, 6));
   panel->set_border_width(12);
@@ -502,7 +513,7 @@ PreferencesDialog::create_monitoring_page()
   sensitivity_box->pack_start(*sensitivity_spin, false, false, 0);
   panel->pack_start(*sensitivity_box, false, false, 0);
 
-  connector->connect(CoreConfig::monitor_sensitivity(), dc::wrap(sensitivity_adjustment));
+  connector.connect(CoreConfig::monitor_sensitivity(), dc::wrap(sensitivity_adjustment));
 
   string monitor_type;
   app->get_core()->get_configurator()->get_value_with_default("advanced/monitor", monitor_type, "default");
@@ -541,6 +552,18 @@ PreferencesDialog::create_network_page()
 }
 #endif
 
+//! Returns a page that is created when first shown, and that only follows the configuration while visible.
+Gtk::Widget *
+PreferencesDialog::create_lazy_page(std::function<Gtk::Widget *(DataConnector &)> factory)
+{
+  connectors.push_back(std::make_unique<DataConnector>(app));
+  DataConnector *connector = connectors.back().get();
+
+  LazyPage *page = Gtk::manage(new LazyPage([connector, factory]() { return factory(*connector); }));
+  connector_connections.push_back(page->signal_visibility_changed().connect(sigc::mem_fun(*connector, &DataConnector::set_active)));
+  return page;
+}
+
 void
 PreferencesDialog::add_page(const char *label, const char *image, Gtk::Widget &widget)
 {
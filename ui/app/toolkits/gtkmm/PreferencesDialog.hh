@@ -20,6 +20,8 @@
 
 #include <cstdio>
 
+#include <functional>
+#include <memory>
 #include <vector>
 
 #include "Hig.hh"
@@ -55,9 +57,10 @@ public:
 
 private:
   void add_page(const char *label, const char *image, Gtk::Widget &widget);
-  Gtk::Widget *create_gui_page();
+  Gtk::Widget *create_lazy_page(std::function<Gtk::Widget *(DataConnector &)> factory);
+  Gtk::Widget *create_gui_page(DataConnector &connector);
   Gtk::Widget *create_timer_page();
-  Gtk::Widget *create_sounds_page();
+  Gtk::Widget *create_sounds_page(DataConnector &connector);
 #ifdef HAVE_DISTRIBUTION
   Gtk::Widget *create_network_page();
 #endif
@@ -125,7 +128,8 @@ private:
 
   std::shared_ptr<IApplication> app;
   SoundTheme::Ptr sound_theme;
-  DataConnector *connector;
+  std::vector<std::unique_ptr<DataConnector>> connectors;
+  std::vector<sigc::connection> connector_connections;
   Gtk::TreeView sound_treeview;
   SoundModel sound_model;
   Glib::RefPtr<Gtk::ListStore> sound_store;
@@ -158,7 +162,7 @@ private:
   Gtk::Button *debug_btn{nullptr};
   void on_debug_pressed();
 
-  Gtk::Widget *create_monitoring_page();
+  Gtk::Widget *create_monitoring_page(DataConnector &connector);
 
 #if defined(PLATFORM_OS_WINDOWS)
   Gtk::CheckButton *monitor_type_cb{nullptr};
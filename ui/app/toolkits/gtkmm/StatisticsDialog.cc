@@ -24,7 +24,6 @@
 #include <sstream>
 
 #include <ctime>
-#include <cstring>
 
 #include <gtkmm.h>
 
@@ -37,6 +36,7 @@
 #include "ui/Text.hh"
 #include "GtkUtil.hh"
 #include "ui/Locale.hh"
+#include "utils/Calendar.hh"
 
 using namespace std;
 using namespace workrave;
@@ -297,35 +297,28 @@ StatisticsDialog::create_activity_page(Gtk::Widget *tnotebook)
 }
 
 void
-StatisticsDialog::display_statistics(IStatistics::DailyStats *stats)
+StatisticsDialog::display_statistics(const IStatistics::DailyStatsView &stats)
 {
-  IStatistics::DailyStats empty{};
-  bool is_empty;
-
-  is_empty = stats == nullptr;
-  if (is_empty)
-    {
-      stats = &empty;
-    }
-
-  if (stats->start.tm_year == 0 /*stats->is_empty() */)
+  if (stats.is_empty())
     {
       date_label->set_text("-");
     }
   else
     {
+      struct tm start_time = stats.get_start();
+      struct tm stop_time = stats.get_stop();
       char date[100];
       char start[100];
       char stop[100];
-      strftime(date, sizeof(date), "%x", &stats->start);
-      strftime(start, sizeof(start), "%X", &stats->start);
-      strftime(stop, sizeof(stop), "%X", &stats->stop);
+      strftime(date, sizeof(date), "%x", &start_time);
+      strftime(start, sizeof(start), "%X", &start_time);
+      strftime(stop, sizeof(stop), "%X", &stop_time);
       char buf[200];
       sprintf(buf, _("%s, from %s to %s"), date, start, stop);
       date_label->set_text(buf);
     }
 
-  int64_t value = stats->misc_stats[IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME];
+  int64_t value = stats.get_misc_stat(IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME);
   daily_usage_time_label->set_text(Text::time_to_string(value));
 
   // Put the breaks in table.
@@ -333,37 +326,37 @@ StatisticsDialog::display_statistics(IStatistics::DailyStats *stats)
     {
       stringstream ss;
 
-      value = stats->break_stats[i][IStatistics::STATS_BREAKVALUE_UNIQUE_BREAKS];
+      value = stats.get_break_stat(BreakId(i), IStatistics::STATS_BREAKVALUE_UNIQUE_BREAKS);
       ss.str("");
       ss << value;
       break_labels[i][0]->set_text(ss.str());
 
-      value = stats->break_stats[i][IStatistics::STATS_BREAKVALUE_PROMPTED] - value;
+      value = stats.get_break_stat(BreakId(i), IStatistics::STATS_BREAKVALUE_PROMPTED) - value;
       ss.str("");
       ss << value;
       break_labels[i][1]->set_text(ss.str());
 
-      value = stats->break_stats[i][IStatistics::STATS_BREAKVALUE_TAKEN];
+      value = stats.get_break_stat(BreakId(i), IStatistics::STATS_BREAKVALUE_TAKEN);
       ss.str("");
       ss << value;
       break_labels[i][2]->set_text(ss.str());
 
-      value = stats->break_stats[i][IStatistics::STATS_BREAKVALUE_NATURAL_TAKEN];
+      value = stats.get_break_stat(BreakId(i), IStatistics::STATS_BREAKVALUE_NATURAL_TAKEN);
       ss.str("");
       ss << value;
       break_labels[i][3]->set_text(ss.str());
 
-      value = stats->break_stats[i][IStatistics::STATS_BREAKVALUE_SKIPPED];
+      value = stats.get_break_stat(BreakId(i), IStatistics::STATS_BREAKVALUE_SKIPPED);
       ss.str("");
       ss << value;
       break_labels[i][4]->set_text(ss.str());
 
-      value = stats->break_stats[i][IStatistics::STATS_BREAKVALUE_POSTPONED];
+      value = stats.get_break_stat(BreakId(i), IStatistics::STATS_BREAKVALUE_POSTPONED);
       ss.str("");
       ss << value;
       break_labels[i][5]->set_text(ss.str());
 
-      value = stats->break_stats[i][IStatistics::STATS_BREAKVALUE_TOTAL_OVERDUE];
+      value = stats.get_break_stat(BreakId(i), IStatistics::STATS_BREAKVALUE_TOTAL_OVERDUE);
 
       break_labels[i][6]->set_text(Text::time_to_string(value));
     }
@@ -374,29 +367,29 @@ StatisticsDialog::display_statistics(IStatistics::DailyStats *stats)
     {
       // Label not available is OS X
 
-      value = stats->misc_stats[IStatistics::STATS_VALUE_TOTAL_MOVEMENT_TIME];
+      value = stats.get_misc_stat(IStatistics::STATS_VALUE_TOTAL_MOVEMENT_TIME);
       if (value > 24 * 60 * 60)
         {
           value = 0;
         }
       activity_labels[0]->set_text(Text::time_to_string(value));
 
-      value = stats->misc_stats[IStatistics::STATS_VALUE_TOTAL_MOUSE_MOVEMENT];
+      value = stats.get_misc_stat(IStatistics::STATS_VALUE_TOTAL_MOUSE_MOVEMENT);
       ss.str("");
       stream_distance(ss, value);
       activity_labels[1]->set_text(ss.str());
 
-      value = stats->misc_stats[IStatistics::STATS_VALUE_TOTAL_CLICK_MOVEMENT];
+      value = stats.get_misc_stat(IStatistics::STATS_VALUE_TOTAL_CLICK_MOVEMENT);
       ss.str("");
       stream_distance(ss, value);
       activity_labels[2]->set_text(ss.str());
 
-      value = stats->misc_stats[IStatistics::STATS_VALUE_TOTAL_CLICKS];
+      value = stats.get_misc_stat(IStatistics::STATS_VALUE_TOTAL_CLICKS);
       ss.str("");
       ss << value;
       activity_labels[3]->set_text(ss.str());
 
-      value = stats->misc_stats[IStatistics::STATS_VALUE_TOTAL_KEYSTROKES];
+      value = stats.get_misc_stat(IStatistics::STATS_VALUE_TOTAL_KEYSTROKES);
       ss.str("");
       ss << value;
       activity_labels[4]->set_text(ss.str());
@@ -409,35 +402,25 @@ StatisticsDialog::display_week_statistics()
   guint y, m, d;
   calendar->get_date(y, m, d);
 
-  std::tm timeinfo{};
-  std::memset(&timeinfo, 0, sizeof(timeinfo));
-  timeinfo.tm_mday = d;
-  timeinfo.tm_mon = m;
-  timeinfo.tm_year = y - 1900;
+  using workrave::utils::Calendar;
 
-  std::time_t t = std::mktime(&timeinfo);
-  std::tm const *time_loc = std::localtime(&t);
-
-  int offset = (time_loc->tm_wday - Locale::get_week_start() + 7) % 7;
+  // GTK months are 0-based.
+  int32_t day = Calendar::days_from_civil(static_cast<int>(y), static_cast<int>(m) + 1, static_cast<int>(d));
+  int offset = (Calendar::weekday(day) - Locale::get_week_start() + 7) % 7;
   int64_t total_week = 0;
   for (int i = 0; i < 7; i++)
     {
-      std::memset(&timeinfo, 0, sizeof(timeinfo));
-      timeinfo.tm_mday = d - offset + i;
-      timeinfo.tm_mon = m;
-      timeinfo.tm_year = y - 1900;
-      t = std::mktime(&timeinfo);
-      time_loc = std::localtime(&t);
+      workrave::utils::CivilDate date = Calendar::civil_from_days(day - offset + i);
 
       int idx, next, prev;
-      statistics->get_day_index_by_date(time_loc->tm_year + 1900, time_loc->tm_mon + 1, time_loc->tm_mday, idx, next, prev);
+      statistics->get_day_index_by_date(date.year, date.month, date.day, idx, next, prev);
 
       if (idx >= 0)
         {
-          IStatistics::DailyStats *stats = statistics->get_day(idx);
-          if (stats != nullptr)
+          IStatistics::DailyStatsView stats = statistics->get_day(idx);
+          if (stats)
             {
-              total_week += stats->misc_stats[IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME];
+              total_week += stats.get_misc_stat(IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME);
             }
 
           update_usage_real_time |= (idx == 0);
@@ -453,27 +436,7 @@ StatisticsDialog::display_month_statistics()
   guint y, m, d;
   calendar->get_date(y, m, d);
 
-  guint max_mday;
-  if (m == 3 || m == 5 || m == 8 || m == 10)
-    {
-      max_mday = 30;
-    }
-  else if (m == 1)
-    {
-      bool is_leap = (y % 4 == 0 && y % 100 != 0) || (y % 400 == 0);
-      if (is_leap)
-        {
-          max_mday = 29;
-        }
-      else
-        {
-          max_mday = 28;
-        }
-    }
-  else
-    {
-      max_mday = 31;
-    }
+  guint max_mday = workrave::utils::Calendar::days_in_month(static_cast<int>(y), static_cast<int>(m) + 1);
 
   int64_t total_month = 0;
   for (guint i = 1; i <= max_mday; i++)
@@ -482,10 +445,10 @@ StatisticsDialog::display_month_statistics()
       statistics->get_day_index_by_date(y, m + 1, i, idx, next, prev);
       if (idx >= 0)
         {
-          IStatistics::DailyStats *stats = statistics->get_day(idx);
-          if (stats != nullptr)
+          IStatistics::DailyStatsView stats = statistics->get_day(idx);
+          if (stats)
             {
-              total_month += stats->misc_stats[IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME];
+              total_month += stats.get_misc_stat(IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME);
             }
 
           update_usage_real_time |= (idx == 0);
@@ -543,9 +506,9 @@ StatisticsDialog::get_calendar_day_index(int &idx, int &next, int &prev)
 void
 StatisticsDialog::set_calendar_day_index(int idx)
 {
-  IStatistics::DailyStats *stats = statistics->get_day(idx);
-  calendar->select_month(stats->start.tm_mon, stats->start.tm_year + 1900);
-  calendar->select_day(stats->start.tm_mday);
+  struct tm start = statistics->get_day(idx).get_start();
+  calendar->select_month(start.tm_mon, start.tm_year + 1900);
+  calendar->select_day(start.tm_mday);
   display_calendar_date();
 }
 
@@ -554,11 +517,9 @@ StatisticsDialog::display_calendar_date()
 {
   int idx, next, prev;
   get_calendar_day_index(idx, next, prev);
-  IStatistics::DailyStats *stats = nullptr;
   if (idx >= 0)
     {
-      stats = statistics->get_day(idx);
-      display_statistics(stats);
+      display_statistics(statistics->get_day(idx));
     }
   else
     {
@@ -87,6 +87,21 @@ TimerPreferencesPanel::~TimerPreferencesPanel()
   delete connector;
 }
 
+//! Follows the configuration only while the panel is visible.
+void
+TimerPreferencesPanel::on_map()
+{
+  connector->set_active(true);
+  Gtk::VBox::on_map();
+}
+
+void
+TimerPreferencesPanel::on_unmap()
+{
+  connector->set_active(false);
+  Gtk::VBox::on_unmap();
+}
+
 Gtk::Widget *
 TimerPreferencesPanel::create_prelude_panel()
 {
@@ -46,6 +46,10 @@ public:
                         Glib::RefPtr<Gtk::SizeGroup> vsize_group);
   ~TimerPreferencesPanel() override;
 
+protected:
+  void on_map() override;
+  void on_unmap() override;
+
 private:
   bool on_preludes_changed(const std::string &key, bool write);
   void on_exercises_changed();
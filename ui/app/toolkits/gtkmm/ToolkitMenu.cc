@@ -147,7 +147,7 @@ ToolkitSubMenuEntry::init()
     }
 
   add_section();
-  for (auto menu_to_add: node->get_children())
+  for (const auto &menu_to_add: node->get_children())
     {
       ToolkitMenuEntry::Ptr child = ToolkitMenuEntryFactory::create(get_context(), this, menu_to_add);
       children.push_back(child);
@@ -194,7 +194,7 @@ ToolkitRadioGroupMenuEntry::ToolkitRadioGroupMenuEntry(ToolkitMenuContext::Ptr c
 
   workrave::utils::connect(node->signal_changed(), this, [action, node]() { action->change_state(node->get_selected_value()); });
 
-  for (auto child_node: node->get_children())
+  for (const auto &child_node: node->get_children())
     {
       auto child = std::make_shared<ToolkitRadioMenuEntry>(context, parent, child_node);
       children.push_back(child);
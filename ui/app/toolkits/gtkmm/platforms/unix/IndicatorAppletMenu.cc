@@ -145,7 +145,7 @@ IndicatorSubMenuEntry::init()
     }
   item = new_item;
 
-  for (auto menu_to_add: node->get_children())
+  for (const auto &menu_to_add: node->get_children())
     {
       IndicatorMenuEntry::Ptr child = IndicatorMenuEntryFactory::create(this, menu_to_add);
       children.push_back(child);
@@ -165,7 +165,7 @@ void IndicatorSubMenuEntry::add_section(){};
 IndicatorRadioGroupMenuEntry::IndicatorRadioGroupMenuEntry(IndicatorSubMenuEntry *parent, menus::RadioGroupNode::Ptr node)
 {
   item = parent->get_item();
-  for (auto child_node: node->get_children())
+  for (const auto &child_node: node->get_children())
     {
       auto child = std::make_shared<IndicatorRadioMenuEntry>(parent, child_node);
       children.push_back(child);
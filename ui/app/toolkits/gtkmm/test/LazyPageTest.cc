@@ -0,0 +1,173 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#define BOOST_TEST_MODULE workrave_lazy_page
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtkmm.h>
+
+#include "LazyPage.hh"
+
+namespace
+{
+  constexpr int NUM_PAGES = 12;
+  constexpr int NUM_ROWS = 40;
+
+  bool init_gtk()
+  {
+    if (gtk_init_check(nullptr, nullptr) == FALSE)
+      {
+        return false;
+      }
+    Gtk::Main::init_gtkmm_internals();
+    return true;
+  }
+
+  //! Tests are skipped when there is no display, e.g. run them under xvfb-run or with GDK_BACKEND=broadway.
+  boost::test_tools::assertion_result display_available(boost::unit_test::test_unit_id)
+  {
+    static bool available = init_gtk();
+    return available;
+  }
+
+  template<typename Predicate>
+  bool run_until(Predicate done)
+  {
+    Glib::RefPtr<Glib::MainContext> context = Glib::MainContext::get_default();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!done() && std::chrono::steady_clock::now() < deadline)
+      {
+        if (!context->iteration(false))
+          {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          }
+      }
+    return done();
+  }
+
+  //! A page about the size of the larger preferences pages.
+  Gtk::Widget *create_page()
+  {
+    Gtk::Grid *grid = Gtk::manage(new Gtk::Grid());
+    for (int row = 0; row < NUM_ROWS; row++)
+      {
+        grid->attach(*Gtk::manage(new Gtk::CheckButton("Option")), 0, row, 1, 1);
+        grid->attach(*Gtk::manage(new Gtk::SpinButton(Gtk::Adjustment::create(row, 0, 100))), 1, row, 1, 1);
+
+        Gtk::ComboBoxText *combo = Gtk::manage(new Gtk::ComboBoxText());
+        combo->append("First");
+        combo->append("Second");
+        combo->set_active(0);
+        grid->attach(*combo, 2, row, 1, 1);
+      }
+    return grid;
+  }
+
+  //! Milliseconds from creating a notebook window until it is first drawn.
+  double measure_first_paint(bool lazy)
+  {
+    auto start = std::chrono::steady_clock::now();
+
+    Gtk::Window window;
+    Gtk::Notebook notebook;
+    for (int i = 0; i < NUM_PAGES; i++)
+      {
+        Gtk::Widget *page = lazy ? Gtk::manage(new LazyPage(create_page)) : create_page();
+        notebook.append_page(*page, "Page");
+      }
+
+    bool painted = false;
+    window.signal_draw().connect([&painted](const Cairo::RefPtr<Cairo::Context> &) {
+      painted = true;
+      return false;
+    });
+
+    window.add(notebook);
+    window.show_all();
+    BOOST_REQUIRE(run_until([&painted]() { return painted; }));
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(lazy_page)
+
+BOOST_AUTO_TEST_CASE(test_created_when_shown, *boost::unit_test::precondition(display_available))
+{
+  Gtk::Window window;
+  Gtk::Notebook notebook;
+
+  int created = 0;
+  std::vector<LazyPage *> pages;
+  for (int i = 0; i < 3; i++)
+    {
+      LazyPage *page = Gtk::manage(new LazyPage([&created]() {
+        created++;
+        return new Gtk::Label("Page");
+      }));
+      notebook.append_page(*page, "Page");
+      pages.push_back(page);
+    }
+
+  std::vector<bool> visibility;
+  pages[1]->signal_visibility_changed().connect([&visibility](bool visible) { visibility.push_back(visible); });
+
+  window.add(notebook);
+  window.show_all();
+  BOOST_REQUIRE(run_until([&pages]() { return pages[0]->get_mapped(); }));
+
+  BOOST_CHECK(pages[0]->is_created());
+  BOOST_CHECK(!pages[1]->is_created());
+  BOOST_CHECK(!pages[2]->is_created());
+  BOOST_CHECK_EQUAL(created, 1);
+
+  notebook.set_current_page(1);
+  BOOST_REQUIRE(run_until([&pages]() { return pages[1]->get_mapped(); }));
+  BOOST_CHECK(pages[1]->is_created());
+  BOOST_CHECK_EQUAL(created, 2);
+
+  notebook.set_current_page(2);
+  BOOST_REQUIRE(run_until([&pages]() { return pages[2]->get_mapped(); }));
+  notebook.set_current_page(1);
+  BOOST_REQUIRE(run_until([&pages]() { return pages[1]->get_mapped(); }));
+
+  // Showing a page again does not recreate it.
+  BOOST_CHECK_EQUAL(created, 3);
+  BOOST_CHECK(visibility == std::vector<bool>({true, false, true}));
+}
+
+BOOST_AUTO_TEST_CASE(test_first_paint, *boost::unit_test::precondition(display_available))
+{
+  // Warm up theme and font caches.
+  measure_first_paint(false);
+
+  double eager = measure_first_paint(false);
+  double lazy = measure_first_paint(true);
+
+  BOOST_TEST_MESSAGE(NUM_PAGES << " pages: first paint after " << eager << " ms when created up front, " << lazy
+                               << " ms when created on demand");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,73 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "LazyPage.hh"
+
+LazyPage::LazyPage(Factory factory)
+  : Gtk::VBox(false, 0)
+  , factory(std::move(factory))
+{
+}
+
+bool
+LazyPage::is_created() const
+{
+  return created;
+}
+
+//! Creates the contents of the page, if not done yet.
+void
+LazyPage::create()
+{
+  if (created)
+    {
+      return;
+    }
+
+  created = true;
+  Gtk::Widget *widget = Gtk::manage(factory());
+  factory = nullptr;
+
+  pack_start(*widget, true, true, 0);
+  widget->show_all();
+}
+
+sigc::signal<void, bool> &
+LazyPage::signal_visibility_changed()
+{
+  return visibility_changed_signal;
+}
+
+void
+LazyPage::on_map()
+{
+  // Create the contents before mapping so that they are mapped along with the page.
+  create();
+  Gtk::VBox::on_map();
+  visibility_changed_signal.emit(true);
+}
+
+void
+LazyPage::on_unmap()
+{
+  visibility_changed_signal.emit(false);
+  Gtk::VBox::on_unmap();
+}
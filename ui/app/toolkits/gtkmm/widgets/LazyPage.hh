@@ -0,0 +1,54 @@
+// Copyright (C) 2026 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef LAZY_PAGE_HH
+#define LAZY_PAGE_HH
+
+#include <functional>
+
+#include <gtkmm/box.h>
+#include <sigc++/sigc++.h>
+
+//! Page of a notebook whose contents are created the first time it is shown.
+/*!
+ *  visibility_changed is emitted whenever the page is mapped or unmapped,
+ *  after the contents are created, so that the page can stop updating
+ *  its widgets while it is hidden.
+ */
+class LazyPage : public Gtk::VBox
+{
+public:
+  using Factory = std::function<Gtk::Widget *()>;
+
+  explicit LazyPage(Factory factory);
+
+  bool is_created() const;
+  void create();
+
+  sigc::signal<void, bool> &signal_visibility_changed();
+
+protected:
+  void on_map() override;
+  void on_unmap() override;
+
+private:
+  Factory factory;
+  bool created{false};
+  sigc::signal<void, bool> visibility_changed_signal;
+};
+
+#endif // LAZY_PAGE_HH
@@ -22,6 +22,7 @@
 #include "debug.hh"
 
 #include <cassert>
+#include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <sstream>
@@ -30,8 +31,8 @@
 #include "ui/Text.hh"
 #include "GtkUtil.hh"
 
-const int MARGINX = 4;
-const int MARGINY = 2;
+const int MARGINX = TimeBarRenderer::MARGINX;
+const int MARGINY = TimeBarRenderer::MARGINY;
 const int MIN_HORIZONTAL_BAR_HEIGHT = 20; // stolen from gtk's progress bar
 
 using namespace std;
@@ -80,49 +81,41 @@ TimeBar::TimeBar()
 void
 TimeBar::set_progress(int value, int max_value)
 {
-  if (value > max_value)
-    {
-      value = max_value;
-    }
-
-  bar_value = value;
-  bar_max_value = max_value;
+  renderer.set_progress(value, max_value);
 }
 
 void
 TimeBar::set_secondary_progress(int value, int max_value)
 {
-  if (value > max_value)
-    {
-      value = max_value;
-    }
-
-  secondary_bar_value = value;
-  secondary_bar_max_value = max_value;
+  renderer.set_secondary_progress(value, max_value);
 }
 
 void
 TimeBar::set_text(string text)
 {
-  bar_text = text;
+  if (text != bar_text || !text_layout)
+    {
+      bar_text = text;
+      update_text_layout();
+    }
 }
 
 void
 TimeBar::set_text_alignment(int align)
 {
-  bar_text_align = align;
+  renderer.set_text_alignment(align);
 }
 
 void
 TimeBar::set_bar_color(TimerColorId color)
 {
-  bar_color = color;
+  renderer.set_bar_color(color);
 }
 
 void
 TimeBar::set_secondary_bar_color(TimerColorId color)
 {
-  secondary_bar_color = color;
+  renderer.set_secondary_bar_color(color);
 }
 
 void
@@ -135,13 +128,51 @@ void
 TimeBar::set_rotation(int r)
 {
   rotation = r;
+  renderer.set_rotation(r);
+
+  if (text_layout)
+    {
+      Pango::Matrix matrix = PANGO_MATRIX_INIT;
+      pango_matrix_rotate(&matrix, 360 - rotation);
+      text_layout->get_context()->set_matrix(matrix);
+      text_layout->context_changed();
+      update_text_layout();
+    }
+
   queue_resize();
 }
 
+//! Redraws only the part of the bar that changed.
 void
 TimeBar::update()
 {
-  queue_draw();
+  TimeBarRenderer::Rect damage = renderer.get_damage();
+  if (!damage.is_empty())
+    {
+      queue_draw_area(damage.x, damage.y, damage.width, damage.height);
+    }
+}
+
+void
+TimeBar::update_text_layout()
+{
+  if (!text_layout)
+    {
+      text_layout = create_pango_layout(bar_text);
+
+      Pango::Matrix matrix = PANGO_MATRIX_INIT;
+      pango_matrix_rotate(&matrix, 360 - rotation);
+      text_layout->get_context()->set_matrix(matrix);
+      text_layout->context_changed();
+    }
+  else
+    {
+      text_layout->set_text(bar_text);
+    }
+
+  int text_width, text_height;
+  text_layout->get_pixel_size(text_width, text_height);
+  renderer.set_text(bar_text, text_width, text_height);
 }
 
 void
@@ -154,6 +185,23 @@ TimeBar::on_size_allocate(Gtk::Allocation &allocation)
     {
       get_window()->move_resize(allocation.get_x(), allocation.get_y(), allocation.get_width(), allocation.get_height());
     }
+
+  renderer.set_size(allocation.get_width() - 2, allocation.get_height());
+  frame_surface.clear();
+}
+
+void
+TimeBar::on_style_updated()
+{
+  Gtk::DrawingArea::on_style_updated();
+
+  frame_surface.clear();
+  if (text_layout)
+    {
+      text_layout->context_changed();
+      update_text_layout();
+    }
+  renderer.invalidate();
 }
 
 void
@@ -240,215 +288,90 @@ TimeBar::get_preferred_height_for_width_vfunc(int /* width */, int &minimum_heig
 bool
 TimeBar::on_draw(const Cairo::RefPtr<Cairo::Context> &cr)
 {
-  const int border_size = 1;
-
   Glib::RefPtr<Gtk::StyleContext> style_context = get_style_context();
-  Gtk::Allocation allocation = get_allocation();
 
   style_context->context_save();
   style_context->add_class(GTK_STYLE_CLASS_FRAME);
+  style_context->set_state(Gtk::STATE_FLAG_ACTIVE);
+  background_text_color = style_context->get_color(Gtk::STATE_FLAG_ACTIVE);
 
-  // Physical width/height
-  int win_w = allocation.get_width() - 2;
-  int win_h = allocation.get_height();
-
-  // Logical width/height
-  // width = direction of bar
-  int win_lw, win_lh;
-  if (rotation == 0 || rotation == 180)
+  if (!frame_surface)
     {
-      win_lw = win_w;
-      win_lh = win_h;
+      render_frame(cr);
     }
-  else
+  if (!text_layout)
     {
-      win_lw = win_h;
-      win_lh = win_w;
+      update_text_layout();
     }
 
-  // Draw background
-  style_context->set_state(Gtk::STATE_FLAG_ACTIVE);
-  Gdk::RGBA back_color = style_context->get_background_color();
-  set_color(cr, back_color);
+  double x1, y1, x2, y2;
+  cr->get_clip_extents(x1, y1, x2, y2);
+  TimeBarRenderer::Rect clip{static_cast<int>(std::floor(x1)),
+                             static_cast<int>(std::floor(y1)),
+                             static_cast<int>(std::ceil(x2) - std::floor(x1)),
+                             static_cast<int>(std::ceil(y2) - std::floor(y1))};
 
-  // clip to the area indicated by the expose event so that we only redraw
-  // the portion of the window that needs to be redrawn
-  cr->rectangle(0, 0, win_w, win_h);
-  cr->clip();
-
-  style_context->render_background(cr, 0, 0, win_w - 1, win_h - 1);
-  style_context->render_frame(cr, 0, 0, win_w - 1, win_h - 1);
-
-  // set_color(cr, back_color);
-  // cr->rectangle(border_size, border_size, win_w - 2*border_size, win_h - 2*border_size);
-  // cr->fill();
-
-  // Bar
-  int bar_width = 0;
-  if (bar_max_value > 0)
-    {
-      bar_width = (bar_value * (win_lw - 2 * border_size - 1)) / bar_max_value;
-    }
+  draw_context = cr;
+  renderer.paint(*this, clip);
+  draw_context.clear();
 
-  // Secondary bar
-  int sbar_width = 0;
-  if (secondary_bar_max_value > 0)
-    {
-      sbar_width = (secondary_bar_value * (win_lw - 2 * border_size - 1)) / secondary_bar_max_value;
-    }
-
-  int bar_height = win_lh - 2 * border_size - 1;
+  style_context->context_restore();
 
-  if (sbar_width > 0)
-    {
-      // Overlap
-
-      // We should assert() because this is not supported
-      // but there are some weird boundary cases
-      // in which this still happens.. need to check
-      // this out some time.
-      // assert(secondary_bar_color == TimerColorId::Inactive);
-      TimerColorId overlap_color;
-      switch (bar_color)
-        {
-        case TimerColorId::Active:
-          overlap_color = TimerColorId::InactiveOverActive;
-          break;
-        case TimerColorId::Overdue:
-          overlap_color = TimerColorId::InactiveOverOverdue;
-          break;
-        default:
-          // We could abort() because this is not supported
-          // but there are some weird boundary cases
-          // in which this still happens.. need to check
-          // this out some time.
-          overlap_color = TimerColorId::InactiveOverActive;
-        }
-
-      if (sbar_width >= bar_width)
-        {
-          if (bar_width)
-            {
-              set_color(cr, bar_colors[overlap_color]);
-              draw_bar(cr, border_size, border_size, bar_width, bar_height, win_lw, win_lh);
-            }
-          if (sbar_width > bar_width)
-            {
-              set_color(cr, bar_colors[secondary_bar_color]);
-              draw_bar(cr, border_size + bar_width, border_size, sbar_width - bar_width, bar_height, win_lw, win_lh);
-            }
-        }
-      else
-        {
-          if (sbar_width)
-            {
-              set_color(cr, bar_colors[overlap_color]);
-              draw_bar(cr, border_size, border_size, sbar_width, bar_height, win_lw, win_lh);
-            }
-          set_color(cr, bar_colors[bar_color]);
-          draw_bar(cr, border_size + sbar_width, border_size, bar_width - sbar_width, bar_height, win_lw, win_lh);
-        }
-    }
-  else
-    {
-      // No overlap
-      set_color(cr, bar_colors[bar_color]);
-      draw_bar(cr, border_size, border_size, bar_width, bar_height, win_lw, win_lh);
-    }
+  return Gtk::Widget::on_draw(cr);
+}
 
-  // Text
-  Pango::Matrix matrix = PANGO_MATRIX_INIT;
-  pango_matrix_rotate(&matrix, 360 - rotation);
+void
+TimeBar::render_frame(const Cairo::RefPtr<Cairo::Context> &cr)
+{
+  int win_w = std::max(renderer.get_width(), 1);
+  int win_h = std::max(renderer.get_height(), 1);
 
-  Glib::RefPtr<Pango::Layout> pl1 = create_pango_layout(bar_text);
-  Glib::RefPtr<Pango::Context> pc1 = pl1->get_context();
+  frame_surface = Cairo::Surface::create(cr->get_target(), Cairo::CONTENT_COLOR_ALPHA, win_w, win_h);
+  Cairo::RefPtr<Cairo::Context> frame_cr = Cairo::Context::create(frame_surface);
 
-  pc1->set_matrix(matrix);
+  Glib::RefPtr<Gtk::StyleContext> style_context = get_style_context();
+  style_context->render_background(frame_cr, 0, 0, win_w - 1, win_h - 1);
+  style_context->render_frame(frame_cr, 0, 0, win_w - 1, win_h - 1);
+}
 
-  int text_width, text_height;
-  pl1->get_pixel_size(text_width, text_height);
+void
+TimeBar::draw_frame(const TimeBarRenderer::Rect &clip)
+{
+  draw_context->save();
+  draw_context->rectangle(clip.x, clip.y, clip.width, clip.height);
+  draw_context->clip();
+  draw_context->set_source(frame_surface, 0, 0);
+  draw_context->paint();
+  draw_context->restore();
+}
 
-  int text_x, text_y;
+void
+TimeBar::fill_rect(const TimeBarRenderer::Rect &rect, TimerColorId color)
+{
+  set_color(draw_context, bar_colors[color]);
+  draw_context->rectangle(rect.x, rect.y, rect.width, rect.height);
+  draw_context->fill();
+}
 
-  Gdk::Rectangle rect1, rect2;
+void
+TimeBar::draw_text(int x, int y, const TimeBarRenderer::Rect &clip, bool on_bar)
+{
+  draw_context->save();
+  draw_context->rectangle(clip.x, clip.y, clip.width, clip.height);
+  draw_context->clip();
 
-  if (rotation == 0 || rotation == 180)
+  if (on_bar)
     {
-      if (win_w - text_width - MARGINX > 0)
-        {
-          if (bar_text_align > 0)
-            text_x = (win_w - text_width - MARGINX);
-          else if (bar_text_align < 0)
-            text_x = MARGINX;
-          else
-            text_x = (win_w - text_width) / 2;
-        }
-      else
-        {
-          text_x = MARGINX;
-        }
-      text_y = (win_h - text_height) / 2;
-
-      int left_width = (bar_width > sbar_width) ? bar_width : sbar_width;
-      left_width += border_size;
-
-      Gdk::Rectangle left_rect(0, 0, left_width, win_h);
-      Gdk::Rectangle right_rect(left_width, 0, win_w - left_width, win_h);
-
-      rect1 = left_rect;
-      rect2 = right_rect;
+      set_color(draw_context, bar_text_color);
     }
   else
     {
-      if (win_h - text_width - MARGINY > 0)
-        {
-          int a = bar_text_align;
-          if (rotation == 270)
-            {
-              a *= -1;
-            }
-          if (a > 0)
-            text_y = (win_h - text_width - MARGINY);
-          else if (a < 0)
-            text_y = MARGINY;
-          else
-            text_y = (win_h - text_width) / 2;
-        }
-      else
-        {
-          text_y = MARGINY;
-        }
-
-      text_x = (win_w - text_height) / 2;
-
-      int left_width = (bar_width > sbar_width) ? bar_width : sbar_width;
-      left_width += border_size;
-
-      Gdk::Rectangle up_rect(0, 0, win_w, left_width);
-      Gdk::Rectangle down_rect(0, left_width, win_w, win_h - left_width);
-
-      rect1 = up_rect;
-      rect2 = down_rect;
+      set_color(draw_context, background_text_color);
     }
 
-  cr->reset_clip();
-  cr->rectangle(rect1.get_x(), rect1.get_y(), rect1.get_width(), rect1.get_height());
-  cr->clip();
-
-  cr->move_to(text_x, text_y);
-  set_color(cr, bar_text_color);
-  pl1->show_in_cairo_context(cr);
-
-  cr->reset_clip();
-  cr->rectangle(rect2.get_x(), rect2.get_y(), rect2.get_width(), rect2.get_height());
-  cr->clip();
-
-  set_color(cr, style_context->get_color(Gtk::STATE_FLAG_ACTIVE));
-  cr->move_to(text_x, text_y);
-  pl1->show_in_cairo_context(cr);
-  style_context->context_restore();
-
-  return Gtk::Widget::on_draw(cr);
+  draw_context->move_to(x, y);
+  text_layout->show_in_cairo_context(draw_context);
+  draw_context->restore();
 }
 
 void
@@ -462,20 +385,3 @@ TimeBar::set_color(const Cairo::RefPtr<Cairo::Context> &cr, const Gdk::RGBA &col
 {
   cr->set_source_rgba(color.get_red(), color.get_green(), color.get_blue(), 1);
 }
-
-void
-TimeBar::draw_bar(const Cairo::RefPtr<Cairo::Context> &cr, int x, int y, int width, int height, int winw, int winh)
-{
-  (void)winh;
-
-  if (rotation == 0 || rotation == 180)
-    {
-      cr->rectangle(x, y, width, height);
-      cr->fill();
-    }
-  else
-    {
-      cr->rectangle(y, winw - x - width, height, width);
-      cr->fill();
-    }
-}
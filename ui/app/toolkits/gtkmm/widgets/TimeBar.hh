@@ -24,8 +24,11 @@
 #include <gdkmm.h>
 
 #include "ui/UiTypes.hh"
+#include "ui/TimeBarRenderer.hh"
 
-class TimeBar : public Gtk::DrawingArea
+class TimeBar
+  : public Gtk::DrawingArea
+  , private TimeBarRenderer::IPainter
 {
 public:
   TimeBar();
@@ -48,10 +51,15 @@ public:
   void get_preferred_size(int &width, int &height) const;
 
 private:
-  void draw_bar(const Cairo::RefPtr<Cairo::Context> &cr, int x, int y, int width, int height, int winw, int winh);
   void set_color(const Cairo::RefPtr<Cairo::Context> &cr, const Gdk::Color &color);
   void set_color(const Cairo::RefPtr<Cairo::Context> &cr, const Gdk::RGBA &color);
   void set_text_color(Gdk::Color color);
+  void update_text_layout();
+  void render_frame(const Cairo::RefPtr<Cairo::Context> &cr);
+
+  void draw_frame(const TimeBarRenderer::Rect &clip) override;
+  void fill_rect(const TimeBarRenderer::Rect &rect, TimerColorId color) override;
+  void draw_text(int x, int y, const TimeBarRenderer::Rect &clip, bool on_bar) override;
 
 protected:
   Gtk::SizeRequestMode get_request_mode_vfunc() const override;
@@ -60,37 +68,32 @@ protected:
   void get_preferred_width_for_height_vfunc(int height, int &minimum_width, int &natural_width) const override;
   void get_preferred_height_for_width_vfunc(int width, int &minimum_height, int &natural_height) const override;
   void on_size_allocate(Gtk::Allocation &allocation) override;
+  void on_style_updated() override;
   bool on_draw(const Cairo::RefPtr<Cairo::Context> &cr) override;
 
 private:
   static std::map<TimerColorId, Gdk::Color> bar_colors;
 
-  //! Color of the time-bar.
-  TimerColorId bar_color;
-
-  //! Color of the time-bar.
-  TimerColorId secondary_bar_color;
+  //! Layout, invalidation and painting order of the bar.
+  TimeBarRenderer renderer;
 
-  //! Color of the text.
+  //! Color of the text on top of the bar.
   Gdk::Color bar_text_color;
 
-  //! The current value.
-  int bar_value{0};
-
-  //! The maximum value.
-  int bar_max_value{0};
-
-  //! The current value.
-  int secondary_bar_value{0};
-
-  //! The maximum value.
-  int secondary_bar_max_value{0};
+  //! Color of the text on the background, from the theme.
+  Gdk::RGBA background_text_color;
 
   //! Text to show;
   std::string bar_text;
 
-  //! Text alignment
-  int bar_text_align{0};
+  //! Layout of the text, kept between draws.
+  Glib::RefPtr<Pango::Layout> text_layout;
+
+  //! Themed background and frame, rendered once per size and theme.
+  Cairo::RefPtr<Cairo::Surface> frame_surface;
+
+  //! Context of the draw in progress.
+  Cairo::RefPtr<Cairo::Context> draw_context;
 
   //! Bar rotation (clockwise degrees)
   int rotation{0};
@@ -21,6 +21,8 @@
 
 #include "DebugDialog.hh"
 
+#include <sstream>
+
 #include <QStyle>
 #include <QtGui>
 
@@ -39,7 +41,54 @@ DebugDialog::DebugDialog()
 {
   setWindowTitle(tr("Debug Workrave"));
   setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint);
+  resize(1024, 800);
+
+  log_view = new QPlainTextEdit();
+  log_view->setReadOnly(true);
+
+  metrics_view = new QPlainTextEdit();
+  metrics_view->setReadOnly(true);
+
+  auto *tabs = new QTabWidget();
+  tabs->addTab(log_view, tr("Log"));
+  tabs->addTab(metrics_view, tr("Metrics"));
+
+  auto *layout = new QVBoxLayout(this);
+  layout->addWidget(tabs);
+
+  timer = new QTimer(this);
+  connect(timer, &QTimer::timeout, this, &DebugDialog::on_timer);
+
+  Diagnostics::instance().enable(this);
+  timer->start(250);
+}
+
+DebugDialog::~DebugDialog()
+{
+  Diagnostics::instance().disable();
+}
+
+void
+DebugDialog::diagnostics_log(const std::vector<std::string> &lines)
+{
+  for (const auto &line: lines)
+    {
+      log_view->appendPlainText(QString::fromStdString(line));
+    }
+}
+
+void
+DebugDialog::on_timer()
+{
+  Diagnostics::instance().process();
 
-  // QGridLayout *layout = new QGridLayout(this);
-  // layout->setSizeConstraint(QLayout::SetFixedSize);
+  if (++timer_count % 4 == 0)
+    {
+      std::stringstream ss;
+      for (const auto &metric: Metrics::instance().snapshot())
+        {
+          ss << metric << "\n";
+        }
+      metrics_view->setPlainText(QString::fromStdString(ss.str()));
+    }
 }
@@ -18,15 +18,34 @@
 #ifndef DEBUGDIALOG_HH
 #define DEBUGDIALOG_HH
 
+#include <string>
+#include <vector>
+
 #include <QtGui>
 #include <QtWidgets>
 
-class DebugDialog : public QDialog
+#include "utils/Diagnostics.hh"
+
+class DebugDialog
+  : public QDialog
+  , public DiagnosticsSink
 {
   Q_OBJECT
 
 public:
   DebugDialog();
+  ~DebugDialog() override;
+
+  void diagnostics_log(const std::vector<std::string> &lines) override;
+
+private:
+  void on_timer();
+
+private:
+  QPlainTextEdit *log_view{nullptr};
+  QPlainTextEdit *metrics_view{nullptr};
+  QTimer *timer{nullptr};
+  int timer_count{0};
 };
 
 #endif // DEBUGDIALOG_HH
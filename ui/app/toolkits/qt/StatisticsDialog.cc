@@ -27,7 +27,6 @@
 #include <boost/date_time/gregorian/gregorian.hpp>
 
 #include <ctime>
-#include <cstring>
 
 #include "debug.hh"
 
@@ -37,6 +36,7 @@
 
 #include "UiUtil.hh"
 #include "qformat.hh"
+#include "utils/Calendar.hh"
 
 using namespace workrave;
 
@@ -259,18 +259,9 @@ StatisticsDialog::create_break_page(QBoxLayout *parent)
 }
 
 void
-StatisticsDialog::display_statistics(IStatistics::DailyStats *stats)
+StatisticsDialog::display_statistics(const IStatistics::DailyStatsView &stats)
 {
-  IStatistics::DailyStats empty{};
-  bool is_empty{};
-
-  is_empty = stats == nullptr;
-  if (is_empty)
-    {
-      stats = &empty;
-    }
-
-  if (stats->start.tm_year == 0 /*stats->is_empty() */)
+  if (stats.is_empty())
     {
       date_label->setText("-");
     }
@@ -278,14 +269,14 @@ StatisticsDialog::display_statistics(IStatistics::DailyStats *stats)
     {
       std::stringstream ss;
       ss.imbue(std::locale(ss.getloc(), new boost::posix_time::time_facet("%x")));
-      boost::posix_time::ptime pt = boost::posix_time::ptime_from_tm(stats->start);
+      boost::posix_time::ptime pt = boost::posix_time::ptime_from_tm(stats.get_start());
       ss << pt;
       std::string date = ss.str();
 
       ss.imbue(std::locale(ss.getloc(), new boost::posix_time::time_facet("%X")));
       ss << pt;
       std::string start = ss.str();
-      pt = boost::posix_time::ptime_from_tm(stats->stop);
+      pt = boost::posix_time::ptime_from_tm(stats.get_stop());
       ss << pt;
       std::string stop = ss.str();
 
@@ -294,31 +285,31 @@ StatisticsDialog::display_statistics(IStatistics::DailyStats *stats)
       date_label->setText(text);
     }
 
-  int64_t value = stats->misc_stats[IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME];
+  int64_t value = stats.get_misc_stat(IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME);
   daily_usage_time_label->setText(UiUtil::time_to_string(value));
 
   // Put the breaks in table.
   for (int i = 0; i < BREAK_ID_SIZEOF; i++)
     {
-      value = stats->break_stats[i][IStatistics::STATS_BREAKVALUE_UNIQUE_BREAKS];
+      value = stats.get_break_stat(BreakId(i), IStatistics::STATS_BREAKVALUE_UNIQUE_BREAKS);
       break_labels[i][0]->setText(QString::number(value));
 
-      value = stats->break_stats[i][IStatistics::STATS_BREAKVALUE_PROMPTED] - value;
+      value = stats.get_break_stat(BreakId(i), IStatistics::STATS_BREAKVALUE_PROMPTED) - value;
       break_labels[i][1]->setText(QString::number(value));
 
-      value = stats->break_stats[i][IStatistics::STATS_BREAKVALUE_TAKEN];
+      value = stats.get_break_stat(BreakId(i), IStatistics::STATS_BREAKVALUE_TAKEN);
       break_labels[i][2]->setText(QString::number(value));
 
-      value = stats->break_stats[i][IStatistics::STATS_BREAKVALUE_NATURAL_TAKEN];
+      value = stats.get_break_stat(BreakId(i), IStatistics::STATS_BREAKVALUE_NATURAL_TAKEN);
       break_labels[i][3]->setText(QString::number(value));
 
-      value = stats->break_stats[i][IStatistics::STATS_BREAKVALUE_SKIPPED];
+      value = stats.get_break_stat(BreakId(i), IStatistics::STATS_BREAKVALUE_SKIPPED);
       break_labels[i][4]->setText(QString::number(value));
 
-      value = stats->break_stats[i][IStatistics::STATS_BREAKVALUE_POSTPONED];
+      value = stats.get_break_stat(BreakId(i), IStatistics::STATS_BREAKVALUE_POSTPONED);
       break_labels[i][5]->setText(QString::number(value));
 
-      value = stats->break_stats[i][IStatistics::STATS_BREAKVALUE_TOTAL_OVERDUE];
+      value = stats.get_break_stat(BreakId(i), IStatistics::STATS_BREAKVALUE_TOTAL_OVERDUE);
 
       break_labels[i][6]->setText(UiUtil::time_to_string(value));
     }
@@ -332,40 +323,30 @@ StatisticsDialog::display_week_statistics()
   int m = date.month() - 1;
   int d = date.day();
 
-  std::tm timeinfo{};
-  std::memset(&timeinfo, 0, sizeof(timeinfo));
-  timeinfo.tm_mday = d;
-  timeinfo.tm_mon = m;
-  timeinfo.tm_year = y - 1900;
+  using workrave::utils::Calendar;
 
-  std::time_t t = std::mktime(&timeinfo);
-  std::tm const *time_loc = std::localtime(&t);
+  int32_t day = Calendar::days_from_civil(y, m + 1, d);
 
   QLocale locale;
   int week_start = locale.firstDayOfWeek() % 7;
 
-  int offset = (time_loc->tm_wday - week_start + 7) % 7;
+  int offset = (Calendar::weekday(day) - week_start + 7) % 7;
   int64_t total_week = 0;
   for (int i = 0; i < 7; i++)
     {
-      std::memset(&timeinfo, 0, sizeof(timeinfo));
-      timeinfo.tm_mday = d - offset + i;
-      timeinfo.tm_mon = m;
-      timeinfo.tm_year = y - 1900;
-      t = std::mktime(&timeinfo);
-      time_loc = std::localtime(&t);
+      workrave::utils::CivilDate civil = Calendar::civil_from_days(day - offset + i);
 
       int idx = 0;
       int next = 0;
       int prev = 0;
-      statistics->get_day_index_by_date(time_loc->tm_year + 1900, time_loc->tm_mon + 1, time_loc->tm_mday, idx, next, prev);
+      statistics->get_day_index_by_date(civil.year, civil.month, civil.day, idx, next, prev);
 
       if (idx >= 0)
         {
-          IStatistics::DailyStats *stats = statistics->get_day(idx);
-          if (stats != nullptr)
+          IStatistics::DailyStatsView stats = statistics->get_day(idx);
+          if (stats)
             {
-              total_week += stats->misc_stats[IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME];
+              total_week += stats.get_misc_stat(IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME);
             }
 
           update_usage_real_time |= (idx == 0);
@@ -382,27 +363,7 @@ StatisticsDialog::display_month_statistics()
   int y = date.year();
   int m = date.month() - 1;
 
-  int max_mday = 0;
-  if (m == 3 || m == 5 || m == 8 || m == 10)
-    {
-      max_mday = 30;
-    }
-  else if (m == 1)
-    {
-      bool is_leap = (y % 4 == 0 && y % 100 != 0) || (y % 400 == 0);
-      if (is_leap)
-        {
-          max_mday = 29;
-        }
-      else
-        {
-          max_mday = 28;
-        }
-    }
-  else
-    {
-      max_mday = 31;
-    }
+  int max_mday = workrave::utils::Calendar::days_in_month(y, m + 1);
 
   int64_t total_month = 0;
   for (int i = 1; i <= max_mday; i++)
@@ -413,10 +374,10 @@ StatisticsDialog::display_month_statistics()
       statistics->get_day_index_by_date(y, m + 1, i, idx, next, prev);
       if (idx >= 0)
         {
-          IStatistics::DailyStats *stats = statistics->get_day(idx);
-          if (stats != nullptr)
+          IStatistics::DailyStatsView stats = statistics->get_day(idx);
+          if (stats)
             {
-              total_month += stats->misc_stats[IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME];
+              total_month += stats.get_misc_stat(IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME);
             }
 
           update_usage_real_time |= (idx == 0);
@@ -472,9 +433,9 @@ StatisticsDialog::get_calendar_day_index(int &idx, int &next, int &prev)
 void
 StatisticsDialog::set_calendar_day_index(int idx)
 {
-  IStatistics::DailyStats *stats = statistics->get_day(idx);
+  struct tm start = statistics->get_day(idx).get_start();
   QDate date = calendar->selectedDate();
-  date.setDate(stats->start.tm_year + 1900, stats->start.tm_mon + 1, stats->start.tm_mday);
+  date.setDate(start.tm_year + 1900, start.tm_mon + 1, start.tm_mday);
   calendar->setSelectedDate(date);
   display_calendar_date();
 }
@@ -486,11 +447,9 @@ StatisticsDialog::display_calendar_date()
   int next = 0;
   int prev = 0;
   get_calendar_day_index(idx, next, prev);
-  IStatistics::DailyStats *stats = nullptr;
   if (idx >= 0)
     {
-      stats = statistics->get_day(idx);
-      display_statistics(stats);
+      display_statistics(statistics->get_day(idx));
     }
   else
     {
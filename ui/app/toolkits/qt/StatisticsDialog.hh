@@ -80,7 +80,7 @@ private:
   void on_history_goto_last();
   void on_history_goto_first();
   void display_calendar_date();
-  void display_statistics(workrave::IStatistics::DailyStats *stats);
+  void display_statistics(const workrave::IStatistics::DailyStatsView &stats);
   void clear_display_statistics();
   void display_week_statistics();
   void display_month_statistics();
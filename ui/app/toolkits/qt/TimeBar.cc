@@ -21,14 +21,16 @@
 
 #include "TimeBar.hh"
 
+#include <QPainter>
+#include <QPaintEvent>
 #include <QStylePainter>
 #include <QStyleOptionProgressBar>
 
 #include "UiUtil.hh"
 #include "debug.hh"
 
-const int MARGINX = 4;
-const int MARGINY = 2;
+const int MARGINX = TimeBarRenderer::MARGINX;
+const int MARGINY = TimeBarRenderer::MARGINY;
 
 std::map<TimerColorId, QColor> TimeBar::bar_colors{
   {TimerColorId::Active, QColor("lightblue")},
@@ -51,55 +53,52 @@ TimeBar::TimeBar(QWidget *parent)
 void
 TimeBar::set_progress(int value, int max_value)
 {
-  if (value > max_value)
-    {
-      value = max_value;
-    }
-
-  bar_value = value;
-  bar_max_value = max_value;
+  renderer.set_progress(value, max_value);
 }
 
 void
 TimeBar::set_secondary_progress(int value, int max_value)
 {
-  if (value > max_value)
-    {
-      value = max_value;
-    }
-
-  secondary_bar_value = value;
-  secondary_bar_max_value = max_value;
+  renderer.set_secondary_progress(value, max_value);
 }
 
 void
 TimeBar::set_text(const QString &text)
 {
-  bar_text = text;
+  if (text != bar_text)
+    {
+      bar_text = text;
+      renderer.set_text(text.toStdString(), fontMetrics().horizontalAdvance(text), fontMetrics().height());
+    }
 }
 
 void
 TimeBar::set_text_alignment(int align)
 {
-  bar_text_align = align;
+  renderer.set_text_alignment(align);
 }
 
 void
 TimeBar::set_bar_color(TimerColorId color)
 {
-  bar_color = color;
+  renderer.set_bar_color(color);
 }
 
 void
 TimeBar::set_secondary_bar_color(TimerColorId color)
 {
-  secondary_bar_color = color;
+  renderer.set_secondary_bar_color(color);
 }
 
+//! Repaints only the part of the bar that changed.
 void
 TimeBar::update()
 {
-  QWidget::update();
+  TimeBarRenderer::Rect damage = renderer.get_damage();
+  if (!damage.is_empty())
+    {
+      QWidget::update(damage.x, damage.y, damage.width, damage.height);
+    }
 }
 
 auto
@@ -129,125 +128,85 @@ TimeBar::sizeHint() const -> QSize
 }
 
 void
-TimeBar::paintEvent(QPaintEvent * /* event */)
+TimeBar::resizeEvent(QResizeEvent *event)
 {
-  TRACE_ENTER("TimeBar::paintEvent");
-  QStylePainter painter(this);
-
-  const int border_size = 1;
-
-  // Draw background
-  painter.fillRect(0, 0, width() - 1, height() - 1, QColor("white"));
-  painter.setPen(QColor("black"));
-  painter.drawRect(0, 0, width() - 1, height() - 1);
-
-  QStyleOptionFrame option;
-  option.initFrom(this);
-  option.features = QStyleOptionFrame::Flat;
-  option.frameShape = QFrame::Panel;
-  option.lineWidth = 2;
-  option.midLineWidth = 0;
-
-  painter.drawPrimitive(QStyle::PE_Frame, option);
+  QWidget::resizeEvent(event);
+  renderer.set_size(width(), height());
+  frame_pixmap = QPixmap();
+}
 
-  // Bar
-  int bar_width = 0;
-  if (bar_max_value > 0)
+void
+TimeBar::changeEvent(QEvent *event)
+{
+  QWidget::changeEvent(event);
+  if (event->type() == QEvent::FontChange || event->type() == QEvent::StyleChange || event->type() == QEvent::PaletteChange)
     {
-      bar_width = (bar_value * (width() - 2 * border_size - 1)) / bar_max_value;
+      frame_pixmap = QPixmap();
+      renderer.set_text(bar_text.toStdString(), fontMetrics().horizontalAdvance(bar_text), fontMetrics().height());
+      renderer.invalidate();
     }
+}
 
-  // Secondary bar
-  int sbar_width = 0;
-  if (secondary_bar_max_value > 0)
+void
+TimeBar::paintEvent(QPaintEvent *event)
+{
+  TRACE_ENTER("TimeBar::paintEvent");
+  if (frame_pixmap.isNull())
     {
-      sbar_width = (secondary_bar_value * (width() - 2 * border_size - 1)) / secondary_bar_max_value;
+      render_frame();
     }
 
-  int bar_height = height() - 2 * border_size;
+  QPainter widget_painter(this);
+  painter = &widget_painter;
 
-  if (sbar_width > 0)
-    {
-      // Overlap
-
-      // We should assert() because this is not supported
-      // but there are some weird boundary cases
-      // in which this still happens.. need to check
-      // this out some time.
-      // assert(secondary_bar_color == TimerColorId::Inactive);
-      TimerColorId overlap_color;
-      switch (bar_color)
-        {
-        case TimerColorId::Active:
-          overlap_color = TimerColorId::InactiveOverActive;
-          break;
-        case TimerColorId::Overdue:
-          overlap_color = TimerColorId::InactiveOverOverdue;
-          break;
-        default:
-          // We could abort() because this is not supported
-          // but there are some weird boundary cases
-          // in which this still happens.. need to check
-          // this out some time.
-          overlap_color = TimerColorId::InactiveOverActive;
-        }
-
-      if (sbar_width >= bar_width)
-        {
-          if (bar_width != 0)
-            {
-              painter.fillRect(border_size, border_size, bar_width, bar_height, bar_colors[overlap_color]);
-            }
-          if (sbar_width > bar_width)
-            {
-              painter.fillRect(border_size + bar_width, border_size, sbar_width - bar_width, bar_height, bar_colors[secondary_bar_color]);
-            }
-        }
-      else
-        {
-          if (sbar_width != 0)
-            {
-              painter.fillRect(border_size, border_size, sbar_width, bar_height, bar_colors[overlap_color]);
-            }
-          painter.fillRect(border_size + sbar_width, border_size, bar_width - sbar_width, bar_height, bar_colors[bar_color]);
-        }
-    }
-  else
-    {
-      // No overlap
-      painter.fillRect(border_size, border_size, bar_width, bar_height, bar_colors[bar_color]);
-    }
+  const QRect &rect = event->rect();
+  renderer.paint(*this, TimeBarRenderer::Rect{rect.x(), rect.y(), rect.width(), rect.height()});
 
-  int text_width = painter.fontMetrics().horizontalAdvance(bar_text);
-  int text_height = painter.fontMetrics().height();
+  painter = nullptr;
+  TRACE_EXIT();
+}
 
-  int text_x = 0;
-  if (bar_text_align > 0)
-    {
-      text_x = std::max(width() - text_width - MARGINX, 0);
-    }
-  else if (bar_text_align < 0)
-    {
-      text_x = MARGINX;
-    }
-  else
-    {
-      text_x = (width() - text_width) / 2;
-    }
+void
+TimeBar::render_frame()
+{
+  frame_pixmap = QPixmap(size() * devicePixelRatioF());
+  frame_pixmap.setDevicePixelRatio(devicePixelRatioF());
+  frame_pixmap.fill(Qt::transparent);
 
-  int text_y = (height() + text_height) / 2 - MARGINY;
+  QStylePainter frame_painter(&frame_pixmap, this);
+  frame_painter.fillRect(0, 0, width() - 1, height() - 1, QColor("white"));
+  frame_painter.setPen(QColor("black"));
+  frame_painter.drawRect(0, 0, width() - 1, height() - 1);
 
-  TRACE_MSG("x = " << text_x << "y = " << text_y);
+  QStyleOptionFrame option;
+  option.initFrom(this);
+  option.features = QStyleOptionFrame::Flat;
+  option.frameShape = QFrame::Panel;
+  option.lineWidth = 2;
+  option.midLineWidth = 0;
 
-  int left_width = (bar_width > sbar_width) ? bar_width : sbar_width;
-  left_width += border_size;
+  frame_painter.drawPrimitive(QStyle::PE_Frame, option);
+}
 
-  QRegion left_rect(0, 0, left_width, height());
-  QRegion right_rect(left_width, 0, width() - left_width, height());
+void
+TimeBar::draw_frame(const TimeBarRenderer::Rect &clip)
+{
+  QRect rect(clip.x, clip.y, clip.width, clip.height);
+  painter->drawPixmap(rect, frame_pixmap, QRectF(rect.topLeft() * devicePixelRatioF(), rect.size() * devicePixelRatioF()));
+}
 
-  painter.setPen(QColor("black"));
-  painter.drawText(text_x, text_y, bar_text);
+void
+TimeBar::fill_rect(const TimeBarRenderer::Rect &rect, TimerColorId color)
+{
+  painter->fillRect(rect.x, rect.y, rect.width, rect.height, bar_colors[color]);
+}
 
-  TRACE_MSG("width = " << text_width << "height = " << text_height);
-  TRACE_EXIT();
+void
+TimeBar::draw_text(int x, int y, const TimeBarRenderer::Rect &clip, bool /* on_bar */)
+{
+  painter->save();
+  painter->setClipRect(clip.x, clip.y, clip.width, clip.height);
+  painter->setPen(QColor("black"));
+  painter->drawText(x, y + painter->fontMetrics().ascent(), bar_text);
+  painter->restore();
 }
@@ -19,10 +19,16 @@
 #define TIMEBAR_HH
 
 #include "ui/UiTypes.hh"
+#include "ui/TimeBarRenderer.hh"
 
+#include <QPixmap>
 #include <QWidget>
 
-class TimeBar : public QWidget
+class QPainter;
+
+class TimeBar
+  : public QWidget
+  , private TimeBarRenderer::IPainter
 {
   Q_OBJECT
 
@@ -45,18 +51,29 @@ public:
 
 protected:
   void paintEvent(QPaintEvent *event) override;
+  void resizeEvent(QResizeEvent *event) override;
+  void changeEvent(QEvent *event) override;
+
+private:
+  void render_frame();
+
+  void draw_frame(const TimeBarRenderer::Rect &clip) override;
+  void fill_rect(const TimeBarRenderer::Rect &rect, TimerColorId color) override;
+  void draw_text(int x, int y, const TimeBarRenderer::Rect &clip, bool on_bar) override;
 
 private:
   static std::map<TimerColorId, QColor> bar_colors;
 
-  TimerColorId bar_color{TimerColorId::Active};
-  TimerColorId secondary_bar_color{TimerColorId::Active};
-  int bar_value{0};
-  int bar_max_value{0};
-  int secondary_bar_value{0};
-  int secondary_bar_max_value{0};
+  //! Layout, invalidation and painting order of the bar.
+  TimeBarRenderer renderer;
+
   QString bar_text;
-  int bar_text_align{0};
+
+  //! Background and frame, rendered once per size and style.
+  QPixmap frame_pixmap;
+
+  //! Painter of the paint event in progress.
+  QPainter *painter{nullptr};
 };
 
 #endif // TIMEBAR_HH
@@ -22,7 +22,8 @@ const IndicatorIface = '<node>\
     <method name="Command"> \
         <arg type="i" name="command" direction="in" /> \
     </method> \
-    <method name="GetMenu"> \
+    <method name="GetMenuSnapshot"> \
+        <arg type="u" name="version" direction="out" /> \
         <arg type="a(ssuyy)" name="menuitems" direction="out" /> \
     </method> \
     <method name="GetTrayIconEnabled"> \
@@ -33,11 +34,15 @@ const IndicatorIface = '<node>\
         <arg type="(siuuuuuu)" /> \
         <arg type="(siuuuuuu)" /> \
     </signal> \
-    <signal name="MenuUpdated"> \
+    <signal name="MenuSnapshot"> \
+        <arg type="u" /> \
         <arg type="a(ssuyy)" /> \
     </signal> \
-    <signal name="MenuItemUpdated"> \
-        <arg type="(ssuyy)" /> \
+    <signal name="MenuItemChanged"> \
+        <arg type="u" /> \
+        <arg type="u" /> \
+        <arg type="s" /> \
+        <arg type="y" /> \
     </signal> \
     <signal name="TrayIconUpdated"> \
         <arg type="b" /> \
@@ -189,6 +194,7 @@ MyApplet.prototype = {
         this._bus_name = 'org.workrave.CinnamonApplet';
         this._bus_id = 0;
         this._menu_entries = {};
+        this._menu_version = 0;
 
         this._area = new St.DrawingArea();
         this._area.set_width(this._width=24);
@@ -201,8 +207,8 @@ MyApplet.prototype = {
 
         this._ui_proxy = new IndicatorProxy(Gio.DBus.session, 'org.workrave.Workrave', '/org/workrave/Workrave/UI');
         this._timers_updated_id = this._ui_proxy.connectSignal("TimersUpdated", Lang.bind(this, this._onTimersUpdated));
-        this._menu_updated_id = this._ui_proxy.connectSignal("MenuUpdated", Lang.bind(this, this._onMenuUpdated));
-        this._menu_item_updated_id = this._ui_proxy.connectSignal("MenuItemUpdated", Lang.bind(this, this._onMenuItemUpdated));
+        this._menu_snapshot_id = this._ui_proxy.connectSignal("MenuSnapshot", Lang.bind(this, this._onMenuSnapshot));
+        this._menu_item_changed_id = this._ui_proxy.connectSignal("MenuItemChanged", Lang.bind(this, this._onMenuItemChanged));
         this._trayicon_updated_id = this._ui_proxy.connectSignal("TrayIconUpdated", Lang.bind(this, this._onTrayIconUpdated));
 
         this._core_proxy = new CoreProxy(Gio.DBus.session, 'org.workrave.Workrave', '/org/workrave/Workrave/Core');
@@ -238,8 +244,8 @@ MyApplet.prototype = {
         if (this._ui_proxy != null)
         {
             this._ui_proxy.disconnectSignal(this._timers_updated_id);
-            this._ui_proxy.disconnectSignal(this._menu_updated_id);
-            this._ui_proxy.disconnectSignal(this._menu_item_updated_id);
+            this._ui_proxy.disconnectSignal(this._menu_snapshot_id);
+            this._ui_proxy.disconnectSignal(this._menu_item_changed_id);
             this._ui_proxy.disconnectSignal(this._trayicon_updated_id);
             this._ui_proxy = null;
         }
@@ -256,7 +262,8 @@ MyApplet.prototype = {
         if (! this._alive)
         {
             this._bus_id = Gio.DBus.session.own_name(this._bus_name, Gio.BusNameOwnerFlags.NONE, null, null);
-            this._ui_proxy.GetMenuRemote(Lang.bind(this, this._onGetMenuReply));
+            this._menu_version = 0;
+            this._ui_proxy.GetMenuSnapshotRemote(Lang.bind(this, this._onGetMenuSnapshotReply));
             this._ui_proxy.GetTrayIconEnabledRemote(Lang.bind(this, this._onGetTrayIconEnabledReply));
             this._ui_proxy.EmbedRemote(true, this._bus_name);
             this._core_proxy.GetOperationModeRemote(Lang.bind(this, this._onGetOperationModeReply));
@@ -373,7 +380,8 @@ MyApplet.prototype = {
         this._area.queue_repaint();
     },
 
-    _onGetMenuReply : function([menuitems], excp) {
+    _onGetMenuSnapshotReply : function([version, menuitems], excp) {
+        this._menu_version = version;
         this._updateMenu(menuitems);
     },
 
@@ -385,12 +393,27 @@ MyApplet.prototype = {
         this._timerbox.set_operation_mode(mode);
     },
 
-    _onMenuUpdated : function(emitter, senderName, [menuitems]) {
+    _onMenuSnapshot : function(emitter, senderName, [version, menuitems]) {
+        this._menu_version = version;
         this._updateMenu(menuitems);
     },
 
-    _onMenuItemUpdated : function(emitter, senderName, [menuitem]) {
-        this._updateItemMenu(menuitem);
+    _onMenuItemChanged : function(emitter, senderName, [version, command, text, flags]) {
+        if (version <= this._menu_version)
+        {
+            // Already part of the menu snapshot.
+            return;
+        }
+
+        if (version != this._menu_version + 1)
+        {
+            // A change was missed, fetch the whole menu again.
+            this._ui_proxy.GetMenuSnapshotRemote(Lang.bind(this, this._onGetMenuSnapshotReply));
+            return;
+        }
+
+        this._menu_version = version;
+        this._updateItemMenu([text, "", command, this._menu_types[command], flags]);
     },
 
     _onTrayIconUpdated : function(emitter, senderName, [enabled]) {
@@ -409,7 +432,7 @@ MyApplet.prototype = {
     },
 
     _onMenuOpenCommand: function(item, event) {
-        this._ui_proxy.GetMenuRemote(); // A dummy method call to re-activate the service
+        this._ui_proxy.GetMenuSnapshotRemote(); // A dummy method call to re-activate the service
     },
 
     _updateTrayIcon : function(enabled) {
@@ -420,6 +443,7 @@ MyApplet.prototype = {
     _updateMenu : function(menuitems) {
         this.menu.removeAll();
         this._menu_entries = {}
+        this._menu_types = {}
 
         let current_menu = this.menu;
         let indent = "";
@@ -494,6 +518,7 @@ MyApplet.prototype = {
                     popup.connect('activate', Lang.bind(this, this._onMenuCommand, id));
                     current_menu.addMenuItem(popup);
                     this._menu_entries[id] = popup;
+                    this._menu_types[id] = type;
                 }
             }
         }
@@ -507,6 +532,11 @@ MyApplet.prototype = {
         let active = ((flags & MENU_ITEM_FLAG_ACTIVE) != 0);
         let visible = ((flags & MENU_ITEM_FLAG_VISIBLE) != 0);
         let popup = this._menu_entries[id];
+        if (popup == null)
+        {
+            // Sub menus cannot change.
+            return;
+        }
 
         popup.setSensitive(visible);
 
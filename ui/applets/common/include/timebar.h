@@ -67,5 +67,6 @@ void workrave_timebar_set_progress(WorkraveTimebar *self, int value, int max_val
 void workrave_timebar_set_secondary_progress(WorkraveTimebar *self, int value, int max_value, WorkraveColorId color);
 void workrave_timebar_set_text(WorkraveTimebar *self, const gchar *text);
 void workrave_timebar_get_dimensions(WorkraveTimebar *self, int *width, int *height);
+void workrave_timebar_invalidate(WorkraveTimebar *self);
 
 #endif /* WORKRAVE_APPLET_COMMON_TIMEBAR_H_ */
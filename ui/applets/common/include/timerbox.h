@@ -68,5 +68,6 @@ void workrave_timerbox_set_operation_mode(WorkraveTimerbox *self, gchar *mode);
 int workrave_timerbox_get_width(WorkraveTimerbox *self);
 int workrave_timerbox_get_height(WorkraveTimerbox *self);
 WorkraveTimebar *workrave_timerbox_get_time_bar(WorkraveTimerbox *self, WorkraveBreakId timer);
+void workrave_timerbox_invalidate(WorkraveTimerbox *self);
 
 #endif /* WORKRAVE_APPLET_COMMON_TIMERBOX_H */
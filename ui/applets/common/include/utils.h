@@ -20,5 +20,6 @@
 #include <glib.h>
 
 void workrave_extract_shortcut(const gchar *text, gchar **out, gchar *shortcut);
+gchar *workrave_time_to_string(int time);
 
 #endif /* WORKRAVE_APPLET_COMMON_UTILS_H_ */
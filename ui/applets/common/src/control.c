@@ -25,6 +25,7 @@
 
 #include "control.h"
 #include "timerbox.h"
+#include "utils.h"
 
 #define WORKRAVE_DBUS_NAME "org.workrave.Applet"
 
@@ -50,6 +51,23 @@ enum
 
 static guint signals[LAST_SIGNAL] = {0};
 
+typedef struct _TimerState TimerState;
+struct _TimerState
+{
+  gint32 slot;
+  gint32 value;
+  gint32 value_rate;
+  guint32 primary_color;
+  gint32 primary_val;
+  gint32 primary_rate;
+  gint32 primary_max;
+  guint32 secondary_color;
+  gint32 secondary_val;
+  gint32 secondary_rate;
+  gint32 secondary_max;
+  gint64 reference;
+};
+
 struct _WorkraveTimerboxControlPrivate
 {
   GtkImage *image;
@@ -78,6 +96,24 @@ struct _WorkraveTimerboxControlPrivate
   guint startup_count;
   guint update_count;
 
+  //! Whether Workrave sends versioned menu changes.
+  gboolean menu_versions;
+
+  //! Version of the menu last seen.
+  guint32 menu_version;
+
+  //! Whether Workrave sends timer states instead of TimersUpdated.
+  gboolean timer_states;
+
+  //! Last state of each timer received from Workrave.
+  TimerState states[BREAK_ID_SIZEOF];
+
+  //! State of each timer as currently shown.
+  TimerState shown[BREAK_ID_SIZEOF];
+
+  //! Wakes up at the next second while a timer is running.
+  guint frame_timer;
+
   WorkraveTimerbox *timerbox;
 };
 
@@ -110,9 +146,16 @@ static void on_dbus_core_ready(GObject *object, GAsyncResult *res, gpointer user
 static void on_dbus_control_ready(GObject *object, GAsyncResult *res, gpointer user_data);
 static void on_dbus_signal(GDBusProxy *proxy, gchar *sender_name, gchar *signal_name, GVariant *parameters, gpointer user_data);
 static void on_update_timers(WorkraveTimerboxControl *self, GVariant *parameters);
+static void on_timer_state_changed(WorkraveTimerboxControl *self, GVariant *parameters);
+static void workrave_timerbox_control_request_timer_states(WorkraveTimerboxControl *self);
+static void workrave_timerbox_control_update_timer_states(WorkraveTimerboxControl *self);
+static void on_menu_snapshot(WorkraveTimerboxControl *self, GVariant *parameters);
+static void on_menu_item_changed(WorkraveTimerboxControl *self, GVariant *parameters);
 static void on_bus_acquired(GDBusConnection *connection, const gchar *name, gpointer user_data);
 static void on_workrave_appeared(GDBusConnection *connection, const gchar *name, const gchar *name_owner, gpointer user_data);
 static void on_workrave_vanished(GDBusConnection *connection, const gchar *name, gpointer user_data);
+static void on_image_style_updated(GtkWidget *widget, gpointer user_data);
+static void on_image_size_allocate(GtkWidget *widget, GdkRectangle *allocation, gpointer user_data);
 
 GDBusProxy *
 workrave_timerbox_control_get_applet_proxy(WorkraveTimerboxControl *self)
@@ -151,6 +194,10 @@ workrave_timerbox_control_get_image(WorkraveTimerboxControl *self)
     {
       priv->image = GTK_IMAGE(gtk_image_new());
 
+      // The timerbox caches its rendering, which depends on the theme and size of the image.
+      g_signal_connect_object(priv->image, "style-updated", G_CALLBACK(on_image_style_updated), self, 0);
+      g_signal_connect_object(priv->image, "size-allocate", G_CALLBACK(on_image_size_allocate), self, 0);
+
       workrave_timerbox_set_enabled(priv->timerbox, FALSE);
       workrave_timerbox_set_force_icon(priv->timerbox, FALSE);
       workrave_timerbox_update(priv->timerbox, priv->image);
@@ -160,6 +207,29 @@ workrave_timerbox_control_get_image(WorkraveTimerboxControl *self)
   return priv->image;
 }
 
+static void
+on_image_style_updated(GtkWidget *widget, gpointer user_data)
+{
+  (void)widget;
+  WorkraveTimerboxControl *self = WORKRAVE_TIMERBOX_CONTROL(user_data);
+  WorkraveTimerboxControlPrivate *priv = workrave_timerbox_control_get_instance_private(self);
+
+  workrave_timerbox_invalidate(priv->timerbox);
+  workrave_timerbox_update(priv->timerbox, priv->image);
+}
+
+static void
+on_image_size_allocate(GtkWidget *widget, GdkRectangle *allocation, gpointer user_data)
+{
+  (void)widget;
+  (void)allocation;
+  WorkraveTimerboxControl *self = WORKRAVE_TIMERBOX_CONTROL(user_data);
+  WorkraveTimerboxControlPrivate *priv = workrave_timerbox_control_get_instance_private(self);
+
+  // Updating the image here would allocate it again; the next timer update redraws it.
+  workrave_timerbox_invalidate(priv->timerbox);
+}
+
 static void
 workrave_timerbox_control_update_show_tray_icon(WorkraveTimerboxControl *self)
 {
@@ -214,16 +284,86 @@ workrave_timerbox_control_get_menus(WorkraveTimerboxControl *self)
   WorkraveTimerboxControlPrivate *priv = workrave_timerbox_control_get_instance_private(self);
 
   GError *error = NULL;
-  GVariant *result = g_dbus_proxy_call_sync(priv->applet_proxy, "GetMenu", NULL, G_DBUS_CALL_FLAGS_NONE, -1, NULL, &error);
+  GVariant *result = g_dbus_proxy_call_sync(priv->applet_proxy, "GetMenuSnapshot", NULL, G_DBUS_CALL_FLAGS_NONE, -1, NULL, &error);
+
+  if (error == NULL)
+    {
+      GVariant *items = NULL;
+      g_variant_get(result, "(u@a(ssuyy))", &priv->menu_version, &items);
+      g_variant_unref(result);
+
+      priv->menu_versions = TRUE;
+      GVariant *menus = g_variant_ref_sink(g_variant_new("(@a(ssuyy))", items));
+      g_variant_unref(items);
+      return menus;
+    }
+
+  // Workrave versions without menu versions.
+  g_clear_error(&error);
+  priv->menu_versions = FALSE;
+
+  result = g_dbus_proxy_call_sync(priv->applet_proxy, "GetMenu", NULL, G_DBUS_CALL_FLAGS_NONE, -1, NULL, &error);
 
   if (error != NULL)
     {
       g_warning("Could not request menu for %s: %s", WORKRAVE_DBUS_APPLET_NAME, error->message);
+      g_error_free(error);
     }
 
   return result;
 }
 
+static void
+on_menu_snapshot(WorkraveTimerboxControl *self, GVariant *parameters)
+{
+  WorkraveTimerboxControlPrivate *priv = workrave_timerbox_control_get_instance_private(self);
+
+  GVariant *items = NULL;
+  g_variant_get(parameters, "(u@a(ssuyy))", &priv->menu_version, &items);
+
+  GVariant *menus = g_variant_ref_sink(g_variant_new("(@a(ssuyy))", items));
+  g_variant_unref(items);
+  g_signal_emit(self, signals[MENU_CHANGED], 0, menus);
+  g_variant_unref(menus);
+}
+
+static void
+on_menu_item_changed(WorkraveTimerboxControl *self, GVariant *parameters)
+{
+  WorkraveTimerboxControlPrivate *priv = workrave_timerbox_control_get_instance_private(self);
+
+  guint32 version;
+  guint32 command;
+  const gchar *text;
+  guint8 flags;
+  g_variant_get(parameters, "(uu&sy)", &version, &command, &text, &flags);
+
+  if (version <= priv->menu_version)
+    {
+      // Already part of the menu snapshot.
+      return;
+    }
+
+  if (version != priv->menu_version + 1)
+    {
+      // A change was missed, fetch the whole menu again.
+      GVariant *menus = workrave_timerbox_control_get_menus(self);
+      if (menus != NULL)
+        {
+          g_signal_emit(self, signals[MENU_CHANGED], 0, menus);
+          g_variant_unref(menus);
+        }
+      return;
+    }
+
+  priv->menu_version = version;
+
+  // Same layout as the MenuItemUpdated signal; applets only use the text, command and flags.
+  GVariant *item = g_variant_ref_sink(g_variant_new("((ssuyy))", text, "", command, (guint8)0, flags));
+  g_signal_emit(self, signals[MENU_ITEM_CHANGED], 0, item);
+  g_variant_unref(item);
+}
+
 static void
 workrave_timerbox_control_class_init(WorkraveTimerboxControlClass *klass)
 {
@@ -290,6 +430,10 @@ workrave_timerbox_control_init(WorkraveTimerboxControl *self)
   priv->startup_count = 0;
   priv->timerbox = NULL;
   priv->update_count = 0;
+  priv->menu_versions = FALSE;
+  priv->menu_version = 0;
+  priv->timer_states = FALSE;
+  priv->frame_timer = 0;
 
   priv->timerbox = g_object_new(WORKRAVE_TYPE_TIMERBOX, NULL);
 
@@ -332,6 +476,12 @@ workrave_timerbox_control_dispose(GObject *object)
       priv->startup_timer = 0;
     }
 
+  if (priv->frame_timer != 0)
+    {
+      g_source_remove(priv->frame_timer);
+      priv->frame_timer = 0;
+    }
+
   // g_clear_pointer(&priv->image, g_object_unref);
   g_clear_pointer(&priv->applet_proxy_cancel, g_object_unref);
   g_clear_pointer(&priv->applet_proxy, g_object_unref);
@@ -427,6 +577,11 @@ workrave_timerbox_control_start(WorkraveTimerboxControl *self)
         }
     }
 
+  if (error == NULL)
+    {
+      workrave_timerbox_control_request_timer_states(self);
+    }
+
   if (error == NULL)
     {
       priv->timer = g_timeout_add_seconds(10, on_timer, self);
@@ -458,6 +613,13 @@ workrave_timerbox_control_stop(WorkraveTimerboxControl *self)
           priv->startup_timer = 0;
         }
 
+      if (priv->frame_timer != 0)
+        {
+          g_source_remove(priv->frame_timer);
+          priv->frame_timer = 0;
+        }
+      priv->timer_states = FALSE;
+
       if (priv->owner_id != 0)
         {
           g_bus_unown_name(priv->owner_id);
@@ -548,7 +710,8 @@ on_timer(gpointer user_data)
   WorkraveTimerboxControl *self = WORKRAVE_TIMERBOX_CONTROL(user_data);
   WorkraveTimerboxControlPrivate *priv = workrave_timerbox_control_get_instance_private(self);
 
-  if (priv->alive && priv->update_count == 0)
+  // Timer states are only sent on changes, Workrave going away is noticed by the name watch.
+  if (priv->alive && priv->update_count == 0 && !priv->timer_states)
     {
       workrave_timerbox_set_enabled(priv->timerbox, FALSE);
       workrave_timerbox_set_force_icon(priv->timerbox, priv->tray_icon_visible_when_not_running);
@@ -654,17 +817,50 @@ on_dbus_signal(GDBusProxy *proxy, gchar *sender_name, gchar *signal_name, GVaria
 
   if (g_strcmp0(signal_name, "TimersUpdated") == 0)
     {
-      on_update_timers(self, parameters);
+      if (!priv->timer_states)
+        {
+          on_update_timers(self, parameters);
+        }
+    }
+
+  else if (g_strcmp0(signal_name, "TimerStateChanged") == 0)
+    {
+      if (priv->timer_states)
+        {
+          on_timer_state_changed(self, parameters);
+        }
+    }
+
+  else if (g_strcmp0(signal_name, "MenuSnapshot") == 0)
+    {
+      if (priv->menu_versions)
+        {
+          on_menu_snapshot(self, parameters);
+        }
+    }
+
+  else if (g_strcmp0(signal_name, "MenuItemChanged") == 0)
+    {
+      if (priv->menu_versions)
+        {
+          on_menu_item_changed(self, parameters);
+        }
     }
 
   else if (g_strcmp0(signal_name, "MenuUpdated") == 0)
     {
-      g_signal_emit(self, signals[MENU_CHANGED], 0, parameters);
+      if (!priv->menu_versions)
+        {
+          g_signal_emit(self, signals[MENU_CHANGED], 0, parameters);
+        }
     }
 
   else if (g_strcmp0(signal_name, "MenuItemUpdated") == 0)
     {
-      g_signal_emit(self, signals[MENU_ITEM_CHANGED], 0, parameters);
+      if (!priv->menu_versions)
+        {
+          g_signal_emit(self, signals[MENU_ITEM_CHANGED], 0, parameters);
+        }
     }
 
   else if (g_strcmp0(signal_name, "TrayIconUpdated") == 0)
@@ -751,6 +947,178 @@ on_update_timers(WorkraveTimerboxControl *self, GVariant *parameters)
     }
 }
 
+static void
+get_timer_state(GVariant *variant, TimerState *state)
+{
+  g_variant_get(variant,
+                "(iiiuiiiuiiix)",
+                &state->slot,
+                &state->value,
+                &state->value_rate,
+                &state->primary_color,
+                &state->primary_val,
+                &state->primary_rate,
+                &state->primary_max,
+                &state->secondary_color,
+                &state->secondary_val,
+                &state->secondary_rate,
+                &state->secondary_max,
+                &state->reference);
+}
+
+static gboolean
+timer_state_equal(const TimerState *a, const TimerState *b)
+{
+  return a->slot == b->slot && a->value == b->value && a->primary_color == b->primary_color && a->primary_val == b->primary_val
+         && a->primary_max == b->primary_max && a->secondary_color == b->secondary_color && a->secondary_val == b->secondary_val
+         && a->secondary_max == b->secondary_max;
+}
+
+//! Computes the state of a timer at the specified time. Must match TimerStateTracker::interpolate.
+static void
+interpolate_timer_state(const TimerState *state, gint64 now, TimerState *out)
+{
+  *out = *state;
+  if (now > state->reference)
+    {
+      gint32 seconds = (gint32)((now - state->reference) / G_USEC_PER_SEC);
+      out->value += state->value_rate * seconds;
+      out->primary_val += state->primary_rate * seconds;
+      out->secondary_val += state->secondary_rate * seconds;
+    }
+}
+
+static void
+workrave_timerbox_control_request_timer_states(WorkraveTimerboxControl *self)
+{
+  WorkraveTimerboxControlPrivate *priv = workrave_timerbox_control_get_instance_private(self);
+
+  GError *error = NULL;
+  GVariant *result = g_dbus_proxy_call_sync(priv->applet_proxy,
+                                            "GetTimerStates",
+                                            g_variant_new("(s)", WORKRAVE_DBUS_NAME),
+                                            G_DBUS_CALL_FLAGS_NONE,
+                                            -1,
+                                            NULL,
+                                            &error);
+
+  if (error != NULL)
+    {
+      // Older versions of Workrave only send TimersUpdated.
+      priv->timer_states = FALSE;
+      g_error_free(error);
+      return;
+    }
+
+  for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+    {
+      GVariant *child = g_variant_get_child_value(result, i);
+      get_timer_state(child, &priv->states[i]);
+      g_variant_unref(child);
+
+      // Force a redraw.
+      priv->shown[i].slot = -2;
+    }
+  g_variant_unref(result);
+
+  priv->timer_states = TRUE;
+  workrave_timerbox_control_update_timer_states(self);
+}
+
+static gboolean
+on_frame(gpointer user_data)
+{
+  WorkraveTimerboxControl *self = WORKRAVE_TIMERBOX_CONTROL(user_data);
+  WorkraveTimerboxControlPrivate *priv = workrave_timerbox_control_get_instance_private(self);
+
+  priv->frame_timer = 0;
+  workrave_timerbox_control_update_timer_states(self);
+  return G_SOURCE_REMOVE;
+}
+
+static void
+workrave_timerbox_control_update_timer_states(WorkraveTimerboxControl *self)
+{
+  WorkraveTimerboxControlPrivate *priv = workrave_timerbox_control_get_instance_private(self);
+
+  gint64 now = g_get_real_time();
+  gboolean changed = FALSE;
+  gboolean running = FALSE;
+
+  for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+    {
+      TimerState state;
+      interpolate_timer_state(&priv->states[i], now, &state);
+
+      running = running || state.value_rate != 0 || state.primary_rate != 0 || state.secondary_rate != 0;
+
+      if (!timer_state_equal(&state, &priv->shown[i]))
+        {
+          priv->shown[i] = state;
+          changed = TRUE;
+        }
+    }
+
+  if (changed)
+    {
+      for (int slot = 0; slot < BREAK_ID_SIZEOF; slot++)
+        {
+          WorkraveBreakId id = BREAK_ID_NONE;
+          for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+            {
+              if (priv->shown[i].slot == slot)
+                {
+                  id = (WorkraveBreakId)i;
+                }
+            }
+          workrave_timerbox_set_slot(priv->timerbox, slot, id);
+        }
+
+      for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+        {
+          WorkraveTimebar *timebar = workrave_timerbox_get_time_bar(priv->timerbox, i);
+          if (timebar != NULL)
+            {
+              TimerState *state = &priv->shown[i];
+              gchar *text = workrave_time_to_string(state->value);
+
+              workrave_timerbox_set_enabled(priv->timerbox, TRUE);
+              workrave_timerbox_control_update_show_tray_icon(self);
+              workrave_timebar_set_progress(timebar, state->primary_val, state->primary_max, state->primary_color);
+              workrave_timebar_set_secondary_progress(timebar, state->secondary_val, state->secondary_max, state->secondary_color);
+              workrave_timebar_set_text(timebar, text);
+              g_free(text);
+            }
+        }
+
+      workrave_timerbox_update(priv->timerbox, priv->image);
+    }
+
+  if (running && priv->frame_timer == 0)
+    {
+      // References are on whole seconds, wake up just after the next one.
+      guint delay = (guint)((G_USEC_PER_SEC - now % G_USEC_PER_SEC) / 1000) + 10;
+      priv->frame_timer = g_timeout_add(delay, on_frame, self);
+    }
+}
+
+static void
+on_timer_state_changed(WorkraveTimerboxControl *self, GVariant *parameters)
+{
+  WorkraveTimerboxControlPrivate *priv = workrave_timerbox_control_get_instance_private(self);
+
+  guint32 timer;
+  GVariant *state;
+  g_variant_get(parameters, "(u@(iiiuiiiuiiix))", &timer, &state);
+
+  if (timer < BREAK_ID_SIZEOF)
+    {
+      get_timer_state(state, &priv->states[timer]);
+      workrave_timerbox_control_update_timer_states(self);
+    }
+  g_variant_unref(state);
+}
+
 static void
 on_bus_acquired(GDBusConnection *connection, const gchar *name, gpointer user_data)
 {
@@ -76,6 +76,13 @@ struct _WorkraveTimebarPrivate
 
   PangoContext *pango_context;
   PangoLayout *pango_layout;
+
+  //! Size of the text in pango_layout.
+  int text_width;
+  int text_height;
+
+  //! Frame, drawn once and reused on every update.
+  cairo_surface_t *frame_surface;
 };
 
 G_DEFINE_TYPE_WITH_PRIVATE(WorkraveTimebar, workrave_timebar, G_TYPE_OBJECT);
@@ -123,6 +130,9 @@ workrave_timebar_init(WorkraveTimebar *self)
   priv->height = 0;
   priv->pango_context = NULL;
   priv->pango_layout = NULL;
+  priv->text_width = 0;
+  priv->text_height = 0;
+  priv->frame_surface = NULL;
 
   workrave_timebar_prepare(self);
 }
@@ -135,6 +145,7 @@ workrave_timebar_dispose(GObject *gobject)
 
   g_clear_pointer(&priv->bar_text, g_free);
   g_clear_pointer(&priv->pango_layout, g_object_unref);
+  g_clear_pointer(&priv->frame_surface, cairo_surface_destroy);
 
   /* Chain up to the parent class */
   G_OBJECT_CLASS(workrave_timebar_parent_class)->dispose(gobject);
@@ -150,7 +161,15 @@ workrave_timebar_draw_bar(WorkraveTimebar *self, cairo_t *cr)
   cairo_clip(cr);
 
   // Frame
-  workrave_timebar_draw_frame(self, cr, priv->width, priv->height);
+  if (priv->frame_surface == NULL)
+    {
+      priv->frame_surface = cairo_surface_create_similar(cairo_get_target(cr), CAIRO_CONTENT_COLOR_ALPHA, priv->width, priv->height);
+      cairo_t *frame_cr = cairo_create(priv->frame_surface);
+      workrave_timebar_draw_frame(self, frame_cr, priv->width, priv->height);
+      cairo_destroy(frame_cr);
+    }
+  cairo_set_source_surface(cr, priv->frame_surface, 0, 0);
+  cairo_paint(cr);
 
   int bar_width = 0;
   int sbar_width = 0;
@@ -227,11 +246,8 @@ workrave_timebar_draw_text(WorkraveTimebar *self, cairo_t *cr)
 {
   WorkraveTimebarPrivate *priv = workrave_timebar_get_instance_private(self);
 
-  // g_debug("bar_text %s", priv->bar_text);
-  pango_layout_set_text(priv->pango_layout, priv->bar_text, -1);
-
-  int text_width, text_height;
-  pango_layout_get_pixel_size(priv->pango_layout, &text_width, &text_height);
+  int text_width = priv->text_width;
+  int text_height = priv->text_height;
 
   int text_x, text_y;
   text_x = priv->width - text_width - MARGINX;
@@ -292,6 +308,9 @@ workrave_timebar_prepare(WorkraveTimebar *self)
       pango_layout_set_text(priv->pango_layout, "-9:59:59", -1);
       pango_layout_get_pixel_size(priv->pango_layout, &priv->width, &priv->height);
 
+      pango_layout_set_text(priv->pango_layout, priv->bar_text, -1);
+      pango_layout_get_pixel_size(priv->pango_layout, &priv->text_width, &priv->text_height);
+
       priv->width = MAX(priv->width + 2 * MARGINX, MIN_HORIZONTAL_BAR_WIDTH);
       priv->height = MAX(priv->height + 2 * MARGINY, MIN_HORIZONTAL_BAR_HEIGHT);
 
@@ -383,8 +402,34 @@ void
 workrave_timebar_set_text(WorkraveTimebar *self, const gchar *text)
 {
   WorkraveTimebarPrivate *priv = workrave_timebar_get_instance_private(self);
-  g_free(priv->bar_text);
-  priv->bar_text = g_strdup(text);
+
+  if (g_strcmp0(priv->bar_text, text) != 0)
+    {
+      g_free(priv->bar_text);
+      priv->bar_text = g_strdup(text);
+
+      pango_layout_set_text(priv->pango_layout, priv->bar_text, -1);
+      pango_layout_get_pixel_size(priv->pango_layout, &priv->text_width, &priv->text_height);
+    }
+}
+
+/**
+ * workrave_timebar_invalidate:
+ * @self: a @WorkraveTimebar
+ *
+ * Drops the cached frame and text layout, e.g. after a theme change, and
+ * measures the bar again with the current font.
+ */
+void
+workrave_timebar_invalidate(WorkraveTimebar *self)
+{
+  WorkraveTimebarPrivate *priv = workrave_timebar_get_instance_private(self);
+
+  g_clear_pointer(&priv->frame_surface, cairo_surface_destroy);
+  g_clear_pointer(&priv->pango_layout, g_object_unref);
+  priv->pango_context = NULL;
+
+  workrave_timebar_prepare(self);
 }
 
 void
@@ -63,6 +63,9 @@ struct _WorkraveTimerboxPrivate
   gboolean force_icon;
   gchar *mode;
   GSettings *settings;
+
+  //! Image the timerbox is drawn into, reused while its size does not change.
+  cairo_surface_t *image_surface;
 };
 
 G_DEFINE_TYPE_WITH_PRIVATE(WorkraveTimerbox, workrave_timerbox, G_TYPE_OBJECT);
@@ -110,6 +113,7 @@ workrave_timerbox_init(WorkraveTimerbox *self)
   priv->normal_sheep_icon = NULL;
   priv->quiet_sheep_icon = NULL;
   priv->suspended_sheep_icon = NULL;
+  priv->image_surface = NULL;
 
   workrave_timerbox_init_images(self);
 }
@@ -127,6 +131,7 @@ workrave_timerbox_dispose(GObject *gobject)
   g_clear_pointer(&priv->mode, g_free);
   g_clear_pointer(&priv->settings, g_object_unref);
   g_clear_pointer(&priv->name, g_free);
+  g_clear_pointer(&priv->image_surface, cairo_surface_destroy);
 
   for (int i = 0; i < BREAK_ID_SIZEOF; i++)
     {
@@ -343,19 +348,31 @@ workrave_timerbox_update(WorkraveTimerbox *self, GtkImage *image)
   int width = 24;
   int height = 24;
 
+  WorkraveTimerboxPrivate *priv = workrave_timerbox_get_instance_private(self);
+
   workrave_timerbox_compute_dimensions(self, &width, &height);
 
-  cairo_surface_t *surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+  cairo_surface_t *surface = priv->image_surface;
+  if (surface == NULL || cairo_image_surface_get_width(surface) != width || cairo_image_surface_get_height(surface) != height)
+    {
+      g_clear_pointer(&priv->image_surface, cairo_surface_destroy);
+      priv->image_surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+      surface = priv->image_surface;
+    }
+
   cairo_t *cr = cairo_create(surface);
 
+  cairo_save(cr);
+  cairo_set_operator(cr, CAIRO_OPERATOR_CLEAR);
+  cairo_paint(cr);
+  cairo_restore(cr);
+
   workrave_timerbox_draw(self, cr);
+  cairo_destroy(cr);
 
   GdkPixbuf *pixbuf = gdk_pixbuf_get_from_surface(surface, 0, 0, width, height);
   gtk_image_set_from_pixbuf(image, pixbuf);
-
   g_object_unref(pixbuf);
-  cairo_surface_destroy(surface);
-  cairo_destroy(cr);
 }
 
 /**
@@ -424,6 +441,25 @@ workrave_timerbox_get_time_bar(WorkraveTimerbox *self, WorkraveBreakId timer)
   return priv->slot_to_time_bar[timer];
 }
 
+/**
+ * workrave_timerbox_invalidate:
+ * @self: a @WorkraveTimerbox
+ *
+ * Drops all cached surfaces and layouts. To be called when the theme or the
+ * size of the widget showing the timerbox changes.
+ */
+void
+workrave_timerbox_invalidate(WorkraveTimerbox *self)
+{
+  WorkraveTimerboxPrivate *priv = workrave_timerbox_get_instance_private(self);
+
+  for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+    {
+      workrave_timebar_invalidate(priv->slot_to_time_bar[i]);
+    }
+  g_clear_pointer(&priv->image_surface, cairo_surface_destroy);
+}
+
 /**
  * workrave_timerbox_set_enabled:
  * @self: a @WorkraveTimerbox
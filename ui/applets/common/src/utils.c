@@ -58,3 +58,24 @@ workrave_extract_shortcut(const gchar *text, gchar **out, gchar *shortcut)
     }
   *dst++ = '\0';
 }
+
+gchar *
+workrave_time_to_string(int time)
+{
+  const gchar *sign = "";
+  if (time < 0)
+    {
+      sign = "-";
+      time = -time;
+    }
+
+  int hrs = time / 3600;
+  int min = (time / 60) % 60;
+  int sec = time % 60;
+
+  if (hrs > 0)
+    {
+      return g_strdup_printf("%s%d:%02d:%02d", sign, hrs, min, sec);
+    }
+  return g_strdup_printf("%s%d:%02d", sign, min, sec);
+}
@@ -23,7 +23,8 @@ const IndicatorIface = '<node>\
     <method name="Command"> \
         <arg type="i" name="command" direction="in" /> \
     </method> \
-    <method name="GetMenu"> \
+    <method name="GetMenuSnapshot"> \
+        <arg type="u" name="version" direction="out" /> \
         <arg type="a(ssuyy)" name="menuitems" direction="out" /> \
     </method> \
     <method name="GetTrayIconEnabled"> \
@@ -34,11 +35,15 @@ const IndicatorIface = '<node>\
         <arg type="(siuuuuuu)" /> \
         <arg type="(siuuuuuu)" /> \
     </signal> \
-    <signal name="MenuUpdated"> \
+    <signal name="MenuSnapshot"> \
+        <arg type="u" /> \
         <arg type="a(ssuyy)" /> \
     </signal> \
-    <signal name="MenuItemUpdated"> \
-        <arg type="(ssuyy)" /> \
+    <signal name="MenuItemChanged"> \
+        <arg type="u" /> \
+        <arg type="u" /> \
+        <arg type="s" /> \
+        <arg type="y" /> \
     </signal> \
     <signal name="TrayIconUpdated"> \
         <arg type="b" /> \
@@ -183,6 +188,7 @@ const WorkraveButton = new Lang.Class({
         this._bus_name = 'org.workrave.GnomeShellApplet';
         this._bus_id = 0;
         this._menu_entries = {};
+        this._menu_version = 0;
 
         this._area = new St.DrawingArea({ style_class: 'workrave-area', reactive: true } );
         this._area.set_width(this._width=24);
@@ -207,8 +213,8 @@ const WorkraveButton = new Lang.Class({
 
         this._ui_proxy = new IndicatorProxy(Gio.DBus.session, 'org.workrave.Workrave', '/org/workrave/Workrave/UI', Lang.bind(this, this._connectUI));
         this._timers_updated_id = this._ui_proxy.connectSignal("TimersUpdated", Lang.bind(this, this._onTimersUpdated));
-        this._menu_updated_id = this._ui_proxy.connectSignal("MenuUpdated", Lang.bind(this, this._onMenuUpdated));
-        this._menu_item_updated_id = this._ui_proxy.connectSignal("MenuItemUpdated", Lang.bind(this, this._onMenuItemUpdated));
+        this._menu_snapshot_id = this._ui_proxy.connectSignal("MenuSnapshot", Lang.bind(this, this._onMenuSnapshot));
+        this._menu_item_changed_id = this._ui_proxy.connectSignal("MenuItemChanged", Lang.bind(this, this._onMenuItemChanged));
         this._trayicon_updated_id = this._ui_proxy.connectSignal("TrayIconUpdated", Lang.bind(this, this._onTrayIconUpdated));
 
         this._core_proxy = new CoreProxy(Gio.DBus.session, 'org.workrave.Workrave', '/org/workrave/Workrave/Core', Lang.bind(this, this._connectCore));
@@ -251,8 +257,8 @@ const WorkraveButton = new Lang.Class({
         if (this._ui_proxy != null)
         {
             this._ui_proxy.disconnectSignal(this._timers_updated_id);
-            this._ui_proxy.disconnectSignal(this._menu_updated_id);
-            this._ui_proxy.disconnectSignal(this._menu_item_updated_id);
+            this._ui_proxy.disconnectSignal(this._menu_snapshot_id);
+            this._ui_proxy.disconnectSignal(this._menu_item_changed_id);
             this._ui_proxy.disconnectSignal(this._trayicon_updated_id);
             this._ui_proxy = null;
         }
@@ -268,7 +274,8 @@ const WorkraveButton = new Lang.Class({
         if (! this._alive)
         {
             this._bus_id = Gio.DBus.session.own_name(this._bus_name, Gio.BusNameOwnerFlags.NONE, null, null);
-            this._ui_proxy.GetMenuRemote(Lang.bind(this, this._onGetMenuReply));
+            this._menu_version = 0;
+            this._ui_proxy.GetMenuSnapshotRemote(Lang.bind(this, this._onGetMenuSnapshotReply));
             this._ui_proxy.GetTrayIconEnabledRemote(Lang.bind(this, this._onGetTrayIconEnabledReply));
             this._ui_proxy.EmbedRemote(true, this._bus_name);
             this._core_proxy.GetOperationModeRemote(Lang.bind(this, this._onGetOperationModeReply));
@@ -384,7 +391,8 @@ const WorkraveButton = new Lang.Class({
         this._area.queue_repaint();
     },
 
-    _onGetMenuReply : function([menuitems], excp) {
+    _onGetMenuSnapshotReply : function([version, menuitems], excp) {
+        this._menu_version = version;
         this._updateMenu(menuitems);
     },
 
@@ -396,12 +404,27 @@ const WorkraveButton = new Lang.Class({
         this._timerbox.set_operation_mode(mode);
     },
 
-    _onMenuUpdated : function(emitter, senderName, [menuitems]) {
+    _onMenuSnapshot : function(emitter, senderName, [version, menuitems]) {
+        this._menu_version = version;
         this._updateMenu(menuitems);
     },
 
-    _onMenuItemUpdated : function(emitter, senderName, [menuitem]) {
-        this._updateItemMenu(menuitem);
+    _onMenuItemChanged : function(emitter, senderName, [version, command, text, flags]) {
+        if (version <= this._menu_version)
+        {
+            // Already part of the menu snapshot.
+            return;
+        }
+
+        if (version != this._menu_version + 1)
+        {
+            // A change was missed, fetch the whole menu again.
+            this._ui_proxy.GetMenuSnapshotRemote(Lang.bind(this, this._onGetMenuSnapshotReply));
+            return;
+        }
+
+        this._menu_version = version;
+        this._updateItemMenu([text, "", command, this._menu_types[command], flags]);
     },
 
     _onTrayIconUpdated : function(emitter, senderName, [enabled]) {
@@ -420,7 +443,7 @@ const WorkraveButton = new Lang.Class({
     },
 
     _onMenuOpenCommand: function(item, event) {
-        this._ui_proxy.GetMenuRemote(); // A dummy method call to re-activate the service
+        this._ui_proxy.GetMenuSnapshotRemote(); // A dummy method call to re-activate the service
     },
 
     _updateTrayIcon : function(enabled) {
@@ -431,6 +454,7 @@ const WorkraveButton = new Lang.Class({
     _updateMenu : function(menuitems) {
         this.menu.removeAll();
         this._menu_entries = {}
+        this._menu_types = {}
 
         let current_menu = this.menu;
         let indent = "";
@@ -505,6 +529,7 @@ const WorkraveButton = new Lang.Class({
                     popup.connect('activate', Lang.bind(this, this._onMenuCommand, id));
                     current_menu.addMenuItem(popup);
                     this._menu_entries[id] = popup;
+                    this._menu_types[id] = type;
                 }
             }
         }
@@ -518,6 +543,11 @@ const WorkraveButton = new Lang.Class({
         let active = ((flags & MENU_ITEM_FLAG_ACTIVE) != 0);
         let visible = ((flags & MENU_ITEM_FLAG_VISIBLE) != 0);
         let popup = this._menu_entries[id];
+        if (popup == null)
+        {
+            // Sub menus cannot change.
+            return;
+        }
 
         global.log('workrave-applet: menu2 ' +  id + ' ' + type +' ' + flags + ' ' + active + ' ' + visible);
 
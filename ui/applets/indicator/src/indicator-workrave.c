@@ -147,6 +147,8 @@ static void on_update_indicator(IndicatorWorkrave *self, GVariant *parameters);
 static void on_bus_acquired(GDBusConnection *connection, const gchar *name, gpointer user_data);
 static void on_workrave_appeared(GDBusConnection *connection, const gchar *name, const gchar *name_owner, gpointer user_data);
 static void on_workrave_vanished(GDBusConnection *connection, const gchar *name, gpointer user_data);
+static void on_image_style_updated(GtkWidget *widget, gpointer user_data);
+static void on_image_size_allocate(GtkWidget *widget, GdkRectangle *allocation, gpointer user_data);
 
 /* Indicator Module Config */
 INDICATOR_SET_VERSION
@@ -268,6 +270,10 @@ get_icon(IndicatorObject *io)
     {
       priv->image = GTK_IMAGE(gtk_image_new());
 
+      // The timerbox caches its rendering, which depends on the theme and size of the image.
+      g_signal_connect_object(priv->image, "style-updated", G_CALLBACK(on_image_style_updated), self, 0);
+      g_signal_connect_object(priv->image, "size-allocate", G_CALLBACK(on_image_size_allocate), self, 0);
+
       workrave_timerbox_set_enabled(priv->timerbox, FALSE);
       workrave_timerbox_set_force_icon(priv->timerbox, FALSE);
       workrave_timerbox_update(priv->timerbox, priv->image);
@@ -277,6 +283,29 @@ get_icon(IndicatorObject *io)
   return priv->image;
 }
 
+static void
+on_image_style_updated(GtkWidget *widget, gpointer user_data)
+{
+  (void)widget;
+  IndicatorWorkrave *self = INDICATOR_WORKRAVE(user_data);
+  IndicatorWorkravePrivate *priv = indicator_workrave_get_instance_private(self);
+
+  workrave_timerbox_invalidate(priv->timerbox);
+  workrave_timerbox_update(priv->timerbox, priv->image);
+}
+
+static void
+on_image_size_allocate(GtkWidget *widget, GdkRectangle *allocation, gpointer user_data)
+{
+  (void)widget;
+  (void)allocation;
+  IndicatorWorkrave *self = INDICATOR_WORKRAVE(user_data);
+  IndicatorWorkravePrivate *priv = indicator_workrave_get_instance_private(self);
+
+  // Updating the image here would allocate it again; the next timer update redraws it.
+  workrave_timerbox_invalidate(priv->timerbox);
+}
+
 static GtkMenu *
 get_menu(IndicatorObject *io)
 {